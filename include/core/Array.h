@@ -36,6 +36,7 @@
 #include "Types.h"
 #include "String.h"
 #include "Exception.h"
+#include "Sort.h"
 
 namespace jm
 {
@@ -72,6 +73,14 @@ namespace jm
             }
          }
 
+         Array(Array&& other) noexcept: Object(),
+            mSize(other.mSize),
+            mData(other.mData)
+         {
+            other.mSize = 0;
+            other.mData = nullptr;
+         }
+
          ~Array() override
          {
             mSize = 0;
@@ -83,33 +92,39 @@ namespace jm
             return mSize;
          };
 
+         /*!
+          \brief Sorts the array in ascending order. Elements derived from Comparable are compared
+          by compareTo(), all others by operator <.
+          */
          inline void sort()
          {
-            if(mSize < 1)return;
-            if(dynamic_cast<Comparable<T>*>(&mData[0]) == nullptr)return;
+            Sort::sort(mData, mData + mSize, Sort::Ascending<T>());
+         }
 
-            size_t n = mSize;
-            do
-            {
-               size_t newn = 1;
-               for(size_t i = 0; i < n - 1; ++i)
-               {
-                  size_t j = i + 1;
-                  Comparable<T>* a1 = static_cast<Comparable<T>*>(&mData[i]);
-                  Comparable<T>* a2 = static_cast<Comparable<T>*>(&mData[j]);
-                  if(a1->compareTo(*static_cast<T*>(a2)) > 0)
-                  {
-                     //Vertausche
-                     T tmp = mData[i];
-                     mData[i] = mData[j];
-                     mData[j] = tmp;
-
-                     newn = i + 1;
-                  }
-               }
-               n = newn;
-            }
-            while(n > 1);
+         /*!
+          \brief Sorts the array with \p less, which returns true, if the first argument must be
+          placed before the second one.
+          */
+         template <class Less>
+         inline void sort(Less less)
+         {
+            Sort::sort(mData, mData + mSize, less);
+         }
+
+         /*!
+          \brief Sorts the array in ascending order. Equal elements keep their order.
+          */
+         inline void stableSort()
+         {
+            Sort::stableSort(mData, mData + mSize, Sort::Ascending<T>());
+         }
+
+         /*!
+          \brief Sorts the array in ascending order with several threads.
+          */
+         inline void parallelSort()
+         {
+            Sort::parallelSort(mData, mData + mSize, Sort::Ascending<T>());
          }
 
          inline T get(size_t index) const
@@ -150,6 +165,21 @@ namespace jm
             return *this;
          }
 
+         Array& operator=(Array&& another) noexcept
+         {
+            if(this != &another)
+            {
+               delete[] mData;
+
+               mSize = another.mSize;
+               mData = another.mData;
+               another.mSize = 0;
+               another.mData = nullptr;
+            }
+
+            return *this;
+         }
+
       private:
 
          /*!
@@ -195,6 +225,14 @@ namespace jm
             }
          }
 
+         Array(Array&& other) noexcept : Object(),
+            mLength(other.mLength),
+            mData(other.mData)
+         {
+            other.mLength = 0;
+            other.mData = nullptr;
+         }
+
          ~Array() override
          {
             mLength = 0;
@@ -206,33 +244,38 @@ namespace jm
             return mLength;
          };
 
+         /*!
+          \brief Sorts the array in ascending order of the objects. nullptr is placed at the end.
+          */
          inline void sort()
          {
-            if(mLength < 1)return;
-            if(mData[0] == nullptr)return;
+            Sort::sort(mData, mData + mLength, Sort::Ascending<T*>());
+         }
 
-            size_t n = mLength;
-            do
-            {
-               size_t newn = 1;
-               for(size_t i = 0; i < n - 1; ++i)
-               {
-                  size_t j = i + 1;
-                  const Comparable<T>* a1 = static_cast<Comparable<T>*>(mData[i]);
-                  const T& a2 = *mData[j];
-                  if(a1->compareTo(a2) > 0)
-                  {
-                     // Swap
-                     T* tmp = mData[i];
-                     mData[i] = mData[j];
-                     mData[j] = tmp;
-
-                     newn = i + 1;
-                  }
-               }
-               n = newn;
-            }
-            while(n > 1);
+         /*!
+          \brief Sorts the array with \p less, which returns true, if the first argument must be
+          placed before the second one.
+          */
+         template <class Less>
+         inline void sort(Less less)
+         {
+            Sort::sort(mData, mData + mLength, less);
+         }
+
+         /*!
+          \brief Sorts the array in ascending order of the objects. Equal objects keep their order.
+          */
+         inline void stableSort()
+         {
+            Sort::stableSort(mData, mData + mLength, Sort::Ascending<T*>());
+         }
+
+         /*!
+          \brief Sorts the array in ascending order of the objects with several threads.
+          */
+         inline void parallelSort()
+         {
+            Sort::parallelSort(mData, mData + mLength, Sort::Ascending<T*>());
          }
 
          inline T* get(size_t index) const
@@ -274,6 +317,21 @@ namespace jm
             return *this;
          }
 
+         Array& operator=(Array&& another) noexcept
+         {
+            if(this != &another)
+            {
+               delete[] mData;
+
+               mLength = another.mLength;
+               mData = another.mData;
+               another.mLength = 0;
+               another.mData = nullptr;
+            }
+
+            return *this;
+         }
+
       private:
 
          //! The length of the array.
@@ -314,6 +372,14 @@ namespace jm
             }
          }
 
+         FloatArray(FloatArray&& other) noexcept: Object(),
+            mLength(other.mLength),
+            mData(other.mData)
+         {
+            other.mLength = 0;
+            other.mData = nullptr;
+         }
+
          FloatArray(std::initializer_list<float> list): Object()
          {
             mLength = list.size();
@@ -340,30 +406,7 @@ namespace jm
 
          inline void Sort()
          {
-            if(mLength < 1)return;
-
-            size_t n = mLength;
-            do
-            {
-               size_t newn = 1;
-               for(size_t i = 0; i < n - 1; ++i)
-               {
-                  size_t j = i + 1;
-                  float a1 = mData[i];
-                  float a2 = mData[j];
-                  if(a1 > a2)
-                  {
-                     // Swap
-                     float tmp = mData[i];
-                     mData[i] = mData[j];
-                     mData[j] = tmp;
-
-                     newn = i + 1;
-                  }
-               }
-               n = newn;
-            }
-            while(n > 1);
+            jm::Sort::sort(mData, mData + mLength, jm::Sort::Ascending<float>());
          }
 
          inline float Get(size_t index) const
@@ -404,6 +447,21 @@ namespace jm
             return *this;
          }
 
+         FloatArray& operator=(FloatArray&& another) noexcept
+         {
+            if(this != &another)
+            {
+               delete[] mData;
+
+               mLength = another.mLength;
+               mData = another.mData;
+               another.mLength = 0;
+               another.mData = nullptr;
+            }
+
+            return *this;
+         }
+
       private:
 
          //! The length of the array
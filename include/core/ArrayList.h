@@ -0,0 +1,473 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ArrayList.h
+// Library:     Jameo Core Library
+// Purpose:     Growable contiguous array
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_ArrayList_h
+#define jm_ArrayList_h
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "Object.h"
+
+namespace jm
+{
+   /*!
+    \brief Storage for the first \p N elements of an ArrayList, which lives inside the list
+    itself. The elements are constructed by the list.
+    */
+   template <class T, size_t N>
+   struct ArrayListBuffer
+   {
+      alignas(T) unsigned char bytes[sizeof(T) * N];
+
+      T* data() noexcept
+      {
+         return reinterpret_cast<T*>(bytes);
+      }
+   };
+
+   //! Without inline capacity, the list has no buffer.
+   template <class T>
+   struct ArrayListBuffer<T, 0>
+   {
+      T* data() noexcept
+      {
+         return nullptr;
+      }
+   };
+
+   /*!
+    \brief A growable array, whose elements are stored contiguously. Appending an element takes
+    amortized constant time, because the capacity grows geometrically.
+
+    In contrast to Array, the size of the list can change. Elements of trivially copyable types
+    are relocated by memcpy(), all others are moved, if this can not throw.
+
+    If \p N is larger than 0, the first \p N elements are stored inside the list itself, so small
+    lists do not allocate memory at all.
+
+    \note References and pointers to elements become invalid, when the capacity changes.
+    \ingroup core
+    */
+   template <class T, size_t N = 0>
+   class ArrayList: public Object
+   {
+      public:
+
+         //! Constructor for an empty list.
+         ArrayList() noexcept: Object(),
+            mSize(0),
+            mCapacity(N)
+         {
+            mData = mBuffer.data();
+         }
+
+         /*!
+          \brief Constructor for a list with \p size value-initialized elements.
+          */
+         explicit ArrayList(size_t size): ArrayList()
+         {
+            resize(size);
+         }
+
+         //! Constructor for a list with the given elements.
+         ArrayList(std::initializer_list<T> items): ArrayList()
+         {
+            reserve(items.size());
+            for(const T& item : items)new(mData + mSize++) T(item);
+         }
+
+         ArrayList(const ArrayList& other): ArrayList()
+         {
+            reserve(other.mSize);
+            for(size_t index = 0; index < other.mSize; index++)
+            {
+               new(mData + mSize++) T(other.mData[index]);
+            }
+         }
+
+         ArrayList(ArrayList&& other) noexcept: ArrayList()
+         {
+            take(other);
+         }
+
+         ~ArrayList() override
+         {
+            clear();
+            release();
+         }
+
+         ArrayList& operator=(const ArrayList& other)
+         {
+            if(this != &other)
+            {
+               clear();
+               reserve(other.mSize);
+               for(size_t index = 0; index < other.mSize; index++)
+               {
+                  new(mData + mSize++) T(other.mData[index]);
+               }
+            }
+            return *this;
+         }
+
+         ArrayList& operator=(ArrayList&& other) noexcept
+         {
+            if(this != &other)
+            {
+               clear();
+               release();
+               mData = mBuffer.data();
+               mCapacity = N;
+               take(other);
+            }
+            return *this;
+         }
+
+         //! Returns the number of elements.
+         size_t size() const noexcept
+         {
+            return mSize;
+         }
+
+         //! Returns the number of elements, which fit into the list without a reallocation.
+         size_t capacity() const noexcept
+         {
+            return mCapacity;
+         }
+
+         //! Returns true, if the list has no elements.
+         bool isEmpty() const noexcept
+         {
+            return mSize == 0;
+         }
+
+         //! Returns the element at \p index. The index is not checked.
+         T& operator[](size_t index) noexcept
+         {
+            return mData[index];
+         }
+
+         //! Returns the element at \p index. The index is not checked.
+         const T& operator[](size_t index) const noexcept
+         {
+            return mData[index];
+         }
+
+         //! Returns the first element. The list must not be empty.
+         T& first() noexcept
+         {
+            return mData[0];
+         }
+
+         //! Returns the first element. The list must not be empty.
+         const T& first() const noexcept
+         {
+            return mData[0];
+         }
+
+         //! Returns the last element. The list must not be empty.
+         T& last() noexcept
+         {
+            return mData[mSize - 1];
+         }
+
+         //! Returns the last element. The list must not be empty.
+         const T& last() const noexcept
+         {
+            return mData[mSize - 1];
+         }
+
+         //! Returns the elements. The pointer is valid until the capacity changes.
+         T* data() noexcept
+         {
+            return mData;
+         }
+
+         //! Returns the elements. The pointer is valid until the capacity changes.
+         const T* data() const noexcept
+         {
+            return mData;
+         }
+
+         /*!
+          \brief Appends a copy of \p item. \p item may be an element of this list.
+          */
+         void append(const T& item)
+         {
+            emplace(item);
+         }
+
+         /*!
+          \brief Moves \p item to the end of the list.
+          */
+         void append(T&& item)
+         {
+            emplace(std::move(item));
+         }
+
+         /*!
+          \brief Constructs a new element from \p args at the end of the list.
+          \return Reference to the new element.
+          */
+         template <class... Args>
+         T& emplace(Args&& ... args)
+         {
+            if(mSize == mCapacity)return emplaceGrow(std::forward<Args>(args)...);
+            T* item = new(mData + mSize) T(std::forward<Args>(args)...);
+            mSize++;
+            return *item;
+         }
+
+         /*!
+          \brief Inserts \p item at \p index. The following elements are moved back by one.
+          \param index The position of the new element. Must not be larger than size().
+          */
+         void insert(size_t index, T item)
+         {
+            if(index == mSize)
+            {
+               emplace(std::move(item));
+               return;
+            }
+
+            emplace(std::move(mData[mSize - 1]));
+            for(size_t position = mSize - 2; position > index; position--)
+            {
+               mData[position] = std::move(mData[position - 1]);
+            }
+            mData[index] = std::move(item);
+         }
+
+         /*!
+          \brief Removes the element at \p index. The following elements are moved forward by one.
+          */
+         void remove(size_t index)
+         {
+            for(size_t position = index + 1; position < mSize; position++)
+            {
+               mData[position - 1] = std::move(mData[position]);
+            }
+            removeLast();
+         }
+
+         //! Removes the last element. The list must not be empty.
+         void removeLast() noexcept
+         {
+            mData[--mSize].~T();
+         }
+
+         //! Removes all elements. The capacity is not changed.
+         void clear() noexcept
+         {
+            destroy(mData, mSize);
+            mSize = 0;
+         }
+
+         /*!
+          \brief Reserves space for \p capacity elements. The size of the list is not changed.
+          */
+         void reserve(size_t capacity)
+         {
+            if(capacity > mCapacity)reallocate(capacity);
+         }
+
+         /*!
+          \brief Changes the size of the list. New elements are value-initialized.
+          */
+         void resize(size_t size)
+         {
+            if(size < mSize)
+            {
+               destroy(mData + size, mSize - size);
+               mSize = size;
+               return;
+            }
+            reserve(size);
+            while(mSize < size)
+            {
+               new(mData + mSize) T();
+               mSize++;
+            }
+         }
+
+         //! Releases unused capacity.
+         void shrinkToFit()
+         {
+            if(mSize < mCapacity && mData != mBuffer.data())reallocate(std::max(mSize, N));
+         }
+
+         // Method needed for range-base for
+         T* begin() noexcept
+         {
+            return mData;
+         }
+
+         // Method needed for range-base for
+         T* end() noexcept
+         {
+            return mData + mSize;
+         }
+
+         // Method needed for range-base for
+         const T* begin() const noexcept
+         {
+            return mData;
+         }
+
+         // Method needed for range-base for
+         const T* end() const noexcept
+         {
+            return mData + mSize;
+         }
+
+      private:
+
+         //! The inline buffer for the first N elements.
+         [[no_unique_address]] ArrayListBuffer<T, N> mBuffer;
+
+         //! The elements. Either points to the inline buffer or to heap memory.
+         T* mData;
+
+         //! The number of elements.
+         size_t mSize;
+
+         //! The number of elements, which fit into mData.
+         size_t mCapacity;
+
+         //! Returns the capacity after the next growth for at least \p capacity elements.
+         size_t grownCapacity(size_t capacity) const noexcept
+         {
+            return std::max(std::max(mCapacity * 2, capacity), static_cast<size_t>(4));
+         }
+
+         //! Destroys \p count elements at \p items.
+         static void destroy(T* items, size_t count) noexcept
+         {
+            if constexpr(!std::is_trivially_destructible_v<T>)
+            {
+               for(size_t index = 0; index < count; index++)items[index].~T();
+            }
+         }
+
+         /*!
+          \brief Moves \p count elements from \p source to the uninitialized memory at \p target.
+          The elements at \p source are destroyed afterwards. An empty list without memory passes
+          nullptr as \p source.
+          */
+         static void relocate(T* target, T* source, size_t count)
+         {
+            if(source == nullptr || count == 0)return;
+
+            if constexpr(std::is_trivially_copyable_v<T>)
+            {
+               std::memcpy(static_cast<void*>(target), source, count * sizeof(T));
+            }
+            else
+            {
+               for(size_t index = 0; index < count; index++)
+               {
+                  new(target + index) T(std::move_if_noexcept(source[index]));
+                  source[index].~T();
+               }
+            }
+         }
+
+         //! Frees the heap memory, if there is some. The elements must be destroyed before.
+         void release() noexcept
+         {
+            if(mData != mBuffer.data())std::allocator<T>().deallocate(mData, mCapacity);
+         }
+
+         //! Moves the elements to a new memory block for \p capacity elements.
+         void reallocate(size_t capacity)
+         {
+            T* data = capacity <= N ? mBuffer.data() : std::allocator<T>().allocate(capacity);
+            relocate(data, mData, mSize);
+            release();
+            mData = data;
+            mCapacity = capacity <= N ? N : capacity;
+         }
+
+         /*!
+          \brief Slow path of emplace(). The new element is constructed before the old elements are
+          relocated, because \p args may refer to one of them.
+          */
+         template <class... Args>
+         T& emplaceGrow(Args&& ... args)
+         {
+            const size_t capacity = grownCapacity(mSize + 1);
+            T* data = std::allocator<T>().allocate(capacity);
+            T* item;
+            try
+            {
+               item = new(data + mSize) T(std::forward<Args>(args)...);
+            }
+            catch(...)
+            {
+               std::allocator<T>().deallocate(data, capacity);
+               throw;
+            }
+            relocate(data, mData, mSize);
+            release();
+            mData = data;
+            mCapacity = capacity;
+            mSize++;
+            return *item;
+         }
+
+         //! Takes the elements of \p other, which becomes empty. This list must be empty.
+         void take(ArrayList& other) noexcept
+         {
+            if(other.mData == other.mBuffer.data())
+            {
+               // Inline elements must be moved one by one.
+               relocate(mData, other.mData, other.mSize);
+               mSize = other.mSize;
+               other.mSize = 0;
+               return;
+            }
+            mData = other.mData;
+            mSize = other.mSize;
+            mCapacity = other.mCapacity;
+            other.mData = other.mBuffer.data();
+            other.mSize = 0;
+            other.mCapacity = N;
+         }
+   };
+}
+
+#endif
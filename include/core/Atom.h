@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Atom.h
+// Library:     Jameo Core Library
+// Purpose:     Interned strings
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_Atom_h
+#define jm_Atom_h
+
+#include <string_view>
+
+#include "String.h"
+
+namespace jm
+{
+
+   /*!
+    \brief An atom is an interned string. All atoms with the same content refer to the same
+    string, so comparing two atoms only compares two pointers and the hash code is calculated
+    only once.
+    \details Atoms are meant for identifiers, which are used again and again, like translation
+    keys, XML tag and attribute names or property ids. Creating an atom looks up the string in a
+    global table, which can be used by several threads at the same time. Interned strings are never
+    freed, so an atom stays valid until the end of the program. For the same reason, only names
+    known to the application should become atoms. Text read from documents or other input must stay
+    a String, otherwise the table grows without limit.
+
+    \code
+    static const Atom kWidth = Atom("width");
+    if(property.is(kWidth)) ...
+    \endcode
+    \ingroup core
+    */
+   class DllExport Atom
+   {
+      public:
+
+         /*!
+          \brief Creates the atom of the empty string.
+          */
+         Atom() noexcept;
+
+         /*!
+          \brief Creates the atom of \p string.
+          */
+         explicit Atom(const String& string);
+
+         /*!
+          \brief Creates the atom of the UTF-8 encoded \p string. If the atom already exists, no
+          String is created.
+          */
+         explicit Atom(const char* string);
+
+         /*!
+          \brief Creates the atom of the UTF-8 encoded \p string. If the atom already exists, no
+          String is created.
+          */
+         explicit Atom(std::string_view string);
+
+         /*!
+          \brief Creates the atom of the \p length UTF-16 units in \p buffer, whose hash code
+          \p hash is already known. \p hash must be String::hashCode(buffer, length). If the atom
+          already exists, no String is created.
+          */
+         Atom(const Char* buffer, size_t length, int64 hash);
+
+         /*!
+          \brief Returns the interned string.
+          */
+         inline const String& string() const noexcept
+         {
+            return *mString;
+         }
+
+         /*!
+          \brief Returns the interned string.
+          */
+         inline operator const String& () const noexcept
+         {
+            return *mString;
+         }
+
+         /*!
+          \brief Returns the hash code of the string, which was calculated when the atom was
+          created.
+          */
+         inline int64 hashCode() const noexcept
+         {
+            return mString->hashCode();
+         }
+
+         /*!
+          \brief Returns the number of characters of the string.
+          */
+         inline size_t size() const noexcept
+         {
+            return mString->size();
+         }
+
+         /*!
+          \brief Returns true, if this is the atom of the empty string.
+          */
+         inline bool isEmpty() const noexcept
+         {
+            return mString->size() == 0;
+         }
+
+         /*!
+          \brief Returns the number of existing atoms.
+          */
+         static size_t count();
+
+         //! Compares the atoms by their pointers.
+         friend inline bool operator==(const Atom& a1, const Atom& a2) noexcept
+         {
+            return a1.mString == a2.mString;
+         }
+
+         //! Compares the atoms by their pointers.
+         friend inline bool operator!=(const Atom& a1, const Atom& a2) noexcept
+         {
+            return a1.mString != a2.mString;
+         }
+
+      private:
+
+         //! The interned string.
+         const String* mString;
+   };
+
+}
+
+namespace std
+{
+   template <>
+   struct hash<jm::Atom>
+   {
+      std::size_t operator()(const jm::Atom& atom) const noexcept
+      {
+         return static_cast<std::size_t>(atom.hashCode());
+      }
+   };
+}
+
+#endif
@@ -40,6 +40,24 @@ namespace jm
    /*!
     \brief This class provides the memory pool component to release objects at regular intervals
     that the programmer has designated for delayed release by Object::autorelease().
+
+    Pools are organized as a stack per thread, similar to the \@autoreleasepool scopes of
+    Objective-C. A pool created with the default constructor becomes the current pool of the
+    creating thread until it is destroyed:
+
+    ~~~~~{.cpp}
+    {
+       jm::AutoreleasePool pool;
+       // All objects autoreleased in this thread are collected in pool.
+    }  // pool is drained here.
+    ~~~~~
+
+    Such a pool belongs to one thread and adding objects needs no lock. If a thread has no pool
+    of its own, objects are collected in the shared pool created by System::init(), which is
+    synchronized by a mutex.
+
+    The entries are stored in chunks of contiguous arrays. Chunks are kept for reuse after
+    drain(), so a pool allocates no memory once it has reached its working size.
     \ingroup datamgr
     */
    class DllExport AutoreleasePool: public Object
@@ -48,46 +66,72 @@ namespace jm
       public:
 
          /*!
-          \brief Constructor
+          \brief Constructor. Creates a pool and pushes it on the pool stack of the current
+          thread. The pool must be destroyed by the same thread in reverse order of creation.
           */
          AutoreleasePool();
 
          /*!
-          \brief Destructor
+          \brief Constructor
+          \param shared If true, the pool is not pushed on the pool stack of the current thread and
+          can be used by all threads. Access to the pool is synchronized then.
+          */
+         explicit AutoreleasePool(bool shared);
+
+         /*!
+          \brief Destructor. Drains the pool and pops it from the pool stack of the thread.
+          \discussion The objects are released before the pool is popped, so objects
+          autoreleased by their destructors are still collected in this pool. If the pool is not
+          the top of the stack, it is removed from the middle of the stack and a warning is
+          logged. The pools above it stay on the stack and collect the objects of the thread.
           */
          ~AutoreleasePool() override;
 
          /*!
           \brief Sends a release() to all objects accumulated in the AutoreleasePool.
+          \details The objects are released in batches of one chunk. Objects which are
+          autoreleased while draining are released too.
           */
          void drain();
 
          /*!
-          \brief Returns the pointer to the mutex object.
+          \brief Returns the current pool of the calling thread or nullptr, if the thread has no
+          pool on its stack.
           */
-         Mutex* mutex();
+         static AutoreleasePool* current();
 
       private:
 
-         //! Struct for the entries of the pool. The pool is a linked list.
-         struct PoolEntry
+         //! Number of entries in one chunk.
+         static constexpr size_t kChunkSize = 256;
+
+         //! Struct for a chunk of entries. The chunks are a double linked list.
+         struct Chunk
          {
-            Object* object;
-            PoolEntry* next;
+            Chunk* prev;
+            Chunk* next;
+            size_t count;
+            Object* objects[kChunkSize];
          };
 
-         //! First element in the pool.
-         PoolEntry* mPool;
+         //! First chunk in the pool. Always exists.
+         Chunk* mFirst;
+
+         //! Chunk where the next object is added.
+         Chunk* mTop;
 
-         //! Top pool element to realise FIFO.
-         PoolEntry* mTop;
+         //! The pool below this pool on the stack of the thread.
+         AutoreleasePool* mParent;
 
-         //! Mutex for reference counter manipulation
-         Mutex mMutex;
+         //! Status, if this pool is shared between threads.
+         bool mShared;
 
-         //! Mutex for autoreleasepool itself
+         //! Mutex for autoreleasepool itself, only used by shared pools.
          Mutex mPoolMutex;
 
+         //! Removes the pool from the pool stack of the current thread.
+         void unlink();
+
          //! Adds an object. Called in Object::autorelease().
          void add(Object* object);
 
@@ -66,6 +66,12 @@ namespace jm
 
          ByteArray(const ByteArray& other);
 
+         /*!
+          \brief Move constructor. The data of \p other is taken over, \p other is a NULL array
+          afterwards.
+          */
+         ByteArray(ByteArray&& other) noexcept;
+
          ByteArray(std::initializer_list<uint8> list);
 
          ~ByteArray() override;
@@ -141,6 +147,8 @@ namespace jm
 
          ByteArray& operator=(const ByteArray& another);
 
+         ByteArray& operator=(ByteArray&& another) noexcept;
+
          friend bool operator==(const ByteArray& a1, const ByteArray& a2);
 
       private:
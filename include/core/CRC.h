@@ -32,12 +32,21 @@
 #ifndef jm_CRC_h
 #define jm_CRC_h
 
+#include "Types.h"
+
 namespace jm
 {
    /*!
     \brief DWG files use many CRC (cyclic redundancy check) checksum algorithms to verify the
     integrity of the file. This method provides the appropriate methods to calculate and check the
     checksums.
+    \discussion Besides the CRC of DWG files, the class calculates the checksums of ZIP and zlib
+    data. All checksums can be calculated in chunks: The result of one chunk is the initial value
+    of the next chunk.
+
+    CRC-32 and CRC-32C process 16 bytes per step with 16 tables (slicing-by-16). If the processor
+    supports it at run time, CRC-32 folds 64 bytes per step with carry-less multiplication
+    (JM_PCLMUL) and CRC-32C uses the crc32 instruction of SSE 4.2 (JM_SSE42).
     \ingroup core
     */
    class DllExport CRC
@@ -51,6 +60,30 @@ namespace jm
           \param length Length to check
           */
          static uint16 crc8(uint16 initial, const uint8* buffer, size_t length);
+
+         /*!
+          \brief Calculates the CRC-32 of ZIP, gzip and PNG (polynomial 0x04C11DB7).
+          \param initial The CRC of the previous data, or 0 for the first chunk.
+          \param buffer Pointer to the first byte of the data.
+          \param length Length of the data in bytes.
+          */
+         static uint32 crc32(uint32 initial, const uint8* buffer, size_t length);
+
+         /*!
+          \brief Calculates the CRC-32C (Castagnoli, polynomial 0x1EDC6F41) of iSCSI and ext4.
+          \param initial The CRC of the previous data, or 0 for the first chunk.
+          \param buffer Pointer to the first byte of the data.
+          \param length Length of the data in bytes.
+          */
+         static uint32 crc32c(uint32 initial, const uint8* buffer, size_t length);
+
+         /*!
+          \brief Calculates the Adler-32 checksum of zlib streams (RFC 1950).
+          \param initial The checksum of the previous data, or 1 for the first chunk.
+          \param buffer Pointer to the first byte of the data.
+          \param length Length of the data in bytes.
+          */
+         static uint32 adler32(uint32 initial, const uint8* buffer, size_t length);
    };
 
 
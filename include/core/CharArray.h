@@ -46,13 +46,13 @@ namespace jm
    {
       public:
 
-         Char();
+         constexpr Char(): mChar(0) {}
 
-         /* explicit */ Char(int character);
+         /* explicit */ constexpr Char(int character): mChar(static_cast<uint16>(character)) {}
 
-         /* explicit */ Char(uint16 character);
+         /* explicit */ constexpr Char(uint16 character): mChar(character) {}
 
-         /* explicit */ Char(char character);
+         /* explicit */ constexpr Char(char character): mChar(static_cast<uint16>(character)) {}
 
          uint16 unicode() const;
 
@@ -83,6 +83,22 @@ namespace jm
          //! \brief Returns the digit value (0-9) or -1 if the character is no digit
          int32 digitValue()const;
 
+         /*!
+          \brief Converts the first \p length characters of \p buffer to lower case.
+          */
+         static void toLowerCase(Char* buffer, size_t length);
+
+         /*!
+          \brief Converts the first \p length characters of \p buffer to upper case.
+          */
+         static void toUpperCase(Char* buffer, size_t length);
+
+         /*!
+          \brief Returns true, if the first \p length characters of both buffers are equal, when
+          the case is ignored.
+          */
+         static bool equalsIgnoreCase(const Char* buffer1, const Char* buffer2, size_t length);
+
          /*!
           \brief Implementation of ==
           */
@@ -159,12 +175,19 @@ namespace jm
        */
       CharArray(const CharArray& another);
 
+      /*!
+       \brief Move constructor
+       */
+      CharArray(CharArray&& another) noexcept;
+
       /*!
        \brief Destructor
        */
       virtual ~CharArray();
 
       CharArray& operator=(const CharArray& another);
+
+      CharArray& operator=(CharArray&& another) noexcept;
    };
 
 
@@ -64,6 +64,29 @@ namespace jm
           */
          virtual CharArray decode(const char* cString) = 0;
 
+         /*!
+          \brief This method decodes exactly \p length bytes using the encoding implemented in the
+          decoder and writes the Unicode-encoded characters directly to \p target. The bytes do
+          not need to be 0-terminated. All decoders decode embedded 0 characters as U+0000, they
+          do not end the decoding.
+
+          The default implementation copies the runs between the 0 bytes into 0-terminated
+          buffers and calls decode(const char*) for each of them. Decoders should override it to
+          avoid the intermediate copies.
+          \param cString The bytes that are to be converted.
+          \param length The number of bytes.
+          \param target The target buffer. It must have space for at least maxLength(length)
+          characters.
+          \return The number of characters written to \p target.
+          */
+         virtual size_t decode(const char* cString, size_t length, Char* target);
+
+         /*!
+          \brief Returns the maximum number of characters, which \p length bytes can be decoded
+          into. The default implementation returns \p length.
+          */
+         virtual size_t maxLength(size_t length) const;
+
          /*!
           \brief This Method encodes the given string into an encoded String using the encoding implemented in the decoder.
           \param string The Unicode-encoded String be converted.
@@ -131,6 +154,11 @@ namespace jm
           */
          CharArray decode(const char* cString);
 
+         /*!
+          \brief Returns the decoder of this character set.
+          */
+         CharsetDecoder* decoder() const;
+
          /*!
           \brief This Method generates the corresponding C-string from a string using this character set.
           \param string The C-string that is to be converted.
@@ -206,6 +234,7 @@ namespace jm
       public:
          RawDecoder();
          CharArray decode(const char* cString)override;
+         size_t decode(const char* cString, size_t length, Char* target) override;
          ByteArray encode(const CharArray& string) override;
    };
 
@@ -218,7 +247,30 @@ namespace jm
       public:
          UTF8Decoder();
          CharArray decode(const char* cString)override;
+
+         /*!
+          \brief Decodes exactly \p length bytes of UTF-8 encoded text. The text does not need to
+          be 0-terminated.
+          */
+         CharArray decode(const char* cString, size_t length);
+
+         size_t decode(const char* cString, size_t length, Char* target) override;
+
          ByteArray encode(const CharArray& string) override;
+
+         /*!
+          \brief Transcodes \p length bytes of UTF-8 encoded text into UTF-16 units.
+
+          Runs of ASCII characters are converted in blocks (SSE2/AVX2, if available at compile
+          time). Malformed sequences are not rejected, every invalid byte is taken as a single
+          character. Characters beyond the BMP are written as surrogate pairs.
+          \param source The UTF-8 encoded text.
+          \param length The number of bytes in \p source.
+          \param target The target buffer. Must have space for at least \p length units.
+          \return The number of UTF-16 units written to \p target.
+          \throw Exception if the text starts with a UTF-16 byte order mark.
+          */
+         static size_t transcode(const uint8* source, size_t length, Char* target);
    };
 
 
@@ -233,6 +285,8 @@ namespace jm
       public:
          explicit UTF16Decoder(bool isBE);
          CharArray decode(const char* cString)override;
+         size_t decode(const char* cString, size_t length, Char* target) override;
+         size_t maxLength(size_t length) const override;
          ByteArray encode(const CharArray& string) override;
    };
 
@@ -249,6 +303,7 @@ namespace jm
          Windows1252Decoder();
          ~Windows1252Decoder() override;
          CharArray decode(const char* cString)override;
+         size_t decode(const char* cString, size_t length, Char* target) override;
          ByteArray encode(const CharArray& string) override;
    };
 
@@ -265,6 +320,7 @@ namespace jm
          MacRomanDecoder();
          ~MacRomanDecoder() override;
          CharArray decode(const char* cString)override;
+         size_t decode(const char* cString, size_t length, Char* target) override;
          ByteArray encode(const CharArray& string) override;
 
          Char decodeCharacter(uint8 macencode);
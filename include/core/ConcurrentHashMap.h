@@ -0,0 +1,253 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        ConcurrentHashMap.h
+// Library:     Jameo Core Library
+// Purpose:     Thread safe hash map
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_ConcurrentHashMap_h
+#define jm_ConcurrentHashMap_h
+
+#include <mutex>
+#include <shared_mutex>
+
+#include "HashMap.h"
+
+namespace jm
+{
+
+   /*!
+    \brief A hash map, which can be used by several threads at the same time.
+    \details The entries are distributed by their hash over 32 shards. Every shard is a HashMap
+    with its own reader-writer lock, so readers never block each other and writers only block the
+    threads, which access the same shard. Values are returned as copies, because a pointer into
+    the map could be invalidated by another thread at any time.
+    \tparam K The type of the keys.
+    \tparam V The type of the values. It must be copyable.
+    \tparam H The hash function for the keys.
+    \ingroup core
+    */
+   template <class K, class V, class H = std::hash<K>>
+   class ConcurrentHashMap: public Object
+   {
+      public:
+
+         /*!
+          \brief Default constructor.
+          */
+         ConcurrentHashMap(): Object()
+         {}
+
+         ConcurrentHashMap(const ConcurrentHashMap&) = delete;
+         ConcurrentHashMap& operator=(const ConcurrentHashMap&) = delete;
+
+         /*!
+          \brief Associates \p value with \p key. An existing value is replaced.
+          \return true, if the key was not in the map before.
+          */
+         bool put(const K& key, V value)
+         {
+            Shard& shard = shardOf(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.map.put(key, std::move(value));
+         }
+
+         /*!
+          \brief Copies the value associated with \p key into \p value.
+          \return true, if the key is in the map. Otherwise \p value is not changed.
+          */
+         bool get(const K& key, V& value) const
+         {
+            const Shard& shard = shardOf(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const V* actual = shard.map.get(key);
+            if(actual == nullptr)return false;
+            value = *actual;
+            return true;
+         }
+
+         /*!
+          \brief Copies the value of the entry, whose key has the hash code \p hash and fulfills
+          \p equal, into \p value. \p hash must be the value, which H returns for the key.
+          \return true, if there is such an entry. Otherwise \p value is not changed.
+          */
+         template <class Equal>
+         bool getByHash(size_t hash, Equal equal, V& value) const
+         {
+            const Shard& shard = mShards[shardIndex(hash)];
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const V* actual = shard.map.getByHash(hash, equal);
+            if(actual == nullptr)return false;
+            value = *actual;
+            return true;
+         }
+
+         /*!
+          \brief Returns a copy of the value associated with \p key, or \p defaultValue if the key
+          is not in the map.
+          */
+         V value(const K& key, const V& defaultValue) const
+         {
+            const Shard& shard = shardOf(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const V* actual = shard.map.get(key);
+            return actual != nullptr ? *actual : defaultValue;
+         }
+
+         /*!
+          \brief Returns true, if \p key is in the map.
+          */
+         bool containsKey(const K& key) const
+         {
+            const Shard& shard = shardOf(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.map.containsKey(key);
+         }
+
+         /*!
+          \brief Removes the entry with \p key.
+          \return true, if the key was in the map.
+          */
+         bool remove(const K& key)
+         {
+            Shard& shard = shardOf(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            return shard.map.remove(key);
+         }
+
+         /*!
+          \brief Returns the number of entries. If other threads modify the map at the same time,
+          the result is only a snapshot.
+          */
+         size_t size() const
+         {
+            size_t count = 0;
+            for(const Shard& shard : mShards)
+            {
+               std::shared_lock<std::shared_mutex> lock(shard.mutex);
+               count += shard.map.size();
+            }
+            return count;
+         }
+
+         /*!
+          \brief Returns true, if the map has no entries.
+          */
+         bool isEmpty() const
+         {
+            return size() == 0;
+         }
+
+         /*!
+          \brief Removes all entries.
+          */
+         void clear()
+         {
+            for(Shard& shard : mShards)
+            {
+               std::unique_lock<std::shared_mutex> lock(shard.mutex);
+               shard.map.clear();
+            }
+         }
+
+         /*!
+          \brief Prepares the map for at least \p count evenly distributed entries.
+          */
+         void reserve(size_t count)
+         {
+            // Some headroom, because the keys are not distributed perfectly.
+            const size_t perShard = count / kShardCount + count / kShardCount / 4 + 1;
+            for(Shard& shard : mShards)
+            {
+               std::unique_lock<std::shared_mutex> lock(shard.mutex);
+               shard.map.reserve(perShard);
+            }
+         }
+
+         /*!
+          \brief Calls \p function with the key and the value of every entry. Each shard is locked
+          for reading while its entries are visited, so \p function must not modify the map.
+          */
+         template <class F>
+         void forEach(F function) const
+         {
+            for(const Shard& shard : mShards)
+            {
+               std::shared_lock<std::shared_mutex> lock(shard.mutex);
+               for(const auto& entry : shard.map)function(entry.key(), entry.value());
+            }
+         }
+
+      private:
+
+         //! The number of shards is 2^kShardBits.
+         static constexpr uint32 kShardBits = 5;
+
+         //! The number of shards.
+         static constexpr size_t kShardCount = static_cast<size_t>(1) << kShardBits;
+
+         /*!
+          \brief One shard of the map. Shards are aligned to cache lines, so that threads locking
+          different shards do not share a cache line.
+          */
+         struct alignas(64) Shard
+         {
+            //! The lock of the shard.
+            mutable std::shared_mutex mutex;
+
+            //! The entries of the shard.
+            HashMap<K, V, H> map;
+         };
+
+         //! The shards.
+         Shard mShards[kShardCount];
+
+         //! Returns the index of the shard for the \p hash of a key. It uses the upper bits of a
+         //! different multiplication than HashMap, so the keys of one shard still spread over its
+         //! slots.
+         static inline size_t shardIndex(size_t hash)
+         {
+            const uint64 mixed = static_cast<uint64>(hash) * 0xC2B2AE3D27D4EB4Full;
+            return static_cast<size_t>(mixed >> (64 - kShardBits));
+         }
+
+         //! Returns the shard for \p key.
+         inline Shard& shardOf(const K& key)
+         {
+            return mShards[shardIndex(H()(key))];
+         }
+
+         //! Returns the shard for \p key.
+         inline const Shard& shardOf(const K& key) const
+         {
+            return mShards[shardIndex(H()(key))];
+         }
+   };
+
+}
+
+#endif
@@ -36,11 +36,14 @@
 #include "Types.h"
 
 #include "Array.h"
+#include "ArrayList.h"
+#include "Atom.h"
 #include "Base64.h"
 #include "ByteArray.h"
 #include "CharArray.h"
 #include "Charset.h"
 #include "Color.h"
+#include "ConcurrentHashMap.h"
 #include "CRC.h"
 #include "Date.h"
 #include "Deflater.h"
@@ -52,9 +55,12 @@
 #include "Document.h"
 #include "Exception.h"
 #include "Geometry.h"
+#include "HashMap.h"
+#include "Hashtable.h"
 #include "I18nBundle.h"
 #include "Inflater.h"
 #include "Integer.h"
+#include "MappedFile.h"
 #include "Math.h"
 #include "Matrix.h"
 #include "MemoryStream.h"
@@ -67,11 +73,14 @@
 #include "SAXParser.h"
 #include "Serializer.h"
 #include "Size.h"
+#include "SlabPool.h"
+#include "Sort.h"
 #include "String.h"
 #include "StringTokenizer.h"
 #include "System.h"
 #include "Test.h"
 #include "Thread.h"
+#include "TranslationKey.h"
 #include "URI.h"
 #include "Vector.h"
 #include "Vertex2.h"
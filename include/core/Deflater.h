@@ -32,16 +32,74 @@
 #ifndef jm_Deflater_h
 #define jm_Deflater_h
 
+#include <deque>
+#include <memory>
+#include <vector>
+
 #include "Types.h"
 #include "Object.h"
 
+// Stream state of zlib
+struct z_stream_s;
+
 namespace jm
 {
 
+   /*!
+    \brief Strategies of the Deflater, which tune the compression to the kind of data.
+    \ingroup core
+    */
+   enum class DeflateStrategy
+   {
+      //! Suitable for most data.
+      kDefault,
+
+      //! For data produced by a filter or predictor, which consists mostly of small values with a
+      //! somewhat random distribution.
+      kFiltered,
+
+      //! Only Huffman coding, no string matching.
+      kHuffmanOnly,
+
+      //! Limits the match distance to one (run-length encoding). Nearly as fast as kHuffmanOnly,
+      //! but gives better compression for PNG image data.
+      kRle,
+
+      //! Uses only the fixed Huffman codes. This allows simpler decoders.
+      kFixed
+   };
+
    /*!
     \brief Compression class for DEFLATE-compressed data.
     The basis is RFC 1950 and RFC 1951.
     As of 2017-01-14, the own implementation was exchanged in favour of zlib.
+    \discussion The Deflater works as a stream. The data can be passed in chunks with setInput(),
+    finish() marks the end of the data, and the compressed data is drained into buffers of the
+    caller with deflate(uint8*, size_t, size_t). So even very large data is compressed with
+    constant memory.
+
+    \code
+    Deflater deflater = Deflater(Deflater::kBestSpeed, DeflateStrategy::kDefault, false);
+    while(!deflater.finished())
+    {
+       if(deflater.needsInput())
+       {
+          size_t count = input->read(chunk, chunkSize);
+          if(count > 0)deflater.setInput(chunk, count);
+          else deflater.finish();
+       }
+       size_t count = deflater.deflate(output, 0, outputSize);
+       // write count bytes of output
+    }
+    \endcode
+
+    With setThreads() the Deflater compresses in parallel. The input is split into blocks of
+    kBlockSize bytes, which are compressed independently on several threads. Each block is
+    primed with the last 32 KB of the previous block as dictionary, so the compression ratio is
+    nearly the same as in the single-threaded mode. The blocks end on a byte boundary and are
+    concatenated into one valid DEFLATE stream. The threads are started with the first block and
+    kept until the Deflater is destroyed. They take the blocks from a queue, so the compression
+    continues while the caller reads the next input.
     \ingroup core
     */
    class DllExport Deflater: public Object
@@ -49,6 +107,21 @@ namespace jm
 
       public:
 
+         //! Compression level without compression. The data is stored in blocks.
+         static constexpr int32 kNoCompression = 0;
+
+         //! Fastest compression level, e.g. for temporary files.
+         static constexpr int32 kBestSpeed = 1;
+
+         //! Best compression level, e.g. for archives.
+         static constexpr int32 kBestCompression = 9;
+
+         //! Default compression level of zlib, a compromise between speed and compression.
+         static constexpr int32 kDefaultCompression = -1;
+
+         //! Size of the uncompressed blocks, which are compressed in parallel.
+         static constexpr size_t kBlockSize = 128 * 1024;
+
          /*!
           \brief Constructor
           */
@@ -60,29 +133,114 @@ namespace jm
           */
          Deflater( bool wrap );
 
+         /*!
+          \brief Constructor
+          \param level The compression level from kNoCompression (0) to kBestCompression (9),
+          or kDefaultCompression.
+          \param strategy The compression strategy.
+          \param wrap Status, whether zlib header and CRC are omitted
+          */
+         Deflater(int32 level, DeflateStrategy strategy, bool wrap);
+
          /*!
           \brief Destructor
           */
-         ~Deflater() override = default;
+         ~Deflater() override;
+
+         Deflater(const Deflater&) = delete;
+
+         Deflater& operator=(const Deflater&) = delete;
+
+         /*!
+          \brief Sets the compression level. The default is kBestCompression.
+          \discussion The level is applied to the next stream, so it must be set before the first
+          call of deflate() or after reset().
+          \param level The compression level from kNoCompression (0) to kBestCompression (9),
+          or kDefaultCompression.
+          */
+         void setLevel(int32 level);
+
+         /*!
+          \brief Sets the compression strategy. The default is DeflateStrategy::kDefault.
+          \discussion The strategy is applied to the next stream, so it must be set before the
+          first call of deflate() or after reset().
+          */
+         void setStrategy(DeflateStrategy strategy);
+
+         /*!
+          \brief Sets the number of threads for the compression. The default is 1, which
+          compresses in the calling thread. Otherwise the calling thread only collects the input
+          and returns the output.
+          \discussion With more than one thread, the input is compressed in blocks of kBlockSize
+          in parallel. The output differs from the single-threaded mode, but does not depend on
+          the number of threads. Like the level, the number of threads must be set before the
+          first call of deflate() or after reset(). If the number differs from the running
+          threads, they are replaced with the next stream.
+          \param threads The number of threads. 0 uses one thread per processor core.
+          */
+         void setThreads(size_t threads);
+
+         /*!
+          \brief Returns the number of running worker threads of the parallel mode. It is 0 before
+          the first block is compressed in parallel.
+          */
+         size_t workerCount() const;
 
          /*!
-          \brief Gives this class a block of bytes to compress.
+          \brief Gives this class the next chunk of bytes to compress.
+          \discussion The Deflater does not copy the data, the buffer must remain valid, until
+          needsInput() returns true.
           \param buffer Uncompressed data
           \param length Data length
           */
          void setInput(uint8* buffer,
                        size_t length);
 
+         /*!
+          \brief Marks the end of the input. Afterwards, deflate() writes the remaining compressed
+          data and finished() becomes true.
+          */
+         void finish();
+
+         /*!
+          \brief Returns true, if the current input chunk is consumed and the next one can be
+          passed with setInput().
+          */
+         bool needsInput() const;
+
+         /*!
+          \brief Returns true, if finish() was called and all compressed data is returned by
+          deflate().
+          */
+         bool finished() const;
+
          /*!
           \brief This method compresses the data in the buffer
           \discussion Both parameters are output values and are initialised by this method.
-          The caller must clean up the array himself afterwards.
+          The caller must clean up the array himself afterwards. The input must be passed before
+          with setInput() as a single chunk.
           \param buffer The buffer into which the data is to be written.
           \param length Buffer length
           */
          void deflate(uint8*& buffer,
                       size_t& length);
 
+         /*!
+          \brief Compresses the input into a buffer of the caller.
+          \param buffer The buffer to write the data into.
+          \param offset The index in the buffer, where the first byte is written.
+          \param length The maximum number of bytes to write.
+          \return The number of bytes written. If 0 is returned, either needsInput() or
+          finished() is true.
+          */
+         size_t deflate(uint8* buffer, size_t offset, size_t length);
+
+         /*!
+          \brief Returns the maximum size of the compressed data for \p length bytes of input
+          with the current level and strategy.
+          */
+         size_t maxOutputSize(size_t length);
+
          /*!
           \brief Resets the compressor so that a new object can be compressed
           */
@@ -102,7 +260,20 @@ namespace jm
 
          bool mWrap = false;
 
-         //Current block
+         int32 mLevel = kBestCompression;
+
+         DeflateStrategy mStrategy = DeflateStrategy::kDefault;
+
+         // Status, whether finish() was called.
+         bool mFinish = false;
+
+         // Status, whether all compressed data is written.
+         bool mFinished = false;
+
+         // The zlib stream. It is created with the first call of deflate().
+         z_stream_s* mStream = nullptr;
+
+         //Current chunk
          uint8* mUncompBytes = nullptr;
          size_t mUncompLength = 0;
          size_t mUncompIndex = 0;
@@ -111,6 +282,52 @@ namespace jm
          size_t mTotalIn = 0;
          size_t mTotalOut = 0;
 
+         // Number of threads. 1 is the single-threaded mode, 0 one thread per processor core.
+         size_t mThreads = 1;
+
+         //! A block of the parallel mode.
+         struct Block;
+
+         //! The threads of the parallel mode.
+         class WorkerPool;
+
+         // Parallel mode: The worker threads. They are kept for the next streams.
+         WorkerPool* mPool = nullptr;
+
+         // Parallel mode: The input of the next block. It starts with the last 32 KB of the
+         // previous blocks, which are the dictionary of the block.
+         std::vector<uint8> mBlocks;
+         size_t mDictionaryLength = 0;
+
+         // Parallel mode: The blocks passed to the workers in the order of the input.
+         std::deque<std::shared_ptr<Block>> mQueue;
+
+         // Parallel mode: The compressed data, which is not yet returned by deflate().
+         std::vector<uint8> mPending;
+         size_t mPendingIndex = 0;
+
+         // Parallel mode: Adler-32 checksum of the input for the zlib trailer.
+         uint32 mAdler = 1;
+
+         // Parallel mode: Status, whether the last block is passed to the workers.
+         bool mLastBlock = false;
+
+         //! Creates the zlib stream, if not done yet.
+         void initStream();
+
+         //! Releases the zlib stream.
+         void endStream();
+
+         //! Implementation of deflate(uint8*, size_t, size_t) for the parallel mode.
+         size_t deflateParallel(uint8* buffer, size_t offset, size_t length);
+
+         //! Passes the collected input as next block to the workers.
+         //! \param last Status, whether this is the last block of the stream.
+         void submitBlock(bool last);
+
+         //! Appends the output of the oldest block, which must be compressed, to the pending data.
+         void takeBlock();
+
    };
 
 }
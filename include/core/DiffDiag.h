@@ -33,8 +33,8 @@
 #ifndef jm_DiffDiag_h
 #define jm_DiffDiag_h
 
-#include <vector>
 #include "Object.h"
+#include "ArrayList.h"
 #include "DiffTypes.h"
 
 namespace jm
@@ -52,8 +52,8 @@ namespace jm
       public:
 
          DiffDiag(DiffDistance* dist,
-                  std::vector<Object*>* u,
-                  std::vector<Object*>* v,
+                  ArrayList<Object*>* u,
+                  ArrayList<Object*>* v,
                   int64 offset);
 
          ~DiffDiag();
@@ -84,12 +84,12 @@ namespace jm
          /*!
           \brief Pointer to the first vector for comparison.
           */
-         std::vector<Object*>* mU;
+         ArrayList<Object*>* mU;
 
          /*!
           \brief Pointer to the second vector for comparison.
           */
-         std::vector<Object*>* mV;
+         ArrayList<Object*>* mV;
 
          /*!
           \brief Linked List
@@ -100,7 +100,7 @@ namespace jm
          /*!
           \brief This vector stores the elements of the diagonal.
           */
-         std::vector<int64>* mElements;
+         ArrayList<int64> mElements;
 
          /*!
           \brief Pointer to DiffDistance object to determine the number of calculated values.
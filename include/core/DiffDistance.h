@@ -32,8 +32,8 @@
 #ifndef jm_DiffDistance_h
 #define jm_DiffDistance_h
 
-#include <vector>
 #include "Object.h"
+#include "ArrayList.h"
 
 namespace jm
 {
@@ -133,12 +133,12 @@ namespace jm
          /*!
           \brief Comparison vector 1
           */
-         std::vector<Object*>* u;
+         ArrayList<Object*> u;
 
          /*!
           \brief Comparison vector 2
           */
-         std::vector<Object*>* v;
+         ArrayList<Object*> v;
 
          friend class DiffDiag;
    };
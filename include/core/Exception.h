@@ -83,6 +83,13 @@ namespace jm
           */
          String GetStrackTrace() const;
 
+         /*!
+          \brief Returns the demangled, human readable name of a C++ symbol.
+          \param symbol The mangled symbol name, like it appears in a stack trace.
+          \return The demangled name, or \p symbol itself, if it is no valid mangled name.
+          */
+         static String demangle(const String& symbol);
+
       private:
 
          //! The error message.
@@ -0,0 +1,744 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        HashMap.h
+// Library:     Jameo Core Library
+// Purpose:     Typed hash map
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_HashMap_h
+#define jm_HashMap_h
+
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+
+#include "ArrayList.h"
+#include "Charset.h"
+#include "String.h"
+
+#if defined(JM_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace jm
+{
+
+   /*!
+    \brief Control bytes for hash tables with open addressing, which are shared by Hashtable and
+    HashMap. Every slot of such a table has one control byte. A full slot stores the lower 7 bits
+    of the hash of its entry, so the sign bit marks empty and deleted slots. The bytes of 16
+    consecutive slots form a group, which is compared at once.
+    */
+   struct HashGroup
+   {
+      //! Control byte of an empty slot.
+      static constexpr int8 kEmpty = -128;
+
+      //! Control byte of a slot, whose entry was removed.
+      static constexpr int8 kDeleted = -2;
+
+      //! Number of control bytes, which are compared at once.
+      static constexpr size_t kWidth = 16;
+
+      //! Returns the control byte of a full slot for \p hash.
+      static inline int8 control(uint64 hash)
+      {
+         return static_cast<int8>(hash & 0x7F);
+      }
+
+      //! Returns the slot, where the search for \p hash starts. The result is not masked.
+      static inline size_t start(uint64 hash)
+      {
+         return static_cast<size_t>(hash >> 7);
+      }
+
+      //! Returns the index of the lowest set bit. \p mask must not be 0.
+      static inline uint32 lowestBit(uint32 mask)
+      {
+         #if defined(_MSC_VER)
+         unsigned long index;
+         _BitScanForward(&index, mask);
+         return static_cast<uint32>(index);
+         #else
+         return static_cast<uint32>(__builtin_ctz(mask));
+         #endif
+      }
+
+      //! Returns the index of the highest set bit. \p mask must not be 0.
+      static inline uint32 highestBit(uint32 mask)
+      {
+         #if defined(_MSC_VER)
+         unsigned long index;
+         _BitScanReverse(&index, mask);
+         return static_cast<uint32>(index);
+         #else
+         return static_cast<uint32>(31 - __builtin_clz(mask));
+         #endif
+      }
+
+      //! Returns a bit mask of the 16 control bytes at \p group, which are equal to \p value.
+      static inline uint32 match(const int8* group, int8 value)
+      {
+         #if defined(JM_SSE2)
+         const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+         return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes,
+                                    _mm_set1_epi8(value))));
+         #else
+         uint32 mask = 0;
+         for(size_t index = 0; index < kWidth; index++)
+         {
+            if(group[index] == value)mask |= 1u << index;
+         }
+         return mask;
+         #endif
+      }
+
+      //! Returns a bit mask of the 16 control bytes at \p group, which mark free slots.
+      static inline uint32 matchFree(const int8* group)
+      {
+         #if defined(JM_SSE2)
+         const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+         return static_cast<uint32>(_mm_movemask_epi8(bytes));
+         #else
+         uint32 mask = 0;
+         for(size_t index = 0; index < kWidth; index++)
+         {
+            if(group[index] < 0)mask |= 1u << index;
+         }
+         return mask;
+         #endif
+      }
+
+      /*!
+       \brief Returns true, if the slot at \p index can become empty after its entry is removed.
+       This is the case, when no search ever passed the slot, because every group containing the
+       slot also contains an empty slot. Otherwise the slot must be marked as deleted.
+       \param control The control bytes of the table.
+       \param length The number of slots of the table.
+       \param index The index of the slot.
+       */
+      static inline bool canEmpty(const int8* control, size_t length, size_t index)
+      {
+         const size_t before = (index - kWidth) & (length - 1);
+         const uint32 emptyBefore = match(control + before, kEmpty);
+         const uint32 emptyAfter = match(control + index, kEmpty);
+         return emptyBefore != 0 && emptyAfter != 0 &&
+                lowestBit(emptyAfter) + (kWidth - 1 - highestBit(emptyBefore)) < kWidth;
+      }
+   };
+
+   /*!
+    \brief A hash map, which maps keys of type \p K to values of type \p V.
+    \details Keys and values are stored inline and in insertion order in one contiguous array, so
+    that iterating the map walks linearly through memory. A separate index with one control byte
+    (see HashGroup) and one entry index per slot is used for the lookup. Removing an entry moves the
+    last entry into its place, so the order is only kept as long as nothing is removed.
+
+    Maps with String keys can also be searched with UTF-8 text (\c const \c char* or
+    \c std::string_view) without creating a String. This requires, that \p H is
+    \c std::hash<String>, or a hash function with the member type \c is_transparent, which also
+    accepts \c std::string_view and returns the same hash as for the equal String.
+
+    \code
+    HashMap<String, int32> map;
+    map.put("width", 100);
+    int32* width = map.get("width");
+    for(const auto& entry : map) System::log(entry.key(), LogLevel::kDebug);
+    \endcode
+
+    \tparam K The type of the keys. It must be supported by \p H and comparable with ==.
+    \tparam V The type of the values.
+    \tparam H The hash function for the keys.
+    \ingroup core
+    */
+   template <class K, class V, class H = std::hash<K>>
+   class HashMap: public Object
+   {
+      public:
+
+         //! True, if the map can be searched with UTF-8 text instead of a key.
+         static constexpr bool kTextLookup = std::is_same_v<K, String> &&
+                                             (std::is_same_v<H, std::hash<String>> ||
+                                              requires { typename H::is_transparent; });
+
+         /*!
+          \brief One entry of the map.
+          */
+         class Entry
+         {
+            public:
+
+               template <class KK, class... Args>
+               Entry(uint64 hash, KK&& key, Args&& ... args):
+                  mKey(std::forward<KK>(key)),
+                  mValue(std::forward<Args>(args)...),
+                  mHash(hash)
+               {}
+
+               //! Returns the key of the entry.
+               inline const K& key() const
+               {
+                  return mKey;
+               }
+
+               //! Returns the value of the entry.
+               inline V& value()
+               {
+                  return mValue;
+               }
+
+               //! Returns the value of the entry.
+               inline const V& value() const
+               {
+                  return mValue;
+               }
+
+            private:
+
+               friend class HashMap;
+
+               //! The key of the entry.
+               K mKey;
+
+               //! The value of the entry.
+               V mValue;
+
+               //! The mixed hash of the key.
+               uint64 mHash;
+         };
+
+         /*!
+          \brief Default constructor. The index is allocated with the first entry.
+          */
+         HashMap(): Object(),
+            mEntries(),
+            mControl(nullptr),
+            mSlots(nullptr),
+            mArrLength(0),
+            mDeleted(0),
+            mThreshold(0)
+         {}
+
+         HashMap(const HashMap& other): Object(),
+            mEntries(other.mEntries),
+            mControl(nullptr),
+            mSlots(nullptr),
+            mArrLength(other.mArrLength),
+            mDeleted(other.mDeleted),
+            mThreshold(other.mThreshold)
+         {
+            if(mArrLength > 0)
+            {
+               mControl = new int8[mArrLength + HashGroup::kWidth];
+               mSlots = new uint32[mArrLength];
+               std::memcpy(mControl, other.mControl, mArrLength + HashGroup::kWidth);
+               std::memcpy(mSlots, other.mSlots, mArrLength * sizeof(uint32));
+            }
+         }
+
+         HashMap(HashMap&& other) noexcept: Object(),
+            mEntries(std::move(other.mEntries)),
+            mControl(other.mControl),
+            mSlots(other.mSlots),
+            mArrLength(other.mArrLength),
+            mDeleted(other.mDeleted),
+            mThreshold(other.mThreshold)
+         {
+            other.mEntries.clear();
+            other.mControl = nullptr;
+            other.mSlots = nullptr;
+            other.mArrLength = 0;
+            other.mDeleted = 0;
+            other.mThreshold = 0;
+         }
+
+         ~HashMap() override
+         {
+            delete[] mControl;
+            delete[] mSlots;
+         }
+
+         HashMap& operator=(const HashMap& another)
+         {
+            if(this != &another)
+            {
+               HashMap copy = HashMap(another);
+               swap(copy);
+            }
+            return *this;
+         }
+
+         HashMap& operator=(HashMap&& another) noexcept
+         {
+            if(this != &another)
+            {
+               HashMap moved = HashMap(std::move(another));
+               swap(moved);
+            }
+            return *this;
+         }
+
+         /*!
+          \brief Returns the number of entries.
+          */
+         inline size_t size() const
+         {
+            return mEntries.size();
+         }
+
+         /*!
+          \brief Returns true, if the map has no entries.
+          */
+         inline bool isEmpty() const
+         {
+            return mEntries.isEmpty();
+         }
+
+         /*!
+          \brief Prepares the map for at least \p count entries, so that inserting them does not
+          reorganize the storage.
+          */
+         void reserve(size_t count)
+         {
+            mEntries.reserve(count);
+            size_t length = HashGroup::kWidth;
+            while(length - length / 8 <= count)length *= 2;
+            if(length > mArrLength)rehash(length);
+         }
+
+         /*!
+          \brief Removes all entries. The storage is kept for reuse.
+          */
+         void clear()
+         {
+            mEntries.clear();
+            if(mControl != nullptr)
+            {
+               std::memset(mControl, HashGroup::kEmpty, mArrLength + HashGroup::kWidth);
+            }
+            mDeleted = 0;
+         }
+
+         /*!
+          \brief Associates \p value with \p key. An existing value is replaced.
+          \return true, if the key was not in the map before.
+          */
+         template <class KK>
+         bool put(KK&& key, V value)
+         {
+            const size_t before = mEntries.size();
+            V& actual = emplace(std::forward<KK>(key), std::move(value));
+            if(mEntries.size() > before)return true;
+            actual = std::move(value);
+            return false;
+         }
+
+         /*!
+          \brief Inserts a new entry, whose value is constructed from \p args in place. If the key
+          is already in the map, nothing is constructed or changed.
+          \return The value associated with \p key.
+          */
+         template <class KK, class... Args>
+         V& emplace(KK&& key, Args&& ... args)
+         {
+            if constexpr(!std::is_same_v<std::decay_t<KK>, K>)
+            {
+               return emplace(K(std::forward<KK>(key)), std::forward<Args>(args)...);
+            }
+            else
+            {
+               const uint64 hash = mix(H()(key));
+               const size_t slot = findSlot(hash, key);
+               if(slot != npos)return mEntries[mSlots[slot]].mValue;
+
+               if(mEntries.size() + mDeleted >= mThreshold)rehash();
+
+               // The entry is created first, so that an exception does not leave a broken index.
+               Entry& entry = mEntries.emplace(hash, std::forward<KK>(key), std::forward<Args>(args)...);
+               insertSlot(hash, mEntries.size() - 1);
+               return entry.mValue;
+            }
+         }
+
+         /*!
+          \brief Returns the value associated with \p key. A default constructed value is inserted,
+          if the key is not in the map.
+          */
+         V& operator[](const K& key)
+         {
+            return emplace(key);
+         }
+
+         /*!
+          \brief Returns a pointer to the value associated with \p key, or nullptr if the key is not
+          in the map. The pointer is valid until the map is modified.
+          */
+         V* get(const K& key)
+         {
+            const size_t index = find(key);
+            return index != npos ? &mEntries[index].mValue : nullptr;
+         }
+
+         //! \copydoc get(const K&)
+         const V* get(const K& key) const
+         {
+            const size_t index = find(key);
+            return index != npos ? &mEntries[index].mValue : nullptr;
+         }
+
+         /*!
+          \brief Returns a pointer to the value associated with the UTF-8 encoded \p key, or
+          nullptr if the key is not in the map. Only available for String keys.
+          */
+         V* get(std::string_view key) requires kTextLookup
+         {
+            const size_t index = find(key);
+            return index != npos ? &mEntries[index].mValue : nullptr;
+         }
+
+         //! \copydoc get(std::string_view)
+         const V* get(std::string_view key) const requires kTextLookup
+         {
+            const size_t index = find(key);
+            return index != npos ? &mEntries[index].mValue : nullptr;
+         }
+
+         //! \copydoc get(std::string_view)
+         V* get(const char* key) requires kTextLookup
+         {
+            return get(std::string_view(key));
+         }
+
+         //! \copydoc get(std::string_view)
+         const V* get(const char* key) const requires kTextLookup
+         {
+            return get(std::string_view(key));
+         }
+
+         /*!
+          \brief Returns a pointer to the value of the entry, whose key has the hash code \p hash
+          and fulfills \p equal, or nullptr if there is no such entry.
+          \details This is the lookup for keys, whose hash is already known, e.g. because it was
+          calculated at compile time. \p hash must be the value, which H returns for the key.
+          */
+         template <class Equal>
+         V* getByHash(size_t hash, Equal equal)
+         {
+            const size_t slot = findSlot(mix(static_cast<uint64>(hash)), equal);
+            return slot != npos ? &mEntries[mSlots[slot]].mValue : nullptr;
+         }
+
+         //! \copydoc getByHash(size_t, Equal)
+         template <class Equal>
+         const V* getByHash(size_t hash, Equal equal) const
+         {
+            const size_t slot = findSlot(mix(static_cast<uint64>(hash)), equal);
+            return slot != npos ? &mEntries[mSlots[slot]].mValue : nullptr;
+         }
+
+         /*!
+          \brief Returns true, if \p key is in the map.
+          */
+         bool containsKey(const K& key) const
+         {
+            return find(key) != npos;
+         }
+
+         //! \copydoc containsKey(const K&)
+         bool containsKey(std::string_view key) const requires kTextLookup
+         {
+            return find(key) != npos;
+         }
+
+         //! \copydoc containsKey(const K&)
+         bool containsKey(const char* key) const requires kTextLookup
+         {
+            return find(std::string_view(key)) != npos;
+         }
+
+         /*!
+          \brief Removes the entry with \p key. The last entry takes its place.
+          \return true, if the key was in the map.
+          */
+         bool remove(const K& key)
+         {
+            const uint64 hash = mix(H()(key));
+            const size_t slot = findSlot(hash, key);
+            if(slot == npos)return false;
+            eraseSlot(slot);
+            return true;
+         }
+
+         //! Returns a pointer to the first entry.
+         inline Entry* begin()
+         {
+            return mEntries.data();
+         }
+
+         //! Returns a pointer behind the last entry.
+         inline Entry* end()
+         {
+            return mEntries.data() + mEntries.size();
+         }
+
+         //! Returns a pointer to the first entry.
+         inline const Entry* begin() const
+         {
+            return mEntries.data();
+         }
+
+         //! Returns a pointer behind the last entry.
+         inline const Entry* end() const
+         {
+            return mEntries.data() + mEntries.size();
+         }
+
+         //! Exchanges the content of this map with \p other.
+         void swap(HashMap& other) noexcept
+         {
+            std::swap(mEntries, other.mEntries);
+            std::swap(mControl, other.mControl);
+            std::swap(mSlots, other.mSlots);
+            std::swap(mArrLength, other.mArrLength);
+            std::swap(mDeleted, other.mDeleted);
+            std::swap(mThreshold, other.mThreshold);
+         }
+
+      private:
+
+         //! Keys up to this length in bytes are transcoded on the stack for the lookup.
+         static constexpr size_t kStackKeyLength = 128;
+
+         //! The entries in insertion order.
+         ArrayList<Entry> mEntries;
+
+         //! The control bytes of the slots. The first 16 bytes are repeated at the end.
+         int8* mControl;
+
+         //! The index of the entry of each full slot.
+         uint32* mSlots;
+
+         //! The number of slots. It is 0 or a power of 2.
+         size_t mArrLength;
+
+         //! The number of slots marked as deleted.
+         size_t mDeleted;
+
+         //! The number of used and deleted slots, at which the index is reorganized.
+         size_t mThreshold;
+
+         //! Spreads the bits of \p hash, so that also weak hashes (like the identity for integers)
+         //! select the slots evenly.
+         static inline uint64 mix(uint64 hash)
+         {
+            hash *= 0x9E3779B97F4A7C15ull;
+            return hash ^ (hash >> 32);
+         }
+
+         //! Returns the index of the entry with \p key, or npos.
+         size_t find(const K& key) const
+         {
+            const size_t slot = findSlot(mix(H()(key)), key);
+            return slot != npos ? mSlots[slot] : npos;
+         }
+
+         //! Returns the index of the entry with the UTF-8 encoded \p key, or npos.
+         size_t find(std::string_view key) const requires kTextLookup
+         {
+            if(key.size() > kStackKeyLength)return find(String(key.data(), key.size()));
+
+            Char buffer[kStackKeyLength];
+            const size_t length = UTF8Decoder::transcode(reinterpret_cast<const uint8*>(key.data()),
+                                  key.size(),
+                                  buffer);
+            uint64 hash;
+            if constexpr(std::is_same_v<H, std::hash<String>>)
+            {
+               hash = mix(static_cast<uint64>(String::hashCode(buffer, length)));
+            }
+            else
+            {
+               hash = mix(static_cast<uint64>(H()(key)));
+            }
+            const size_t slot = findSlot(hash, [&buffer, length](const String & other)
+            {
+               return other.equals(buffer, length);
+            });
+            return slot != npos ? mSlots[slot] : npos;
+         }
+
+         //! Returns the slot of the entry with \p key, or npos.
+         size_t findSlot(uint64 hash, const K& key) const
+         {
+            return findSlot(hash, [&key](const K & other)
+            {
+               return other == key;
+            });
+         }
+
+         //! Returns the slot of the entry with \p hash, whose key fulfills \p equal, or npos.
+         template <class Equal>
+         size_t findSlot(uint64 hash, Equal equal) const
+         {
+            if(mArrLength == 0)return npos;
+
+            // The groups are probed quadratically. Because the number of groups is a power of 2,
+            // every group is visited and the search ends at the latest at a group with an empty
+            // slot.
+            const size_t mask = mArrLength - 1;
+            const int8 ctrl = HashGroup::control(hash);
+            size_t position = HashGroup::start(hash) & mask;
+            size_t step = 0;
+
+            while(true)
+            {
+               const int8* group = mControl + position;
+               uint32 candidates = HashGroup::match(group, ctrl);
+               while(candidates != 0)
+               {
+                  const size_t slot = (position + HashGroup::lowestBit(candidates)) & mask;
+                  const Entry& entry = mEntries[mSlots[slot]];
+                  if(entry.mHash == hash && equal(entry.mKey))return slot;
+                  candidates &= candidates - 1;
+               }
+
+               if(HashGroup::match(group, HashGroup::kEmpty) != 0)return npos;
+
+               step += HashGroup::kWidth;
+               position = (position + step) & mask;
+            }
+         }
+
+         //! Returns the slot, which refers to the entry at \p index.
+         size_t slotOf(uint64 hash, size_t index) const
+         {
+            const size_t mask = mArrLength - 1;
+            const int8 ctrl = HashGroup::control(hash);
+            size_t position = HashGroup::start(hash) & mask;
+            size_t step = 0;
+
+            while(true)
+            {
+               uint32 candidates = HashGroup::match(mControl + position, ctrl);
+               while(candidates != 0)
+               {
+                  const size_t slot = (position + HashGroup::lowestBit(candidates)) & mask;
+                  if(mSlots[slot] == index)return slot;
+                  candidates &= candidates - 1;
+               }
+
+               step += HashGroup::kWidth;
+               position = (position + step) & mask;
+            }
+         }
+
+         //! Occupies a free slot for the entry at \p index.
+         void insertSlot(uint64 hash, size_t index)
+         {
+            const size_t mask = mArrLength - 1;
+            size_t position = HashGroup::start(hash) & mask;
+            size_t step = 0;
+            uint32 free = HashGroup::matchFree(mControl + position);
+            while(free == 0)
+            {
+               step += HashGroup::kWidth;
+               position = (position + step) & mask;
+               free = HashGroup::matchFree(mControl + position);
+            }
+
+            const size_t slot = (position + HashGroup::lowestBit(free)) & mask;
+            if(mControl[slot] == HashGroup::kDeleted)mDeleted--;
+            setControl(slot, HashGroup::control(hash));
+            mSlots[slot] = static_cast<uint32>(index);
+         }
+
+         //! Removes the entry of \p slot and moves the last entry into its place.
+         void eraseSlot(size_t slot)
+         {
+            if(HashGroup::canEmpty(mControl, mArrLength, slot))
+            {
+               setControl(slot, HashGroup::kEmpty);
+            }
+            else
+            {
+               setControl(slot, HashGroup::kDeleted);
+               mDeleted++;
+            }
+
+            const size_t index = mSlots[slot];
+            const size_t last = mEntries.size() - 1;
+            if(index != last)
+            {
+               mSlots[slotOf(mEntries[last].mHash, last)] = static_cast<uint32>(index);
+               mEntries[index] = std::move(mEntries[last]);
+            }
+            mEntries.removeLast();
+         }
+
+         //! Sets the control byte of \p slot.
+         void setControl(size_t slot, int8 value)
+         {
+            mControl[slot] = value;
+            if(slot < HashGroup::kWidth)mControl[mArrLength + slot] = value;
+         }
+
+         //! Doubles the number of slots, unless removing the deleted slots is sufficient.
+         void rehash()
+         {
+            if(mArrLength == 0)rehash(HashGroup::kWidth);
+            else if(mEntries.size() * 2 < mThreshold)rehash(mArrLength);
+            else rehash(mArrLength * 2);
+         }
+
+         //! Rebuilds the index with \p length slots. The entries are not touched.
+         void rehash(size_t length)
+         {
+            delete[] mControl;
+            delete[] mSlots;
+            mControl = nullptr;
+            mSlots = nullptr;
+
+            mControl = new int8[length + HashGroup::kWidth];
+            mSlots = new uint32[length];
+            std::memset(mControl, HashGroup::kEmpty, length + HashGroup::kWidth);
+            mArrLength = length;
+            mThreshold = length - length / 8;
+            mDeleted = 0;
+
+            for(size_t index = 0; index < mEntries.size(); index++)
+            {
+               insertSlot(mEntries[index].mHash, index);
+            }
+         }
+   };
+
+}
+
+#endif
@@ -43,6 +43,12 @@ namespace jm
     \brief A hash table is an instrument used to sort data. A string serves as the access key, whose
     hash value ensures fast access. This class provides all the necessary methods to be able to work
     comfortably with a hash table.
+
+    The table uses open addressing. Hash, key and value of an entry are stored inline in one slot
+    array, and a separate array holds one control byte per slot. The control byte marks a slot as
+    empty or deleted, or it contains the lower 7 bits of the hash of the entry. A lookup compares
+    the control bytes of 16 consecutive slots at once and only verifies the few candidates, so
+    that in most cases a single cache line of control bytes and one slot are touched.
     \ingroup core
     */
    class DllExport Hashtable: public Object
@@ -51,7 +57,8 @@ namespace jm
       public:
 
          /*!
-          \brief Default constructor for the Hashtable class.
+          \brief Default constructor for the Hashtable class. The storage is allocated with the
+          first entry.
           */
          Hashtable() noexcept;
 
@@ -123,22 +130,31 @@ namespace jm
          Iterator* values() noexcept;
 
          /*!
-          \brief This method removes all elements from the Hashtable.
+          \brief This method removes all elements from the Hashtable. The storage is kept for
+          reuse.
           */
          void clear() noexcept;
 
+         /*!
+          \brief Prepares the table for at least \p count entries, so that inserting them does not
+          reorganize the storage.
+          \param count The number of entries the table should hold without rehashing.
+          */
+         void reserve(size_t count) noexcept;
+
       protected:
 
          /*!
-          \brief This method increases the capacity of the Hashtable.
+          \brief This method reorganizes the storage of the Hashtable. The capacity is doubled,
+          unless removed entries occupy so many slots, that reorganizing them is sufficient.
           */
          void rehash() noexcept;
 
       private:
 
          /*!
-          \brief This private typedef simplifies the sorting of data into the data array.
-          It is a linked list for performance reasons.
+          \brief One slot of the storage array. The hash is stored to avoid recalculation during
+          rehashing and to reject most non-matching keys without comparing them.
           */
          struct HashtableEntry
          {
@@ -151,30 +167,42 @@ namespace jm
             //! The value associated with the entry.
             void* value;
 
-            //! Pointer to the next entry in the linked list.
-            HashtableEntry* next;
             HashtableEntry() noexcept;
             ~HashtableEntry() noexcept;
          };
 
-         //! \brief This field stores the data of the Hashtable.
-         HashtableEntry** mData;
+         //! \brief This field stores the slots of the Hashtable.
+         HashtableEntry* mData;
+
+         //! \brief This field stores the control bytes of the slots. The first 16 bytes are
+         //! repeated at the end, so that 16 bytes can be read at every position.
+         int8* mControl;
 
-         //! \brief This variable stores the actual length of the storage array.
+         //! \brief This variable stores the number of slots. It is 0 or a power of 2.
          size_t mArrLength;
 
          //! \brief This variable stores the number of entries in the hashtable.
          size_t mDataLength;
 
-         //! This variable stores the load factor threshold at which the Hashtable should be rehashed.
-         //! A value of 0 means 0%, while a value of 1 means 100%.
-         double mLoadfactor;
+         //! \brief This variable stores the number of slots marked as deleted.
+         size_t mDeleted;
 
-         //! \brief This threshold defines the number of entries at which the storage array for
-         //! the data should be resized. It is the absolute number of entries at which a storage
-         //! reorganization is performed.
+         //! \brief This threshold defines the number of used and deleted slots at which the
+         //! storage should be reorganized. It is 7/8 of the number of slots.
          size_t mThreshold;
 
+         //! \brief Returns the slot index of \p key, or npos if the key is not in the table.
+         size_t find(const String& key, int64 hash) const noexcept;
+
+         //! \brief Returns the index of the first empty or deleted slot for \p hash.
+         size_t findFree(int64 hash) const noexcept;
+
+         //! \brief Sets the control byte of the slot at \p index.
+         void setControl(size_t index, int8 value) noexcept;
+
+         //! \brief Moves all entries into new storage with \p length slots.
+         void rehash(size_t length) noexcept;
+
          /*!
           \brief This subclass implements an iterator that allows iterating through the hashtable.
           */
@@ -185,7 +213,7 @@ namespace jm
                /*!
                 \brief Constructor for the HashtableIterator class.
                 \param table A pointer to the Hashtable object being iterated.
-                \patam retKey A boolean value indicating whether the iterator should return keys or values.
+                \param retKey A boolean value indicating whether the iterator should return keys or values.
                 */
                HashtableIterator(Hashtable* table, bool retKey) noexcept;
 
@@ -205,8 +233,8 @@ namespace jm
 
                //!param table A pointer to the Hashtable object being iterated.
                Hashtable* table;
-               HashtableEntry* entry;
-               HashtableEntry* last;
+
+               //! The index of the next slot to examine.
                size_t index;
          };
 
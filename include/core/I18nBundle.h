@@ -32,16 +32,33 @@
 #ifndef jm_I18nBundle_h
 #define jm_I18nBundle_h
 
+#include <atomic>
+#include <memory>
+
+#include "Atom.h"
+#include "MappedFile.h"
 #include "Preferences.h"
 #include "Resource.h"
+#include "TranslationKey.h"
 
 /*!
-\brief Quick macro for translation
-\deprecated please use jtr
+\brief Quick macro for translation. Like jtr(), the key is decoded and hashed at run time.
+\deprecated please use jtr, or TrLiteral for string literals
  */
-#define Tr(X) jm::I18nBundle::getDefault()->translate(X)
+#define Tr(X) jm::I18nBundle::getDefault()->translate(jm::translationKey(X))
 
-#define jtr(X) jm::I18nBundle::getDefault()->translate(X)
+/*!
+ \brief Translates \p X with the default bundle. \p X can be a String, a character array or a
+ pointer to UTF-8 text. The key is decoded and hashed for every call, so use TrLiteral() for
+ string literals.
+ */
+#define jtr(X) jm::I18nBundle::getDefault()->translate(jm::translationKey(X))
+
+/*!
+ \brief Translates the string literal \p X with the default bundle. The literal is decoded and
+ hashed at compile time. Other arguments do not compile, use jtr() for them.
+ */
+#define TrLiteral(X) jm::I18nBundle::getDefault()->translate(jm::literalKey("" X))
 
 namespace jm
 {
@@ -60,14 +77,56 @@ namespace jm
           */
          explicit I18nBundle(const String& language);
 
+         /*!
+          \brief Destructor. Unmaps the mapped catalogs.
+          */
+         ~I18nBundle() override;
+
          /*!
          	\brief This method reads a *.mo file and adds the content to this bundle.
          	\param stream The mo resource (file, resource etc.).
          	*/
          void appendMo(Stream* stream);
 
+         /*!
+          \brief Maps the *.mo file \p file into memory and adds it to this bundle.
+          \details Unlike appendMo(), the file is not read. Translations are looked up with the hash
+          table of the file and decoded on first use, so the start-up time does not depend on the
+          size of the catalog. Values set with setValue() or appendMo() take precedence over mapped
+          catalogs, and a catalog mapped later takes precedence over one mapped before. Mapped
+          translations are only used by translate(). Their line breaks are escaped like by
+          appendMo().
+          If the file has no hash table, it is read with appendMo().
+          \return Status::eOK, if the translations were added.
+          */
+         Status mapMo(const File& file);
+
          String translate(const String& key) const;
 
+         /*!
+          \brief Translates \p key. The hash code of an atom is already known, so this is faster
+          than creating the key as String for every call.
+          */
+         String translate(const Atom& key) const;
+
+         /*!
+          \brief Translates the string literal \p key, which was decoded and hashed at compile
+          time. If there is no translation, the interned key is returned, so that no String is
+          allocated after the first call.
+          */
+         template <size_t N>
+         String translate(const TranslationKey<N>& key) const
+         {
+            if(!key.isPrecomputed())return translate(String(key.literal()));
+            return translate(key.units(), key.size(), key.hashCode());
+         }
+
+         /*!
+          \brief Translates the \p length UTF-16 units in \p buffer with the known hash code
+          \p hash.
+          */
+         String translate(const Char* buffer, size_t length, int64 hash) const;
+
          /*!
           \brief returns the application default translation
           */
@@ -92,8 +151,26 @@ namespace jm
 
       private:
 
+         class Catalog;
+
          //! Language
          String mLanguage;
+
+         //! The mapped catalogs in the order they were added.
+         std::vector<std::unique_ptr<Catalog>> mCatalogs;
+
+         //! Protects mCatalogs.
+         mutable std::shared_mutex mCatalogMutex;
+
+         //! True, if there is at least one mapped catalog.
+         std::atomic<bool> mMapped;
+
+         //! The translations and misses of the keys, which were already looked up in the mapped
+         //! catalogs.
+         mutable ConcurrentHashMap<String, String> mMappedValues;
+
+         //! Looks up \p key in the mapped catalogs. Returns \p key, if there is no translation.
+         String translateMapped(const String& key) const;
    };
 
 }
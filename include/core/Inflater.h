@@ -32,7 +32,8 @@
 #ifndef jm_Inflater_h
 #define jm_Inflater_h
 
-#include "Array.h"
+#include "Types.h"
+#include "Object.h"
 
 namespace jm
 {
@@ -40,118 +41,173 @@ namespace jm
    /*!
     \brief Decompression class for DEFLATE-compressed data.
     Basis are RFC 1950 and RFC 1951.
+    \discussion The Inflater works as a stream. The compressed data can be passed in chunks with
+    SetInput() and the decompressed data is drained into buffers of the caller with
+    Inflate(uint8*, size_t, size_t). The decoder stops at any point, where either the input
+    or the output buffer is exhausted, and resumes with the next call. Only the last 32 KB of the
+    output are kept as sliding window, so the memory needed is independent of the size of the
+    data.
+
+    \code
+    Inflater inflater;
+    while(!inflater.Finished())
+    {
+       if(inflater.NeedsInput())
+       {
+          size_t count = file->read(chunk, chunkSize);
+          if(count == 0)throw Exception("Unexpected end of data");
+          inflater.SetInput(chunk, count);
+       }
+       size_t count = inflater.Inflate(output, 0, outputSize);
+       // process count bytes of output
+    }
+    \endcode
+
+    The Huffman codes are decoded with lookup tables. A primary table resolves all codes up to
+    kLiteralBits (kDistanceBits) bits with a single lookup, longer codes are resolved by a second
+    lookup in a subtable. The input is read through a 64 bit buffer, which is refilled a whole
+    word at a time.
     \ingroup core
     */
    class DllExport Inflater: public Object
    {
       private:
 
-         // The tree is constructed analogously to RFC 1951.
-         struct HuffmanTree
+         /*!
+          \brief Reads the compressed input LSB first through a 64 bit buffer.
+          \discussion The buffer holds \c count valid bits. When at least 8 input bytes are left, a
+          refill loads a whole word and afterwards at least 56 bits are available. This is enough
+          for a complete length/distance pair, so the decoder refills only once per symbol.
+          The bits are kept, when the input is exhausted and the next chunk is passed.
+          */
+         struct BitReader
          {
-            HuffmanTree* node0;
-            HuffmanTree* node1;
-            uint16 symbol;
-            uint16 length;
-            uint16 code;
-            uint16 tmp;
-            HuffmanTree();
-            ~HuffmanTree();
-            HuffmanTree* Find(uint16 code, uint16 bits);
+            const uint8* bytes = nullptr;
+            size_t length = 0;
+            size_t index = 0;
+            uint64 buffer = 0;
+            uint32 count = 0;
+
+            //! Fills the bit buffer from the input.
+            void refill();
+
+            //! Returns the next \p bits bits without consuming them.
+            uint32 peek(uint32 bits) const;
+
+            //! Consumes \p bits bits. Throws, if the input ends before.
+            void consume(uint32 bits);
+
+            //! Returns and consumes the next \p bits bits.
+            uint32 take(uint32 bits);
+
+            //! Refills the bit buffer and returns true, if at least \p bits bits are available.
+            bool request(uint32 bits);
          };
 
-         // Current Block
-         uint8* mCompBytes;
-         size_t mCompLength;
-         size_t mCompIndex;
+         //! The position in the stream, where the decoder resumes.
+         enum class State
+         {
+            kZlibHeader,
+            kBlockHeader,
+            kStoredHeader,
+            kStored,
+            kTableHeader,
+            kCodeLengthCodes,
+            kCodeLengths,
+            kCodes,
+            kFinished
+         };
+
+         //! Size of the sliding window.
+         static constexpr size_t kWindowSize = 32768;
+
+         //! The decoder stops, when the window holds this number of bytes. Afterwards, the window
+         //! is slid back to kWindowSize bytes.
+         static constexpr size_t kWindowLimit = 2 * kWindowSize;
 
-         // Current Block
-         uint8* mUncompBytes;
-         size_t mUncompLength;
-         size_t mUncompIndex;
+         //! Number of index bits of the primary literal/length table.
+         static constexpr uint32 kLiteralBits = 10;
+
+         //! Number of index bits of the primary distance table.
+         static constexpr uint32 kDistanceBits = 8;
+
+         //! Size of the literal/length table including all subtables.
+         static constexpr size_t kLiteralTableSize = 2560;
+
+         //! Size of the distance table including all subtables.
+         static constexpr size_t kDistanceTableSize = 640;
+
+         //! Number of index bits of the table for the code length alphabet.
+         static constexpr uint32 kCodeLengthBits = 7;
+
+         // Compressed input
+         BitReader mInput;
+
+         // Sliding window with the decompressed data. The bytes between mWindowRead and
+         // mWindowEnd are not yet passed to the caller.
+         uint8* mWindow;
+         size_t mWindowRead;
+         size_t mWindowEnd;
 
          // Counting variables for processed bytes.
          size_t mTotalIn;
          size_t mTotalOut;
 
-         int32 mBit; // Index of the current bit in the current byte.
+         State mState;
+
+         // Status indicating whether the decoder stopped, because the input ran out of bits
+         bool mNeedsInput;
 
          // Status indicating whether the last block has been read
          bool mLastBlock;
 
-         // Status indicating whether the end of the stream has been reached
-         bool mEof;
-
          // Status, indicating whether the zlib header and CRC are omitted
          bool mWrap;
 
-         // Maximum number of bits in the current Huffman tree
-         uint16 MAX_BITS;
+         // Remaining bytes of the current stored block
+         uint32 mStoredLength;
 
-         /*!
-          \brief Reads the next bit from the input stream.
-          */
-         uint8 nextBit();
+         // Header of the current dynamic Huffman block
+         uint32 mLiteralCount;
+         uint32 mDistanceCount;
+         uint32 mCodeLengthCount;
+         uint32 mCodeIndex;
+         uint8 mCodeLengths[286 + 30];
+         uint32 mCodeLengthTable[1 << kCodeLengthBits];
 
-         /*!
-          \brief Skips all bits until the end of the current byte in the input stream and jumps to the beginning of the next byte.
-          If already at the beginning of a byte, nothing happens.
-          */
-         void skipByteBits();
+         // Decoding tables of the current Huffman block
+         const uint32* mLiterals;
+         const uint32* mDistances;
 
-         /*!
-          \brief Returns the next "aligned" byte. Must be at the beginning of a byte.
-          \throws If not at the beginning of a byte, an error occurs.
-          */
-         uint8 nextAlignedUInt8();
+         // Decoding tables of the current dynamic Huffman block
+         uint32 mLiteralTable[kLiteralTableSize];
+         uint32 mDistanceTable[kDistanceTableSize];
 
-         /*!
-          \brief Reads a UINT16 in little-endian format. Must be at the beginning of a byte.
-          \throws If not at the beginning of a byte, an error occurs.
-          */
-         uint16 nextAlignedUInt16();
+         bool readZlibHeader();
 
-         /*!
-          \brief Reads the next X bits as a number. Byte boundaries are ignored.
-          The MSB (Most Significant Bit) is read first.
-          \param bits The number of bits
-          */
-         uint16 nextUIntX(uint8 bits);
+         bool readBlockHeader();
 
-         /*!
-          \brief Reads the next X bits as a number. Byte boundaries are ignored.
-          The LSB (Least Significant Bit) is read first.
-          \param bits The number of bits
-          */
-         uint16 nextUIntXR(uint8 bits);
+         bool readStoredHeader();
 
-         HuffmanTree* createTree(Array<uint16>* lengths, Array<uint16>* codes);
+         bool copyStored();
 
-         uint16 decodeHuffmanSymbol(Inflater::HuffmanTree* tree);
+         bool readTableHeader();
 
-         Array<uint16>* huffmanCodes(Array<uint16>* codelengths);
+         bool readCodeLengthCodes();
 
-         // Writes the byte to the output buffer.
-         void writeUncompressed(uint8 byte);
+         bool readCodeLengths();
 
          /*!
-          \brief This method is used for the "BTYPE=01" encoding "Fixed Huffman Codes".
-          It reads the next "Fixed Huffman Code" and decodes it to the desired numerical value.
+          \brief Decodes the symbols of a compressed block up to the end-of-block code.
           */
-         uint16 nextFixedHuffmanCode();
-
-         void handleUncompressedBlock();
-
-         void handleCompressedFixHuffman();
-
-         void handleCompressedDynamicHuffman();
-
-         void readLengthDists(Array<uint16>* target, Inflater::HuffmanTree* tree, size_t count);
+         bool decodeHuffmanBlock();
 
+         /*!
+          \brief Decompresses into the window, until it is full, the input is exhausted or the
+          stream ends. Each step returns false, if it needs more input.
+          */
          void inflate();
 
-         void checkCapacity();
-
 
       public:
          /*!
@@ -168,33 +224,52 @@ namespace jm
          /*!
           \brief Destructor
           */
-         ~Inflater() override = default;
+         ~Inflater() override;
+
+         Inflater(const Inflater&) = delete;
+
+         Inflater& operator=(const Inflater&) = delete;
 
          /*!
-          \brief Passes a block of bytes to this class for decompression.
+          \brief Passes the next chunk of compressed data to this class for decompression.
+          \discussion The Inflater does not copy the data, the buffer must remain valid, until
+          NeedsInput() returns true or the stream is finished.
           \param buffer The compressed data
           \param length The length of the data
           */
          void SetInput(uint8* buffer, size_t length);
 
          /*!
-          \brief Returns true if the end of the input block has been reached, but the end of the input stream has not been reached yet.
+          \brief Returns true if the decoder has run out of input bits, but the end of the input stream has not been reached yet.
           */
          bool NeedsInput();
 
          /*!
-          \brief Returns true if the end of the input stream has been reached.
+          \brief Returns true if the end of the input stream has been reached and all data is
+          returned by Inflate().
           */
          bool Finished();
 
          /*!
           \brief This method decompresses the data into the buffer.
           \discussion Both parameters are output values and will be initialized by this method. The caller must clean up the array afterwards.
+          The complete input must be passed before with SetInput(). If the input is truncated or
+          corrupt, an exception is thrown.
           \param buffer The buffer to write the data into.
           \param length The length of the buffer.
           */
          void Inflate(uint8*& buffer, size_t& length);
 
+         /*!
+          \brief Decompresses the data into a buffer of the caller.
+          \param buffer The buffer to write the data into.
+          \param offset The index in the buffer, where the first byte is written.
+          \param length The maximum number of bytes to write.
+          \return The number of bytes written. If 0 is returned, either NeedsInput() or Finished()
+          is true.
+          */
+         size_t Inflate(uint8* buffer, size_t offset, size_t length);
+
          /*!
           \brief Resets the decompressor, allowing a new object to be decompressed.
           */
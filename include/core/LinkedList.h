@@ -35,24 +35,127 @@
 #include "Object.h"
 #include "UndoManager.h"
 #include "Iterator.h"
+#include "SlabPool.h"
+#include "HashMap.h"
 
 namespace jm
 {
    class LinkedList;
+   class LinkedListBase;
 
-   class LListElement : public Object
+   /*!
+    \brief The links of an element in a linked list. Elements of an IntrusiveList derive from this
+    struct, so the list itself does not allocate anything.
+    \ingroup core
+    */
+   struct LinkedListHook
    {
+      //! The next element in the list or nullptr.
+      LinkedListHook* listNext = nullptr;
+
+      //! The previous element in the list or nullptr.
+      LinkedListHook* listPrev = nullptr;
+
+      //! The list, which the element is linked into, or nullptr.
+      LinkedListBase* listOwner = nullptr;
+   };
+
+   /*!
+    \brief Element of a LinkedList, which refers to the data. The elements are allocated by the
+    SlabPool of the list.
+    */
+   struct LListElement: public LinkedListHook
+   {
+      Object* data = nullptr;
+
+      //! Returns the next element in the list or nullptr.
+      LListElement* next() const
+      {
+         return static_cast<LListElement*>(listNext);
+      }
+   };
+
+   /*!
+    \brief Base class of LinkedList and IntrusiveList. It links and unlinks the elements and
+    records these changes at the UndoManager.
 
+    \details If an element is removed with an UndoManager, the UndoChangeLink takes over the
+    element until the change is deleted. Only then the element is disposed.
+    \ingroup core
+    */
+   class DllExport LinkedListBase: public Object
+   {
       public:
-         LListElement* next = nullptr;
-         LListElement* prev = nullptr;
-         Object* data = nullptr;
 
-         LListElement() = default;
-         ~LListElement() override = default;
+         LinkedListBase() noexcept;
 
-         jm::String displayName() const override;
+         /*!
+          \brief Returns the number of entries in this list.
+          */
+         size_t size() const;
+
+      protected:
+
+         //! The first element or nullptr.
+         LinkedListHook* mStart;
+
+         //! The last element or nullptr.
+         LinkedListHook* mEnd;
+
+         //! The number of elements.
+         size_t mCount;
+
+         /*!
+          \brief Links \p item into this list.
+          \param item The element to add. It must not be linked into a list.
+          \param before The element, before which \p item is added. If nullptr, \p item is
+          appended.
+          \param um The UndoManager, which records the change, or nullptr.
+          */
+         void link(LinkedListHook* item, LinkedListHook* before, UndoManager* um);
+
+         /*!
+          \brief Unlinks \p item from this list. Without UndoManager, \p item is disposed at once.
+          \param item An element of this list.
+          \param um The UndoManager, which records the change, or nullptr.
+          */
+         void unlink(LinkedListHook* item, UndoManager* um);
+
+         //! Returns true, if \p item is linked into this list.
+         bool isLinked(const LinkedListHook* item) const;
+
+         /*!
+          \brief Is called, after \p item was linked into this list, also by undo and redo.
+          The default implementation does nothing.
+          */
+         virtual void linked(LinkedListHook* item);
+
+         /*!
+          \brief Is called, after \p item was unlinked from this list, also by undo and redo.
+          The default implementation does nothing.
+          */
+         virtual void unlinked(LinkedListHook* item);
+
+         /*!
+          \brief Returns the object, which is retained by an undo change of \p item.
+          */
+         virtual Object* payload(LinkedListHook* item) const = 0;
+
+         /*!
+          \brief Is called, when \p item was removed and no undo change refers to it anymore.
+          The default implementation does nothing.
+          */
+         virtual void dispose(LinkedListHook* item);
+
+      private:
+
+         //! Links \p item before \p before without undo.
+         void insert(LinkedListHook* item, LinkedListHook* before);
+
+         //! Unlinks \p item without undo.
+         void erase(LinkedListHook* item);
 
+         friend class UndoChangeLink;
    };
 
    class DllExport LinkedListIterator : public Iterator
@@ -87,9 +190,10 @@ namespace jm
 
    /*!
     \brief This class provides a linked list including undo management.
+    \details The elements of the list are allocated by a SlabPool, which belongs to the list.
     \ingroup core
     */
-   class DllExport LinkedList: public Object
+   class DllExport LinkedList: public LinkedListBase
    {
       public:
 
@@ -147,41 +251,162 @@ namespace jm
          void swapData(Object* data1, Object* data2, UndoManager* um);
 
          /*!
-          \brief Returns the number of entries in this list.
+          \brief Returns true, if \p data is in the list.
           */
-         size_t size() const;
+         bool contains(const Object* data) const;
+
+         /*!
+          \brief Enables or disables the index from the data to the elements.
+
+          \details With the index, remove(), addBefore(), swapData() and contains() take constant
+          time instead of searching the list. The index needs memory for each element, so it pays
+          off for large lists, which are modified often. The index is kept up to date by undo and
+          redo.
+          \note With the index, an object must not be more than once in the list.
+          */
+         void setIndexed(bool indexed);
+
+         /*!
+          \brief Returns true, if the index from the data to the elements is enabled.
+          */
+         bool isIndexed() const;
 
          LinkedListIterator iterator() const;
 
          jm::String displayName() const override;
 
+      protected:
+
+         Object* payload(LinkedListHook* item) const override;
+
+         void dispose(LinkedListHook* item) override;
+
+         void linked(LinkedListHook* item) override;
+
+         void unlinked(LinkedListHook* item) override;
+
       private:
 
-         LListElement* listStart;
-         LListElement* listEnd;
-         LListElement* current;
+         //! The elements of this list.
+         SlabPool<LListElement> mElements;
 
-         size_t count;
+         //! The index from the data to the elements, if enabled.
+         HashMap<const Object*, LListElement*> mIndex;
+
+         //! True, if the index is enabled.
+         bool mIndexed;
+
+         LListElement* current;
 
          Object* mOwner;
 
          friend class LinkedListIterator;
 
+         //! Returns the first element or nullptr.
+         LListElement* firstElement() const;
+
+         //! Returns the element, which refers to \p data, or nullptr.
+         LListElement* findElement(const Object* data) const;
+
          /*!
            \brief Iterates to the next element in the list and returns the current one.
            The next element can be NULL, but then hasNext() will return false.
            */
          LListElement* nextElement();
 
-         void add(LListElement* item, UndoManager* um);
-
-         void addBefore(LListElement* addBeforeThis, LListElement* itemToAdd, UndoManager* um);
+         //! Swaps the data of \p item1 and \p item2 without undo.
+         void swapElementData(LListElement* item1, LListElement* item2);
 
-         Status remove(LListElement* element, UndoManager* um);
+         friend class UndoChangeSwapData;
 
    };
 
+   /*!
+    \brief A linked list including undo management, whose elements embed the links.
 
+    \details The element class \p T derives from Object and LinkedListHook. Compared to LinkedList,
+    adding an element does not allocate memory and removing an element takes constant time. An
+    element can only be in one IntrusiveList at a time. The list does not own the elements, but
+    an undo change retains its element as long as the change exists.
+    \ingroup core
+    */
+   template <class T>
+   class IntrusiveList: public LinkedListBase
+   {
+      public:
+
+         IntrusiveList() noexcept: LinkedListBase()
+         {}
+
+         /*!
+          \brief Destructor. The elements are unlinked, but not released.
+          \warning The same restrictions as for the destructor of LinkedList apply.
+          */
+         ~IntrusiveList() override
+         {
+            clear(nullptr);
+         }
+
+         //! Returns the first element or nullptr.
+         T* first() const
+         {
+            return static_cast<T*>(mStart);
+         }
+
+         //! Returns the last element or nullptr.
+         T* last() const
+         {
+            return static_cast<T*>(mEnd);
+         }
+
+         //! Returns the element after \p item or nullptr.
+         T* next(const T* item) const
+         {
+            return static_cast<T*>(item->listNext);
+         }
+
+         //! Returns the element before \p item or nullptr.
+         T* previous(const T* item) const
+         {
+            return static_cast<T*>(item->listPrev);
+         }
+
+         //! Appends \p item, which must not be in a list.
+         void add(T* item, UndoManager* um)
+         {
+            link(item, nullptr, um);
+         }
+
+         //! Adds \p item, which must not be in a list, before \p addBeforeThis.
+         void addBefore(T* addBeforeThis, T* item, UndoManager* um)
+         {
+            link(item, addBeforeThis, um);
+         }
+
+         /*!
+          \brief Removes \p item from the list.
+          \return eOK on success. eNotFound, if \p item is not in this list.
+          */
+         Status remove(T* item, UndoManager* um)
+         {
+            if(!isLinked(item))return Status::eNotFound;
+            unlink(item, um);
+            return Status::eOK;
+         }
+
+         //! Removes all elements.
+         void clear(UndoManager* um)
+         {
+            while(mStart != nullptr)unlink(mStart, um);
+         }
+
+      protected:
+
+         Object* payload(LinkedListHook* item) const override
+         {
+            return static_cast<T*>(item);
+         }
+   };
 
 }
 
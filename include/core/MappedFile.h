@@ -0,0 +1,112 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MappedFile.h
+// Library:     Jameo Core Library
+// Purpose:     Read-only memory mapped files
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_MappedFile_h
+#define jm_MappedFile_h
+
+#include "File.h"
+
+namespace jm
+{
+
+   /*!
+    \brief A file, which is mapped read-only into memory.
+    \details The operating system loads the pages of the file on first access and can drop them
+    again when memory is short, so mapping a large file costs neither start-up time nor resident
+    memory for the parts, which are never read. The content must not be changed by other programs
+    while it is mapped.
+    \ingroup core
+    */
+   class DllExport MappedFile: public Object
+   {
+      public:
+
+         /*!
+          \brief Creates an unmapped object.
+          */
+         MappedFile();
+
+         MappedFile(const MappedFile&) = delete;
+         MappedFile& operator=(const MappedFile&) = delete;
+
+         /*!
+          \brief Destructor. Unmaps the file.
+          */
+         ~MappedFile() override;
+
+         /*!
+          \brief Maps the content of \p file into memory. A file mapped before is unmapped.
+          \return Status::eOK on success, Status::eNotFound if the file does not exist and
+          Status::eError if the file is empty or cannot be mapped.
+          */
+         Status map(const File& file);
+
+         /*!
+          \brief Unmaps the file. data() is nullptr afterwards.
+          */
+         void unmap();
+
+         /*!
+          \brief Returns true, if a file is mapped.
+          */
+         inline bool isMapped() const
+         {
+            return mData != nullptr;
+         }
+
+         /*!
+          \brief Returns the content of the file, or nullptr if no file is mapped.
+          */
+         inline const uint8* data() const
+         {
+            return mData;
+         }
+
+         /*!
+          \brief Returns the size of the file in bytes.
+          */
+         inline size_t size() const
+         {
+            return mSize;
+         }
+
+      private:
+
+         //! The mapped content.
+         const uint8* mData;
+
+         //! The size of the content.
+         size_t mSize;
+   };
+
+}
+
+#endif
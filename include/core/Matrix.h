@@ -110,6 +110,11 @@ namespace jm
           */
          Matrix(const Matrix& other);
 
+         /*!
+          \brief Move constructor
+          */
+         Matrix(Matrix&& other) noexcept;
+
          /*!
           \brief Copy constructor
           */
@@ -358,6 +363,8 @@ namespace jm
 
          Matrix& operator=(const Matrix& A);
 
+         Matrix& operator=(Matrix&& A) noexcept;
+
          /*!
           \brief This method returns the number of rows.
           */
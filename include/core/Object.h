@@ -32,6 +32,8 @@
 #ifndef jm_Object_h
 #define jm_Object_h
 
+#include <atomic>
+
 #include "Types.h"
 #include "DiffTypes.h"
 
@@ -54,11 +56,24 @@ namespace jm
           */
          Object() noexcept;
 
+         /*!
+          \brief Copy constructor.
+          \details The reference counter is not copied. The new object starts with a reference
+          counter of 1.
+          */
+         Object(const Object& other) noexcept;
+
          /*!
           \brief Destructor.
           */
          virtual ~Object() noexcept;
 
+         /*!
+          \brief Copy assignment. The reference counter and the flag of this object are not
+          touched.
+          */
+         Object& operator=(const Object& other) noexcept;
+
          /*!
           \brief Decreases the reference counter and releases the object immediately when the
           reference counter becomes 0.
@@ -115,12 +130,15 @@ namespace jm
          /*!
           \brief Reference counter for reference counting.
 
-          \note the highest bit is a modified flag for undo management
+          \note the highest bit is a modified flag for undo management. All manipulations of the
+          counter are atomic, so no lock is needed for retain() and release().
           */
-         int32 mRefCount;
+         std::atomic<int32> mRefCount;
 
          /*!
-          \brief The auto release pool for this object.
+          \brief The auto release pool, which was current when this object was created.
+          \note Objects created before System::init() have no pool and are never deleted by
+          release().
           */
          AutoreleasePool* mPool;
 
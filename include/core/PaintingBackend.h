@@ -33,6 +33,7 @@
 #define jm_Painter_h
 
 #include "Object.h"
+#include "ArrayList.h"
 #include "Color.h"
 
 #include "Transform.h"
@@ -228,7 +229,7 @@ namespace jm
          /*!
           \brief The stack of transformation settings... necessary for inserts.
           */
-         std::vector<Matrix>* mTransformstack = nullptr;
+         ArrayList<Matrix> mTransformstack;
 
          /*!
           \brief The current line style used for drawing lines, or NULL if a solid line is being drawn.
@@ -277,7 +278,7 @@ namespace jm
          /*!
           \brief Buffer for storing the points that need to be drawn in a path.
           */
-         std::vector<BufferElement>* mBuffer = nullptr;
+         ArrayList<BufferElement> mBuffer;
 
          /*!
           \brief This method updates the transformation matrix.
@@ -32,7 +32,7 @@
 #ifndef jm_Preferences_h
 #define jm_Preferences_h
 
-#include "Hashtable.h"
+#include "ConcurrentHashMap.h"
 
 namespace jm
 {
@@ -43,9 +43,16 @@ namespace jm
     \brief The Preferences class abstracts the reading and writing of properties in a preferences file.
     The file should have the extension .properties.
 
+    The properties can be read and written by several threads at the same time.
+
+    \note Preferences derived from Hashtable in earlier versions. The values are now stored as
+    String, so put() and get() with \c void* values are replaced by setValue() and value(). The keys
+    are returned as a copy by keys() or visited by forEach(), because an iterator could refer to
+    entries, which another thread removes.
+
     \ingroup app
     */
-   class DllExport Preferences: public Hashtable
+   class DllExport Preferences: public Object
    {
       public:
 
@@ -55,7 +62,7 @@ namespace jm
          Preferences();
 
          /*!
-         \brief Destructor. Deletes all entries in the hashtable.
+         \brief Destructor.
          */
          ~Preferences() override;
 
@@ -81,28 +88,28 @@ namespace jm
          bool hasValue(const String& key)const;
 
          /*!
-          \brief Sets the property. Essentially calls the Put() method of Hashtable, but ensures that strings are used.
+          \brief Sets the property. The value is stored as string.
           \param key The property key.
           \param value The value.
           */
          void setValue(const String& key, const String& value);
 
          /*!
-          \brief Sets the property. Essentially calls the Put() method of Hashtable, but ensures that strings are used.
+          \brief Sets the property. The value is stored as string.
           \param key The property key.
           \param value The value.
           */
          void setValue(const String& key, int64 value);
 
          /*!
-          \brief Sets the property. Essentially calls the Put() method of Hashtable, but ensures that strings are used.
+          \brief Sets the property. The value is stored as string.
           \param key The property key.
           \param value The value.
           */
          void setValue(const String& key, double value);
 
          /*!
-          \brief Sets the property. Essentially calls the Put() method of Hashtable, but ensures that strings are used.
+          \brief Sets the property. The value is stored as string.
           \param key The property key.
           \param value The value.
           */
@@ -146,6 +153,65 @@ namespace jm
           \return The value of the property.
           */
          bool valueBool(const String& key, bool defaultValue) const;
+
+         /*!
+          \brief Prepares the preferences for at least \p count properties.
+          */
+         void reserve(size_t count);
+
+         /*!
+          \brief Returns the number of properties.
+          */
+         size_t size() const;
+
+         /*!
+          \brief Returns true, if there are no properties.
+          */
+         bool isEmpty() const;
+
+         /*!
+          \brief Check if the property is present. Same as hasValue().
+          \param key The key of the property to check.
+          */
+         bool containsKey(const String& key) const;
+
+         /*!
+          \brief Removes the property.
+          \param key The property key.
+          \return true, if the property was present.
+          */
+         bool remove(const String& key);
+
+         /*!
+          \brief Removes all properties.
+          */
+         void clear();
+
+         /*!
+          \brief Returns the keys of all properties in ascending order.
+          */
+         StringList keys() const;
+
+         /*!
+          \brief Calls \p function with the key and the value of every property. The values are
+          stored with escaped line breaks, like in the file. \p function must not modify the
+          preferences.
+          */
+         template <class F>
+         void forEach(F function) const
+         {
+            mValues.forEach(function);
+         }
+
+      protected:
+
+         /*!
+          \brief Returns \p value with line breaks replaced by "\\n", like the values are stored.
+          */
+         static String escapeLineBreaks(const String& value);
+
+         //! The properties.
+         ConcurrentHashMap<String, String> mValues;
    };
 
 }
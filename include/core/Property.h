@@ -36,6 +36,7 @@
 #include <cinttypes>
 
 #include "Types.h"
+#include "Atom.h"
 #include "String.h"
 #include "Integer.h"
 #include "Vertex3.h"
@@ -175,6 +176,12 @@ namespace jm
           */
          bool is(const String& id)const;
 
+         /*!
+          \brief Same as is(const String&), but only compares the atoms.
+          \param id The unique id of the property.
+          */
+         bool is(const Atom& id)const;
+
          /*!
           \brief Returns the id of the property
           */
@@ -297,7 +304,7 @@ namespace jm
          /*!
           \brief Identifier of the property.
           */
-         String mId;
+         Atom mId;
 
          /*!
           \brief Name of the group where the property will be automatically sorted at the end
@@ -37,6 +37,7 @@
 
 namespace jm
 {
+   class File;
 
    /*!
     \brief This class represents a resource, which comes with the app.
@@ -69,6 +70,12 @@ namespace jm
 
          bool exists() const;
 
+         /*!
+          \brief Returns the file of the resource, or nullptr if the resource is no plain file (like
+          on Android).
+          */
+         const jm::File* file() const;
+
          size_t size() const override;
 
          jm::Status open(jm::FileMode mode) override;
@@ -32,8 +32,7 @@
 #ifndef jm_SAXParser_h
 #define jm_SAXParser_h
 
-#include <vector>
-
+#include "Atom.h"
 #include "String.h"
 
 
@@ -41,6 +40,8 @@ namespace jm
 {
    /*!
     \brief This class represents the attributes used in the SAX parser.
+    \details The names of the attributes are stored as strings. Searching an attribute by an atom
+    compares the string of the atom with the names.
     \ingroup xml
     */
    class DllExport SAXAttributes: public Object
@@ -83,6 +84,13 @@ namespace jm
           */
          size_t indexOf(const String& qName) const;
 
+         /*!
+          \brief This method searches for the index of an attribute.
+          \param qName The qualified name of the attribute.
+          \return The index of the attribute, or -1 if not found.
+          */
+         size_t indexOf(const Atom& qName) const;
+
          /*!
           \brief This method searches for the index of an attribute.
           \param localName The local name of the attribute.
@@ -152,6 +160,14 @@ namespace jm
           */
          String value(const String& qname) const;
 
+         /*!
+          \brief Returns the value.
+          \param qname The qualified name of the attribute.
+
+          \return The value.
+          */
+         String value(const Atom& qname) const;
+
          /*!
           \brief Returns the value as an integer.
           \param qname The qualified name of the attribute.
@@ -182,6 +198,12 @@ namespace jm
           */
          bool hasValue(const String& qname) const;
 
+         /*!
+          \brief Checks if the attribute is contained
+          \param qname The qualified name of the attribute.
+          */
+         bool hasValue(const Atom& qname) const;
+
          /*!
           \brief Returns the value.
           \param uri The URI of the attribute.
@@ -191,8 +213,8 @@ namespace jm
 
       private:
 
-         std::vector<String>* mNames;
-         std::vector<String>* mValues;
+         ArrayList<String> mNames;
+         ArrayList<String> mValues;
 
    };
 
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        SlabPool.h
+// Library:     Jameo Core Library
+// Purpose:     Allocator for objects of equal size
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_SlabPool_h
+#define jm_SlabPool_h
+
+#include <new>
+#include <utility>
+
+#include "ArrayList.h"
+
+namespace jm
+{
+   /*!
+    \brief Allocator for many small objects of the type \p T.
+
+    The objects are carved out of larger memory blocks (slabs), so creating an object usually
+    takes a few instructions and needs no call to the heap. Destroyed objects are kept in a free
+    list and reused by the next create(). The memory is given back, when the pool is destroyed.
+    The first slab holds 16 objects, each further slab twice as many, up to 4096 objects.
+
+    \warning Objects, which are still alive, when the pool is destroyed, are not destructed.
+    \note The pool is not thread safe.
+    \ingroup core
+    */
+   template <class T>
+   class SlabPool
+   {
+      public:
+
+         //! Constructor for an empty pool, which has not allocated memory yet.
+         SlabPool() noexcept:
+            mFree(nullptr),
+            mNext(nullptr),
+            mEnd(nullptr),
+            mSlabSize(kFirstSlabSize),
+            mCount(0)
+         {}
+
+         SlabPool(const SlabPool&) = delete;
+
+         SlabPool& operator=(const SlabPool&) = delete;
+
+         ~SlabPool()
+         {
+            for(Slot* slab : mSlabs)delete[] slab;
+         }
+
+         /*!
+          \brief Creates a new object from \p args.
+          \return Pointer to the object. It must be destroyed by destroy() of this pool.
+          */
+         template <class... Args>
+         T* create(Args&& ... args)
+         {
+            Slot* slot = mFree;
+            if(slot != nullptr)mFree = slot->next;
+            else
+            {
+               if(mNext == mEnd)addSlab();
+               slot = mNext++;
+            }
+            mCount++;
+            return new(slot->bytes) T(std::forward<Args>(args)...);
+         }
+
+         /*!
+          \brief Destroys \p item and keeps its memory for the next create().
+          \param item An object, which was created by this pool.
+          */
+         void destroy(T* item) noexcept
+         {
+            item->~T();
+            Slot* slot = reinterpret_cast<Slot*>(item);
+            slot->next = mFree;
+            mFree = slot;
+            mCount--;
+         }
+
+         //! Returns the number of objects, which are alive.
+         size_t size() const noexcept
+         {
+            return mCount;
+         }
+
+      private:
+
+         //! Memory for one object. While the object is not alive, it links the free list.
+         union Slot
+         {
+            Slot* next;
+            alignas(T) unsigned char bytes[sizeof(T)];
+         };
+
+         //! The number of objects in the first slab.
+         static constexpr size_t kFirstSlabSize = 16;
+
+         //! The maximum number of objects in one slab.
+         static constexpr size_t kMaxSlabSize = 4096;
+
+         //! The first slot of the free list.
+         Slot* mFree;
+
+         //! The next slot in the recent slab, which was never used.
+         Slot* mNext;
+
+         //! The end of the recent slab.
+         Slot* mEnd;
+
+         //! The number of objects in the next slab.
+         size_t mSlabSize;
+
+         //! The number of objects, which are alive.
+         size_t mCount;
+
+         //! All slabs of this pool.
+         ArrayList<Slot*> mSlabs;
+
+         //! Allocates the next slab.
+         void addSlab()
+         {
+            Slot* slab = new Slot[mSlabSize];
+            mSlabs.append(slab);
+            mNext = slab;
+            mEnd = slab + mSlabSize;
+            if(mSlabSize < kMaxSlabSize)mSlabSize *= 2;
+         }
+   };
+}
+
+#endif
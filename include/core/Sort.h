@@ -0,0 +1,545 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Sort.h
+// Library:     Jameo Core Library
+// Purpose:     Sorting algorithms
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_Sort_h
+#define jm_Sort_h
+
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Types.h"
+
+namespace jm
+{
+
+   /*!
+    \brief The sorting algorithms of the containers.
+    \details sort() is a pattern-defeating quicksort (pdqsort by Orson Peters, zlib licence): a
+    quicksort with median-of-3 or ninther pivots, which sorts small ranges by insertion sort,
+    finishes already sorted ranges in linear time and falls back to heapsort, if the pivots are bad
+    too often. So it needs O(n log n) in the worst case. Elements are only moved, never copied.
+    stableSort() is a merge sort, which keeps the order of equal elements, and parallelSort()
+    sorts large ranges with several threads.
+    All algorithms take the comparison \p less, which returns true, if the first argument must be
+    placed before the second one.
+    \ingroup core
+    */
+   class Sort
+   {
+      public:
+
+         /*!
+          \brief Compares elements in ascending order. Elements derived from Comparable are
+          compared by compareTo(), all others by operator <. Pointers are compared by the
+          objects they point to, and nullptr is placed at the end.
+          */
+         template <class T>
+         struct Ascending
+         {
+            inline bool operator()(const T& a, const T& b) const
+            {
+               if constexpr(std::is_pointer_v<T>)
+               {
+                  if(b == nullptr)return a != nullptr;
+                  if(a == nullptr)return false;
+                  return Ascending<std::remove_cv_t<std::remove_pointer_t<T>>>()(*a, *b);
+               }
+               else if constexpr(std::is_base_of_v<Comparable<T>, T>)
+               {
+                  return a.compareTo(b) < 0;
+               }
+               else if constexpr(std::is_floating_point_v<T>)
+               {
+                  // NaN is placed at the end, so that the order stays strict.
+                  return a < b || (b != b && a == a);
+               }
+               else return a < b;
+            }
+         };
+
+         /*!
+          \brief Sorts the range from \p first to \p last. The order of equal elements is not
+          kept.
+          */
+         template <class Iterator, class Less>
+         static void sort(Iterator first, Iterator last, Less less)
+         {
+            const size_t size = distance(first, last);
+            if(size < 2)return;
+
+            // floor(log2(size)) bad partitions are allowed before the fallback to heapsort.
+            int32 badAllowed = 0;
+            for(size_t n = size; n > 1; n >>= 1)badAllowed++;
+            pdqSort(first, last, less, badAllowed, true);
+         }
+
+         /*!
+          \brief Sorts the range from \p first to \p last. Equal elements keep their order. A
+          buffer for half of the elements is allocated.
+          */
+         template <class Iterator, class Less>
+         static void stableSort(Iterator first, Iterator last, Less less)
+         {
+            if(distance(first, last) <= kInsertionSortThreshold)
+            {
+               insertionSort(first, last, less);
+               return;
+            }
+
+            std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+            buffer.reserve(distance(first, last) / 2 + 1);
+            mergeSort(first, last, less, buffer);
+         }
+
+         /*!
+          \brief Sorts the range from \p first to \p last with up to \p threads threads. 0 uses
+          one thread per processor. Ranges, which are too small to profit from threads, are
+          sorted by sort() in the calling thread. The order of equal elements is not kept.
+          */
+         template <class Iterator, class Less>
+         static void parallelSort(Iterator first, Iterator last, Less less, size_t threads = 0)
+         {
+            const size_t size = distance(first, last);
+            if(threads == 0)threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+            // Every thread sorts at least kParallelThreshold elements. The number of parts is a
+            // power of 2, so that they can be merged in pairs.
+            size_t parts = 1;
+            while(parts * 2 <= threads && size / (parts * 2) >= kParallelThreshold)parts *= 2;
+            if(parts == 1)
+            {
+               sort(first, last, less);
+               return;
+            }
+
+            std::vector<Iterator> bounds;
+            for(size_t part = 0; part <= parts; part++)
+            {
+               bounds.push_back(at(first, size * part / parts));
+            }
+
+            runParallel(parts, [&bounds, &less](size_t part)
+            {
+               sort(bounds[part], bounds[part + 1], less);
+            });
+
+            // Merges neighbouring parts until one part is left.
+            for(size_t step = 1; step < parts; step *= 2)
+            {
+               runParallel(parts / (step * 2), [&bounds, &less, step](size_t merge)
+               {
+                  const size_t left = merge * step * 2;
+                  std::vector<typename std::iterator_traits<Iterator>::value_type> buffer;
+                  mergeAdjacent(bounds[left], bounds[left + step], bounds[left + step * 2],
+                                less, buffer);
+               });
+            }
+         }
+
+         /*!
+          \brief Sorts the \p length bytes in \p data by counting them. Needs O(n) time.
+          */
+         static void countingSort(uint8* data, size_t length)
+         {
+            size_t counts[256] = {};
+            for(size_t index = 0; index < length; index++)counts[data[index]]++;
+
+            uint8* target = data;
+            for(size_t value = 0; value < 256; value++)
+            {
+               std::fill(target, target + counts[value], static_cast<uint8>(value));
+               target += counts[value];
+            }
+         }
+
+      private:
+
+         //! Ranges smaller than this are sorted by insertion sort.
+         static constexpr size_t kInsertionSortThreshold = 24;
+
+         //! Ranges larger than this take the pivot from the ninther instead of the median of 3.
+         static constexpr size_t kNintherThreshold = 128;
+
+         //! The number of moves, after which partialInsertionSort() gives up.
+         static constexpr size_t kPartialInsertionSortLimit = 8;
+
+         //! The minimum number of elements for each thread of parallelSort().
+         static constexpr size_t kParallelThreshold = 32768;
+
+         //! Returns the number of elements from \p first to \p last. Sizes are unsigned, so the
+         //! compiler does not need to assume, that signed differences do not overflow.
+         template <class Iterator>
+         static inline size_t distance(Iterator first, Iterator last)
+         {
+            return static_cast<size_t>(last - first);
+         }
+
+         //! Returns the iterator \p offset elements behind \p first.
+         template <class Iterator>
+         static inline Iterator at(Iterator first, size_t offset)
+         {
+            using Difference = typename std::iterator_traits<Iterator>::difference_type;
+            return first + static_cast<Difference>(offset);
+         }
+
+         //! Calls \p function(index) for index 0 to \p count - 1, each in its own thread.
+         template <class Function>
+         static void runParallel(size_t count, Function function)
+         {
+            std::vector<std::thread> threads;
+            for(size_t index = 1; index < count; index++)threads.emplace_back(function, index);
+            function(0);
+            for(std::thread& thread : threads)thread.join();
+         }
+
+         //! Sorts small ranges.
+         template <class Iterator, class Less>
+         static void insertionSort(Iterator first, Iterator last, Less less)
+         {
+            if(first == last)return;
+
+            for(Iterator current = first + 1; current != last; ++current)
+            {
+               Iterator sift = current;
+               Iterator previous = current - 1;
+               if(less(*sift, *previous))
+               {
+                  auto value = std::move(*sift);
+                  do
+                  {
+                     *sift-- = std::move(*previous);
+                  }
+                  while(sift != first && less(value, *--previous));
+                  *sift = std::move(value);
+               }
+            }
+         }
+
+         //! Sorts small ranges, which are not at the left end. The element before \p first must
+         //! not be greater than any element of the range, so it stops the search.
+         template <class Iterator, class Less>
+         static void unguardedInsertionSort(Iterator first, Iterator last, Less less)
+         {
+            if(first == last)return;
+
+            for(Iterator current = first + 1; current != last; ++current)
+            {
+               Iterator sift = current;
+               Iterator previous = current - 1;
+               if(less(*sift, *previous))
+               {
+                  auto value = std::move(*sift);
+                  do
+                  {
+                     *sift-- = std::move(*previous);
+                  }
+                  while(less(value, *--previous));
+                  *sift = std::move(value);
+               }
+            }
+         }
+
+         //! Tries to sort a nearly sorted range by insertion sort. Returns false, if more than
+         //! kPartialInsertionSortLimit elements had to be moved. The range is then unsorted.
+         template <class Iterator, class Less>
+         static bool partialInsertionSort(Iterator first, Iterator last, Less less)
+         {
+            if(first == last)return true;
+
+            size_t moves = 0;
+            for(Iterator current = first + 1; current != last; ++current)
+            {
+               Iterator sift = current;
+               Iterator previous = current - 1;
+               if(less(*sift, *previous))
+               {
+                  auto value = std::move(*sift);
+                  do
+                  {
+                     *sift-- = std::move(*previous);
+                  }
+                  while(sift != first && less(value, *--previous));
+                  *sift = std::move(value);
+                  moves += distance(sift, current);
+               }
+               if(moves > kPartialInsertionSortLimit)return false;
+            }
+            return true;
+         }
+
+         //! Sorts the elements at \p a, \p b and \p c.
+         template <class Iterator, class Less>
+         static inline void sort3(Iterator a, Iterator b, Iterator c, Less less)
+         {
+            if(less(*b, *a))std::iter_swap(a, b);
+            if(less(*c, *b))std::iter_swap(b, c);
+            if(less(*b, *a))std::iter_swap(a, b);
+         }
+
+         /*!
+          \brief Partitions the range around the pivot at \p first. Elements equal to the pivot
+          go to the right side.
+          \return The new position of the pivot and true, if the range was already partitioned.
+          */
+         template <class Iterator, class Less>
+         static std::pair<Iterator, bool> partitionRight(Iterator first, Iterator last, Less less)
+         {
+            auto pivot = std::move(*first);
+            Iterator left = first;
+            Iterator right = last;
+
+            // The median of 3 guarantees an element >= pivot on the right side.
+            while(less(*++left, pivot));
+
+            // Only if there is no element < pivot on the left side, the right side needs a
+            // bounds check.
+            if(left - 1 == first)
+            {
+               while(left < right && !less(*--right, pivot));
+            }
+            else
+            {
+               while(!less(*--right, pivot));
+            }
+
+            const bool alreadyPartitioned = left >= right;
+            while(left < right)
+            {
+               std::iter_swap(left, right);
+               while(less(*++left, pivot));
+               while(!less(*--right, pivot));
+            }
+
+            Iterator position = left - 1;
+            *first = std::move(*position);
+            *position = std::move(pivot);
+            return std::pair<Iterator, bool>(position, alreadyPartitioned);
+         }
+
+         /*!
+          \brief Partitions the range around the pivot at \p first. Elements equal to the pivot
+          go to the left side. Used for ranges with many equal elements: all elements equal to the
+          pivot of the parent partition are gathered in linear time.
+          \return The new position of the pivot.
+          */
+         template <class Iterator, class Less>
+         static Iterator partitionLeft(Iterator first, Iterator last, Less less)
+         {
+            auto pivot = std::move(*first);
+            Iterator left = first;
+            Iterator right = last;
+
+            while(less(pivot, *--right));
+            if(right + 1 == last)
+            {
+               while(left < right && !less(pivot, *++left));
+            }
+            else
+            {
+               while(!less(pivot, *++left));
+            }
+
+            while(left < right)
+            {
+               std::iter_swap(left, right);
+               while(less(pivot, *--right));
+               while(!less(pivot, *++left));
+            }
+
+            Iterator position = right;
+            *first = std::move(*position);
+            *position = std::move(pivot);
+            return position;
+         }
+
+         //! Swaps some elements of a highly unbalanced partition, to break patterns, which led to
+         //! bad pivots.
+         template <class Iterator>
+         static void breakPatterns(Iterator first, Iterator last)
+         {
+            const size_t size = distance(first, last);
+            if(size < kInsertionSortThreshold)return;
+
+            const size_t quarter = size / 4;
+            std::iter_swap(first, at(first, quarter));
+            std::iter_swap(at(first, size - 1), at(first, size - quarter));
+            if(size > kNintherThreshold)
+            {
+               std::iter_swap(at(first, 1), at(first, quarter + 1));
+               std::iter_swap(at(first, 2), at(first, quarter + 2));
+               std::iter_swap(at(first, size - 2), at(first, size - quarter - 1));
+               std::iter_swap(at(first, size - 3), at(first, size - quarter - 2));
+            }
+         }
+
+         //! The main loop of pdqsort. \p leftmost is false, if the element before \p first is a
+         //! former pivot, which is not greater than the elements of the range.
+         template <class Iterator, class Less>
+         static void pdqSort(Iterator first, Iterator last, Less less, int32 badAllowed,
+                             bool leftmost)
+         {
+            while(true)
+            {
+               const size_t size = distance(first, last);
+               if(size < kInsertionSortThreshold)
+               {
+                  if(leftmost)insertionSort(first, last, less);
+                  else unguardedInsertionSort(first, last, less);
+                  return;
+               }
+
+               // The pivot is moved to first.
+               const size_t half = size / 2;
+               if(size > kNintherThreshold)
+               {
+                  sort3(first, at(first, half), at(first, size - 1), less);
+                  sort3(at(first, 1), at(first, half - 1), at(first, size - 2), less);
+                  sort3(at(first, 2), at(first, half + 1), at(first, size - 3), less);
+                  sort3(at(first, half - 1), at(first, half), at(first, half + 1), less);
+                  std::iter_swap(first, at(first, half));
+               }
+               else sort3(at(first, half), first, at(first, size - 1), less);
+
+               // If the pivot equals the former pivot before this range, all elements equal to
+               // it are put to the left. They need no further sorting.
+               if(!leftmost && !less(*(first - 1), *first))
+               {
+                  first = partitionLeft(first, last, less) + 1;
+                  continue;
+               }
+
+               const std::pair<Iterator, bool> result = partitionRight(first, last, less);
+               const Iterator pivot = result.first;
+               const size_t leftSize = distance(first, pivot);
+               const size_t rightSize = size - leftSize - 1;
+
+               if(leftSize < size / 8 || rightSize < size / 8)
+               {
+                  if(--badAllowed == 0)
+                  {
+                     heapSort(first, last, less);
+                     return;
+                  }
+                  breakPatterns(first, pivot);
+                  breakPatterns(pivot + 1, last);
+               }
+               else if(result.second && partialInsertionSort(first, pivot, less) &&
+                       partialInsertionSort(pivot + 1, last, less))
+               {
+                  // The range was (nearly) sorted already.
+                  return;
+               }
+
+               // Recursion for the left part, iteration for the right part.
+               pdqSort(first, pivot, less, badAllowed, leftmost);
+               first = pivot + 1;
+               leftmost = false;
+            }
+         }
+
+         //! Moves the element at \p root down the heap of \p size elements at \p first.
+         template <class Iterator, class Less>
+         static void siftDown(Iterator first, size_t root, size_t size, Less less)
+         {
+            auto value = std::move(*at(first, root));
+            for(size_t child = 2 * root + 1; child < size; child = 2 * root + 1)
+            {
+               if(child + 1 < size && less(*at(first, child), *at(first, child + 1)))child++;
+               if(!less(value, *at(first, child)))break;
+               *at(first, root) = std::move(*at(first, child));
+               root = child;
+            }
+            *at(first, root) = std::move(value);
+         }
+
+         //! Sorts the range by heapsort. The fallback of pdqSort() for bad pivots.
+         template <class Iterator, class Less>
+         static void heapSort(Iterator first, Iterator last, Less less)
+         {
+            const size_t size = distance(first, last);
+            if(size < 2)return;
+
+            for(size_t index = size / 2; index > 0; index--)siftDown(first, index - 1, size, less);
+            for(size_t end = size - 1; end > 0; end--)
+            {
+               std::iter_swap(first, at(first, end));
+               siftDown(first, 0, end, less);
+            }
+         }
+
+         //! Merges the sorted ranges from \p first to \p middle and from \p middle to \p last.
+         //! The left range is moved to \p buffer, so that equal elements of it stay in front.
+         template <class Iterator, class Less, class Buffer>
+         static void mergeAdjacent(Iterator first, Iterator middle, Iterator last, Less less,
+                                   Buffer& buffer)
+         {
+            if(first == middle || middle == last || !less(*middle, *(middle - 1)))return;
+
+            buffer.clear();
+            buffer.insert(buffer.end(), std::make_move_iterator(first),
+                          std::make_move_iterator(middle));
+
+            auto left = buffer.begin();
+            Iterator right = middle;
+            Iterator target = first;
+            while(left != buffer.end() && right != last)
+            {
+               if(less(*right, *left))*target++ = std::move(*right++);
+               else *target++ = std::move(*left++);
+            }
+            std::move(left, buffer.end(), target);
+         }
+
+         //! Sorts the range stable with \p buffer for the merges.
+         template <class Iterator, class Less, class Buffer>
+         static void mergeSort(Iterator first, Iterator last, Less less, Buffer& buffer)
+         {
+            const size_t size = distance(first, last);
+            if(size <= kInsertionSortThreshold)
+            {
+               insertionSort(first, last, less);
+               return;
+            }
+
+            const Iterator middle = at(first, size / 2);
+            mergeSort(first, middle, less, buffer);
+            mergeSort(middle, last, less, buffer);
+            mergeAdjacent(first, middle, last, less, buffer);
+         }
+   };
+
+}
+
+#endif
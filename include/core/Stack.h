@@ -134,7 +134,7 @@ namespace jm
             }
 
             // Handle the case when there are not enough elements on the stack
-            throw jm::Exception(Tr("Not enough elements on the stack"));
+            throw jm::Exception(TrLiteral("Not enough elements on the stack"));
          };
 
          /*!
@@ -149,7 +149,7 @@ namespace jm
             }
 
             // Handle the case when there are not enough elements on the stack
-            throw jm::Exception(Tr("Not enough elements on the stack"));
+            throw jm::Exception(TrLiteral("Not enough elements on the stack"));
          };
 
          /*!
@@ -39,6 +39,7 @@
 #endif
 
 #include "Object.h"
+#include "ArrayList.h"
 #include "ByteArray.h"
 #include "CharArray.h"
 
@@ -51,6 +52,7 @@
 namespace jm
 {
    class Charset;
+   class CharsetDecoder;
    class ByteArray;
    class StringList;
 
@@ -136,6 +138,12 @@ namespace jm
           */
          String(const String& another) noexcept;
 
+         /*!
+          \brief Move constructor. The content of \p another is taken over without copying.
+          \p another is empty afterwards.
+          */
+         String(String&& another) noexcept;
+
          /*!
           \brief Destructor
           */
@@ -255,6 +263,14 @@ namespace jm
           */
          bool equalsIgnoreCase(const String& another) const;
 
+         /*!
+          \brief This method checks if this string consists of the given UTF-16 units.
+          \param buffer The UTF-16 units to compare with.
+          \param length The number of units in \p buffer.
+          \return Returns true if both contain the same units, otherwise false.
+          */
+         bool equals(const Char* buffer, size_t length) const;
+
          /*!
           \brief This method checks if the beginning of this string matches another string.
           \param another The string to be checked.
@@ -291,31 +307,50 @@ namespace jm
 
          /*!
           \brief This method calculates the hash code for this string and returns it.
-          \details The hash code is calculated based on the content of the string.
+          \details The hash code is calculated based on the content of the string (64 bit, wyhash).
+          It is calculated only once and cached until the string is modified. This is also safe,
+          if several threads ask for the hash code of the same string.
           \return The hash code for this string.
           */
-         int64 hashCode();
+         int64 hashCode() const;
 
          /*!
-         \brief This method calculates the hash code for this string and returns it.
-         \details The hash code is calculated based on the content of the string.
-         \return The hash code for this string.
+         \brief Same as hashCode().
          */
          int64 constHashCode() const;
 
+         /*!
+          \brief Calculates the hash code of a string with the given UTF-16 units, without
+          creating the string.
+          \param buffer The UTF-16 units of the string.
+          \param length The number of units in \p buffer.
+          \return The same value, which hashCode() returns for such a string.
+          */
+         static int64 hashCode(const Char* buffer, size_t length);
+
          /*!
           \brief This method returns a string in which all uppercase letters have been replaced with lowercase letters.
           \details The method creates a new string with all uppercase letters replaced by their lowercase counterparts.
           \return A new string with all uppercase letters replaced by lowercase letters.
           */
-         String toLowerCase() const;
+         String toLowerCase() const&;
+
+         /*!
+          \brief Same as toLowerCase(), but converts a temporary string in place.
+          */
+         String toLowerCase() &&;
 
          /*!
           \brief This method returns a string in which all lowercase letters have been replaced with uppercase letters.
           \details The method creates a new string with all lowercase letters replaced by their uppercase counterparts.
           \return A new string with all lowercase letters replaced by uppercase letters.
           */
-         String toUpperCase() const;
+         String toUpperCase() const&;
+
+         /*!
+          \brief Same as toUpperCase(), but converts a temporary string in place.
+          */
+         String toUpperCase() &&;
 
          /*!
           \brief This method creates a substring that consists of a portion of this string.
@@ -338,7 +373,12 @@ namespace jm
           \details The method creates a new string by removing all non-visible text characters (whitespaces) from the beginning and end of the original string.
           \return A new string with all non-visible text characters (whitespaces) removed from the beginning and end.
           */
-         String trim() const;
+         String trim() const&;
+
+         /*!
+          \brief Same as trim(), but trims a temporary string in place.
+          */
+         String trim() &&;
 
          /*!
           \brief This method replaces characters in the string. The "old" character is replaced with the "new" character at all positions.
@@ -347,7 +387,13 @@ namespace jm
           \return The string with the replacements.
           \details This method replaces occurrences of the "old" character with the "new" character in the string.
           */
-         String replace(Char oldChar, Char newChar) const;
+         String replace(Char oldChar, Char newChar) const&;
+
+         /*!
+          \brief Same as replace(Char, Char), but replaces the characters of a temporary string in
+          place.
+          */
+         String replace(Char oldChar, Char newChar) &&;
 
          /*!
           \brief This method replaces substrings in the string. The "oldStr" substring is replaced with the "newStr" substring at all positions.
@@ -410,6 +456,15 @@ namespace jm
           */
          size_t indexOf(const String& str, size_t fromIndex) const;
 
+         /*!
+          \brief This method returns the zero-based position of the first character in the
+          string, which is one of the given \p characters.
+          \param characters The characters to search for.
+          \param fromIndex The position to start searching from.
+          \return Returns the zero-based index, or npos if none of the characters is found.
+          */
+         size_t indexOfAny(const String& characters, size_t fromIndex) const;
+
          /*!
           \brief This method returns the zero-based position of the last occurrence of the desired character in the string.
           \details This method can also be understood as searching from the end of the string for the first occurrence of the character.
@@ -581,6 +636,7 @@ namespace jm
 
          // Operators
          String& operator=(const String& another);
+         String& operator=(String&& another) noexcept;
          String& operator+=(const String& another);
 
          // Friends
@@ -626,6 +682,9 @@ namespace jm
          DllExport
          friend String operator+(const String& left, const String& right);
 
+         DllExport
+         friend String operator+(String&& left, const String& right);
+
          DllExport
          friend String operator+(const char*& left, const String& right);
 
@@ -715,9 +774,28 @@ namespace jm
 
       private:
 
-         //! This char array stores the content of the string. The length of the string can be
-         //! bigger than the string itself. In principle, the characters are unicode encoded.
-         //! Valid values are in the range of 0x0000 - 0xFFFF.
+         //! Number of characters, which are stored inside the object without heap allocation.
+         static constexpr size_t kInlineLength = 16;
+
+         /*!
+          \brief Header of an array on the heap. The characters follow directly after the header.
+          Copies of a string share the array. It is immutable as long as more than one string
+          references it. Before a string modifies a shared array, it makes an own copy (copy on
+          write).
+          */
+         struct SharedArray
+         {
+            //! Number of strings referencing the array.
+            std::atomic<int32> references;
+
+            //! Padding, so that the characters are aligned to 8 bytes.
+            int32 reserved;
+         };
+
+         //! Pointer to the content of the string. It points either to \c mInline or to the
+         //! characters of a SharedArray on the heap. The length of the array can be bigger than
+         //! the string itself. In principle, the characters are unicode encoded. Valid values are
+         //! in the range of 0x0000 - 0xFFFF.
          Char* mValue;
 
          //! Length of array.
@@ -726,8 +804,53 @@ namespace jm
          //! Length of string.
          size_t mStrLength;
 
-         //! Stored hashvalue for operation. Is 0 if not initialized.
-         int32 mHash;
+         //! Stored hashvalue for operation. Is 0 if not initialized. It is mutable, since the
+         //! hash is calculated on demand, also for const strings.
+         mutable std::atomic<uint64> mHash;
+
+         //! Inline storage for short strings (small string optimization).
+         Char mInline[kInlineLength];
+
+         /*!
+          \brief Returns true, if the content is stored in \c mInline.
+          */
+         bool isInline() const;
+
+         /*!
+          \brief Prepares the (empty) storage of this string for at least \p length characters.
+          Only if the inline storage is too small, an array is allocated.
+          \param length The number of characters.
+          */
+         void allocate(size_t length);
+
+         /*!
+          \brief Releases the array on the heap, if any. The array is freed, if no other string
+          references it. The string uses the inline storage afterwards.
+          */
+         void deallocate();
+
+         /*!
+          \brief Returns the header of the array on the heap.
+          \note Must only be called, if the string does not use the inline storage.
+          */
+         SharedArray* sharedArray() const;
+
+         /*!
+          \brief Drops one reference of \p array. The array is freed, if it was the last one.
+          */
+         static void release(SharedArray* array);
+
+         /*!
+          \brief Takes over the content of \p another. \p another is empty afterwards.
+          \note The own storage must be empty (deallocated) before.
+          */
+         void take(String& another) noexcept;
+
+         /*!
+          \brief Makes sure, that the array on the heap is referenced only by this string. Must be
+          called before the content is modified.
+          */
+         void detach();
 
          /*!
           \brief This method copies the content of CharArrays into this string.
@@ -735,6 +858,12 @@ namespace jm
           */
          void copy(const CharArray& array);
 
+         /*!
+          \brief Decodes \p size bytes with \p decoder directly into the storage of this string.
+          \note The own storage must be empty (deallocated) before.
+          */
+         void decode(const char* buffer, size_t size, CharsetDecoder* decoder);
+
          //! Helper method for arg.
          bool argIndicies(size_t& first, size_t& second) const;
 
@@ -784,6 +913,8 @@ namespace jm
 
          StringList(const StringList& other);
 
+         StringList(StringList&& other) noexcept;
+
          explicit StringList(const jm::String& string);
 
          ~StringList() override;
@@ -800,8 +931,21 @@ namespace jm
 
          size_t size() const;
 
+         /*!
+          \brief Sorts the list in ascending order.
+          */
          void sort();
 
+         /*!
+          \brief Sorts the list in ascending order. Equal strings keep their order.
+          */
+         void stableSort();
+
+         /*!
+          \brief Sorts the list in ascending order with several threads.
+          */
+         void parallelSort();
+
          jm::String join(Char divider) const;
 
          const String& get(size_t index) const;
@@ -812,6 +956,8 @@ namespace jm
 
          StringList& operator=(const StringList& another);
 
+         StringList& operator=(StringList&& another) noexcept;
+
          void clear();
 
          bool contains(const String& str) const;
@@ -827,16 +973,8 @@ namespace jm
 
       private:
 
-         //! The length of the array.
-         size_t mLength;
-
-         //! The data size (can be less then length
-         size_t mSize;
-
-         //! The data array itself.
-         String* mData;
-
-         void checkSize(size_t size);
+         //! The strings.
+         ArrayList<String> mData;
    };
 }
 
@@ -850,7 +988,7 @@ namespace std
     {
         std::size_t operator()(const jm::String& s) const noexcept
         {
-            return static_cast<std::size_t>(s.constHashCode());
+            return static_cast<std::size_t>(s.hashCode());
         }
     };
 }
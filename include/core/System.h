@@ -55,6 +55,14 @@ namespace jm
       kError
    };
 
+   //! Instruction set extensions of the processor, which the library uses, if available.
+   enum class CpuFeature
+   {
+      kSSE42,
+      kPCLMUL,
+      kAVX2
+   };
+
    /*!
    \brief Basic system information.
    \ingroup app
@@ -157,10 +165,18 @@ namespace jm
          static void* findSymbol(void* library, const String& name);
 
          /*!
-          \brief This method returns the path to the autoreleased objects pool.
+          \brief This method returns the autorelease pool of the current thread. If the thread has
+          no pool on its stack, the shared pool is returned.
           */
          static AutoreleasePool* autoreleasePool();
 
+         /*!
+          \brief Returns true, if the processor and the operating system support \p feature.
+          \discussion The result is determined once. On processors other than x86-64 the result
+          is always false.
+          */
+         static bool hasCpuFeature(CpuFeature feature);
+
    };
 
    //
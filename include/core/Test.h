@@ -32,8 +32,6 @@
 #ifndef jm_Test_h
 #define jm_Test_h
 
-#include <vector>
-
 #include "String.h"
 
 
@@ -366,7 +364,7 @@ namespace jm
          String mArg;
 
          //! \brief  The tests to be done.
-         std::vector<Test*>* mTests;
+         ArrayList<Test*> mTests;
 
          //! \brief  Helper method for single test run.
          //! \param test Test to run.
@@ -0,0 +1,348 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        TranslationKey.h
+// Library:     Jameo Core Library
+// Purpose:     Translation keys hashed at compile time
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef jm_TranslationKey_h
+#define jm_TranslationKey_h
+
+#include <bit>
+#include <utility>
+
+#include "String.h"
+
+namespace jm
+{
+
+   /*!
+    \brief Calculates String::hashCode() at compile time. It is the same wyhash over the bytes of
+    the UTF-16 units as in String.cpp, only written without memcpy and 128 bit integers, so that
+    the compiler can evaluate it.
+    \ingroup core
+    */
+   class ConstHash
+   {
+      public:
+
+         /*!
+          \brief Returns the same value as String::hashCode(buffer, length) for the UTF-16 units
+          in \p units.
+          */
+         static constexpr int64 hashCode(const uint16* units, size_t length)
+         {
+            uint64 hash = hashBytes(units, sizeof(uint16) * length);
+            if(hash == 0)hash = 1; // 0 marks a hash, which is not calculated yet.
+            return static_cast<int64>(hash);
+         }
+
+      private:
+
+         static constexpr uint64 kSecret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                                               0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+                                              };
+
+         //! Returns the byte at \p index of the units, as it is stored in memory.
+         static constexpr uint64 byteAt(const uint16* units, size_t index)
+         {
+            const uint16 unit = units[index >> 1];
+            const bool high = ((index & 1) != 0) == (std::endian::native == std::endian::little);
+            return high ? static_cast<uint64>(unit >> 8) : static_cast<uint64>(unit & 0xFF);
+         }
+
+         //! Reads \p count bytes from \p index like memcpy into an integer would do.
+         static constexpr uint64 read(const uint16* units, size_t index, size_t count)
+         {
+            uint64 value = 0;
+            for(size_t a = 0; a < count; a++)
+            {
+               const size_t shift = std::endian::native == std::endian::little ? a : count - 1 - a;
+               value |= byteAt(units, index + a) << (8 * shift);
+            }
+            return value;
+         }
+
+         //! Multiplies \p a and \p b to 128 bits. \p a gets the low, \p b the high 64 bits.
+         static constexpr void multiply(uint64& a, uint64& b)
+         {
+            const uint64 ha = a >> 32, hb = b >> 32;
+            const uint64 la = static_cast<uint32>(a), lb = static_cast<uint32>(b);
+            const uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+            const uint64 t = rl + (rm0 << 32);
+            uint64 c = t < rl;
+            const uint64 lo = t + (rm1 << 32);
+            c += lo < t;
+            a = lo;
+            b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+         }
+
+         static constexpr uint64 mix(uint64 a, uint64 b)
+         {
+            multiply(a, b);
+            return a ^ b;
+         }
+
+         static constexpr uint64 hashBytes(const uint16* units, size_t length)
+         {
+            uint64 seed = mix(kSecret[0], kSecret[1]);
+            uint64 a = 0;
+            uint64 b = 0;
+
+            if(length <= 16)
+            {
+               if(length >= 4)
+               {
+                  const size_t shift = (length >> 3) << 2;
+                  a = (read(units, 0, 4) << 32) | read(units, shift, 4);
+                  b = (read(units, length - 4, 4) << 32) | read(units, length - 4 - shift, 4);
+               }
+               else if(length > 0)
+               {
+                  a = (byteAt(units, 0) << 16) | (byteAt(units, length >> 1) << 8) |
+                      byteAt(units, length - 1);
+               }
+            }
+            else
+            {
+               size_t index = 0;
+               size_t remaining = length;
+               if(remaining > 48)
+               {
+                  uint64 seed1 = seed;
+                  uint64 seed2 = seed;
+                  do
+                  {
+                     seed = mix(read(units, index, 8) ^ kSecret[1],
+                                read(units, index + 8, 8) ^ seed);
+                     seed1 = mix(read(units, index + 16, 8) ^ kSecret[2],
+                                 read(units, index + 24, 8) ^ seed1);
+                     seed2 = mix(read(units, index + 32, 8) ^ kSecret[3],
+                                 read(units, index + 40, 8) ^ seed2);
+                     index += 48;
+                     remaining -= 48;
+                  }
+                  while(remaining > 48);
+                  seed ^= seed1 ^ seed2;
+               }
+               while(remaining > 16)
+               {
+                  seed = mix(read(units, index, 8) ^ kSecret[1], read(units, index + 8, 8) ^ seed);
+                  index += 16;
+                  remaining -= 16;
+               }
+               a = read(units, index + remaining - 16, 8);
+               b = read(units, index + remaining - 8, 8);
+            }
+
+            a ^= kSecret[1];
+            b ^= seed;
+            multiply(a, b);
+            return mix(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+         }
+   };
+
+   /*!
+    \brief A translation key from a string literal. The literal is decoded to UTF-16 and hashed by
+    the compiler, so a translation with TrLiteral("...") neither decodes, allocates nor hashes at
+    run time.
+    \details Literals, which are not valid UTF-8 or start with a byte order mark, are not
+    precomputed. They are translated like a String, so that they give the same result as before.
+    \ingroup core
+    */
+   template <size_t N>
+   class TranslationKey
+   {
+      public:
+
+         /*!
+          \brief Decodes and hashes \p key. Only possible at compile time.
+          */
+         consteval TranslationKey(const char (&key)[N]):
+            mKey(key),
+            mUnits(),
+            mLength(0),
+            mHash(0),
+            mValid(true)
+         {
+            uint16 units[N] = {};
+            size_t index = 0;
+
+            // Like String(const char*), the key ends at the first 0.
+            while(index < N && key[index] != 0 && mValid)
+            {
+               const uint32 c = static_cast<uint8>(key[index]);
+               uint32 code = 0;
+               size_t count = 0;
+
+               if(c < 0x80)
+               {
+                  code = c;
+                  count = 1;
+               }
+               else if(c >= 0xC2 && c < 0xE0)
+               {
+                  code = c & 0x1F;
+                  count = 2;
+               }
+               else if((c & 0xF0) == 0xE0)
+               {
+                  code = c & 0x0F;
+                  count = 3;
+               }
+               else if(c >= 0xF0 && c < 0xF5)
+               {
+                  code = c & 0x07;
+                  count = 4;
+               }
+               else mValid = false;
+
+               for(size_t a = 1; a < count && mValid; a++)
+               {
+                  const uint32 next = index + a < N ? static_cast<uint8>(key[index + a]) : 0;
+                  if((next & 0xC0) != 0x80)mValid = false;
+                  code = (code << 6) | (next & 0x3F);
+               }
+
+               if(!mValid)break;
+               if((count == 3 && code < 0x800) ||
+                     (count == 4 && (code < 0x10000 || code > 0x10FFFF)))
+               {
+                  // Overlong or out of range. The decoder at run time handles it.
+                  mValid = false;
+               }
+               else if(code == 0xFEFF && index == 0)
+               {
+                  // The decoder at run time skips a leading byte order mark.
+                  mValid = false;
+               }
+               else if(code >= 0x10000)
+               {
+                  code -= 0x10000;
+                  units[mLength++] = static_cast<uint16>(0xD800 | (code >> 10));
+                  units[mLength++] = static_cast<uint16>(0xDC00 | (code & 0x3FF));
+               }
+               else units[mLength++] = static_cast<uint16>(code);
+
+               index += count;
+            }
+
+            if(mValid)
+            {
+               mHash = ConstHash::hashCode(units, mLength);
+               for(size_t a = 0; a < mLength; a++)mUnits[a] = Char(units[a]);
+            }
+            else mLength = 0;
+         }
+
+         /*!
+          \brief Returns false, if the literal could not be decoded at compile time. Then only
+          literal() is valid.
+          */
+         constexpr bool isPrecomputed() const
+         {
+            return mValid;
+         }
+
+         //! Returns the literal.
+         constexpr const char* literal() const
+         {
+            return mKey;
+         }
+
+         //! Returns the UTF-16 units of the key.
+         constexpr const Char* units() const
+         {
+            return mUnits;
+         }
+
+         //! Returns the number of UTF-16 units.
+         constexpr size_t size() const
+         {
+            return mLength;
+         }
+
+         //! Returns the hash code, which is equal to String::hashCode() of the same key.
+         constexpr int64 hashCode() const
+         {
+            return mHash;
+         }
+
+      private:
+
+         //! The literal.
+         const char* mKey;
+
+         //! The decoded key.
+         Char mUnits[N];
+
+         //! The number of units in mUnits.
+         size_t mLength;
+
+         //! The hash code of mUnits.
+         int64 mHash;
+
+         //! True, if mUnits and mHash are valid.
+         bool mValid;
+   };
+
+   /*!
+    \brief Returns the precomputed key for the string literal \p key. Only possible at compile
+    time, so it is used by TrLiteral(), which only accepts string literals.
+    */
+   template <size_t N>
+   consteval TranslationKey<N> literalKey(const char (&key)[N])
+   {
+      return TranslationKey<N>(key);
+   }
+
+   /*!
+    \brief Returns the text of the character array \p key as String, which is hashed at run time.
+    Used by Tr() and jtr(). Like a string literal, the text ends at the first 0, but the array
+    does not need to contain one.
+    */
+   template <size_t N>
+   inline String translationKey(const char (&key)[N])
+   {
+      size_t length = 0;
+      while(length < N && key[length] != 0)length++;
+      return String(key, length);
+   }
+
+   /*!
+    \brief Returns \p key unchanged. Used by Tr() and jtr() for everything, which is not a
+    character array.
+    */
+   template <class T>
+   constexpr T&& translationKey(T&& key)
+   {
+      return std::forward<T>(key);
+   }
+
+}
+
+#endif
@@ -55,6 +55,28 @@
    #endif
 #endif
 
+//! Flags for the SIMD instruction sets, which are available at compile time.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+   #define JM_SSE2
+#endif
+
+//! Flags for the SIMD instruction sets, which are compiled without compiler options. Functions
+//! using them are marked with JM_TARGET and only called, if System::hasCpuFeature() reports the
+//! instruction set at run time.
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(_M_ARM64EC)
+   #define JM_X64
+   #define JM_AVX2
+   #define JM_SSE42
+   #define JM_PCLMUL
+#endif
+
+//! Compiles a function for the instruction sets \p X, e.g. "sse4.2". MSVC needs no attribute.
+#if defined(__GNUC__) || defined(__clang__)
+   #define JM_TARGET(X) __attribute__((target(X)))
+#else
+   #define JM_TARGET(X)
+#endif
+
 //! ASCII Constants for different operations
 #define kTxtClearScreen "\033[2J\033[H" // CLEAR SCREEN AND CURSOR TO HOME
 
@@ -40,7 +40,10 @@
 
 namespace jm
 {
-
+   class LinkedListBase;
+   class LinkedList;
+   struct LinkedListHook;
+   struct LListElement;
 
    /*!
     \brief This element of a linked list stores the changes made to the file in an Undo Step.
@@ -663,6 +666,70 @@ namespace jm
          Object* mObject;
    };
 
+   /*!
+    \brief This class encapsulates the step when an element is linked into or unlinked from a
+    LinkedList or an IntrusiveList.
+
+    \details While the element is unlinked, this change owns it. If the change is deleted in this
+    state, the list disposes the element. The payload of the element is retained as long as the
+    change exists.
+
+    \ingroup undo
+    */
+   class DllExport UndoChangeLink: public UndoChange
+   {
+      public:
+
+         /*!
+          \brief Constructor, which is called after the element was linked or unlinked.
+          \param list The list of the element.
+          \param item The element.
+          \param before The element, which follows \p item, while \p item is linked.
+          \param linked True, if \p item is linked now.
+          */
+         UndoChangeLink(LinkedListBase* list, LinkedListHook* item, LinkedListHook* before,
+                        bool linked);
+
+         ~UndoChangeLink() override;
+
+         /*!
+          \copydoc UndoChange::swap()
+          */
+         void swap() override;
+
+      private:
+
+         LinkedListBase* mList;
+         LinkedListHook* mItem;
+         LinkedListHook* mBefore;
+         Object* mPayload;
+         bool mLinked;
+   };
+
+   /*!
+    \brief This class encapsulates the step when the data of two elements of a LinkedList is
+    swapped. Undo and redo swap the data again.
+
+    \ingroup undo
+    */
+   class DllExport UndoChangeSwapData: public UndoChange
+   {
+      public:
+
+         UndoChangeSwapData(LinkedList* list, LListElement* item1, LListElement* item2);
+
+         /*!
+          \copydoc UndoChange::swap()
+          */
+         void swap() override;
+
+      private:
+
+         LinkedList* mList;
+         LListElement* mItem1;
+         LListElement* mItem2;
+   };
+
    /*!
     \brief This object stores an editing step made to the file.
     The undo list is a doubly linked list.
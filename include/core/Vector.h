@@ -63,6 +63,11 @@ namespace jm
        */
       Vector(const Vector& another);
 
+      /*!
+       \brief Move constructor
+       */
+      Vector(Vector&& another) noexcept;
+
       /*!
        \brief Constructor creates an n-dimensional vector.
        \param rows Number of rows (dimensions) in the vector.
@@ -110,6 +115,8 @@ namespace jm
 
       Vector& operator=(const Vector& another);
 
+      Vector& operator=(Vector&& another) noexcept;
+
       DllExport
       friend std::ostream& operator<< (std::ostream& out, const Vector& str);
 
@@ -119,19 +126,19 @@ namespace jm
     \brief Implementation of the operator +
     */
    DllExport
-   const Vector operator+(const Vector& v1, const Vector& v2);
+   Vector operator+(const Vector& v1, const Vector& v2);
 
    /*!
     \brief Implementation of the operator -
     */
    DllExport
-   const Vector operator-(const Vector& v1, const Vector& v2);
+   Vector operator-(const Vector& v1, const Vector& v2);
 
    /*!
     \brief Implementation of the operator *
     */
    DllExport
-   const Vector operator*(const double& d, const Vector& v);
+   Vector operator*(const double& d, const Vector& v);
 
 }
 
@@ -0,0 +1,164 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        Atom.cpp
+// Library:     Jameo Core Library
+// Purpose:     Interned strings
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PrecompiledCore.hpp"
+
+#include <shared_mutex>
+
+using namespace jm;
+
+namespace
+{
+   /*!
+    \brief The table of all atoms. Lookups of existing atoms only take the shared lock, so they do
+    not block each other.
+    */
+   class AtomTable
+   {
+      public:
+
+         AtomTable():
+            mMutex(),
+            mAtoms(),
+            mEmpty(intern(String()))
+         {}
+
+         //! Returns the interned string for \p string.
+         const String* intern(const String& string)
+         {
+            {
+               std::shared_lock<std::shared_mutex> lock(mMutex);
+               const String* const* atom = mAtoms.get(string);
+               if(atom != nullptr)return *atom;
+            }
+            return create(string);
+         }
+
+         //! Returns the interned string for the UTF-8 encoded \p string.
+         const String* intern(std::string_view string)
+         {
+            {
+               std::shared_lock<std::shared_mutex> lock(mMutex);
+               const String* const* atom = mAtoms.get(string);
+               if(atom != nullptr)return *atom;
+            }
+            return create(String(string.data(), string.size()));
+         }
+
+         //! Returns the interned string for the \p length units in \p buffer with the hash code
+         //! \p hash.
+         const String* intern(const Char* buffer, size_t length, int64 hash)
+         {
+            {
+               std::shared_lock<std::shared_mutex> lock(mMutex);
+               const String* const* atom = mAtoms.getByHash(static_cast<size_t>(hash),
+                                           [buffer, length](const String & other)
+               {
+                  return other.equals(buffer, length);
+               });
+               if(atom != nullptr)return *atom;
+            }
+            return create(String(reinterpret_cast<const uint16*>(buffer), length));
+         }
+
+         //! Returns the interned empty string.
+         inline const String* empty() const
+         {
+            return mEmpty;
+         }
+
+         //! Returns the number of atoms.
+         size_t count()
+         {
+            std::shared_lock<std::shared_mutex> lock(mMutex);
+            return mAtoms.size();
+         }
+
+      private:
+
+         //! Protects mAtoms.
+         std::shared_mutex mMutex;
+
+         //! Maps the content to the interned strings.
+         HashMap<String, const String*> mAtoms;
+
+         //! The interned empty string.
+         const String* mEmpty;
+
+         //! Interns \p string, unless another thread was faster.
+         const String* create(const String& string)
+         {
+            std::unique_lock<std::shared_mutex> lock(mMutex);
+            const String*& atom = mAtoms.emplace(string, nullptr);
+            if(atom == nullptr)
+            {
+               // The interned strings are never freed, so that atoms stay valid until the end of
+               // the program, also in destructors of static objects.
+               String* interned = new String(string);
+               interned->hashCode();
+               atom = interned;
+            }
+            return atom;
+         }
+   };
+
+   //! Returns the table. It is created on first use and never destroyed, like the atoms.
+   AtomTable& table()
+   {
+      static AtomTable* atoms = new AtomTable();
+      return *atoms;
+   }
+}
+
+Atom::Atom() noexcept:
+   mString(table().empty())
+{}
+
+Atom::Atom(const String& string):
+   mString(table().intern(string))
+{}
+
+Atom::Atom(const char* string):
+   mString(table().intern(std::string_view(string)))
+{}
+
+Atom::Atom(std::string_view string):
+   mString(table().intern(string))
+{}
+
+Atom::Atom(const Char* buffer, size_t length, int64 hash):
+   mString(table().intern(buffer, length, hash))
+{}
+
+size_t Atom::count()
+{
+   return table().count();
+}
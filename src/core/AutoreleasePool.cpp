@@ -33,15 +33,28 @@
 
 using namespace jm;
 
+//! Top of the pool stack of the current thread.
+thread_local AutoreleasePool* gCurrentPool = nullptr;
 
-AutoreleasePool::AutoreleasePool(): Object()
+AutoreleasePool::AutoreleasePool(): AutoreleasePool(false)
 {
-   //1st Entry is a dummy to avoid if-queries with AddObject
-   mPool = new PoolEntry();
-   mPool->object = nullptr;
-   mPool->next = nullptr;
+}
+
+AutoreleasePool::AutoreleasePool(bool shared): Object()
+{
+   mFirst = new Chunk();
+   mFirst->prev = nullptr;
+   mFirst->next = nullptr;
+   mFirst->count = 0;
+   mTop = mFirst;
 
-   mTop = mPool;
+   mShared = shared;
+   mParent = nullptr;
+   if(!mShared)
+   {
+      mParent = gCurrentPool;
+      gCurrentPool = this;
+   }
 }
 
 AutoreleasePool::~AutoreleasePool()
@@ -49,42 +62,89 @@ AutoreleasePool::~AutoreleasePool()
    // Cleanup autorelease
    drain();
 
-   // Delete dummy
-   delete mPool;
+   if(!mShared)unlink();
+
+   Chunk* chunk = mFirst;
+   while(chunk != nullptr)
+   {
+      Chunk* next = chunk->next;
+      delete chunk;
+      chunk = next;
+   }
+}
+
+void AutoreleasePool::unlink()
+{
+   if(gCurrentPool == this)
+   {
+      gCurrentPool = mParent;
+      return;
+   }
+
+   // Not destroyed in reverse order of creation: The pool is removed from the middle of the
+   // stack, so that the pools above it do not refer to a destroyed pool.
+   AutoreleasePool* pool = gCurrentPool;
+   while(pool != nullptr && pool->mParent != this)pool = pool->mParent;
+
+   if(pool != nullptr)
+   {
+      pool->mParent = mParent;
+      System::log("AutoreleasePool is not destroyed in reverse order of creation.",
+                  LogLevel::kWarning);
+   }
+   else System::log("AutoreleasePool is destroyed by another thread.", LogLevel::kWarning);
 }
 
 void AutoreleasePool::drain()
 {
-   mPoolMutex.lock();
-   PoolEntry* pool = mPool->next;
+   // Release the objects chunk by chunk from the top. The batch is copied, so that the lock is
+   // not held during release() and objects autoreleased by destructors can be added meanwhile.
+   Object* batch[kChunkSize];
 
-   while(pool != nullptr)
+   while(true)
    {
-      //Release objects
-      pool->object->release();
+      if(mShared)mPoolMutex.lock();
 
-      PoolEntry* next = pool->next;
-      delete pool;
-      pool = next;
-   }
+      while(mTop->count == 0 && mTop->prev != nullptr)mTop = mTop->prev;
+
+      size_t count = mTop->count;
+      std::memcpy(batch, mTop->objects, count * sizeof(Object*));
+      mTop->count = 0;
+
+      if(mShared)mPoolMutex.unlock();
 
-   mTop = mPool;
-   mPool->next = nullptr;
-   mPoolMutex.unlock();
+      if(count == 0)break;
+
+      for(size_t index = 0; index < count; index++)
+      {
+         //Release objects
+         batch[index]->release();
+      }
+   }
 }
 
 void AutoreleasePool::add(Object* object)
 {
-   mPoolMutex.lock();
-   PoolEntry* entry = new PoolEntry();
-   entry->object = object;
-   entry->next = nullptr;
-   mTop->next = entry;
-   mTop = entry;
-   mPoolMutex.unlock();
+   if(mShared)mPoolMutex.lock();
+
+   if(mTop->count == kChunkSize)
+   {
+      if(mTop->next == nullptr)
+      {
+         Chunk* chunk = new Chunk();
+         chunk->prev = mTop;
+         chunk->next = nullptr;
+         chunk->count = 0;
+         mTop->next = chunk;
+      }
+      mTop = mTop->next;
+   }
+   mTop->objects[mTop->count++] = object;
+
+   if(mShared)mPoolMutex.unlock();
 }
 
-Mutex* AutoreleasePool::mutex()
+AutoreleasePool* AutoreleasePool::current()
 {
-   return &mMutex;
+   return gCurrentPool;
 }
@@ -98,6 +98,16 @@ ByteArray::ByteArray(const ByteArray& other) : Object()
    }
 }
 
+ByteArray::ByteArray(ByteArray&& other) noexcept : Object()
+{
+   mArrSize = other.mArrSize;
+   mRawSize = other.mRawSize;
+   mData = other.mData;
+   other.mArrSize = 0;
+   other.mRawSize = 0;
+   other.mData = nullptr;
+}
+
 ByteArray::ByteArray(std::initializer_list<uint8> list) : Object()
 {
    mArrSize = list.size();
@@ -147,30 +157,7 @@ const char* ByteArray::constData() const
 
 void ByteArray::sort()
 {
-   if(mArrSize < 1)return;
-
-   size_t n = mArrSize;
-   do
-   {
-      size_t newn = 1;
-      for(size_t i = 0; i < n - 1; ++i)
-      {
-         const size_t j = i + 1;
-         const uint8 a1 = mData[i];
-         const uint8 a2 = mData[j];
-         if(a1 > a2)
-         {
-            //Vertausche
-            const uint8 tmp = mData[i];
-            mData[i] = mData[j];
-            mData[j] = tmp;
-
-            newn = i + 1;
-         }
-      }
-      n = newn;
-   }
-   while(n > 1);
+   Sort::countingSort(mData, mArrSize);
 }
 
 void ByteArray::fill(uint8 ch)
@@ -293,6 +280,23 @@ ByteArray& jm::ByteArray::operator=(const ByteArray& another)
    return *this;
 }
 
+ByteArray& jm::ByteArray::operator=(ByteArray&& another) noexcept
+{
+   if(this != &another)
+   {
+      delete[] mData;
+
+      mArrSize = another.mArrSize;
+      mRawSize = another.mRawSize;
+      mData = another.mData;
+      another.mArrSize = 0;
+      another.mRawSize = 0;
+      another.mData = nullptr;
+   }
+
+   return *this;
+}
+
 namespace jm
 {
    bool operator==(const ByteArray& a1, const ByteArray& a2)
@@ -32,6 +32,14 @@
 
 #include "PrecompiledCore.hpp"
 
+#if defined(JM_SSE42)
+#include <nmmintrin.h>
+#endif
+#if defined(JM_PCLMUL)
+#include <smmintrin.h>
+#include <wmmintrin.h>
+#endif
+
 using namespace jm;
 
 uint16 crctable[256] =
@@ -72,3 +80,241 @@ uint16 CRC::crc8(uint16 initial, const uint8* buffer, size_t length)
 
    return initial;
 }
+
+//
+// CRC-32 and CRC-32C
+//
+
+//! The tables of slicing-by-16 for the reflected polynomial. Table 0 is the common byte table,
+//! table k continues the CRC of table k - 1 by a zero byte.
+struct SlicingTables
+{
+   uint32 table[16][256];
+
+   constexpr explicit SlicingTables(uint32 polynomial): table()
+   {
+      for(uint32 index = 0; index < 256; index++)
+      {
+         uint32 crc = index;
+         for(uint32 bit = 0; bit < 8; bit++)crc = (crc >> 1) ^ ((crc & 1) != 0 ? polynomial : 0);
+         table[0][index] = crc;
+      }
+
+      for(uint32 index = 0; index < 256; index++)
+      {
+         for(uint32 slice = 1; slice < 16; slice++)
+         {
+            const uint32 crc = table[slice - 1][index];
+            table[slice][index] = (crc >> 8) ^ table[0][crc & 0xFF];
+         }
+      }
+   }
+};
+
+static constexpr SlicingTables kCrc32Tables = SlicingTables(0xEDB88320);
+static constexpr SlicingTables kCrc32cTables = SlicingTables(0x82F63B78);
+
+//! Continues the inverted \p crc with slicing-by-16. It needs twice the tables of slicing-by-8,
+//! but has half the dependent steps and is about 1.5 times faster.
+static uint32 sliceBy16(const SlicingTables& tables,
+                        uint32 crc,
+                        const uint8* buffer,
+                        size_t length)
+{
+   const uint32 (&t)[16][256] = tables.table;
+
+   if constexpr(std::endian::native == std::endian::little)
+   {
+      while(length >= 16)
+      {
+         uint64 word;
+         uint64 next;
+         memcpy(&word, buffer, 8);
+         memcpy(&next, buffer + 8, 8);
+         word ^= crc;
+         crc = t[15][word & 0xFF] ^ t[14][(word >> 8) & 0xFF] ^ t[13][(word >> 16) & 0xFF] ^
+               t[12][(word >> 24) & 0xFF] ^ t[11][(word >> 32) & 0xFF] ^
+               t[10][(word >> 40) & 0xFF] ^ t[9][(word >> 48) & 0xFF] ^ t[8][word >> 56] ^
+               t[7][next & 0xFF] ^ t[6][(next >> 8) & 0xFF] ^ t[5][(next >> 16) & 0xFF] ^
+               t[4][(next >> 24) & 0xFF] ^ t[3][(next >> 32) & 0xFF] ^
+               t[2][(next >> 40) & 0xFF] ^ t[1][(next >> 48) & 0xFF] ^ t[0][next >> 56];
+         buffer += 16;
+         length -= 16;
+      }
+   }
+
+   while(length-- > 0)crc = t[0][(crc ^ *buffer++) & 0xFF] ^ (crc >> 8);
+   return crc;
+}
+
+#if defined(JM_PCLMUL)
+
+//! Folds the lane \p x of 16 bytes onto \p next.
+JM_TARGET("pclmul,sse4.1") static inline __m128i foldLane(__m128i x, __m128i next, __m128i k)
+{
+   const __m128i low = _mm_clmulepi64_si128(x, k, 0x00);
+   return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), next), low);
+}
+
+//! Continues the inverted \p crc of CRC-32 by folding the data with carry-less multiplication.
+//! The algorithm is described in "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+//! Instruction" by Intel. \p length must be a multiple of 16 and at least 64.
+JM_TARGET("pclmul,sse4.1") static uint32 foldCrc32(uint32 crc, const uint8* buffer, size_t length)
+{
+   // x^(4*128+32), x^(4*128-32), x^(128+32), x^(128-32), x^64 mod P and the Barrett constants,
+   // all bit reflected.
+   const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+   const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+   const __m128i k5 = _mm_set_epi64x(0, 0x0163CD6124);
+   const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+   const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+
+   const __m128i* data = reinterpret_cast<const __m128i*>(buffer);
+   __m128i x1 = _mm_xor_si128(_mm_loadu_si128(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+   __m128i x2 = _mm_loadu_si128(data + 1);
+   __m128i x3 = _mm_loadu_si128(data + 2);
+   __m128i x4 = _mm_loadu_si128(data + 3);
+   data += 4;
+   length -= 64;
+
+   // Folds 4 lanes of 16 bytes in parallel.
+   while(length >= 64)
+   {
+      const __m128i y1 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+      const __m128i y2 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+      const __m128i y3 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+      const __m128i y4 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+      x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k1k2, 0x11), y1);
+      x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, k1k2, 0x11), y2);
+      x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, k1k2, 0x11), y3);
+      x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, k1k2, 0x11), y4);
+      x1 = _mm_xor_si128(x1, _mm_loadu_si128(data));
+      x2 = _mm_xor_si128(x2, _mm_loadu_si128(data + 1));
+      x3 = _mm_xor_si128(x3, _mm_loadu_si128(data + 2));
+      x4 = _mm_xor_si128(x4, _mm_loadu_si128(data + 3));
+      data += 4;
+      length -= 64;
+   }
+
+   // Folds the lanes and the remaining blocks of 16 bytes into one lane.
+   x1 = foldLane(foldLane(foldLane(x1, x2, k3k4), x3, k3k4), x4, k3k4);
+   for(; length >= 16; length -= 16)x1 = foldLane(x1, _mm_loadu_si128(data++), k3k4);
+
+   // Reduces 128 bit to 64 bit.
+   x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+   x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+   x2 = _mm_srli_si128(x1, 4);
+   x1 = _mm_and_si128(x1, mask);
+   x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, k5, 0x00), x2);
+
+   // Barrett reduction to 32 bit
+   x2 = _mm_and_si128(x1, mask);
+   x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+   x2 = _mm_and_si128(x2, mask);
+   x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+   x1 = _mm_xor_si128(x1, x2);
+
+   return static_cast<uint32>(_mm_extract_epi32(x1, 1));
+}
+
+#endif
+
+#if defined(JM_SSE42)
+
+//! Continues the inverted \p crc of CRC-32C with the crc32 instruction for all whole words.
+//! \p buffer and \p length are advanced to the remaining bytes.
+JM_TARGET("sse4.2") static uint32 crc32cWords(uint32 crc, const uint8*& buffer, size_t& length)
+{
+   uint64 crc64 = crc;
+   for(; length >= 8; length -= 8)
+   {
+      uint64 word;
+      memcpy(&word, buffer, 8);
+      crc64 = _mm_crc32_u64(crc64, word);
+      buffer += 8;
+   }
+   return static_cast<uint32>(crc64);
+}
+
+#endif
+
+uint32 CRC::crc32(uint32 initial, const uint8* buffer, size_t length)
+{
+   uint32 crc = ~initial;
+
+#if defined(JM_PCLMUL)
+   static const bool pclmul = System::hasCpuFeature(CpuFeature::kPCLMUL);
+   if(pclmul && length >= 64)
+   {
+      const size_t folded = length & ~static_cast<size_t>(15);
+      crc = foldCrc32(crc, buffer, folded);
+      buffer += folded;
+      length -= folded;
+   }
+#endif
+
+   return ~sliceBy16(kCrc32Tables, crc, buffer, length);
+}
+
+uint32 CRC::crc32c(uint32 initial, const uint8* buffer, size_t length)
+{
+   uint32 crc = ~initial;
+
+#if defined(JM_SSE42)
+   static const bool sse42 = System::hasCpuFeature(CpuFeature::kSSE42);
+   if(sse42)crc = crc32cWords(crc, buffer, length);
+#endif
+
+   return ~sliceBy16(kCrc32cTables, crc, buffer, length);
+}
+
+//
+// Adler-32
+//
+
+uint32 CRC::adler32(uint32 initial, const uint8* buffer, size_t length)
+{
+   // The largest number of bytes, for which the sums do not overflow 32 bit before the modulo.
+   const size_t kMaxRun = 5552;
+   const uint32 kBase = 65521;
+
+   uint32 a = initial & 0xFFFF;
+   uint32 b = initial >> 16;
+
+   while(length > 0)
+   {
+      size_t run = std::min(length, kMaxRun);
+      length -= run;
+
+      for(; run >= 8; run -= 8)
+      {
+         a += buffer[0];
+         b += a;
+         a += buffer[1];
+         b += a;
+         a += buffer[2];
+         b += a;
+         a += buffer[3];
+         b += a;
+         a += buffer[4];
+         b += a;
+         a += buffer[5];
+         b += a;
+         a += buffer[6];
+         b += a;
+         a += buffer[7];
+         b += a;
+         buffer += 8;
+      }
+      for(; run > 0; run--)
+      {
+         a += *buffer++;
+         b += a;
+      }
+
+      a %= kBase;
+      b %= kBase;
+   }
+
+   return (b << 16) | a;
+}
@@ -55,6 +55,14 @@ CharArray::CharArray(const CharArray& another):
    memcpy(buffer, another.buffer, length * 2);
 }
 
+CharArray::CharArray(CharArray&& another) noexcept:
+   length(another.length),
+   buffer(another.buffer)
+{
+   another.length = 0;
+   another.buffer = nullptr;
+}
+
 CharArray::CharArray(size_t alength):
    length(alength)
 {
@@ -83,6 +91,18 @@ namespace jm
 
       return *this;
    }
+
+   CharArray& CharArray::operator=(CharArray&& another) noexcept
+   {
+      if(this == &another) return *this;
+      if(buffer != nullptr)delete[] buffer;
+      length = another.length;
+      buffer = another.buffer;
+      another.length = 0;
+      another.buffer = nullptr;
+
+      return *this;
+   }
 }
 
 Charset::Charset(CharsetDecoder* decoder): Object()
@@ -150,6 +170,11 @@ CharArray Charset::decode(const char* cString)
    return mDecoder->decode(cString);
 }
 
+CharsetDecoder* Charset::decoder() const
+{
+   return mDecoder;
+}
+
 ByteArray Charset::encode(const CharArray& string)
 {
    return mDecoder->encode(string);
@@ -39,6 +39,48 @@ CharsetDecoder::CharsetDecoder(): Object()
 
 }
 
+size_t CharsetDecoder::decode(const char* cString, size_t length, Char* target)
+{
+   // decode(const char*) stops at the first 0 byte. So the bytes are decoded in runs between the
+   // 0 bytes, which become U+0000 like in the other decoders.
+   const size_t capacity = maxLength(length);
+   size_t count = 0;
+   size_t index = 0;
+
+   while(index < length && count < capacity)
+   {
+      const size_t run = strnlen(cString + index, length - index);
+      if(run > 0)
+      {
+         // Two 0-bytes, since UTF-16 requires a 0-character as terminator.
+         char* cstring = new char[run + 2];
+         memcpy(cstring, cString + index, run);
+         cstring[run] = 0;
+         cstring[run + 1] = 0;
+
+         CharArray array = decode(cstring);
+         delete[] cstring;
+
+         const size_t size = std::min(array.length, capacity - count);
+         memcpy(static_cast<void*>(target + count), array.buffer, sizeof(Char) * size);
+         count += size;
+      }
+
+      index += run;
+      if(index < length && count < capacity)
+      {
+         target[count++] = Char(static_cast<uint16>(0));
+         index++;
+      }
+   }
+   return count;
+}
+
+size_t CharsetDecoder::maxLength(size_t length) const
+{
+   return length;
+}
+
 RawDecoder::RawDecoder(): CharsetDecoder()
 {
 }
@@ -50,13 +92,17 @@ CharArray RawDecoder::decode(const char* cstring)
    while(cstring[length] != 0)length++;
 
    CharArray array = CharArray(length);
+   decode(cstring, length, array.buffer);
+   return array;
+}
 
+size_t RawDecoder::decode(const char* cString, size_t length, Char* target)
+{
    for(size_t a = 0; a < length; a++)
    {
-      array.buffer[a] = Char(cstring[a]);
+      target[a] = Char(cString[a]);
    }
-
-   return array;
+   return length;
 }
 
 ByteArray RawDecoder::encode(const CharArray& string)
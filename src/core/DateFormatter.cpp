@@ -431,51 +431,51 @@ void DateFormatter::Pattern::appendPattern(String& value, const Date& date) cons
             switch(date.month())
             {
                case Date::JANUARY:
-                  value.append(Tr("January"));
+                  value.append(TrLiteral("January"));
                   return;
 
                case Date::FEBRUARY:
-                  value.append(Tr("February"));
+                  value.append(TrLiteral("February"));
                   return;
 
                case Date::MARCH:
-                  value.append(Tr("March"));
+                  value.append(TrLiteral("March"));
                   return;
 
                case Date::APRIL:
-                  value.append(Tr("April"));
+                  value.append(TrLiteral("April"));
                   return;
 
                case Date::MAY:
-                  value.append(Tr("May"));
+                  value.append(TrLiteral("May"));
                   return;
 
                case Date::JUNE:
-                  value.append(Tr("June"));
+                  value.append(TrLiteral("June"));
                   return;
 
                case Date::JULY:
-                  value.append(Tr("July"));
+                  value.append(TrLiteral("July"));
                   return;
 
                case Date::AUGUST:
-                  value.append(Tr("August"));
+                  value.append(TrLiteral("August"));
                   return;
 
                case Date::SEPTEMBER:
-                  value.append(Tr("Septemper"));
+                  value.append(TrLiteral("Septemper"));
                   return;
 
                case Date::OCTOBER:
-                  value.append(Tr("October"));
+                  value.append(TrLiteral("October"));
                   return;
 
                case Date::NOVEMBER:
-                  value.append(Tr("November"));
+                  value.append(TrLiteral("November"));
                   return;
 
                case Date::DECEMBER:
-                  value.append(Tr("December"));
+                  value.append(TrLiteral("December"));
                   return;
             }
          }
@@ -31,8 +31,227 @@
 
 #include "PrecompiledCore.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 using namespace jm;
 
+//! Size of the DEFLATE window, which is the dictionary of the parallel blocks.
+static constexpr size_t kDictionarySize = 32768;
+
+//! Returns the zlib constant of \p strategy.
+static int zlibStrategy(DeflateStrategy strategy)
+{
+   switch(strategy)
+   {
+      case DeflateStrategy::kDefault:
+         return Z_DEFAULT_STRATEGY;
+
+      case DeflateStrategy::kFiltered:
+         return Z_FILTERED;
+
+      case DeflateStrategy::kHuffmanOnly:
+         return Z_HUFFMAN_ONLY;
+
+      case DeflateStrategy::kRle:
+         return Z_RLE;
+
+      case DeflateStrategy::kFixed:
+         return Z_FIXED;
+   }
+   return Z_DEFAULT_STRATEGY;
+}
+
+//! Compresses one block of the parallel mode as raw DEFLATE data.
+//! \param dictionary The uncompressed data, which precedes the block.
+//! \param last Status, whether this is the last block. All other blocks end with a sync flush,
+//! so that they end on a byte boundary and can be concatenated.
+//! \return The zlib result code. Z_OK on success.
+static int compressBlock(int32 level,
+                         int strategy,
+                         const uint8* dictionary,
+                         size_t dictionaryLength,
+                         const uint8* input,
+                         size_t inputLength,
+                         bool last,
+                         std::vector<uint8>& output)
+{
+   // Each block has a new stream. A stream reused with deflateReset() keeps the old window, whose
+   // bytes behind the input influence the choice of matches, so the output would depend on the
+   // previous block of the stream.
+   z_stream stream = {};
+   int result = ::deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, strategy);
+   if(result != Z_OK)return result;
+   if(dictionaryLength > 0)
+   {
+      result = ::deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionaryLength));
+   }
+
+   // The bound is sufficient in nearly all cases. Otherwise the output is enlarged.
+   output.resize(::deflateBound(&stream, static_cast<uLong>(inputLength)) + 16);
+   stream.next_in = const_cast<uint8*>(input);
+   stream.avail_in = static_cast<uInt>(inputLength);
+   size_t length = 0;
+
+   while(result == Z_OK)
+   {
+      stream.next_out = output.data() + length;
+      stream.avail_out = static_cast<uInt>(output.size() - length);
+      const int status = ::deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+      length = output.size() - stream.avail_out;
+
+      if(status == Z_STREAM_END)break;
+      if(status == Z_STREAM_ERROR)result = status;
+      else if(stream.avail_out == 0)output.resize(output.size() * 2);
+      // The sync flush is complete, if space is left in the output.
+      else if(!last)break;
+      else result = Z_BUF_ERROR;
+   }
+
+   ::deflateEnd(&stream);
+   output.resize(length);
+   return result;
+}
+
+struct Deflater::Block
+{
+   //! The dictionary followed by the input of the block.
+   std::vector<uint8> data;
+   size_t dictionaryLength = 0;
+
+   int32 level = kBestCompression;
+   int strategy = Z_DEFAULT_STRATEGY;
+
+   //! Status, whether the Adler-32 checksum of the input is needed.
+   bool checksum = false;
+
+   //! Status, whether this is the last block of the stream.
+   bool last = false;
+
+   //! The results, which are valid when done is true.
+   std::vector<uint8> output;
+   uint32 adler = 1;
+   int result = Z_OK;
+   bool done = false;
+};
+
+class Deflater::WorkerPool
+{
+   public:
+
+      explicit WorkerPool(size_t threads)
+      {
+         for(size_t index = 0; index < threads; index++)
+         {
+            mThreads.emplace_back(&WorkerPool::run, this);
+         }
+      }
+
+      ~WorkerPool()
+      {
+         {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStop = true;
+         }
+         mWork.notify_all();
+         for(std::thread& thread : mThreads)thread.join();
+      }
+
+      //! Returns the number of threads.
+      size_t size() const
+      {
+         return mThreads.size();
+      }
+
+      //! Appends \p block to the queue of the workers.
+      void submit(const std::shared_ptr<Block>& block)
+      {
+         {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mQueue.push_back(block);
+         }
+         mWork.notify_one();
+      }
+
+      //! Returns true, if \p block is compressed.
+      bool isDone(const Block& block)
+      {
+         std::lock_guard<std::mutex> lock(mMutex);
+         return block.done;
+      }
+
+      //! Waits, until \p block is compressed.
+      void wait(const Block& block)
+      {
+         std::unique_lock<std::mutex> lock(mMutex);
+         mDone.wait(lock, [&block]()
+         {
+            return block.done;
+         });
+      }
+
+      //! Removes the blocks, which are not yet taken by a worker.
+      void cancel()
+      {
+         std::lock_guard<std::mutex> lock(mMutex);
+         mQueue.clear();
+      }
+
+   private:
+
+      std::vector<std::thread> mThreads;
+      std::deque<std::shared_ptr<Block>> mQueue;
+      std::mutex mMutex;
+
+      //! Signals new blocks in the queue or the end of the pool.
+      std::condition_variable mWork;
+
+      //! Signals a compressed block.
+      std::condition_variable mDone;
+
+      bool mStop = false;
+
+      void run()
+      {
+         while(true)
+         {
+            std::shared_ptr<Block> block;
+            {
+               std::unique_lock<std::mutex> lock(mMutex);
+               mWork.wait(lock, [this]()
+               {
+                  return mStop || !mQueue.empty();
+               });
+               if(mStop)return;
+               block = std::move(mQueue.front());
+               mQueue.pop_front();
+            }
+
+            const uint8* data = block->data.data();
+            const size_t dictionary = block->dictionaryLength;
+            const size_t length = block->data.size() - dictionary;
+            const int result = compressBlock(block->level, block->strategy, data, dictionary,
+                                             data + dictionary, length, block->last,
+                                             block->output);
+            uint32 adler = 1;
+            if(block->checksum)
+            {
+               adler = static_cast<uint32>(::adler32(1, data + dictionary,
+                                                     static_cast<uInt>(length)));
+            }
+
+            {
+               std::lock_guard<std::mutex> lock(mMutex);
+               block->result = result;
+               block->adler = adler;
+               block->done = true;
+            }
+            mDone.notify_all();
+         }
+      }
+};
+
 Deflater::Deflater(): Object()
 {
 }
@@ -42,56 +261,343 @@ Deflater::Deflater( bool wrap ): Object()
    mWrap = wrap;
 }
 
+Deflater::Deflater(int32 level, DeflateStrategy strategy, bool wrap): Object()
+{
+   mWrap = wrap;
+   mLevel = level;
+   mStrategy = strategy;
+}
+
+Deflater::~Deflater()
+{
+   reset();
+   delete mPool;
+}
+
+void Deflater::setLevel(int32 level)
+{
+   mLevel = level;
+}
+
+void Deflater::setStrategy(DeflateStrategy strategy)
+{
+   mStrategy = strategy;
+}
 
 void Deflater::setInput(uint8* buffer, size_t length)
 {
    mUncompBytes = buffer;
    mUncompLength = length;
    mUncompIndex = 0;
-   mTotalIn += length;
+}
+
+void Deflater::setThreads(size_t threads)
+{
+   mThreads = threads;
+}
+
+size_t Deflater::workerCount() const
+{
+   return mPool != nullptr ? mPool->size() : 0;
+}
+
+void Deflater::finish()
+{
+   mFinish = true;
+}
+
+bool Deflater::needsInput() const
+{
+   return !mFinish && mUncompIndex == mUncompLength;
+}
+
+bool Deflater::finished() const
+{
+   return mFinished;
+}
+
+void Deflater::initStream()
+{
+   if(mStream != nullptr)return;
+
+   const int strategy = zlibStrategy(mStrategy);
+
+   mStream = new z_stream();
+   mStream->zalloc = Z_NULL;
+   mStream->zfree = Z_NULL;
+   mStream->opaque = Z_NULL;
+
+   // Negative window bits create a raw stream without zlib header and checksum.
+   const int result = ::deflateInit2(mStream, mLevel, Z_DEFLATED, mWrap ? -MAX_WBITS : MAX_WBITS,
+                                     8, strategy);
+   if(result != Z_OK)
+   {
+      delete mStream;
+      mStream = nullptr;
+      throw Exception("Cannot initialize the compression. (" + String::valueOf(result) + ")");
+   }
 }
 
 void Deflater::deflate(uint8*& buffer, size_t& length)
 {
-   mUncompIndex = 0;
+   // Each call compresses the input as a stream of its own.
+   if(mFinished)
+   {
+      endStream();
+      mFinished = false;
+   }
+   finish();
+
+   // The bound is the worst case, so the buffer is large enough for incompressible data.
+   size_t capacity = maxOutputSize(mUncompLength - mUncompIndex);
+   buffer = new uint8[capacity];
+   length = 0;
+
+   while(!finished())
+   {
+      if(length == capacity)
+      {
+         uint8* tmp = new uint8[capacity * 2];
+         memcpy(tmp, buffer, length);
+         delete[] buffer;
+         buffer = tmp;
+         capacity *= 2;
+      }
+      length += deflate(buffer, length, capacity - length);
+   }
+}
 
-   buffer = new uint8[mUncompLength];
+size_t Deflater::deflate(uint8* buffer, size_t offset, size_t length)
+{
+   if(mFinished)return 0;
+   if(mThreads != 1)return deflateParallel(buffer, offset, length);
+   initStream();
 
-   z_stream defstream;
-   defstream.zalloc = Z_NULL;
-   defstream.zfree = Z_NULL;
-   defstream.opaque = Z_NULL;
-   // setup "a" as the input and "b" as the compressed output
-   defstream.avail_in = (uInt) mUncompLength; // size of input, string + terminator
-   defstream.next_in = reinterpret_cast<Bytef*>(mUncompBytes);  // input char array
-   defstream.avail_out = (uInt)mUncompLength; // size of output
-   defstream.next_out = reinterpret_cast<Bytef*>(buffer);  // output char array
+   // zlib counts with 32 bit, so large buffers are passed in several steps.
+   const size_t kStep = 0x40000000;
+   size_t count = 0;
 
-   if(mWrap)
+   while(count < length && !mFinished)
    {
-      ::deflateInit2(&defstream, Z_BEST_COMPRESSION, Z_DEFLATED,
-                   -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+      const size_t input = std::min(mUncompLength - mUncompIndex, kStep);
+      const size_t output = std::min(length - count, kStep);
+      const int flush = mFinish && input == mUncompLength - mUncompIndex ? Z_FINISH : Z_NO_FLUSH;
+
+      mStream->next_in = mUncompBytes + mUncompIndex;
+      mStream->avail_in = static_cast<uInt>(input);
+      mStream->next_out = buffer + offset + count;
+      mStream->avail_out = static_cast<uInt>(output);
+
+      const int result = ::deflate(mStream, flush);
+      if(result == Z_STREAM_ERROR)throw Exception("Error in compression process.");
+
+      const size_t consumed = input - mStream->avail_in;
+      const size_t produced = output - mStream->avail_out;
+      mUncompIndex += consumed;
+      mTotalIn += consumed;
+      count += produced;
+
+      if(result == Z_STREAM_END)mFinished = true;
+
+      // No progress: The input is consumed and zlib holds back the output until more input or
+      // finish() follows.
+      if(consumed == 0 && produced == 0)break;
    }
-   else
+
+   mTotalOut += count;
+   return count;
+}
+
+size_t Deflater::deflateParallel(uint8* buffer, size_t offset, size_t length)
+{
+   // The pool is replaced, if the number of threads was changed since the last stream. The
+   // output does not depend on the number of threads, so it is enough that no block is queued.
+   const size_t threads = mThreads > 0 ? mThreads :
+                          std::max(std::thread::hardware_concurrency(), 1u);
+   if(mPool != nullptr && mPool->size() != threads && mQueue.empty())
    {
-      // the actual compression work.
-      deflateInit(&defstream, Z_BEST_COMPRESSION);
+      delete mPool;
+      mPool = nullptr;
    }
+   if(mPool == nullptr)mPool = new WorkerPool(threads);
+   if(mBlocks.capacity() == 0)mBlocks.reserve(kDictionarySize + kBlockSize);
+
+   // Up to two blocks for each thread are in the queue, so the workers do not run out of blocks
+   // while the caller reads the next input.
+   const size_t maxBlocks = 2 * mPool->size();
+   size_t count = 0;
+
+   while(count < length)
+   {
+      // Returns the compressed data first.
+      if(mPendingIndex < mPending.size())
+      {
+         const size_t size = std::min(mPending.size() - mPendingIndex, length - count);
+         memcpy(buffer + offset + count, mPending.data() + mPendingIndex, size);
+         mPendingIndex += size;
+         count += size;
+         continue;
+      }
+      if(!mQueue.empty() && mPool->isDone(*mQueue.front()))
+      {
+         takeBlock();
+         continue;
+      }
+
+      // Collects the input of the next block.
+      const size_t capacity = mDictionaryLength + kBlockSize;
+      const bool inputLeft = mUncompIndex < mUncompLength;
+      if(inputLeft && mBlocks.size() < capacity)
+      {
+         const size_t size = std::min(capacity - mBlocks.size(), mUncompLength - mUncompIndex);
+         mBlocks.insert(mBlocks.end(), mUncompBytes + mUncompIndex,
+                        mUncompBytes + mUncompIndex + size);
+         mUncompIndex += size;
+         mTotalIn += size;
+         continue;
+      }
 
-   ::deflate(&defstream, Z_FINISH);
-   deflateEnd(&defstream);
+      // A full block waits for the next input, until it is known, whether it is the last one.
+      // So the last block is never empty and the output does not depend on the input chunks.
+      if(!mLastBlock && (inputLeft || mFinish))
+      {
+         if(mQueue.size() < maxBlocks)
+         {
+            submitBlock(!inputLeft);
+            continue;
+         }
+      }
+      else if(!mLastBlock || mQueue.empty())
+      {
+         // More input is needed, or all data is returned.
+         break;
+      }
+
+      mPool->wait(*mQueue.front());
+   }
+
+   if(mLastBlock && mQueue.empty() && mPendingIndex == mPending.size())mFinished = true;
+   mTotalOut += count;
+   return count;
+}
+
+void Deflater::submitBlock(bool last)
+{
+   std::shared_ptr<Block> block = std::make_shared<Block>();
+   block->dictionaryLength = mDictionaryLength;
+   block->level = mLevel;
+   block->strategy = zlibStrategy(mStrategy);
+   block->checksum = !mWrap;
+   block->last = last;
+
+   // The last 32 KB are the dictionary of the next block.
+   const size_t dictionary = std::min(mBlocks.size(), kDictionarySize);
+   std::vector<uint8> next;
+   next.reserve(kDictionarySize + kBlockSize);
+   next.insert(next.end(), mBlocks.end() - static_cast<std::ptrdiff_t>(dictionary),
+               mBlocks.end());
+   block->data = std::move(mBlocks);
+   mBlocks = std::move(next);
+   mDictionaryLength = dictionary;
+
+   mQueue.push_back(block);
+   mPool->submit(block);
+   if(last)mLastBlock = true;
+}
+
+void Deflater::takeBlock()
+{
+   const std::shared_ptr<Block> block = std::move(mQueue.front());
+   mQueue.pop_front();
+   if(block->result != Z_OK)throw Exception("Error in compression process.");
+
+   mPending.clear();
+   mPendingIndex = 0;
+
+   // zlib header (RFC 1950) with the same compression level flags as zlib writes. Only the first
+   // block has no dictionary.
+   if(!mWrap && block->dictionaryLength == 0)
+   {
+      const int32 level = mLevel == kDefaultCompression ? 6 : mLevel;
+      uint32 flags = 3;
+      if(block->strategy >= Z_HUFFMAN_ONLY || level < 2)flags = 0;
+      else if(level < 6)flags = 1;
+      else if(level == 6)flags = 2;
+
+      uint32 header = ((Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8) | (flags << 6);
+      header += 31 - header % 31;
+      mPending.push_back(static_cast<uint8>(header >> 8));
+      mPending.push_back(static_cast<uint8>(header));
+   }
+
+   mPending.insert(mPending.end(), block->output.begin(), block->output.end());
+
+   if(!mWrap)
+   {
+      const size_t size = block->data.size() - block->dictionaryLength;
+      mAdler = static_cast<uint32>(::adler32_combine(mAdler, block->adler,
+                                                     static_cast<z_off_t>(size)));
+
+      // zlib trailer
+      if(block->last)
+      {
+         for(int32 shift = 24; shift >= 0; shift -= 8)
+         {
+            mPending.push_back(static_cast<uint8>(mAdler >> shift));
+         }
+      }
+   }
+}
+
+size_t Deflater::maxOutputSize(size_t length)
+{
+   if(mThreads != 1)
+   {
+      // Without a stream, zlib returns the bound for all levels and strategies. Each block has
+      // the overhead of the sync flush with up to 5 bytes, the stream has the zlib header and
+      // trailer.
+      const size_t blocks = length / kBlockSize + 1;
+      return blocks * (::deflateBound(Z_NULL, static_cast<uLong>(kBlockSize)) + 5) + 6;
+   }
+
+   initStream();
+   if(length <= 0xFFFFFFFF)return ::deflateBound(mStream, static_cast<uLong>(length));
+
+   // deflateBound() counts with 32 bit on some platforms. Sum up the bound of 1 GB steps.
+   const size_t step = 0x40000000;
+   return (length / step + 1) * ::deflateBound(mStream, static_cast<uLong>(step));
+}
+
+void Deflater::endStream()
+{
+   if(mStream != nullptr)
+   {
+      ::deflateEnd(mStream);
+      delete mStream;
+      mStream = nullptr;
+   }
 
-   length = defstream.total_out;
-   mTotalOut += length;
+   // The workers drop the blocks, which they compress at the moment, when they are done.
+   if(mPool != nullptr)mPool->cancel();
+   mQueue.clear();
+   mBlocks.clear();
+   mDictionaryLength = 0;
+   mPending.clear();
+   mPendingIndex = 0;
+   mAdler = 1;
+   mLastBlock = false;
 }
 
 void Deflater::reset()
 {
+   endStream();
    mUncompBytes = nullptr;
    mUncompLength = 0;
    mUncompIndex = 0;
    mTotalIn = 0;
    mTotalOut = 0;
+   mFinish = false;
+   mFinished = false;
 }
 
 size_t Deflater::totalInSize() const
@@ -34,7 +34,7 @@
 
 using namespace jm;
 
-DiffDiag::DiffDiag(DiffDistance* dist, std::vector<Object*>* u, std::vector<Object*>* v,
+DiffDiag::DiffDiag(DiffDistance* dist, ArrayList<Object*>* u, ArrayList<Object*>* v,
                    int64 offset)
 {
    mU = u;
@@ -42,15 +42,12 @@ DiffDiag::DiffDiag(DiffDistance* dist, std::vector<Object*>* u, std::vector<Obje
    mBelow = nullptr;
    mAbove = nullptr;
    this->mOffset = offset;
-   mElements = new std::vector<int64>();
-   mElements->push_back(std::abs(offset));
+   mElements.append(std::abs(offset));
    this->mDistance = dist;
 }
 
 DiffDiag::~DiffDiag()
 {
-   mElements->clear();
-   delete mElements;
 }
 
 
@@ -92,14 +89,14 @@ int64 DiffDiag::leftEntry(size_t i)
 
 int64 DiffDiag::entry(size_t j)
 {
-   if(j < mElements->size())return mElements->at(j);
+   if(j < mElements.size())return mElements[j];
 
-   int64 x = mElements->at(mElements->size() - 1);
+   int64 x = mElements.last();
 
-   while(mElements->size() <= j)
+   while(mElements.size() <= j)
    {
       int64 lu = x;
-      size_t i = mElements->size();
+      size_t i = mElements.size();
 
       //  \ \  \
       //   \ \  \
@@ -134,19 +131,26 @@ int64 DiffDiag::entry(size_t j)
       }
 
       mDistance->mCalc++;
-      mElements->push_back(x);
+      mElements.append(x);
    }
    return x;
 }
 
 Object* DiffDiag::objectU(size_t i)
 {
-   return mU->at(i - 1);
+   // i starts at 1. For i = 0 the index wraps around and is out of bounds, too.
+   const size_t index = i - 1;
+   if(index >= mU->size())
+      throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
+   return (*mU)[index];
 }
 
 Object* DiffDiag::objectV(size_t i)
 {
-   return mV->at(static_cast<size_t>(std::abs(mOffset)) + i - 1);
+   const size_t index = static_cast<size_t>(std::abs(mOffset)) + i - 1;
+   if(index >= mV->size())
+      throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
+   return (*mV)[index];
 }
 
 int64 DiffDiag::offset() const
@@ -41,15 +41,11 @@ DiffDistance::DiffDistance()
    mDiagonal = nullptr;
    mDistance = 0;
    mCalc = 0;
-   u = new std::vector<Object*>();
-   v = new std::vector<Object*>();
 }
 
 DiffDistance::~DiffDistance()
 {
    clear();
-   delete u;
-   delete v;
 }
 
 void DiffDistance::clear()
@@ -59,26 +55,26 @@ void DiffDistance::clear()
       delete mDiagonal;
       mDiagonal = nullptr;
    }
-   u->clear();
-   v->clear();
+   u.clear();
+   v.clear();
    mDistance = 0;
    mCalc = 0;
 }
 
 void DiffDistance::addU(Object* obj)
 {
-   u->push_back(obj);
+   u.append(obj);
 }
 
 void DiffDistance::addV(Object* obj)
 {
-   v->push_back(obj);
+   v.append(obj);
 }
 
 DiffBacktrace* DiffDistance::solve()
 {
-   mRows = u->size();
-   mCols = v->size();
+   mRows = u.size();
+   mCols = v.size();
 
 
    //Speed-Up: Durch Betrachtung der Diagonalen....
@@ -91,9 +87,9 @@ DiffBacktrace* DiffDistance::solve()
 
 
    // which is the diagonal containing the bottom R.H. element?
-   size_t lba = v->size() - u->size();
+   size_t lba = v.size() - u.size();
 
-   DiffDiag* main = new DiffDiag(this, u, v, 0);
+   DiffDiag* main = new DiffDiag(this, &u, &v, 0);
 
 
    if(lba >= 0)
@@ -112,8 +108,8 @@ DiffBacktrace* DiffDistance::solve()
    mDistance = mDiagonal->entry(std::min(mRows, mCols));
 
    size_t sz = mRows * mCols;
-   std::cout << Tr("Distance %1").arg(mDistance) << std::endl;
-   std::cout << Tr("Calculated %1/%2: %3%")
+   std::cout << TrLiteral("Distance %1").arg(mDistance) << std::endl;
+   std::cout << TrLiteral("Calculated %1/%2: %3%")
              .arg(mCalc)
              .arg(sz)
              .arg(mCalc * 100.0 / double(sz))
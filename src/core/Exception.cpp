@@ -73,9 +73,6 @@ void Exception::printStackTrace() const
    if(mMessage.size() > 0)std::cerr << " : " << mMessage;
    std::cerr << std::endl;
 
-   char* buffer = new char[1024];
-   memset(buffer, 0, 1024);
-
    for(size_t i = 1; i < addrlen; i++)
    {
 
@@ -103,11 +100,7 @@ void Exception::printStackTrace() const
       String function = line.substring(0, pos);
       line = line.substring(pos).trim();
 
-      int status;
-      size_t size = 1024;
-      ByteArray cstr = function.toCString();
-      abi::__cxa_demangle(cstr.constData(), buffer, &size, &status);
-      function = String(buffer, size, Charset::forName("RAW"));
+      function = demangle(function);
 
       std:: cerr << "\tat [" << binaryName << "] " << function << " (" << address << " " << line << ")" <<
                  std::endl;
@@ -119,7 +112,6 @@ void Exception::printStackTrace() const
 #endif
 
    }
-   delete[] buffer;
 
 #elif defined JM_WINDOWS
    //Keine Threadbib
@@ -127,6 +119,29 @@ void Exception::printStackTrace() const
 
 }
 
+String Exception::demangle(const String& symbol)
+{
+#if defined(JM_MACOS) || defined(JM_IOS) || defined(JM_LINUX) || defined(JM_ANDROID)
+   int status = 0;
+   ByteArray cstr = symbol.toCString();
+
+   // Let __cxa_demangle allocate the buffer. It returns the name NUL terminated and only on
+   // success, so the length of the name is strlen() and not the size of the buffer.
+   char* name = abi::__cxa_demangle(cstr.constData(), nullptr, nullptr, &status);
+   if(status != 0 || name == nullptr)
+   {
+      free(name);
+      return symbol;
+   }
+
+   String result = String(name, strlen(name), Charset::forName("RAW"));
+   free(name);
+   return result;
+#elif defined JM_WINDOWS
+   return symbol;
+#endif
+}
+
 String Exception::GetStrackTrace() const
 {
    String ret;
@@ -138,9 +153,6 @@ String Exception::GetStrackTrace() const
    if(mMessage.size() > 0)ret << " : " << mMessage;
    ret << '\r' << '\n';
 
-   char* buffer = new char[1024];
-   memset(buffer, 0, 1024);
-
    for(size_t i = 1; i < addrlen; i++)
    {
 
@@ -168,11 +180,7 @@ String Exception::GetStrackTrace() const
       String function = line.substring(0, pos);
       line = line.substring(pos).trim();
 
-      int status;
-      size_t size = 1024;
-      ByteArray cstr = function.toCString();
-      abi::__cxa_demangle(cstr.constData(), buffer, &size, &status);
-      function = String(buffer, size, Charset::forName("RAW"));
+      function = demangle(function);
 
       ret << "\tat [" << binaryName << "] " << function << " (" << address << " " << line << ")" << '\r'
           << '\n';
@@ -184,7 +192,6 @@ String Exception::GetStrackTrace() const
 #endif
 
    }
-   delete[] buffer;
 
 #elif defined JM_WINDOWS
    //Keine Threadbib
@@ -49,7 +49,7 @@ File::File(const String& pathname): Stream(), Comparable<File>()
 
 File::File(String parent, String child): Stream(), Comparable<File>()
 {
-   if(child.size() < 1)throw Exception(Tr("Child is empty."));
+   if(child.size() < 1)throw Exception(TrLiteral("Child is empty."));
    mPathname = resolve(normalize(parent), normalize(child));
    setCString();
    mHandle = nullptr;
@@ -57,7 +57,7 @@ File::File(String parent, String child): Stream(), Comparable<File>()
 
 File::File(const File& parent, String child): Stream(), Comparable<File>()
 {
-   if(child.size() < 1)throw Exception(Tr("Child is empty."));
+   if(child.size() < 1)throw Exception(TrLiteral("Child is empty."));
    mPathname = resolve(parent.absolutePath(), normalize(child));
    setCString();
    mHandle = nullptr;
@@ -459,7 +459,7 @@ Array<File>* File::listFiles()const
 
    if(dp == nullptr)
    {
-      throw Exception(Tr("Cannot open directory"));
+      throw Exception(TrLiteral("Cannot open directory"));
    }
 
    size_t fileCount = 0;
@@ -525,7 +525,7 @@ Array<File>* File::listFiles()const
    else
    {
       delete wstr;
-      throw Exception(Tr("Cannot open directory"));
+      throw Exception(TrLiteral("Cannot open directory"));
    }
 
 #endif
@@ -626,7 +626,7 @@ Status File::open(FileMode mode)
 
    if(mHandle == nullptr)
    {
-      String msg = Tr("Cannot open file! \"%1\" Errno: %2").arg(mPathname).arg(int64(errno));
+      String msg = TrLiteral("Cannot open file! \"%1\" Errno: %2").arg(mPathname).arg(int64(errno));
       jm::System::log(msg, jm::LogLevel::kError);
 
       if(errno == EACCES)return Status::eNotAllowed;
@@ -647,7 +647,7 @@ void File::close()
 {
    if(mHandle == nullptr)return;
    int32 eof = fclose(mHandle);
-   if(eof == EOF)throw Exception(Tr("Error while closing file!"));
+   if(eof == EOF)throw Exception(TrLiteral("Error while closing file!"));
    mHandle = nullptr;
 }
 
@@ -655,14 +655,14 @@ void File::seek(size_t position)
 {
    //Data type is long int in fseek
    int res = fseek(mHandle, (long int)position, SEEK_SET);
-   if(res != 0)throw Exception(Tr("Error while moving file reading pointer!"));
+   if(res != 0)throw Exception(TrLiteral("Error while moving file reading pointer!"));
 }
 
 void File::move(ssize_t offset)
 {
    //Data type is long int in fseek
    int res = fseek(mHandle, (long int)offset, SEEK_CUR);
-   if(res != 0)throw Exception(Tr("Error while moving file reading pointer!"));
+   if(res != 0)throw Exception(TrLiteral("Error while moving file reading pointer!"));
 }
 
 size_t File::position()
@@ -886,7 +886,7 @@ String jm::ExecPath()
    int ok = _NSGetExecutablePath(path, &size);
    if(ok < 0)
    {
-      throw Exception(Tr("Cannot determinate executable Path"));
+      throw Exception(TrLiteral("Cannot determinate executable Path"));
    }
    path[size - 1] = '\0';
    String ret = String(path);
@@ -924,7 +924,7 @@ String jm::ExecPath()
       return ret;
    }
 #endif
-   throw Exception(Tr("Cannot determinate executable path"));
+   throw Exception(TrLiteral("Cannot determinate executable path"));
 }
 
 String jm::ExecName()
@@ -959,7 +959,7 @@ File jm::ResourceDir(const String& bundleId)
 
       if(!bundleId.isEmpty())
       {
-         System::log(Tr("BundleRef for %1 not found. Cannot determine resource directory.").arg(bundleId),
+         System::log(TrLiteral("BundleRef for %1 not found. Cannot determine resource directory.").arg(bundleId),
                      LogLevel::kError);
       }
       return File("/");
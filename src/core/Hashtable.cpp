@@ -34,130 +34,167 @@
 using namespace jm;
 
 Hashtable::Hashtable() noexcept: Object(),
-   mArrLength(7),
+   mData(nullptr),
+   mControl(nullptr),
+   mArrLength(0),
    mDataLength(0),
-   mLoadfactor(0.75f),
-   mThreshold(5)
-{
-   mData = new HashtableEntry*[mArrLength]; // Array for data
-   for(size_t i = 0; i < mArrLength; i++)
-   {
-      mData[i] = nullptr;  // Explicitly set each pointer to nullptr
-   }
-}
+   mDeleted(0),
+   mThreshold(0)
+{}
 
 Hashtable::~Hashtable() noexcept
 {
-   clear();
    delete[] mData;
+   delete[] mControl;
+   mData = nullptr;
+   mControl = nullptr;
    mDataLength = 0;
    mArrLength = 0;
 }
 
-void* Hashtable::put(String key, void* value) noexcept
+size_t Hashtable::find(const String& key, int64 hash) const noexcept
 {
-   // Make sure that no entry already exists in the hash table.
-   int64 hash = key.hashCode();
-   int64 index = (hash & 0x7FFFFFFF) % mArrLength;
-   for(HashtableEntry* e = mData[index] ; e != nullptr ; e = e->next)
+   if(mArrLength == 0)return npos;
+
+   // The groups are probed quadratically. Because the number of groups is a power of 2, every
+   // group is visited and the search ends at the latest at a group with an empty slot.
+   const size_t mask = mArrLength - 1;
+   const int8 ctrl = HashGroup::control(static_cast<uint64>(hash));
+   size_t position = HashGroup::start(static_cast<uint64>(hash)) & mask;
+   size_t step = 0;
+
+   while(true)
    {
-      if((e->hash == hash) && e->key.equals(key))
+      const int8* group = mControl + position;
+      uint32 candidates = HashGroup::match(group, ctrl);
+      while(candidates != 0)
       {
-         void* old = e->value;
-         e->value = value;
-         return old;
+         const size_t index = (position + HashGroup::lowestBit(candidates)) & mask;
+         const HashtableEntry& entry = mData[index];
+         if(entry.hash == hash && entry.key.equals(key))return index;
+         candidates &= candidates - 1;
       }
+
+      if(HashGroup::match(group, HashGroup::kEmpty) != 0)return npos;
+
+      step += HashGroup::kWidth;
+      position = (position + step) & mask;
    }
+}
+
+size_t Hashtable::findFree(int64 hash) const noexcept
+{
+   const size_t mask = mArrLength - 1;
+   size_t position = HashGroup::start(static_cast<uint64>(hash)) & mask;
+   size_t step = 0;
 
-   // Increase table when threshold value is reached.
-   if(mDataLength >= mThreshold)
+   while(true)
    {
-      rehash();
-      index = (hash & 0x7FFFFFFF) % mArrLength;
-   }
+      const uint32 free = HashGroup::matchFree(mControl + position);
+      if(free != 0)return (position + HashGroup::lowestBit(free)) & mask;
 
-   // Create new entry.
-   HashtableEntry* e = mData[index] ;
-   HashtableEntry* n = new HashtableEntry();
-   n->hash = hash;
-   n->key = key;
-   n->value = value;
-   n->next = e;
-   mData[index] = n;
-   mDataLength++;
-   return nullptr;
+      step += HashGroup::kWidth;
+      position = (position + step) & mask;
+   }
 }
 
-void* Hashtable::get(const String& key) const noexcept
+void Hashtable::setControl(size_t index, int8 value) noexcept
 {
-   int64 hash = key.constHashCode();
+   mControl[index] = value;
+   if(index < HashGroup::kWidth)mControl[mArrLength + index] = value;
+}
 
-   int64 index = (hash & 0x7FFFFFFF) % mArrLength;
-   for(HashtableEntry* e = mData[index] ; e != nullptr ; e = e->next)
+void* Hashtable::put(String key, void* value) noexcept
+{
+   // Make sure that no entry already exists in the hash table.
+   int64 hash = key.hashCode();
+   size_t index = find(key, hash);
+   if(index != npos)
    {
-      if((e->hash == hash) && e->key.equals(key))
-      {
-         return e->value;
-      }
+      void* old = mData[index].value;
+      mData[index].value = value;
+      return old;
    }
 
+   // Reorganize the table when the threshold value is reached.
+   if(mDataLength + mDeleted >= mThreshold)rehash();
+
+   // Create new entry.
+   index = findFree(hash);
+   if(mControl[index] == HashGroup::kDeleted)mDeleted--;
+   setControl(index, HashGroup::control(static_cast<uint64>(hash)));
+
+   HashtableEntry& entry = mData[index];
+   entry.hash = hash;
+   entry.key = std::move(key);
+   entry.value = value;
+   mDataLength++;
    return nullptr;
 }
 
+void* Hashtable::get(const String& key) const noexcept
+{
+   size_t index = find(key, key.constHashCode());
+   if(index == npos)return nullptr;
+   return mData[index].value;
+}
+
 bool Hashtable::containsKey(const String& key) const noexcept
 {
    return get(key) != nullptr;
 }
 
-void* Hashtable::remove(const String& key) noexcept
+bool Hashtable::containsValue(void* value) const noexcept
 {
-   int64 hash = key.constHashCode();
-   int64 index = (hash & 0x7FFFFFFF) % mArrLength;
-
-   HashtableEntry* prev = nullptr;
-   HashtableEntry* e = mData[index];
-   while(e != nullptr)
+   for(size_t index = 0; index < mArrLength; index++)
    {
-      if((e->hash == hash) && e->key.equals(key))
-      {
-         // Delete element in the linked list
-         if(prev != nullptr)
-         {
-            prev->next = e->next;
-         }
-         else
-         {
-            mData[index] = e->next;
-         }
-         mDataLength--;
-
-         // Return value
-         void* oldValue = e->value;
-         delete e;
-         return oldValue;
-      }
-      prev = e;
-      e = e->next;
+      if(mControl[index] >= 0 && mData[index].value == value)return true;
    }
+   return false;
+}
+
+void* Hashtable::remove(const String& key) noexcept
+{
+   size_t index = find(key, key.constHashCode());
 
    // Nothing found
-   return nullptr;
+   if(index == npos)return nullptr;
+
+   if(HashGroup::canEmpty(mControl, mArrLength, index))
+   {
+      setControl(index, HashGroup::kEmpty);
+   }
+   else
+   {
+      setControl(index, HashGroup::kDeleted);
+      mDeleted++;
+   }
+   mDataLength--;
+
+   // Return value
+   HashtableEntry& entry = mData[index];
+   void* oldValue = entry.value;
+   entry.key = String();
+   entry.value = nullptr;
+   return oldValue;
 }
 
 void Hashtable::clear() noexcept
 {
    for(size_t index = 0; index < mArrLength; index++)
    {
-      HashtableEntry* e = mData[index];
-      while(e != nullptr)
+      if(mControl[index] >= 0)
       {
-         HashtableEntry* n = e->next;
-         delete e;
-         e = n;
+         mData[index].key = String();
+         mData[index].value = nullptr;
       }
-      mData[index] = nullptr;
+   }
+   if(mControl != nullptr)
+   {
+      std::memset(mControl, HashGroup::kEmpty, mArrLength + HashGroup::kWidth);
    }
    mDataLength = 0;
+   mDeleted = 0;
 }
 
 size_t Hashtable::size() const noexcept
@@ -165,37 +202,53 @@ size_t Hashtable::size() const noexcept
    return mDataLength;
 }
 
-void Hashtable::rehash() noexcept
+bool Hashtable::isEmpty() const noexcept
 {
-   size_t oldLength = mArrLength;
-   HashtableEntry** oldData = mData;
+   return mDataLength == 0;
+}
 
-   size_t newLength = oldLength * 2 + 1;
+void Hashtable::reserve(size_t count) noexcept
+{
+   size_t length = HashGroup::kWidth;
+   while(length - length / 8 <= count)length *= 2;
+   if(length > mArrLength)rehash(length);
+}
 
-   HashtableEntry** newData = new HashtableEntry*[newLength];
+void Hashtable::rehash() noexcept
+{
+   if(mArrLength == 0)rehash(HashGroup::kWidth);
+   else if(mDataLength * 2 < mThreshold)rehash(mArrLength);
+   else rehash(mArrLength * 2);
+}
 
-   for(size_t a = 0; a < newLength; a++)newData[a] = nullptr;
+void Hashtable::rehash(size_t length) noexcept
+{
+   HashtableEntry* oldData = mData;
+   int8* oldControl = mControl;
+   size_t oldLength = mArrLength;
 
-   mArrLength = newLength;
-   mThreshold = static_cast<size_t>(std::ceil(static_cast<double>(newLength) * mLoadfactor));
+   mData = new HashtableEntry[length];
+   mControl = new int8[length + HashGroup::kWidth];
+   std::memset(mControl, HashGroup::kEmpty, length + HashGroup::kWidth);
+   mArrLength = length;
+   mThreshold = length - length / 8;
+   mDeleted = 0;
 
+   // The stored hash values are reused, the keys are moved without copying.
    for(size_t a = 0 ; a < oldLength ; a++)
    {
-      HashtableEntry* old = oldData[a];
-
-      while(old != nullptr)
-      {
-         HashtableEntry* next = old->next;
-
-         size_t index = (old->hash & 0x7FFFFFFF) % mArrLength;
-         old->next = newData[index];
-         newData[index] = old;
-
-         old = next;
-      }
+      if(oldControl[a] < 0)continue;
+
+      HashtableEntry& old = oldData[a];
+      size_t index = findFree(old.hash);
+      setControl(index, HashGroup::control(static_cast<uint64>(old.hash)));
+      mData[index].hash = old.hash;
+      mData[index].key = std::move(old.key);
+      mData[index].value = old.value;
    }
-   delete[] mData;
-   mData = newData;
+
+   delete[] oldData;
+   delete[] oldControl;
 }
 
 Iterator* Hashtable::keys() noexcept
@@ -216,34 +269,21 @@ Iterator* Hashtable::values() noexcept
 Hashtable::HashtableIterator::HashtableIterator(Hashtable* _table, bool _retKey) noexcept: Iterator(),
    retKey(_retKey),
    table(_table),
-   entry(nullptr),
-   last(nullptr),
    index(0)
 {}
 
 bool Hashtable::HashtableIterator::hasNext() noexcept
 {
-   while(entry == nullptr && index < table->mArrLength)
-   {
-      entry = table->mData[index++];
-   }
-   return entry != nullptr;
+   while(index < table->mArrLength && table->mControl[index] < 0)index++;
+   return index < table->mArrLength;
 }
 
 Object* Hashtable::HashtableIterator::next() noexcept
 {
-   while(entry == nullptr && index < table->mArrLength)
-   {
-      entry = table->mData[index++];
-   }
+   if(!hasNext())return nullptr;
 
-   if(entry != nullptr)
-   {
-      last = entry;
-      entry = entry->next;
-      return reinterpret_cast<Object*>((retKey) ? & (last->key) : last->value);
-   }
-   else return nullptr;
+   HashtableEntry& entry = table->mData[index++];
+   return reinterpret_cast<Object*>((retKey) ? & (entry.key) : entry.value);
 }
 
 /*
@@ -252,17 +292,12 @@ Object* Hashtable::HashtableIterator::next() noexcept
 
 Hashtable::HashtableEntry::HashtableEntry() noexcept:
    hash(0),
-   key(jm::kEmptyString),
-   value(nullptr),
-   next(nullptr)
+   key(),
+   value(nullptr)
 {}
 
 Hashtable::HashtableEntry::~HashtableEntry() noexcept
 {
    hash = 0;
    value = nullptr;
-   next = nullptr;
 }
-
-
-
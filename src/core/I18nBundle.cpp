@@ -35,8 +35,158 @@ using namespace jm;
 
 I18nBundle* gDefaultTranslation = nullptr;
 
+/*!
+ \brief A *.mo file, which is mapped into memory. Keys are looked up with the hash table of the
+ file, like GNU gettext does, and only the found translation is decoded.
+ */
+class I18nBundle::Catalog
+{
+   public:
+
+      /*!
+       \brief Maps \p file and checks its header.
+       \return Status::eNotImplemented, if the file is valid, but has no hash table.
+       */
+      Status open(const File& file)
+      {
+         Status status = mFile.map(file);
+         if(status != Status::eOK)return status;
+
+         const size_t size = mFile.size();
+         if(size < 28 || read(0) != 0x950412de || read(4) != 0)return Status::eInvalidInput;
+
+         mCount = read(8);
+         mOrigOffset = read(12);
+         mTransOffset = read(16);
+         mHashSize = read(20);
+         mHashOffset = read(24);
+
+         // Only the tables are checked, so that opening does not depend on the number of strings.
+         // The strings are checked when they are found.
+         const uint64 tableSize = static_cast<uint64>(mCount) * 8;
+         if(mOrigOffset + tableSize > size || mTransOffset + tableSize > size)
+         {
+            return Status::eInvalidInput;
+         }
+         if(mHashSize <= 2 || mHashOffset + static_cast<uint64>(mHashSize) * 4 > size)
+         {
+            return Status::eNotImplemented;
+         }
+         return Status::eOK;
+      }
+
+      /*!
+       \brief Looks up the UTF-8 encoded \p key with \p length bytes.
+       \return true, if the key was found. Then \p translation contains the translation.
+       */
+      bool find(const char* key, size_t length, String& translation) const
+      {
+         const uint32 hash = hashString(key, length);
+         const uint32 step = 1 + hash % (mHashSize - 2);
+         uint32 index = hash % mHashSize;
+
+         // The table is probed with double hashing. Every slot is visited at most once, also if a
+         // broken file has no empty slot.
+         for(uint32 probe = 0; probe < mHashSize; probe++)
+         {
+            const uint32 entry = read(mHashOffset + static_cast<size_t>(index) * 4);
+            if(entry == 0)return false;
+
+            if(entry <= mCount && matches(entry - 1, key, length))
+            {
+               // Like in gettext, an empty translation is no translation and the plural forms
+               // after a 0 byte are ignored. Line breaks are escaped like by appendMo().
+               size_t transLength = 0;
+               const char* trans = string(mTransOffset, entry - 1, transLength);
+               if(trans == nullptr || transLength == 0)return false;
+               translation = escapeLineBreaks(String(trans, strnlen(trans, transLength)));
+               return true;
+            }
+
+            index = index >= mHashSize - step ? index - (mHashSize - step) : index + step;
+         }
+         return false;
+      }
+
+   private:
+
+      //! The mapped file.
+      MappedFile mFile;
+
+      //! The number of strings.
+      uint32 mCount = 0;
+
+      //! The offset of the table of the original strings.
+      uint32 mOrigOffset = 0;
+
+      //! The offset of the table of the translated strings.
+      uint32 mTransOffset = 0;
+
+      //! The number of slots of the hash table.
+      uint32 mHashSize = 0;
+
+      //! The offset of the hash table.
+      uint32 mHashOffset = 0;
+
+      //! Reads the 32 bit value at \p offset.
+      inline uint32 read(size_t offset) const
+      {
+         return jm::deserializeLEUInt32(mFile.data(), offset);
+      }
+
+      /*!
+       \brief Returns the string \p index of the table at \p table and its \p length, or nullptr if
+       the string is not inside the file.
+       */
+      const char* string(uint32 table, uint32 index, size_t& length) const
+      {
+         const size_t record = table + static_cast<size_t>(index) * 8;
+         const uint64 stringLength = read(record);
+         const uint64 stringOffset = read(record + 4);
+         if(stringOffset + stringLength >= mFile.size())return nullptr;
+         length = static_cast<size_t>(stringLength);
+         return reinterpret_cast<const char*>(mFile.data() + stringOffset);
+      }
+
+      //! Returns true, if the original string \p index is \p key. Like in gettext, the plural form
+      //! after a 0 byte is ignored.
+      bool matches(uint32 index, const char* key, size_t length) const
+      {
+         size_t origLength = 0;
+         const char* orig = string(mOrigOffset, index, origLength);
+         if(orig == nullptr || origLength < length)return false;
+         if(memcmp(orig, key, length) != 0)return false;
+         return origLength == length || orig[length] == 0;
+      }
+
+      //! The hash function of GNU gettext (hashpjw).
+      static uint32 hashString(const char* key, size_t length)
+      {
+         uint32 hash = 0;
+         for(size_t index = 0; index < length; index++)
+         {
+            hash = (hash << 4) + static_cast<uint8>(key[index]);
+            const uint32 high = hash & 0xF0000000u;
+            if(high != 0)
+            {
+               hash ^= high >> 24;
+               hash ^= high;
+            }
+         }
+         return hash;
+      }
+};
+
 I18nBundle::I18nBundle(const String& language):
-   mLanguage(language)
+   mLanguage(language),
+   mCatalogs(),
+   mCatalogMutex(),
+   mMapped(false),
+   mMappedValues()
+{
+}
+
+I18nBundle::~I18nBundle()
 {
 }
 
@@ -46,7 +196,7 @@ void I18nBundle::appendMo(Stream* file)
    {
       if(System::bundleId().size() > 0)
       {
-         System::log(Tr("Cannot find translation file: %1")
+         System::log(TrLiteral("Cannot find translation file: %1")
                      .arg(mLanguage),
                      LogLevel::kDebug);
       }
@@ -59,7 +209,7 @@ void I18nBundle::appendMo(Stream* file)
    Status status = file->open(FileMode::kRead);
    if(status != Status::eOK)
    {
-      System::log(Tr("Cannot open translation file"), LogLevel::kError);
+      System::log(TrLiteral("Cannot open translation file"), LogLevel::kError);
       return;
    }
    size_t check = file->readFully(buf);
@@ -67,7 +217,7 @@ void I18nBundle::appendMo(Stream* file)
 
    if(check != length)
    {
-      System::log(Tr("Translation file not fully read"), LogLevel::kError);
+      System::log(TrLiteral("Translation file not fully read"), LogLevel::kError);
       return;
    }
    uint8* buffer = (uint8*)buf.constData();
@@ -81,12 +231,12 @@ void I18nBundle::appendMo(Stream* file)
 
    if(magic != 0x950412de)
    {
-      System::log(Tr("Translation File magic wrong"), LogLevel::kError);
+      System::log(TrLiteral("Translation File magic wrong"), LogLevel::kError);
       return;
    }
    if(version != 0)
    {
-      System::log(Tr("MO file version not supported: %1").arg(version), LogLevel::kError);
+      System::log(TrLiteral("MO file version not supported: %1").arg(version), LogLevel::kError);
       return;
    }
 
@@ -116,18 +266,110 @@ void I18nBundle::appendMo(Stream* file)
    }
 
    // Process the records
+   reserve(stringCount);
    for(size_t index = 0; index < stringCount; index++)
    {
       const Record rec = records[index];
-      const jm::String orig = jm::String((char*)&buffer[rec.origOffset], rec.origLength);
-      const jm::String trans = jm::String((char*)&buffer[rec.transOffset], rec.transLength);
+
+      // Like in gettext, the plural forms after a 0 byte are ignored.
+      const char* origString = (char*)&buffer[rec.origOffset];
+      const char* transString = (char*)&buffer[rec.transOffset];
+      const jm::String orig = jm::String(origString, strnlen(origString, rec.origLength));
+      const jm::String trans = jm::String(transString, strnlen(transString, rec.transLength));
       setValue(orig, trans);
    }
 }
 
+Status I18nBundle::mapMo(const File& file)
+{
+   std::unique_ptr<Catalog> catalog = std::make_unique<Catalog>();
+   const Status status = catalog->open(file);
+
+   if(status == Status::eNotImplemented)
+   {
+      File copy = file;
+      appendMo(&copy);
+      return Status::eOK;
+   }
+   if(status != Status::eOK)
+   {
+      if(status == Status::eInvalidInput)
+      {
+         System::log(TrLiteral("Translation file invalid: %1").arg(file.absolutePath()),
+                     LogLevel::kError);
+      }
+      else if(System::bundleId().size() > 0)
+      {
+         System::log(TrLiteral("Cannot find translation file: %1").arg(mLanguage),
+                     LogLevel::kDebug);
+      }
+      return status;
+   }
+
+   // Misses looked up before may be in the new catalog. The remembered values are cleared under
+   // the same lock, so no lookup in the old catalogs can store its result afterwards.
+   std::unique_lock<std::shared_mutex> lock(mCatalogMutex);
+   mCatalogs.push_back(std::move(catalog));
+   mMappedValues.clear();
+   mMapped.store(true, std::memory_order_release);
+   return Status::eOK;
+}
+
 String I18nBundle::translate(const String& key) const
 {
-   return value(key, key);
+   // Like Preferences::value(), an empty translation is no translation.
+   String translation;
+   if(mValues.get(key, translation) && !translation.isEmpty())return translation;
+   return translateMapped(key);
+}
+
+String I18nBundle::translate(const Atom& key) const
+{
+   return translate(key.string());
+}
+
+String I18nBundle::translate(const Char* buffer, size_t length, int64 hash) const
+{
+   const auto equal = [buffer, length](const String & other)
+   {
+      return other.equals(buffer, length);
+   };
+
+   String translation;
+   if(mValues.getByHash(static_cast<size_t>(hash), equal, translation) && !translation.isEmpty())
+   {
+      return translation;
+   }
+
+   if(mMapped.load(std::memory_order_acquire))
+   {
+      if(mMappedValues.getByHash(static_cast<size_t>(hash), equal, translation))return translation;
+      return translateMapped(Atom(buffer, length, hash));
+   }
+
+   // The interned key is shared, so the fallback does not allocate after the first call.
+   return Atom(buffer, length, hash);
+}
+
+String I18nBundle::translateMapped(const String& key) const
+{
+   if(!mMapped.load(std::memory_order_acquire))return key;
+
+   String translation;
+   if(mMappedValues.get(key, translation))return translation;
+
+   translation = key;
+   const ByteArray utf8 = key.toCString();
+   std::shared_lock<std::shared_mutex> lock(mCatalogMutex);
+   for(auto catalog = mCatalogs.rbegin(); catalog != mCatalogs.rend(); ++catalog)
+   {
+      if((*catalog)->find(utf8.constData(), utf8.size(), translation))break;
+   }
+
+   // Misses are remembered as well, so every key is searched and decoded only once. The result
+   // is stored under the lock, so mapMo() cannot add a catalog in between.
+   mMappedValues.put(key, translation);
+   return translation;
 }
 
 
@@ -144,7 +386,9 @@ void I18nBundle::initDefault()
    // Append Data only if bundle id is set
    if(jm::System::bundleId().size() == 0)return;
    Resource res = transFileByBundleId(jm::kEmptyString, gDefaultTranslation->mLanguage);
-   gDefaultTranslation->appendMo(&res);
+   const File* file = res.file();
+   if(file != nullptr)gDefaultTranslation->mapMo(*file);
+   else gDefaultTranslation->appendMo(&res);
 }
 
 void I18nBundle::quitDefault()
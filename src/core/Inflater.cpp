@@ -39,756 +39,769 @@ const uint16 LENGTH_OFFSET[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 2
 const uint8 DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
 const uint16 DIST_OFFSET[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
 
-Inflater::Inflater(): Object()
-{
-   mWrap = false;
-   mCompBytes = nullptr;
-   mCompLength = 0;
-   mCompIndex = 0;
-   mUncompBytes = nullptr;
-   mUncompLength = 1024;
-   mUncompIndex = 0;
-   mTotalIn = 0;
-   mTotalOut = 0;
-   mBit = 0;
-   mLastBlock = false;
-   mEof = false;
-}
+// Order, in which the code lengths of the code length alphabet are stored (RFC 1951 3.2.7)
+const uint8 CODELENGTH_ORDER[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
 
-Inflater::Inflater(bool wrap): Object()
-{
-   mUncompBytes = nullptr;
-   Reset();
-   mWrap = wrap;
-}
+// A table entry holds in bits 0-7 the number of bits to consume, in bits 8-15 the operation and
+// in bits 16-31 the literal, the base value or the offset of the subtable.
+const uint32 OP_LITERAL = 0x00;
+const uint32 OP_BASE = 0x10;    // Low 4 bits: Number of extra bits
+const uint32 OP_END = 0x20;
+const uint32 OP_LINK = 0x40;    // Low 4 bits: Number of index bits of the subtable
+const uint32 OP_INVALID = 0x80;
 
-void Inflater::SetInput(uint8* buffer, size_t length)
+// Maximum length of a Huffman code
+const uint32 MAX_CODE_BITS = 15;
+
+// Maximum number of bits of a length/distance pair: 15 + 5 for the length, 15 + 13 for the distance
+const uint32 MAX_SYMBOL_BITS = 48;
+
+enum class HuffmanAlphabet
 {
-   mCompBytes = buffer;
-   mCompLength = length;
-   mCompIndex = 0;
-}
+   kCodeLengths,
+   kLiterals,
+   kDistances
+};
 
-bool Inflater::NeedsInput()
+static inline uint32 tableEntry(uint32 op, uint32 bits, uint32 value)
 {
-   return !mEof;
+   return (value << 16) | (op << 8) | bits;
 }
 
-bool Inflater::Finished()
+// Returns the table entry for a decoded symbol.
+static uint32 symbolEntry(HuffmanAlphabet alphabet, uint32 symbol, uint32 bits)
 {
-   return mEof;
+   switch(alphabet)
+   {
+      case HuffmanAlphabet::kCodeLengths:
+         return tableEntry(OP_LITERAL, bits, symbol);
+
+      case HuffmanAlphabet::kLiterals:
+         if(symbol < 256)return tableEntry(OP_LITERAL, bits, symbol);
+         if(symbol == 256)return tableEntry(OP_END, bits, 0);
+         if(symbol < 286)return tableEntry(OP_BASE | LENGTH_EXTRA[symbol - 257], bits,
+                                              LENGTH_OFFSET[symbol - 257]);
+         break;
+
+      case HuffmanAlphabet::kDistances:
+         if(symbol < 30)return tableEntry(OP_BASE | DIST_EXTRA[symbol], bits, DIST_OFFSET[symbol]);
+         break;
+   }
+   return tableEntry(OP_INVALID, bits, 0);
 }
 
-void Inflater::Inflate(uint8*& buffer, size_t& length)
+// Creates the decoding table for the canonical Huffman code given by the code lengths
+// (RFC 1951 3.2.2). Codes up to rootBits bits are resolved by the primary table, where a code is
+// repeated for all values of the unused high bits. Longer codes are stored in subtables, which are
+// placed behind the primary table and are sized for the longest code sharing the same prefix.
+static void buildHuffmanTable(HuffmanAlphabet alphabet,
+                              const uint8* lengths,
+                              uint32 count,
+                              uint32 rootBits,
+                              uint32* table,
+                              size_t size)
 {
-   mUncompIndex = 0;
+   // Count the number of codes for each code length.
+   uint16 blCount[MAX_CODE_BITS + 1] = {};
+   for(uint32 a = 0; a < count; a++)blCount[lengths[a]]++;
+   blCount[0] = 0;
 
-   // You are at the beginning of the stream. Read in ZLIB header (RFC1950)
-   if(mTotalIn == 0 && mWrap == false)
+   int32 left = 1;
+   uint32 maxBits = 0;
+   for(uint32 bits = 1; bits <= MAX_CODE_BITS; bits++)
    {
-      // Check compression header
-      if(mCompLength < 2)throw Exception("No compressed data found!");
-
-      //cmf: Compression Method and flag
-      //flg: Flags
-      uint8 cmf = mCompBytes[0];
-      uint8 flg = mCompBytes[1];
-
-      int8 compressionMethod = cmf & 0x0F;
-      int8 compressionInfo = (cmf >> 4) & 0x0F;
-      if(compressionMethod != 8)throw
-         Exception("Compression method must be deflate with 32k window. (" + String::valueOf(
-                      compressionMethod) + ")");
-      if(compressionInfo > 7)throw Exception("png window size is only for 32k implemented.");
-
-      //int8 fcheck = flg & 0x1F; Does not have to be calculated explicitly for decompression, as fcheck must be set so that the following check is successful.
-      int8 fdict = (flg >> 5) & 0x01;
-      // int8 flevel = ( flg >> 6 ) & 0x03; Not needed for decompression. For information purposes only
-      if(fdict != 0)throw Exception("Inflater need Dictionary. Currently not implemented.");
-
-      // Check Fcheck
-      uint16 check1 = cmf * 256 + flg;
-      uint16 check2 = check1 % 31;
-      if(check2 != 0)throw Exception("Wrong checksum for compressed zlib data stream");
-
-      // Prepare the read-in
-      mCompIndex = 2;
-      mTotalIn = 2;
-      mBit = 0;
+      left <<= 1;
+      left -= blCount[bits];
+      if(left < 0)throw Exception("Huffman code is over-subscribed.");
+      if(blCount[bits] > 0)maxBits = bits;
    }
 
+   // Only an empty code or a single code of one bit may be incomplete.
+   if(left > 0 && (alphabet == HuffmanAlphabet::kCodeLengths || maxBits > 1))
+      throw Exception("Huffman code is incomplete.");
 
-   inflate();
+   // Find the numerical value of the smallest code for each code length.
+   uint16 nextCode[MAX_CODE_BITS + 1] = {};
+   uint32 code = 0;
+   for(uint32 bits = 1; bits <= MAX_CODE_BITS; bits++)
+   {
+      code = (code + blCount[bits - 1]) << 1;
+      nextCode[bits] = static_cast<uint16>(code);
+   }
 
-   buffer = mUncompBytes;
-   length = mUncompIndex;
-}
+   // Assign the codes. The table is indexed LSB first, so the codes are stored bit reversed.
+   uint16 reversed[288];
+   uint8 longest[1 << 10] = {};
+   const uint32 rootSize = 1u << rootBits;
+   for(uint32 a = 0; a < count; a++)
+   {
+      const uint32 bits = lengths[a];
+      if(bits == 0)continue;
 
-void Inflater::Reset()
-{
-   mCompBytes = nullptr;
-   mCompLength = 0;
-   mCompIndex = 0;
-   mUncompBytes = nullptr;
-   mUncompBytes = new uint8[1024];
-   mUncompLength = 1024;
-   mUncompIndex = 0;
-   mTotalIn = 0;
-   mTotalOut = 0;
-   mBit = 0;
-   mLastBlock = false;
-   mEof = false;
+      uint32 value = nextCode[bits]++;
+      uint32 reverse = 0;
+      for(uint32 b = 0; b < bits; b++)
+      {
+         reverse = (reverse << 1) | (value & 1);
+         value >>= 1;
+      }
+      reversed[a] = static_cast<uint16>(reverse);
+
+      uint8& slot = longest[reverse & (rootSize - 1)];
+      if(bits > rootBits && bits > slot)slot = static_cast<uint8>(bits);
+   }
+
+   // Fill the primary table and link the subtables.
+   // Unused entries are given one bit, so that a lookup at the end of the input waits for data.
+   std::fill(table, table + rootSize, tableEntry(OP_INVALID, 1, 0));
+   size_t used = rootSize;
+   for(uint32 a = 0; a < rootSize; a++)
+   {
+      if(longest[a] == 0)continue;
+
+      const uint32 subBits = longest[a] - rootBits;
+      const size_t subSize = static_cast<size_t>(1) << subBits;
+      if(used + subSize > size)throw Exception("Huffman table overflow.");
+
+      table[a] = tableEntry(OP_LINK | subBits, rootBits, static_cast<uint32>(used));
+      std::fill(table + used, table + used + subSize, tableEntry(OP_INVALID, 1, 0));
+      used += subSize;
+   }
+
+   for(uint32 a = 0; a < count; a++)
+   {
+      const uint32 bits = lengths[a];
+      if(bits == 0)continue;
+
+      const uint32 reverse = reversed[a];
+      if(bits <= rootBits)
+      {
+         const uint32 entry = symbolEntry(alphabet, a, bits);
+         for(uint32 index = reverse; index < rootSize; index += 1u << bits)table[index] = entry;
+      }
+      else
+      {
+         const uint32 link = table[reverse & (rootSize - 1)];
+         uint32* sub = table + (link >> 16);
+         const uint32 subSize = 1u << ((link >> 8) & 0x0F);
+         const uint32 subBits = bits - rootBits;
+         const uint32 entry = symbolEntry(alphabet, a, subBits);
+         for(uint32 index = reverse >> rootBits; index < subSize; index += 1u << subBits)
+            sub[index] = entry;
+      }
+   }
 }
 
-size_t Inflater::GetRemaining()
+// Looks up the next symbol. The bit buffer must hold at least MAX_CODE_BITS bits, unless the input
+// ends before.
+static inline uint32 decodeSymbol(const uint32* table, uint32 rootBits, uint64 buffer)
 {
-   return mCompLength - mCompIndex;
+   uint32 entry = table[buffer & ((1u << rootBits) - 1)];
+   if((entry >> 8) & OP_LINK)
+   {
+      const uint64 subMask = (1u << ((entry >> 8) & 0x0F)) - 1;
+      entry = table[(entry >> 16) + ((buffer >> rootBits) & subMask)];
+      entry += rootBits;
+   }
+   return entry;
 }
 
-size_t Inflater::GetTotalIn()
+static inline uint64 loadLEUInt64(const uint8* bytes)
 {
-   return mTotalIn;
+   uint64 value = 0;
+   if constexpr(std::endian::native == std::endian::little)
+   {
+      memcpy(&value, bytes, 8);
+   }
+   else
+   {
+      for(size_t a = 8; a > 0; a--)value = (value << 8) | bytes[a - 1];
+   }
+   return value;
 }
 
-size_t Inflater::GetTotalOut()
+// Returns true, if the length/distance pair starting with the literal/length entry is complete
+// in the bit buffer.
+static bool symbolAvailable(uint64 buffer, uint32 count, uint32 entry, const uint32* distances,
+                            uint32 distanceBits)
 {
-   return mTotalOut;
-}
+   uint32 bits = entry & 0xFF;
+   const uint32 op = (entry >> 8) & 0xFF;
+   if(bits > count)return false;
+   if((op & OP_BASE) == 0)return true;
 
+   bits += op & 0x0F;
+   if(bits > count)return false;
 
-uint8 Inflater::nextBit()
-{
-   uint8 ret = ((0x01 << mBit) & mCompBytes[mCompIndex]) >> mBit;
+   const uint32 distance = decodeSymbol(distances, distanceBits, buffer >> bits);
+   bits += (distance & 0xFF) + ((distance >> 8) & 0x0F);
+   return bits <= count;
+}
 
-   mBit++;
-   if((mBit % 8) == 0)
+inline void Inflater::BitReader::refill()
+{
+   if(length - index >= 8)
    {
-      mBit = 0;
-      mCompIndex++;
-      mTotalIn++;
+      // Loads 8 bytes and keeps the whole bytes, which fit. Bits above "count" are either zero or
+      // already the bits of the next byte, so reloading them is harmless.
+      buffer |= loadLEUInt64(bytes + index) << count;
+      index += (63 - count) >> 3;
+      count |= 56;
+   }
+   else
+   {
+      while(count < 56 && index < length)
+      {
+         buffer |= static_cast<uint64>(bytes[index++]) << count;
+         count += 8;
+      }
    }
-   return ret;
 }
 
-void Inflater::skipByteBits()
+inline uint32 Inflater::BitReader::peek(uint32 bits) const
 {
-   if(mBit == 0)return;
-   mBit = 0;
-   mCompIndex++;
-   mTotalIn++;
+   return static_cast<uint32>(buffer & ((static_cast<uint64>(1) << bits) - 1));
 }
 
-uint8 Inflater::nextAlignedUInt8()
+inline void Inflater::BitReader::consume(uint32 bits)
 {
-   if(mBit != 0)throw Exception("Incorrect bit order for uint8!");
-   uint8 ret = mCompBytes[mCompIndex++];
-   mTotalIn++;
-   return ret;
+   if(bits > count)throw Exception("Unexpected end of compressed data.");
+   buffer >>= bits;
+   count -= bits;
 }
 
-uint16 Inflater::nextAlignedUInt16()
+inline uint32 Inflater::BitReader::take(uint32 bits)
 {
-   uint8 sub[2];
-   sub[0] = nextAlignedUInt8();
-   sub[1] = nextAlignedUInt8();
-
-   uint16 ret = deserializeLEUInt16(sub, 0);
+   const uint32 ret = peek(bits);
+   consume(bits);
    return ret;
 }
 
-uint16 Inflater::nextUIntX(uint8 bits)
+inline bool Inflater::BitReader::request(uint32 bits)
 {
-   uint16 ret = 0;
-   for(uint8 a = 0; a < bits; a++)
-   {
-      ret <<= 1;
-      ret |= nextBit();
-   }
-   return ret;
+   refill();
+   return count >= bits;
 }
 
-uint16 Inflater::nextUIntXR(uint8 bits)
+Inflater::Inflater(): Object()
 {
-   uint16 ret = 0;
-   for(uint8 a = 0; a < bits; a++)
-   {
-      ret |= (nextBit() << a);
-   }
-   return ret;
+   mWrap = false;
+   mWindow = new uint8[kWindowLimit + 258 + 8];
+   Reset();
 }
 
-void Inflater::checkCapacity()
+Inflater::Inflater(bool wrap): Object()
 {
-   if(mUncompIndex < mUncompLength)return;
-
-   // Increase
-   double ratio = mCompIndex / (double)mCompLength;
-   size_t newLength = mUncompLength + std::max(static_cast<size_t>(4096), static_cast<size_t>(mUncompLength / ratio));
-   uint8* tmp = new uint8[newLength];
-   if(tmp == nullptr)throw Exception("Cannot allocate memory!");
-   memcpy(tmp, mUncompBytes, mUncompIndex);
-   delete[] mUncompBytes;
-   mUncompBytes = tmp;
-   mUncompLength = newLength;
+   mWrap = wrap;
+   mWindow = new uint8[kWindowLimit + 258 + 8];
+   Reset();
 }
 
-void Inflater::writeUncompressed(uint8 byte)
+Inflater::~Inflater()
 {
-   checkCapacity();
-   mUncompBytes[mUncompIndex++] = byte;
-   mTotalOut++;
+   delete[] mWindow;
 }
 
-
-void Inflater::handleUncompressedBlock()
+void Inflater::SetInput(uint8* buffer, size_t length)
 {
-   //	std::cout << "UNCOMPRESSED BLOCK\n";
-
-   //read LEN and NLEN (see next section)
-   //copy LEN bytes of data to output
-   skipByteBits();
-   uint16 len = nextAlignedUInt16();
-   uint16 nlen = nextAlignedUInt16();//Komplement von len
-
-   if((nlen & len) != 0)throw Exception("Length of uncompressed block is corrupted.");
+   mTotalIn += mInput.index;
+
+   // Keep the bits of the previous chunk, but drop the look-ahead into it.
+   if(mInput.count < 64)mInput.buffer &= (static_cast<uint64>(1) << mInput.count) - 1;
+   mInput.bytes = buffer;
+   mInput.length = length;
+   mInput.index = 0;
+   mNeedsInput = false;
+}
 
-   for(int32 a = 0; a < len; a++)
-   {
-      uint8 b = nextAlignedUInt8();
-      writeUncompressed(b);
-   }
+bool Inflater::NeedsInput()
+{
+   // Loading the whole chunk into the bit buffer is not enough. The decoder may also have stopped
+   // at the window limit with symbols left in the buffer.
+   return mState != State::kFinished && mNeedsInput;
 }
 
+bool Inflater::Finished()
+{
+   return mState == State::kFinished && mWindowRead == mWindowEnd;
+}
 
-void Inflater::handleCompressedFixHuffman()
+void Inflater::Inflate(uint8*& buffer, size_t& length)
 {
-   //std::cout << "COMPRESSED BLOCK FIX HUFFMAN\n";
-   bool endOfBlock = false;
+   size_t capacity = std::max(static_cast<size_t>(1024), GetRemaining() * 4);
+   buffer = new uint8[capacity];
+   length = 0;
 
-   while(!endOfBlock)
+   try
    {
-      uint16 value = nextFixedHuffmanCode();
-
-      if(value < 256)
-      {
-         writeUncompressed((uint8) value);
-      }
-      else if(value == 256)
+      while(!Finished())
       {
-         endOfBlock = true;
-      }
-      else if(value >= 257 && value <= 285)
-      {
-         //Length
-         uint8 extrabits = LENGTH_EXTRA[value - 257];
-         uint16 length = nextUIntXR((uint8) extrabits);
-         length += LENGTH_OFFSET[value - 257];
-
-
-         //Distance
-
-         //Distance codes 0-31 are represented by (fixed-length) 5-bit
-         //codes, with possible additional bits as shown in the table
-         //shown in Paragraph 3.2.5, above.
-
-         uint16 code = nextUIntX(5);
-
-         extrabits = DIST_EXTRA[code];
-         uint16 distance = nextUIntXR(extrabits);
-         distance += DIST_OFFSET[code];
-
-         //move backwards distance bytes in the output
-         //stream, and copy length bytes from this
-         //position to the output stream.
-
-         int64 src = (mUncompIndex - distance) & 32767;
-         if(src < 0)throw Exception("Distance in fix hufmann refer before output stream beginning.");
-         for(int64 a = 0; a < length; a++)
+         if(length == capacity)
          {
-            writeUncompressed(mUncompBytes[src + a]);
-         }
-      }
-      else throw Exception("Code has unexpected value: " + String::valueOf(value));
+            // Increase. Estimate the total size from the compression ratio so far.
+            size_t newLength = capacity * 2;
+            if(mInput.index > 0)
+            {
+               const double ratio = static_cast<double>(mInput.length) /
+                                    static_cast<double>(mInput.index);
+               newLength = std::max(newLength, static_cast<size_t>(static_cast<double>(length) * ratio) + 4096);
+            }
 
+            uint8* tmp = new uint8[newLength];
+            memcpy(tmp, buffer, length);
+            delete[] buffer;
+            buffer = tmp;
+            capacity = newLength;
+         }
 
+         const size_t count = Inflate(buffer, length, capacity - length);
+         if(count == 0 && !Finished())throw Exception("Unexpected end of compressed data.");
+         length += count;
+      }
+   }
+   catch(Exception&)
+   {
+      delete[] buffer;
+      buffer = nullptr;
+      length = 0;
+      throw;
    }
 }
 
-Inflater::HuffmanTree* Inflater::createTree(Array<uint16>* lengths, Array<uint16>* codes)
+size_t Inflater::Inflate(uint8* buffer, size_t offset, size_t length)
 {
-   // Algorithm:
-   //1. Determine maximum number of bits
-   //2. Take all elements with the highest number of bits
-   //3. Sort the elements according to their size
-   //4. Remove (in the intermediate value) the last bit
-   //5. Combine the elements with the same intermediate value in a node
-   //   The "new" node has the intermediate value as code and the length is reduced by 1.
-   //6. Add the new element to the list
-   //7. Start at 2 until there is only one element left.
+   size_t count = 0;
 
-   // Create array with all codes and lengths to generate the tree
-   //1. Determine maxBits at the same time
-   std::vector<Inflater::HuffmanTree*> nodes;
-   int32 maxBits = 0;
-   for(size_t a = 0; a < lengths->size(); a++)
+   while(count < length)
    {
-      // Only insert the elements that exist (i.e. length>0)
-      if((*lengths)[a] != 0)
+      if(mWindowRead == mWindowEnd)
       {
-         HuffmanTree* node = new HuffmanTree();
-         node->length = (*lengths)[a];
-         node->symbol = a;
-         node->code = (*codes)[a];
-         nodes.push_back(node);
-
-         if(node->length > maxBits)maxBits = node->length;
-      }
-   }
-
-   do
-   {
-      if(maxBits < 0)throw Exception("Mööp");
+         if(mState == State::kFinished)break;
 
-      //2. Take all elements with the highest number of bits
-      std::vector<Inflater::HuffmanTree*> focus;
-      for(uint32 a = 0; a < nodes.size(); a++)
-      {
-         if(nodes[a]->length == maxBits)
+         // Slide the window. Only the last 32K are needed for the back references.
+         if(mWindowEnd >= kWindowLimit)
          {
-            focus.push_back(nodes[a]);
-            nodes.erase(nodes.begin() + a);
-            a--;
+            memmove(mWindow, mWindow + mWindowEnd - kWindowSize, kWindowSize);
+            mWindowEnd = kWindowSize;
+            mWindowRead = kWindowSize;
          }
-      }
 
+         inflate();
 
-      //3. Sort these elements according to the code
-      for(uint32 n = (uint32)focus.size(); n > 1; n--)
-      {
-         for(uint32 i = 0; i < n - 1; i++)
-         {
-            if(focus[i]->code > focus[i + 1]->code)
-            {
-               HuffmanTree* tmp = focus[i + 1];
-               focus[i + 1] = focus[i];
-               focus[i] = tmp;
-            }
-         }
-      }
-
-      // Check for duplicate entries
-      for(uint32 a = 1; a < focus.size(); a++)
-      {
-         if(focus[a - 1]->code == focus[a]->code)throw Exception("Mööp");
+         // No progress, more input is needed.
+         if(mWindowRead == mWindowEnd)break;
       }
 
-      //4. Remove bit in tmp
-      for(jm::Inflater::HuffmanTree* item:focus)
-      {
-         item->tmp = (item->code) >> 1;
-      }
+      const size_t size = std::min(mWindowEnd - mWindowRead, length - count);
+      memcpy(buffer + offset + count, mWindow + mWindowRead, size);
+      mWindowRead += size;
+      count += size;
+   }
 
-      while(focus.size() > 1)
-      {
-         HuffmanTree* n1 = focus[0];
-         HuffmanTree* n2 = focus[1];
-         if(n1->tmp == n2->tmp)
-         {
-            HuffmanTree* nn = new HuffmanTree();
-            nn->length = n1->length - 1;
-            nn->node0 = n1;
-            nn->node1 = n2;
-            nn->code = n1->tmp;
-            nodes.push_back(nn);
-
-            focus.erase(focus.begin());
-            focus.erase(focus.begin());
-         }
-         else
-         {
-            HuffmanTree* nn = new HuffmanTree();
-            nn->length = n1->length - 1;
+   mTotalOut += count;
+   return count;
+}
 
-            if((n1->tmp & 0x01) == 0)nn->node0 = n1;
-            else nn->node1 = n1;
-            nn->code = n1->tmp;
-            nodes.push_back(nn);
+void Inflater::Reset()
+{
+   mInput = BitReader();
+   mWindowRead = 0;
+   mWindowEnd = 0;
+   mTotalIn = 0;
+   mTotalOut = 0;
+   mState = mWrap ? State::kBlockHeader : State::kZlibHeader;
+   mNeedsInput = true;
+   mLastBlock = false;
+   mStoredLength = 0;
+   mLiteralCount = 0;
+   mDistanceCount = 0;
+   mCodeLengthCount = 0;
+   mCodeIndex = 0;
+   mLiterals = nullptr;
+   mDistances = nullptr;
+}
 
-            focus.erase(focus.begin());
-         }
-      }
+size_t Inflater::GetRemaining()
+{
+   return mInput.length - mInput.index;
+}
 
-      if(focus.size() == 1)
-      {
-         HuffmanTree* n1 = focus[0];
+size_t Inflater::GetTotalIn()
+{
+   return mTotalIn + mInput.index - (mInput.count >> 3);
+}
 
-         HuffmanTree* nn = new HuffmanTree();
-         nn->length = n1->length - 1;
+size_t Inflater::GetTotalOut()
+{
+   return mTotalOut;
+}
 
-         if((n1->tmp & 0x01) == 0)nn->node0 = n1;
-         else nn->node1 = n1;
+bool Inflater::readZlibHeader()
+{
+   // You are at the beginning of the stream. Read in ZLIB header (RFC1950)
+   if(!mInput.request(16))return false;
+
+   //cmf: Compression Method and flag
+   //flg: Flags
+   const uint32 cmf = mInput.take(8);
+   const uint32 flg = mInput.take(8);
+
+   const uint32 compressionMethod = cmf & 0x0F;
+   const uint32 compressionInfo = (cmf >> 4) & 0x0F;
+   if(compressionMethod != 8)throw
+      Exception("Compression method must be deflate with 32k window. (" + String::valueOf(
+                   compressionMethod) + ")");
+   if(compressionInfo > 7)throw Exception("png window size is only for 32k implemented.");
+
+   //fcheck = flg & 0x1F; Does not have to be calculated explicitly for decompression, as fcheck must be set so that the following check is successful.
+   const uint32 fdict = (flg >> 5) & 0x01;
+   // flevel = ( flg >> 6 ) & 0x03; Not needed for decompression. For information purposes only
+   if(fdict != 0)throw Exception("Inflater need Dictionary. Currently not implemented.");
+
+   // Check Fcheck
+   if((cmf * 256 + flg) % 31 != 0)throw Exception("Wrong checksum for compressed zlib data stream");
+
+   mState = State::kBlockHeader;
+   return true;
+}
 
-         nn->code = n1->tmp;
-         nodes.push_back(nn);
+bool Inflater::readBlockHeader()
+{
+   // The fixed Huffman codes (RFC 1951 3.2.6) never change, so the tables are created only once.
+   struct FixedTables
+   {
+      uint32 literals[1 << kLiteralBits];
+      uint32 distances[1 << kDistanceBits];
 
-         focus.erase(focus.begin());
+      FixedTables()
+      {
+         uint8 lengths[288];
+         std::fill(lengths, lengths + 144, 8);
+         std::fill(lengths + 144, lengths + 256, 9);
+         std::fill(lengths + 256, lengths + 280, 7);
+         std::fill(lengths + 280, lengths + 288, 8);
+         buildHuffmanTable(HuffmanAlphabet::kLiterals, lengths, 288, kLiteralBits, literals,
+                           1 << kLiteralBits);
+
+         std::fill(lengths, lengths + 32, 5);
+         buildHuffmanTable(HuffmanAlphabet::kDistances, lengths, 32, kDistanceBits, distances,
+                           1 << kDistanceBits);
       }
+   };
+   static const FixedTables fixed;
 
-      if(focus.size() != 0)throw Exception("Mööp");
-      maxBits--;
+   //Blockheader lesen
+   if(!mInput.request(3))return false;
+   const uint32 header = mInput.take(3);
+   if((header & 0x01) != 0)mLastBlock = true;
 
-   }
-   while(nodes.size() > 1);
+   switch(header >> 1)
+   {
+      //stored with no compression BTYPE = 00
+      case 0:
+         // Skip the remaining bits of the current byte.
+         mInput.consume(mInput.count & 0x07);
+         mState = State::kStoredHeader;
+         break;
 
-   return nodes[0];
+      // Compression with fixed Huffman codes (BTYPE=01)
+      case 1:
+         mLiterals = fixed.literals;
+         mDistances = fixed.distances;
+         mState = State::kCodes;
+         break;
+
+      case 2:
+         mState = State::kTableHeader;
+         break;
+
+      default:
+         throw Exception("Error in decompression process. Corrupt Block header");
+   }
+   return true;
 }
 
-
-// Reads the next Huffman value from the stream and returns the code
-uint16 Inflater::decodeHuffmanSymbol(Inflater::HuffmanTree* tree)
+bool Inflater::readStoredHeader()
 {
-   uint16 bits = 0;
-   uint16  ret = 0;
-
-   do
-   {
-      //Nächstes Bit einlesen
-      ret <<= 1;
-      ret |= nextBit();
-      bits++;
-
-      HuffmanTree* symbol = tree->Find(ret, bits);
+   //read LEN and NLEN (see next section)
+   if(!mInput.request(32))return false;
+   const uint32 len = mInput.take(16);
+   const uint32 nlen = mInput.take(16);//Komplement von len
 
-      if(symbol != nullptr)return symbol->symbol;
+   if((len ^ nlen) != 0xFFFF)throw Exception("Length of uncompressed block is corrupted.");
 
-   }
-   while(bits <= MAX_BITS);
-
-   throw Exception("No Huffman symbol found.");
+   mStoredLength = len;
+   mState = State::kStored;
+   return true;
 }
 
-//Erzeugt die Huffmancodes für eine gegebenes Array aus Codelängen
-Array<uint16>* Inflater::huffmanCodes(Array<uint16>* codelengths)
+bool Inflater::copyStored()
 {
-   //Größte Codelänge
-   MAX_BITS = 0;
-   for(uint32 a = 0; a < codelengths->size();
-         a++)MAX_BITS = (*codelengths)[a] > MAX_BITS ? (*codelengths)[a] : MAX_BITS;
-
-   uint16* blCount = new uint16[MAX_BITS + 1];
-   uint16* nextCode = new uint16[MAX_BITS + 1];
-   for(uint16 a = 0; a <= MAX_BITS; a++)
+   //copy LEN bytes of data to output
+   // The first bytes may still be in the bit buffer.
+   while(mStoredLength > 0 && mInput.count >= 8 && mWindowEnd < kWindowLimit)
    {
-      blCount[a] = 0;
-      nextCode[a] = 0;
+      mWindow[mWindowEnd++] = static_cast<uint8>(mInput.take(8));
+      mStoredLength--;
    }
 
-   //1. Zähle die Codelängen
-   // Count the number of codes for each code length.  Let
-   //    bl_count[N] be the number of codes of length N, N >= 1.
-   for(uint32 a = 0; a < codelengths->size(); a++)
+   if(mInput.count == 0)
    {
-      uint16 l = (*codelengths)[a];
-      blCount[l]++;
+      // The look-ahead bits are skipped together with the bytes.
+      mInput.buffer = 0;
+      const size_t size = std::min({static_cast<size_t>(mStoredLength), kWindowLimit - mWindowEnd,
+                                    mInput.length - mInput.index});
+      memcpy(mWindow + mWindowEnd, mInput.bytes + mInput.index, size);
+      mWindowEnd += size;
+      mInput.index += size;
+      mStoredLength -= static_cast<uint32>(size);
    }
 
-   //2. Kleinsten Wert finden
-   //  Find the numerical value of the smallest code for each
-   //    code length:
-
-   uint16 code = 0;
-   blCount[0] = 0;
-   for(uint16 bits = 1; bits <= MAX_BITS; bits++)
+   if(mStoredLength == 0)
    {
-      code = (code + blCount[bits - 1]) << 1;
-      nextCode[bits] = code;
+      mState = mLastBlock ? State::kFinished : State::kBlockHeader;
+      return true;
    }
 
-   //3)  Assign numerical values to all codes, using consecutive
-   //values for all codes of the same length with the base
-   //    values determined at step 2. Codes that are never used
-   //    (which have a bit length of zero) must not be assigned a
-   //    value.
+   // Either the window is full or the input is exhausted.
+   return mWindowEnd >= kWindowLimit;
+}
+
+bool Inflater::readTableHeader()
+{
+   //Lies die Längenangaben ein
+   if(!mInput.request(14))return false;
+   mLiteralCount = mInput.take(5) + 257;
+   mDistanceCount = mInput.take(5) + 1;
+   mCodeLengthCount = mInput.take(4) + 4;
+   if(mLiteralCount > 286 || mDistanceCount > 30)
+      throw Exception("Too many length or distance symbols.");
+
+   std::fill(mCodeLengths, mCodeLengths + 19, 0);
+   mCodeIndex = 0;
+   mState = State::kCodeLengthCodes;
+   return true;
+}
 
-   Array<uint16>* codes = new Array<uint16>(codelengths->size());
-   //for (int n = 0;  n <= codelengths->Length(); n++)
-   for(uint32 n = 0;  n < codelengths->size(); n++)
+bool Inflater::readCodeLengthCodes()
+{
+   //Einlesen der definierten Codelängen (3 Bit feste Breite)
+   while(mCodeIndex < mCodeLengthCount)
    {
-      int32 len = (*codelengths)[n];
-      if(len != 0)
-      {
-         (*codes)[n] = nextCode[len];
-         nextCode[len]++;
-      }
-      else(*codes)[n] = 0;
+      if(!mInput.request(3))return false;
+      mCodeLengths[CODELENGTH_ORDER[mCodeIndex++]] = static_cast<uint8>(mInput.take(3));
    }
 
-   //Aufräumen
-   delete [] blCount;
-   delete [] nextCode;
+   buildHuffmanTable(HuffmanAlphabet::kCodeLengths, mCodeLengths, 19, kCodeLengthBits,
+                     mCodeLengthTable, 1 << kCodeLengthBits);
 
-   return codes;
+   mCodeIndex = 0;
+   mState = State::kCodeLengths;
+   return true;
 }
 
-
-void Inflater::readLengthDists(Array<uint16>* target, Inflater::HuffmanTree* tree, size_t count)
+bool Inflater::readCodeLengths()
 {
-   size_t cnt = 0;
-
-   uint16 length;
-   uint16 repeat;
-
-   while(cnt < count)
+   // The code lengths of both alphabets form a single sequence, repetitions may cross from the
+   // literal/length codes into the distance codes.
+   const uint32 count = mLiteralCount + mDistanceCount;
+   while(mCodeIndex < count)
    {
-      length = decodeHuffmanSymbol(tree);
+      mInput.refill();
+      const uint32 entry = decodeSymbol(mCodeLengthTable, kCodeLengthBits, mInput.buffer);
+      const uint32 symbol = entry >> 16;
 
+      // Repetitions are followed by extra bits. Consume nothing, until all are available.
+      const uint32 extra = symbol < 16 ? 0 : (symbol == 16 ? 2 : (symbol == 17 ? 3 : 7));
+      if((entry & 0xFF) + extra > mInput.count)return false;
+      mInput.consume(entry & 0xFF);
 
-      switch(length)
+      if(symbol < 16)
+      {
+         mCodeLengths[mCodeIndex++] = static_cast<uint8>(symbol);
+         continue;
+      }
+
+      uint8 length = 0;
+      uint32 repeat;
+      switch(symbol)
       {
          //16: Copy the previous code length 3 - 6 times.
          case 16:
-            repeat = nextUIntXR(2) + 3;
-            for(uint16 a = 0; a < repeat; a++)
-            {
-               (*target)[cnt] = (*target)[cnt - 1];
-               cnt++;
-            }
+            if(mCodeIndex == 0)throw Exception("No previous code length to repeat.");
+            length = mCodeLengths[mCodeIndex - 1];
+            repeat = mInput.take(2) + 3;
             break;
 
          //17: Repeat a code length of 0 for 3 - 10 times.
          case 17:
-            repeat = nextUIntXR(3) + 3;
-            for(uint16 a = 0; a < repeat; a++)
-            {
-               (*target)[cnt] = 0;
-               cnt++;
-            }
+            repeat = mInput.take(3) + 3;
             break;
 
          //18: Repeat a code length of 0 for 11 - 138 times
-         case 18:
-            repeat = nextUIntXR(7) + 11;
-            for(uint16 a = 0; a < repeat; a++)
-            {
-               (*target)[cnt] = 0;
-               cnt++;
-            }
-            break;
-
          default:
-            (*target)[cnt] = length;
-            cnt++;
+            repeat = mInput.take(7) + 11;
             break;
       }
-   }
-
-}
-
 
-
-void Inflater::handleCompressedDynamicHuffman()
-{
-   //std::cout << "COMPRESSED BLOCK DYNAMIC HUFFMAN\n";
-
-   //Lies die Längenangaben ein
-   uint16 HLIT = nextUIntXR(5) + 257;
-   uint16 HDIST = nextUIntXR(5) + 1;
-   uint16 HCLEN = nextUIntXR(4) + 4;
-
-   //Positionierhilfe für die Codelängen
-   const uint16 CODELENTH_ALPHABET[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
-
-   //Codelängenarray erzeugen und Nullen
-   Array<uint16>* codelengths = new Array<uint16>(19);
-   for(uint32 a = 0; a < codelengths->size(); a++)(*codelengths)[a] = 0;
-
-   //Einlesen der definierten Codelängen (3 Bit feste Breite)
-   for(uint16 a = 0; a < HCLEN; a++)
-   {
-      uint16 codelength = nextUIntXR(3);
-      (*codelengths)[CODELENTH_ALPHABET[a]] = codelength;
+      if(mCodeIndex + repeat > count)throw Exception("Too many code lengths.");
+      std::fill(mCodeLengths + mCodeIndex, mCodeLengths + mCodeIndex + repeat, length);
+      mCodeIndex += repeat;
    }
 
-   //Erzeuge aus den Codelängen die HuffmanCodes
-   Array<uint16>* codes = huffmanCodes(codelengths);
+   if(mCodeLengths[256] == 0)throw Exception("Missing end-of-block code.");
 
-   HuffmanTree* intermediate = createTree(codelengths, codes);
+   buildHuffmanTable(HuffmanAlphabet::kLiterals, mCodeLengths, mLiteralCount, kLiteralBits,
+                     mLiteralTable, kLiteralTableSize);
+   buildHuffmanTable(HuffmanAlphabet::kDistances, mCodeLengths + mLiteralCount, mDistanceCount,
+                     kDistanceBits, mDistanceTable, kDistanceTableSize);
 
-   Array<uint16>* lengths2 = new Array<uint16>(HLIT);
-   readLengthDists(lengths2, intermediate, HLIT);
-
-   Array<uint16>* distances2 = new Array<uint16>(HDIST);
-   readLengthDists(distances2, intermediate, HDIST);
-
-   Array<uint16>* lengthcodes2 = huffmanCodes(lengths2);
-
-   Array<uint16>* distcodes2 = huffmanCodes(distances2);
-
-   //Workaround
-   MAX_BITS = 15;
-
-   HuffmanTree* htvallen = createTree(lengths2, lengthcodes2);
-   HuffmanTree* htdist = createTree(distances2, distcodes2);
+   mLiterals = mLiteralTable;
+   mDistances = mDistanceTable;
+   mState = State::kCodes;
+   return true;
+}
 
-   bool endOfBlock = false;
-   while(!endOfBlock)
+bool Inflater::decodeHuffmanBlock()
+{
+   // Work on local copies. Writing the output through a byte pointer would otherwise force the
+   // compiler to reload the members after every byte.
+   BitReader input = mInput;
+   const uint32* literals = mLiterals;
+   const uint32* distances = mDistances;
+   uint8* begin = mWindow;
+   uint8* out = begin + mWindowEnd;
+
+   // The window has room for one more match behind the limit.
+   uint8* limit = begin + kWindowLimit;
+   bool available = true;
+
+   while(out < limit)
    {
-      uint16 value ;
-
-      value = decodeHuffmanSymbol(htvallen);
-
-      if(value < 256)
+      // After a refill at least 56 bits are available, enough for a literal/length code, a
+      // distance code and their extra bits. Only at the end of the input, the symbol must be
+      // checked for completeness, before anything is consumed.
+      input.refill();
+
+      uint32 entry = decodeSymbol(literals, kLiteralBits, input.buffer);
+      if(input.count < MAX_SYMBOL_BITS &&
+            !symbolAvailable(input.buffer, input.count, entry, distances, kDistanceBits))
       {
-         writeUncompressed((uint8) value);
+         available = false;
+         break;
       }
-      else if(value == 256)
+
+      input.consume(entry & 0xFF);
+      uint32 op = (entry >> 8) & 0xFF;
+
+      if(op == OP_LITERAL)
       {
-         endOfBlock = true;
+         *out++ = static_cast<uint8>(entry >> 16);
       }
-      else if(value >= 257 && value <= 285)
+      else if(op & OP_BASE)
       {
-         //Length
-         uint8 extrabits = LENGTH_EXTRA[value - 257];
-         uint16 length = nextUIntXR(extrabits);
-         length += LENGTH_OFFSET[value - 257];
-
-         //Distance
-
-         //Distance codes 0-31 are represented by (fixed-length) 5-bit
-         //codes, with possible additional bits as shown in the table
-         //shown in Paragraph 3.2.5, above.
-
-         uint16 code = decodeHuffmanSymbol(htdist);
+         const size_t length = (entry >> 16) + input.take(op & 0x0F);
 
-         extrabits = DIST_EXTRA[code];
-         uint16 distance = nextUIntXR(extrabits);
-         distance += DIST_OFFSET[code];
+         entry = decodeSymbol(distances, kDistanceBits, input.buffer);
+         input.consume(entry & 0xFF);
+         op = (entry >> 8) & 0xFF;
+         if((op & OP_BASE) == 0)throw Exception("Invalid distance code.");
+         const size_t distance = (entry >> 16) + input.take(op & 0x0F);
 
          //move backwards distance bytes in the output
          //stream, and copy length bytes from this
          //position to the output stream.
+         if(distance > static_cast<size_t>(out - begin))
+            throw Exception("Distance refers before output stream beginning.");
 
-         size_t src = mUncompIndex - distance;
-         if(src < 0)throw Exception("Distance in fix hufmann refer before output stream beginning.");
-         for(uint16 a = 0; a < length; a++)
+         const uint8* src = out - distance;
+         uint8* stop = out + length;
+         if(distance >= 8)
+         {
+            // Copies in words. The window has some slack for the last word.
+            do
+            {
+               memcpy(out, src, 8);
+               out += 8;
+               src += 8;
+            }
+            while(out < stop);
+         }
+         else if(distance == 1)
          {
-            writeUncompressed(mUncompBytes[src + a]);
+            memset(out, *src, length);
          }
+         else
+         {
+            while(out < stop)*out++ = *src++;
+         }
+         out = stop;
       }
-      else Exception("Code has unexpected value: " + String::valueOf(value));
-
-
+      else if(op & OP_END)
+      {
+         mState = mLastBlock ? State::kFinished : State::kBlockHeader;
+         break;
+      }
+      else throw Exception("Code has unexpected value.");
    }
 
-   delete codelengths;
-   delete codes;
-   delete lengths2;
-   delete distances2;
-   delete lengthcodes2;
-   delete distcodes2;
-   delete intermediate;
-   delete htvallen;
-   delete htdist;
+   mInput = input;
+   mWindowEnd = static_cast<size_t>(out - begin);
+   return available;
 }
 
-
 void Inflater::inflate()
 {
-
-   do
+   bool progress = true;
+   while(progress && mWindowEnd < kWindowLimit && mState != State::kFinished)
    {
-      //Blockheader lesen
-      uint8 bfinal = nextBit();
-      uint8 btype = nextBit() + nextBit() * 2;
-      if(bfinal == 1)mLastBlock = true;
 
-      //stored with no compression BTYPE = 00
-      if(btype == 0)
+      switch(mState)
       {
-         handleUncompressedBlock();
-      }
-      // Compression with fixed Huffman codes (BTYPE=01)
-      else if(btype == 1)
-      {
-         handleCompressedFixHuffman();
-      }
-      else if(btype == 2)
-      {
-         handleCompressedDynamicHuffman();
-      }
-      else new Exception("Error in decompression process. Corrupt Block header");
+         case State::kZlibHeader:
+            progress = readZlibHeader();
+            break;
 
-   }
-   while(!mLastBlock);
+         case State::kBlockHeader:
+            progress = readBlockHeader();
+            break;
 
-   mEof = true;
-}
+         case State::kStoredHeader:
+            progress = readStoredHeader();
+            break;
 
-uint16 Inflater::nextFixedHuffmanCode()
-{
-   // Siehe RFC 1951 3.2.6
-   uint16 code = nextUIntX(7);
+         case State::kStored:
+            progress = copyStored();
+            break;
 
-   //Mit 7 Bit wird der Bereich 256-279 kodiert:
-   // (7 bit) 000 0000 - 001 0111 das entspricht (0 - 23 | 0x00 - 0x17 )
-   // 256 addieren ergibt den tatsächlichen Bereich -> 256 - 279 : +256 = +0x100
-   if(code <= 0x17)code += 0x100;
-   else
-   {
-      code <<= 1;
-      code |= nextBit();
-
-      if(code >= 0xC0
-            && code <= 0xC7)  // (8 bit) 1100 0000 - 1100 0111 ( 192 - 199 | 0xC0 - 0xC7 ) -> 280 - 287: +88 = +0x58
-         code += 0x58;
-      else if(code >= 0x30
-              && code <= 0xBF)  // (8 bit) 0011 0000 - 1011 1111 ( 48 - 191 | 0x30 - 0BF ) -> 0 - 143: -48 =-0x30
-         code -= 0x30;
-      else
-      {
-         code <<= 1;
-         code |= nextBit();
-         if(code >= 0x190
-               && code <= 0x1FF)  // (9 bit) 1 1001 0000 - 1 1111 1111 ( 400 - 511 | 0x190 - 0x1FF ) -> 144 - 255: -256 =-0x100
-            code -= 0x100;
-         else new Exception("Wrong code");
-      }
-   }
-   return code;
-}
+         case State::kTableHeader:
+            progress = readTableHeader();
+            break;
 
+         case State::kCodeLengthCodes:
+            progress = readCodeLengthCodes();
+            break;
 
-Inflater::HuffmanTree::HuffmanTree()
-{
-   node0 = nullptr; // If there is a sub-node and this bit is 0, the system branches to it
-   node1 = nullptr; // If there is a sub-node and this bit is 1, the system branches to it
-   symbol = 0;   // If there is no sub-node, then it is this node and the symbol must match
-   length = 0;   // Number of bits that are
-   code = 0;     // The code that belongs to this
-}
+         case State::kCodeLengths:
+            progress = readCodeLengths();
+            break;
 
-Inflater::HuffmanTree::~HuffmanTree()
-{
-   if(node0 != nullptr)delete node0;
-   if(node1 != nullptr)delete node1;
-}
+         case State::kCodes:
+            progress = decodeHuffmanBlock();
+            break;
 
+         case State::kFinished:
+            break;
+      }
+   }
 
-Inflater::HuffmanTree* Inflater::HuffmanTree::Find(uint16 _code, uint16 bits)
-{
-   // If it is this node, then give it back
-   if(length == bits && code == _code && node0 == nullptr && node1 == nullptr)return this;
+   if(!progress)mNeedsInput = true;
 
-   if(bits > this->length)
+   if(mState == State::kFinished)
    {
-      uint16 msk = 0x0001 << (bits - this->length - 1);
-      uint16 target = msk & _code;
-      if(target == 0 && this->node0 != nullptr)return this->node0->Find(_code, bits);
-      else if(target != 0 && this->node1 != nullptr)return this->node1->Find(_code, bits);
-      else new Exception("Huffman Tree Error");
+      // Give the unused whole bytes back, so the remaining input is exact.
+      mInput.index -= std::min(static_cast<size_t>(mInput.count >> 3), mInput.index);
+      mInput.buffer = 0;
+      mInput.count = 0;
    }
-
-   return nullptr;
 }
-
-
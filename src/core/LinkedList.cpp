@@ -33,17 +33,99 @@
 
 using namespace jm;
 
-jm::String LListElement::displayName() const
+//
+// LinkedListBase
+//
+
+LinkedListBase::LinkedListBase() noexcept: Object()
+{
+   mStart = nullptr;
+   mEnd = nullptr;
+   mCount = 0;
+}
+
+size_t LinkedListBase::size() const
+{
+   return mCount;
+}
+
+void LinkedListBase::link(LinkedListHook* item, LinkedListHook* before, UndoManager* um)
+{
+   insert(item, before);
+   if(um != nullptr)um->registerChange(new UndoChangeLink(this, item, before, true));
+}
+
+void LinkedListBase::unlink(LinkedListHook* item, UndoManager* um)
+{
+   LinkedListHook* before = item->listNext;
+   erase(item);
+
+   // The change may be deleted at once, if the UndoManager is not active.
+   if(um != nullptr)um->registerChange(new UndoChangeLink(this, item, before, false));
+   else dispose(item);
+}
+
+bool LinkedListBase::isLinked(const LinkedListHook* item) const
+{
+   return item->listOwner == this;
+}
+
+void LinkedListBase::dispose(LinkedListHook*)
+{
+}
+
+void LinkedListBase::linked(LinkedListHook*)
+{
+}
+
+void LinkedListBase::unlinked(LinkedListHook*)
+{
+}
+
+void LinkedListBase::insert(LinkedListHook* item, LinkedListHook* before)
+{
+   LinkedListHook* after = before != nullptr ? before->listPrev : mEnd;
+
+   item->listPrev = after;
+   item->listNext = before;
+   item->listOwner = this;
+
+   if(after != nullptr)after->listNext = item;
+   else mStart = item;
+
+   if(before != nullptr)before->listPrev = item;
+   else mEnd = item;
+
+   mCount++;
+   linked(item);
+}
+
+void LinkedListBase::erase(LinkedListHook* item)
 {
-   return "jm::LListElement";
+   LinkedListHook* prev = item->listPrev;
+   LinkedListHook* next = item->listNext;
+
+   if(prev != nullptr)prev->listNext = next;
+   else mStart = next;
+
+   if(next != nullptr)next->listPrev = prev;
+   else mEnd = prev;
+
+   item->listPrev = nullptr;
+   item->listNext = nullptr;
+   item->listOwner = nullptr;
+   mCount--;
+   unlinked(item);
 }
 
-LinkedList::LinkedList(Object* owner): Object()
+//
+// LinkedList
+//
+
+LinkedList::LinkedList(Object* owner): LinkedListBase()
 {
-   listStart = nullptr;
-   listEnd = nullptr;
    current = nullptr;
-   count = 0;
+   mIndexed = false;
    mOwner = owner;
    if(mOwner == nullptr)
    {
@@ -61,238 +143,177 @@ bool LinkedList::hasNext() const
    return current != nullptr;
 }
 
+LListElement* LinkedList::firstElement() const
+{
+   return static_cast<LListElement*>(mStart);
+}
+
 LListElement* LinkedList::nextElement()
 {
    LListElement* ret = current;
-   current = current->next;
+   current = current->next();
    return ret;
 }
 
+LListElement* LinkedList::findElement(const Object* data) const
+{
+   if(mIndexed)
+   {
+      LListElement* const* elem = mIndex.get(data);
+      return elem != nullptr ? *elem : nullptr;
+   }
+
+   for(LListElement* elem = firstElement(); elem != nullptr; elem = elem->next())
+   {
+      if(elem->data == data)return elem;
+   }
+   return nullptr;
+}
+
 Object* LinkedList::next()
 {
    Object* ret = current->data;
-   current = current->next;
+   current = current->next();
    return ret;
 }
 
 Object* LinkedList::first() const
 {
-   if(count == 0)return nullptr;
-   return listStart->data;
+   if(mCount == 0)return nullptr;
+   return firstElement()->data;
 }
 
 Object* LinkedList::last() const
 {
-   if(count == 0)return nullptr;
-   return listEnd->data;
+   if(mCount == 0)return nullptr;
+   return static_cast<LListElement*>(mEnd)->data;
 }
 
 void LinkedList::rewind()
 {
-   current = listStart;
+   current = firstElement();
 }
 
 void LinkedList::clear(UndoManager* um)
 {
-   if(um != nullptr)
-   {
-      while(listStart != nullptr)
-      {
-         LListElement* victim = listStart;
-         remove(victim, um); //Here undo magic is done
-      }
-   }
-   else
-   {
-      rewind();
-      while(hasNext())nextElement()->release();
-   }
-
-   listStart = nullptr;
-   listEnd = nullptr;
+   // Here undo magic is done
+   while(mStart != nullptr)unlink(mStart, um);
    current = nullptr;
-   count = 0;
 }
 
 void LinkedList::add(Object* data, UndoManager* um)
 {
-   LListElement* item = new LListElement();
-   if(um != nullptr)um->registerChange(item, reinterpret_cast<Object * *>(&(item->data)));
+   LListElement* item = mElements.create();
    item->data = data;
-   add(item, um);
+   link(item, nullptr, um);
 }
 
-void LinkedList::add(LListElement* item, UndoManager* um)
+void LinkedList::addBefore(const Object* addBeforeThis, Object* itemToAdd, UndoManager* um)
 {
-   if(um != nullptr)
-   {
-      um->registerChange(item, reinterpret_cast<Object**>(& (item->prev)));
-      if(listEnd != nullptr)um->registerChange(listEnd, reinterpret_cast<Object * *>(& (listEnd->next)));
-      if(listStart == nullptr)um->registerChange(this, reinterpret_cast<Object * *>(&listStart));
-      um->registerChange(this, reinterpret_cast<Object**>(&listEnd));
-      um->registerChange(this, &count);
-   }
-
-   item->prev = listEnd;
+   LListElement* before = findElement(addBeforeThis);
 
-   if(listEnd != nullptr)
+   if(before != nullptr)
    {
-      listEnd->next = item;
-      item->prev = listEnd;
+      LListElement* item = mElements.create();
+      item->data = itemToAdd;
+      link(item, before, um);
    }
+}
 
-   listEnd = item;
+Status LinkedList::remove(const Object* data, UndoManager* um)
+{
+   LListElement* elem = findElement(data);
+   if(elem == nullptr)return Status::eNotFound;
 
-   if(listStart == nullptr)
-   {
-      listStart = item;
-   }
-   count++;
+   if(current == elem)current = elem->next();
+   unlink(elem, um);
+   return Status::eOK;
 }
 
-void LinkedList::addBefore(const Object* addBeforeThis, Object* itemToAdd, UndoManager* um)
+void LinkedList::swapData(Object* data1, Object* data2, UndoManager* um)
 {
-   LListElement* before = nullptr;
+   LListElement* elem1 = nullptr;
+   LListElement* elem2 = nullptr;
 
-   rewind();
-   while(hasNext())
+   if(mIndexed)
    {
-      LListElement* elem = nextElement();
-      if(elem->data == addBeforeThis)
+      elem1 = findElement(data1);
+      elem2 = findElement(data2);
+   }
+   else
+   {
+      for(LListElement* elem = firstElement(); elem != nullptr; elem = elem->next())
       {
-         before = elem;
-         break;
+         if(elem->data == data1)elem1 = elem;
+         if(elem->data == data2)elem2 = elem;
+         if(elem1 != nullptr && elem2 != nullptr)break;
       }
    }
 
-   if(before != nullptr)
+   if(elem1 != nullptr && elem2 != nullptr)
    {
-      LListElement* item = new LListElement();
-      if(um != nullptr)um->registerChange(item, (Object* *) & (item->data));
-      item->data = itemToAdd;
-
-      addBefore(before, item, um);
+      swapElementData(elem1, elem2);
+      if(um != nullptr)um->registerChange(new UndoChangeSwapData(this, elem1, elem2));
    }
 }
 
-void LinkedList::addBefore(LListElement* addBeforeThis, LListElement* itemToAdd, UndoManager* um)
+void LinkedList::swapElementData(LListElement* item1, LListElement* item2)
 {
-   LListElement* addAfterThis = addBeforeThis->prev;
-
-   if(um != nullptr)
+   std::swap(item1->data, item2->data);
+   if(mIndexed)
    {
-      um->registerChange(itemToAdd, (Object**) & (itemToAdd->prev));
-      um->registerChange(itemToAdd, (Object**) & (itemToAdd->next));
-      if(listStart == addBeforeThis)um->registerChange(this, (Object* *)&listStart);
-      um->registerChange(addBeforeThis, (Object**) & (addBeforeThis->prev));
-      if(addBeforeThis->prev != nullptr)um->registerChange(addBeforeThis,
-               (Object* *) & (addAfterThis->next));
-      um->registerChange(this, &count);
+      mIndex.put(item1->data, item1);
+      mIndex.put(item2->data, item2);
    }
-
-   //Listenanfang anpassen
-   if(listStart == addBeforeThis)listStart = itemToAdd;
-
-   //ItemToAdd anpassen
-   itemToAdd->prev = addAfterThis;
-   itemToAdd->next = addBeforeThis;
-
-   //Vorgänger anpassen
-   if(addAfterThis != nullptr)addAfterThis->next = itemToAdd;
-
-   //Nachfolger anpassen
-   addBeforeThis->prev = itemToAdd;
-
-   //Zähler anpassen
-   count++;
 }
 
-
-Status LinkedList::remove(LListElement* element, UndoManager* um)
+bool LinkedList::contains(const Object* data) const
 {
-   LListElement* prev = element->prev;
-   LListElement* next = element->next;
-
-   if(um != nullptr)
-   {
-      if(prev != nullptr)um->registerChange(prev, (Object* *) & (prev->next));
-      if(next != nullptr)um->registerChange(next, (Object* *) & (next->prev));
-      if(listStart == element)um->registerChange(this, (Object* *) &listStart);
-      if(listEnd == element)um->registerChange(this, (Object* *) &listEnd);
-      um->registerChange(element, reinterpret_cast<Object**>(&element->prev));
-      um->registerChange(element, (Object**) & (element->next));
-      um->registerChange(this, &count);
-      um->registerRelease(element);
-   }
-
-   if(prev != nullptr)prev->next = next;
-   if(next != nullptr)next->prev = prev;
+   return findElement(data) != nullptr;
+}
 
-   if(listStart == element)
-   {
-      if(listStart->next != nullptr)listStart = listStart->next;
-      else listStart = nullptr;
-   }
+void LinkedList::setIndexed(bool indexed)
+{
+   if(indexed == mIndexed)return;
+   mIndexed = indexed;
+   mIndex = HashMap<const Object*, LListElement*>();
+   if(!indexed)return;
 
-   if(listEnd == element)
+   mIndex.reserve(mCount);
+   for(LListElement* elem = firstElement(); elem != nullptr; elem = elem->next())
    {
-      if(listEnd->prev != nullptr)listEnd = listEnd->prev;
-      else listEnd = nullptr;
+      mIndex.emplace(elem->data, elem);
    }
-
-   element->prev = nullptr;
-   element->next = nullptr;
-   element->release();
-   count--;
-
-   return Status::eOK;
 }
 
-
-Status LinkedList::remove(const Object* data, UndoManager* um)
+bool LinkedList::isIndexed() const
 {
-   rewind();
-   while(hasNext())
-   {
-      LListElement* elem = nextElement();
-      if(elem->data == data)
-      {
-         return remove(elem, um);
-      }
-   }
-
-   return Status::eNotFound;
+   return mIndexed;
 }
 
-size_t LinkedList::size() const
+Object* LinkedList::payload(LinkedListHook* item) const
 {
-   return count;
+   return static_cast<LListElement*>(item)->data;
 }
 
-void LinkedList::swapData(Object* data1, Object* data2, UndoManager* um)
+void LinkedList::dispose(LinkedListHook* item)
 {
-   LListElement* elem1 = nullptr;
-   LListElement* elem2 = nullptr;
+   mElements.destroy(static_cast<LListElement*>(item));
+}
 
-   rewind();
-   while(hasNext())
-   {
-      LListElement* elem = nextElement();
-      if(elem->data == data1)elem1 = elem;
-      if(elem->data == data2)elem2 = elem;
-      if(elem1 != nullptr && elem2 != nullptr)break;
-   }
+void LinkedList::linked(LinkedListHook* item)
+{
+   if(!mIndexed)return;
+   LListElement* elem = static_cast<LListElement*>(item);
+   mIndex.emplace(elem->data, elem);
+}
 
-   if(elem1 != nullptr && elem2 != nullptr)
-   {
-      if(um != nullptr)
-      {
-         um->registerChange(elem1, (Object**) & (elem1->data));
-         um->registerChange(elem2, (Object**) & (elem2->data));
-         elem1->data = data2;
-         elem2->data = data1;
-      }
-   }
+void LinkedList::unlinked(LinkedListHook* item)
+{
+   if(!mIndexed)return;
+   LListElement* elem = static_cast<LListElement*>(item);
+   LListElement** indexed = mIndex.get(elem->data);
+   if(indexed != nullptr && *indexed == elem)mIndex.remove(elem->data);
 }
 
 LinkedListIterator LinkedList::iterator() const
@@ -319,10 +340,10 @@ LinkedListIterator::LinkedListIterator(const LinkedList* list)
       count = 0;
       return;
    }
-   listStart = list->listStart;
-   listEnd = list->listEnd;
+   listStart = static_cast<LListElement*>(list->mStart);
+   listEnd = static_cast<LListElement*>(list->mEnd);
    current = listStart;
-   count = list->count;
+   count = list->mCount;
 }
 
 LinkedListIterator::LinkedListIterator(const LinkedListIterator& other)
@@ -343,7 +364,7 @@ Object* LinkedListIterator::next() noexcept
 {
    if(current == nullptr)return nullptr;
    Object* ret = current->data;
-   current = current->next;
+   current = current->next();
    return ret;
 }
 
@@ -617,13 +617,17 @@ CharArray MacRomanDecoder::decode(const char* cstring)
    while(cstring[length] != 0)length++;
 
    CharArray array = CharArray(length);
+   decode(cstring, length, array.buffer);
+   return array;
+}
 
+size_t MacRomanDecoder::decode(const char* cString, size_t length, Char* target)
+{
    for(size_t a = 0; a < length; a++)
    {
-      array.buffer[a] = decodeCharacter((uint8)cstring[a]);
+      target[a] = codepage[static_cast<uint8>(cString[a])];
    }
-
-   return array;
+   return length;
 }
 
 ByteArray MacRomanDecoder::encode(const CharArray& string)
@@ -0,0 +1,120 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+// Name:        MappedFile.cpp
+// Library:     Jameo Core Library
+// Purpose:     Read-only memory mapped files
+//
+// Author:      Uwe Runtemund (2026-today)
+// Modified by:
+// Created:     17.10.2026
+//
+// Copyright:   (c) 2026 Jameo Software, Germany. https://jameo.de
+//
+// Licence:     The MIT License
+//              Permission is hereby granted, free of charge, to any person obtaining a copy of this
+//              software and associated documentation files (the "Software"), to deal in the
+//              Software without restriction, including without limitation the rights to use, copy,
+//              modify, merge, publish, distribute, sublicense, and/or sell copies of the Software,
+//              and to permit persons to whom the Software is furnished to do so, subject to the
+//              following conditions:
+//
+//              The above copyright notice and this permission notice shall be included in all
+//              copies or substantial portions of the Software.
+//
+//              THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,
+//              INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A
+//              PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//              HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+//              CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE
+//              OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PrecompiledCore.hpp"
+
+#if defined(__APPLE__) || defined(JM_LINUX) || defined(JM_ANDROID)
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+
+using namespace jm;
+
+MappedFile::MappedFile(): Object(),
+   mData(nullptr),
+   mSize(0)
+{}
+
+MappedFile::~MappedFile()
+{
+   unmap();
+}
+
+Status MappedFile::map(const File& file)
+{
+   unmap();
+   if(!file.exists())return Status::eNotFound;
+
+#if defined(__APPLE__) || defined(JM_LINUX) || defined(JM_ANDROID)
+
+   const ByteArray path = file.absolutePath().toCString();
+   const int handle = ::open(path.constData(), O_RDONLY);
+   if(handle < 0)return Status::eError;
+
+   struct stat filestat;
+   if(fstat(handle, &filestat) != 0 || filestat.st_size <= 0)
+   {
+      ::close(handle);
+      return Status::eError;
+   }
+
+   const size_t size = static_cast<size_t>(filestat.st_size);
+   void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, handle, 0);
+
+   // The mapping stays valid after closing the file.
+   ::close(handle);
+   if(data == MAP_FAILED)return Status::eError;
+
+#elif defined JM_WINDOWS
+
+   uint16* path = file.absolutePath().toWString();
+   HANDLE handle = CreateFileW(reinterpret_cast<LPCWSTR>(path), GENERIC_READ, FILE_SHARE_READ,
+                               nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+   delete[] path;
+   if(handle == INVALID_HANDLE_VALUE)return Status::eError;
+
+   LARGE_INTEGER fileSize;
+   if(!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart <= 0)
+   {
+      CloseHandle(handle);
+      return Status::eError;
+   }
+
+   const size_t size = static_cast<size_t>(fileSize.QuadPart);
+   HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+   CloseHandle(handle);
+   if(mapping == nullptr)return Status::eError;
+
+   // The view keeps the mapping alive after closing its handle.
+   void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+   CloseHandle(mapping);
+   if(data == nullptr)return Status::eError;
+
+#endif
+
+   mData = static_cast<const uint8*>(data);
+   mSize = size;
+   return Status::eOK;
+}
+
+void MappedFile::unmap()
+{
+   if(mData == nullptr)return;
+
+#if defined(__APPLE__) || defined(JM_LINUX) || defined(JM_ANDROID)
+   munmap(const_cast<uint8*>(mData), mSize);
+#elif defined JM_WINDOWS
+   UnmapViewOfFile(mData);
+#endif
+
+   mData = nullptr;
+   mSize = 0;
+}
@@ -94,6 +94,16 @@ Matrix::Matrix(const Matrix& other)
    }
 }
 
+Matrix::Matrix(Matrix&& other) noexcept:
+   m(other.m),
+   n(other.n),
+   data(other.data)
+{
+   other.m = 0;
+   other.n = 0;
+   other.data = nullptr;
+}
+
 Matrix::Matrix(const Matrix* other)
 {
    if(other==nullptr)
@@ -519,7 +529,7 @@ double Matrix::trace() const
 
 Vector Matrix::eigen() const
 {
-   if(m != n)throw Exception(Tr("Matrix must be square"));
+   if(m != n)throw Exception(TrLiteral("Matrix must be square"));
 
    // See: https://en.wikipedia.org/wiki/Eigenvalue_algorithm
 
@@ -590,7 +600,7 @@ Vector Matrix::eigen() const
       return v;
    }
 
-   throw Exception(Tr("Matrix is greater than 3x3"));
+   throw Exception(TrLiteral("Matrix is greater than 3x3"));
 }
 
 void Matrix::initIdentity()
@@ -906,6 +916,20 @@ namespace jm
 
       return *this;
    }
+
+   Matrix& Matrix::operator=(Matrix&& A) noexcept
+   {
+      if(this == &A) return *this;
+      if(data != nullptr)delete[] data;
+      m = A.m;
+      n = A.n;
+      data = A.data;
+      A.m = 0;
+      A.n = 0;
+      A.data = nullptr;
+
+      return *this;
+   }
 }
 
 Vertex3 jm::operator*(Matrix const& A, Vertex3 const& b)
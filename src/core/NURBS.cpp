@@ -54,9 +54,10 @@ Nurbs::Nurbs(uint32 degree,
              const double* weights,
              size_t weightCount): Object()
 {
-   if(degree < 1)throw Exception(Tr("Degree of NURBS must be greater 0."));
-   if(knotCount <= degree)throw Exception(Tr("Knot count of NURBS must be greater than degree."));
-   if(controlCount <= degree)throw Exception(Tr("Control point count of NURBS must be greater than degree."));
+   if(degree < 1)throw Exception(TrLiteral("Degree of NURBS must be greater 0."));
+   if(knotCount <= degree)
+      throw Exception(TrLiteral("Knot count of NURBS must be greater than degree."));
+   if(controlCount <= degree)throw Exception(TrLiteral("Control point count of NURBS must be greater than degree."));
 
    mDegree = degree;
 
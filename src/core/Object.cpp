@@ -41,22 +41,29 @@ Object::Object() noexcept:
    //mRefCount=2;
 }
 
+Object::Object(const Object&) noexcept:
+   mRefCount(1),
+   mPool(System::autoreleasePool())
+{
+}
+
 Object::~Object() noexcept
 {
    mPool = nullptr;
 }
 
+Object& Object::operator=(const Object&) noexcept
+{
+   return *this;
+}
+
 void Object::release() noexcept
 {
    if(mPool == nullptr)return;
 
-   int32 count;
-   Mutex* mutex = mPool->mutex();
-
-   mutex->lock();
-   mRefCount--;
-   count = referenceCount();
-   mutex->unlock();
+   // fetch_sub() returns the previous value. Acquire-release ordering ensures that all writes to
+   // the object of other threads are visible before the object is deleted.
+   int32 count = (mRefCount.fetch_sub(1, std::memory_order_acq_rel) - 1) & 0x7FFFFFFF;
 
    if(count == 0)
    {
@@ -70,22 +77,22 @@ void Object::release() noexcept
 
 Object* Object::retain() noexcept
 {
-   Mutex* mutex = mPool->mutex();
-   mutex->lock();
-   mRefCount++;
-   mutex->unlock();
+   // A new reference can only be created from an existing one, so no ordering is needed here.
+   mRefCount.fetch_add(1, std::memory_order_relaxed);
    return this;
 }
 
 Object* Object::autorelease() noexcept
 {
-   mPool->add(this);
+   // The object is added to the current pool of the calling thread, which is not necessarily the
+   // pool of the thread which created the object.
+   System::autoreleasePool()->add(this);
    return this;
 }
 
 int32 Object::referenceCount() const noexcept
 {
-   return mRefCount & 0x7FFFFFFF;
+   return mRefCount.load(std::memory_order_relaxed) & 0x7FFFFFFF;
 }
 
 bool Object::equals(const Object*) const
@@ -105,10 +112,12 @@ void Object::printDiffInfo(DiffOperation, Object*) const
 
 void Object::setHighBit(bool status) noexcept
 {
-   mRefCount = referenceCount() | static_cast<int32>(status ? 0x80000000 : 0x00000000);
+   // Only the flag is modified, so concurrent retain() and release() calls are not lost.
+   if(status)mRefCount.fetch_or(static_cast<int32>(0x80000000), std::memory_order_relaxed);
+   else mRefCount.fetch_and(0x7FFFFFFF, std::memory_order_relaxed);
 }
 
 bool Object::highBit()const noexcept
 {
-   return (mRefCount & static_cast<int32>(0x80000000)) != 0;
+   return (mRefCount.load(std::memory_order_relaxed) & static_cast<int32>(0x80000000)) != 0;
 }
@@ -20,14 +20,10 @@ using namespace jm;
 
 PaintingBackend::PaintingBackend(): Object()
 {
-   mTransformstack = new std::vector<Matrix>();
-   mBuffer = new std::vector<BufferElement>();
 }
 
 PaintingBackend::~PaintingBackend()
 {
-   delete mTransformstack;
-   delete mBuffer;
 }
 
 
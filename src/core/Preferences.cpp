@@ -33,21 +33,14 @@
 
 using namespace jm;
 
-Preferences::Preferences(): Hashtable()
+Preferences::Preferences(): Object(),
+   mValues()
 {
 }
 
 
 Preferences::~Preferences()
 {
-   Iterator* i = keys();
-   while(i->hasNext())
-   {
-      const String* s = static_cast<String*>(i->next());
-      String* p = static_cast<String*>(get(*s));
-      delete p;
-   }
-   delete i;
 }
 
 
@@ -125,18 +118,16 @@ void Preferences::save(File file)
       Status status = file.open(FileMode::kWrite);
       if(status != Status::eOK)
       {
-         jm::System::log(Tr("cannot store preferences in '%1'").arg(file.absolutePath()), jm::LogLevel::kError);
+         jm::System::log(TrLiteral("cannot store preferences in '%1'").arg(file.absolutePath()), jm::LogLevel::kError);
          return;
       }
 
-      Iterator* keyiter = keys();
-
       jm::StringList entries;
 
-      while(keyiter->hasNext())
+      mValues.forEach([&entries](const String & key, const String & text)
       {
-         String key = *static_cast<String*>(keyiter->next());
-         String val = value(key);
+         String line = key;
+         String val = text;
 
          //Ersetzungen
          //Ersetze
@@ -160,13 +151,12 @@ void Preferences::save(File file)
          }
 
          //Zeile bilden
-         key.append('=');
-         key.append(val);
-         key.append(String::lineSeparator());
+         line.append('=');
+         line.append(val);
+         line.append(String::lineSeparator());
 
-         entries.append(key);
-      }
-      delete keyiter;
+         entries.append(line);
+      });
 
       // sort the entries, so that the file is better readablye by humans
       entries.sort();
@@ -182,24 +172,28 @@ void Preferences::save(File file)
    catch(Exception& e)
    {
       e.printStackTrace();
-      System::log(Tr("Cannot save property file: %1").arg(file.absolutePath()), LogLevel::kError);
+      System::log(TrLiteral("Cannot save property file: %1").arg(file.absolutePath()),
+                  LogLevel::kError);
    }
 }
 
 bool Preferences::hasValue(const String& key)const
 {
-   return get(key) != nullptr;
+   return mValues.containsKey(key);
 }
 
-void Preferences::setValue(const String& key, const String& value)
+String Preferences::escapeLineBreaks(const String& value)
 {
    String tmp = value;
    tmp = tmp.replace("\r\n", "\\n");
    tmp = tmp.replace("\r", "\\n");
    tmp = tmp.replace("\n", "\\n");
-   String* actual = new String(tmp);
-   String* old = static_cast<String*>(put(key, actual));
-   if(old != nullptr)delete old;
+   return tmp;
+}
+
+void Preferences::setValue(const String& key, const String& value)
+{
+   mValues.put(key, escapeLineBreaks(value));
 }
 
 void Preferences::setValue(const String& key, int64 value)
@@ -219,16 +213,14 @@ void Preferences::setValue(const String& key, bool value)
 
 String Preferences::value(const String& key) const
 {
-   const String* result = (String*)get(key);
-   if(result == nullptr)return kEmptyString;
-   return *result;
+   return mValues.value(key, kEmptyString);
 }
 
 String Preferences::value(const String& key, String const& defaultValue) const
 {
-   const String* result = static_cast<String*>(get(key));
-   if(result == nullptr || result->isEmpty())return defaultValue;
-   return *result;
+   String result;
+   if(!mValues.get(key, result) || result.isEmpty())return defaultValue;
+   return result;
 }
 
 int64 Preferences::valueInt(const String& key, int64 defaultValue) const
@@ -273,3 +265,44 @@ bool Preferences::valueBool(const String& key, bool defaultValue) const
 
    return result.equals("true");
 }
+
+void Preferences::reserve(size_t count)
+{
+   mValues.reserve(count);
+}
+
+size_t Preferences::size() const
+{
+   return mValues.size();
+}
+
+bool Preferences::isEmpty() const
+{
+   return mValues.isEmpty();
+}
+
+bool Preferences::containsKey(const String& key) const
+{
+   return mValues.containsKey(key);
+}
+
+bool Preferences::remove(const String& key)
+{
+   return mValues.remove(key);
+}
+
+void Preferences::clear()
+{
+   mValues.clear();
+}
+
+StringList Preferences::keys() const
+{
+   StringList result;
+   mValues.forEach([&result](const String & key, const String&)
+   {
+      result.append(key);
+   });
+   result.sort();
+   return result;
+}
@@ -45,7 +45,7 @@ Property::Property()
 Property::Property(const String& id)
 {
    mReadOnly = false;
-   mId = id;
+   mId = Atom(id);
    mNumberValue.intValue = 0;
    mChangeMode = PropertyChangeMode::kItself;
    mAllowEmpty = true;
@@ -62,7 +62,7 @@ Property::Property(const String& id,
                    PropertyChangeMode changeMode,
                    bool allowEmpty)
 {
-   mId = id;
+   mId = Atom(id);
    mGroup = group;
    mName = name;
    mHint = hint;
@@ -76,7 +76,12 @@ Property::Property(const String& id,
 
 bool Property::is(const String& id)const
 {
-   return mId.equals(id);
+   return mId.string().equals(id);
+}
+
+bool Property::is(const Atom& id)const
+{
+   return mId == id;
 }
 
 PropertyType Property::type() const
@@ -91,7 +96,7 @@ void Property::setType(PropertyType type)
 
 const String& Property::id() const
 {
-   return mId;
+   return mId.string();
 }
 
 const String& Property::name() const
@@ -226,7 +231,7 @@ bool jm::operator==(Property const& v1, Property const& v2)
    // Actually we do not check mType, because if values are equal, but type different
    // (like for compoboxes), they are supposed to be equal anyway.
 
-   if(v1.mId.equals(v2.mId) == false)return false;
+   if(v1.mId != v2.mId)return false;
    if(v1.mEditor.equals(v2.mEditor) == false)return false;
 
    if(v1.type() == PropertyType::kValue)
@@ -269,7 +274,7 @@ bool jm::operator==(Property const& v1, Property const& v2)
    {
       return v1.stringValue().equals(v2.stringValue());
    }
-   System::log(Tr("Property not comparable"), LogLevel::kDebug);
+   System::log(TrLiteral("Property not comparable"), LogLevel::kDebug);
    return false;
 }
 
@@ -143,3 +143,8 @@ bool Resource::exists() const
    }
    return false;
 }
+
+const File* Resource::file() const
+{
+   return dynamic_cast<const File*>(mStream);
+}
@@ -35,40 +35,22 @@ using namespace jm;
 
 SAXAttributes::SAXAttributes(): Object()
 {
-   mNames = new std::vector<String>();
-   mValues = new std::vector<String>();
 }
 
 SAXAttributes::~SAXAttributes()
 {
-   delete mNames;
-   delete mValues;
 }
 
-SAXAttributes::SAXAttributes(const SAXAttributes& other)
+SAXAttributes::SAXAttributes(const SAXAttributes& other): Object(),
+   mNames(other.mNames),
+   mValues(other.mValues)
 {
-   mNames->clear();
-   mValues->clear();
-
-   for(size_t a = 0; a < other.mNames->size(); a++)
-   {
-      mNames->push_back(other.mNames->at(a));
-      mValues->push_back(other.mValues->at(a));
-   }
 }
 
 SAXAttributes& SAXAttributes::operator=(const SAXAttributes& other)
 {
-   if(this == &other) return *this;
-   mNames->clear();
-   mValues->clear();
-
-   for(size_t a = 0; a < other.mNames->size(); a++)
-   {
-      mNames->push_back(other.mNames->at(a));
-      mValues->push_back(other.mValues->at(a));
-   }
-
+   mNames = other.mNames;
+   mValues = other.mValues;
    return *this;
 
 }
@@ -79,15 +61,25 @@ void SAXAttributes::addAttribute(const String& /*uri*/,
                                  const String& value)
 {
    //	std::cout << "Add Attrib: " << localname << " " << value << std::endl;
-   mNames->push_back(localname);
-   mValues->push_back(value);
+   mNames.append(localname);
+   mValues.append(value);
 }
 
 size_t SAXAttributes::indexOf(const String& qName) const
 {
-   for(size_t a = 0; a < mNames->size(); a++)
+   for(size_t a = 0; a < mNames.size(); a++)
+   {
+      if(mNames[a].equals(qName))return a;
+   }
+
+   return npos;
+}
+
+size_t SAXAttributes::indexOf(const Atom& qName) const
+{
+   for(size_t a = 0; a < mNames.size(); a++)
    {
-      if(mNames->at(a).equals(qName))return a;
+      if(mNames[a].equals(qName.string()))return a;
    }
 
    return npos;
@@ -101,17 +93,21 @@ size_t SAXAttributes::indexOf(const String& /*uri*/,
 
 size_t SAXAttributes::count() const
 {
-   return mNames->size();
+   return mNames.size();
 }
 
 String SAXAttributes::localName(size_t index) const
 {
-   return mNames->at(index);
+   if(index >= mNames.size())
+      throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
+   return mNames[index];
 }
 
 String SAXAttributes::qualifiedName(size_t index) const
 {
-   return mNames->at(index);
+   if(index >= mNames.size())
+      throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
+   return mNames[index];
 }
 
 String SAXAttributes::type(size_t /*index*/) const
@@ -137,13 +133,22 @@ String SAXAttributes::uri(size_t /*index*/) const
 
 String SAXAttributes::value(size_t index) const
 {
-   return mValues->at(index);
+   if(index >= mNames.size())
+      throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
+   return mValues[index];
 }
 
 String SAXAttributes::value(const String& qname) const
 {
    size_t index = indexOf(qname);
-   if(index != npos)return mValues->at(index);
+   if(index != npos)return mValues[index];
+   return kEmptyString;
+}
+
+String SAXAttributes::value(const Atom& qname) const
+{
+   size_t index = indexOf(qname);
+   if(index != npos)return mValues[index];
    return kEmptyString;
 }
 
@@ -175,9 +180,14 @@ bool SAXAttributes::hasValue(const String& qname) const
    return false;
 }
 
+bool SAXAttributes::hasValue(const Atom& qname) const
+{
+   return indexOf(qname) != npos;
+}
+
 String SAXAttributes::value(const String& uri,const String& localName) const
 {
    size_t index = indexOf(uri, localName);
-   if(index != npos)return mValues->at(index);
+   if(index != npos)return mValues[index];
    return kEmptyString;
 }
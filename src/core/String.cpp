@@ -31,68 +31,414 @@
 
 #include "PrecompiledCore.hpp"
 
+#if defined(JM_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 using namespace jm;
 
+//
+// Search primitives over the UTF-16 units. With SSE2 8 units are compared at once, the
+// substring search compares the first and the last character of the pattern at 8 positions at
+// once and only verifies the candidates.
+//
+namespace
+{
+   //! Returns the index of the lowest set bit. \p mask must not be 0.
+   inline uint32 lowestBit(uint32 mask)
+   {
+      #if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanForward(&index, mask);
+      return static_cast<uint32>(index);
+      #else
+      return static_cast<uint32>(__builtin_ctz(mask));
+      #endif
+   }
+
+   //! Returns the index of the highest set bit. \p mask must not be 0.
+   inline uint32 highestBit(uint32 mask)
+   {
+      #if defined(_MSC_VER)
+      unsigned long index;
+      _BitScanReverse(&index, mask);
+      return static_cast<uint32>(index);
+      #else
+      return 31 - static_cast<uint32>(__builtin_clz(mask));
+      #endif
+   }
+
+   //! Returns the number of set bits.
+   inline uint32 bitCount(uint32 mask)
+   {
+      #if defined(_MSC_VER)
+      return static_cast<uint32>(__popcnt(mask));
+      #else
+      return static_cast<uint32>(__builtin_popcount(mask));
+      #endif
+   }
+
+   #if defined(JM_SSE2)
+   //! Returns a mask with 2 bits for every unit of \p data[0..7], which equals \p pattern.
+   inline uint32 matchMask(const Char* data, __m128i pattern)
+   {
+      __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+      return static_cast<uint32>(_mm_movemask_epi8(_mm_cmpeq_epi16(units, pattern)));
+   }
+   #endif
+
+   size_t findChar(const Char* data, size_t length, Char character)
+   {
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      const __m128i pattern = _mm_set1_epi16(static_cast<int16>(character.unicode()));
+      for(; index + 8 <= length; index += 8)
+      {
+         uint32 mask = matchMask(data + index, pattern);
+         if(mask != 0)return index + lowestBit(mask) / 2;
+      }
+      #endif
+
+      for(; index < length; index++)
+      {
+         if(data[index] == character)return index;
+      }
+      return npos;
+   }
+
+   //! Searches backwards in \p data[0..length-1].
+   size_t findCharReverse(const Char* data, size_t length, Char character)
+   {
+      size_t index = length;
+
+      #if defined(JM_SSE2)
+      const __m128i pattern = _mm_set1_epi16(static_cast<int16>(character.unicode()));
+      while(index >= 8)
+      {
+         index -= 8;
+         uint32 mask = matchMask(data + index, pattern);
+         if(mask != 0)return index + highestBit(mask) / 2;
+      }
+      #endif
+
+      while(index > 0)
+      {
+         index--;
+         if(data[index] == character)return index;
+      }
+      return npos;
+   }
+
+   size_t countChar(const Char* data, size_t length, Char character)
+   {
+      size_t count = 0;
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      const __m128i pattern = _mm_set1_epi16(static_cast<int16>(character.unicode()));
+      for(; index + 8 <= length; index += 8)
+      {
+         count += bitCount(matchMask(data + index, pattern)) / 2;
+      }
+      #endif
+
+      for(; index < length; index++)
+      {
+         if(data[index] == character)count++;
+      }
+      return count;
+   }
+
+   //! Returns the index of the first unit, which equals one of the \p setLength \p set units.
+   size_t findAny(const Char* data, size_t length, const Char* set, size_t setLength)
+   {
+      if(setLength == 0)return npos;
+      if(setLength == 1)return findChar(data, length, set[0]);
+
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      if(setLength <= 8)
+      {
+         __m128i patterns[8];
+         for(size_t a = 0; a < setLength; a++)
+         {
+            patterns[a] = _mm_set1_epi16(static_cast<int16>(set[a].unicode()));
+         }
+
+         for(; index + 8 <= length; index += 8)
+         {
+            __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+            __m128i hits = _mm_cmpeq_epi16(units, patterns[0]);
+            for(size_t a = 1; a < setLength; a++)
+            {
+               hits = _mm_or_si128(hits, _mm_cmpeq_epi16(units, patterns[a]));
+            }
+            uint32 mask = static_cast<uint32>(_mm_movemask_epi8(hits));
+            if(mask != 0)return index + lowestBit(mask) / 2;
+         }
+      }
+      #endif
+
+      for(; index < length; index++)
+      {
+         for(size_t a = 0; a < setLength; a++)
+         {
+            if(data[index] == set[a])return index;
+         }
+      }
+      return npos;
+   }
+
+   //
+   // Hash function over the bytes of the UTF-16 units. It follows wyhash (final version 4) by
+   // Wang Yi, which is released into the public domain.
+   //
+   const uint64 kSecret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                              0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL
+                             };
+
+   inline uint64 read8(const uint8* data)
+   {
+      uint64 value;
+      memcpy(&value, data, 8);
+      return value;
+   }
+
+   inline uint64 read4(const uint8* data)
+   {
+      uint32 value;
+      memcpy(&value, data, 4);
+      return value;
+   }
+
+   //! Multiplies \p a and \p b to 128 bits. \p a gets the low, \p b the high 64 bits.
+   inline void multiply(uint64& a, uint64& b)
+   {
+      #if defined(__SIZEOF_INT128__)
+      __extension__ typedef unsigned __int128 uint128;
+      uint128 product = static_cast<uint128>(a) * b;
+      a = static_cast<uint64>(product);
+      b = static_cast<uint64>(product >> 64);
+      #elif defined(_MSC_VER) && defined(_M_X64)
+      a = _umul128(a, b, &b);
+      #else
+      uint64 ha = a >> 32, hb = b >> 32, la = static_cast<uint32>(a), lb = static_cast<uint32>(b);
+      uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+      uint64 t = rl + (rm0 << 32);
+      uint64 c = t < rl;
+      uint64 lo = t + (rm1 << 32);
+      c += lo < t;
+      a = lo;
+      b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+      #endif
+   }
+
+   inline uint64 mix(uint64 a, uint64 b)
+   {
+      multiply(a, b);
+      return a ^ b;
+   }
+
+   uint64 hashBytes(const uint8* data, size_t length)
+   {
+      uint64 seed = mix(kSecret[0], kSecret[1]);
+      uint64 a;
+      uint64 b;
+
+      if(length <= 16)
+      {
+         if(length >= 4)
+         {
+            const size_t shift = (length >> 3) << 2;
+            a = (read4(data) << 32) | read4(data + shift);
+            b = (read4(data + length - 4) << 32) | read4(data + length - 4 - shift);
+         }
+         else if(length > 0)
+         {
+            a = (static_cast<uint64>(data[0]) << 16) |
+                (static_cast<uint64>(data[length >> 1]) << 8) |
+                data[length - 1];
+            b = 0;
+         }
+         else a = b = 0;
+      }
+      else
+      {
+         size_t remaining = length;
+         if(remaining > 48)
+         {
+            uint64 seed1 = seed;
+            uint64 seed2 = seed;
+            do
+            {
+               seed = mix(read8(data) ^ kSecret[1], read8(data + 8) ^ seed);
+               seed1 = mix(read8(data + 16) ^ kSecret[2], read8(data + 24) ^ seed1);
+               seed2 = mix(read8(data + 32) ^ kSecret[3], read8(data + 40) ^ seed2);
+               data += 48;
+               remaining -= 48;
+            }
+            while(remaining > 48);
+            seed ^= seed1 ^ seed2;
+         }
+         while(remaining > 16)
+         {
+            seed = mix(read8(data) ^ kSecret[1], read8(data + 8) ^ seed);
+            data += 16;
+            remaining -= 16;
+         }
+         a = read8(data + remaining - 16);
+         b = read8(data + remaining - 8);
+      }
+
+      a ^= kSecret[1];
+      b ^= seed;
+      multiply(a, b);
+      return mix(a ^ kSecret[0] ^ length, b ^ kSecret[1]);
+   }
+
+   //! Returns true, if \p data starts with the \p length units of \p pattern.
+   inline bool matches(const Char* data, const Char* pattern, size_t length)
+   {
+      return memcmp(static_cast<const void*>(data), static_cast<const void*>(pattern),
+                    sizeof(Char) * length) == 0;
+   }
+
+   //! Returns the first position of \p pattern in \p data. \p patternLength must be > 1.
+   size_t findString(const Char* data, size_t length, const Char* pattern, size_t patternLength)
+   {
+      if(patternLength > length)return npos;
+      const size_t last = length - patternLength; // Last possible position.
+      const size_t tail = patternLength - 1;
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      const __m128i firstUnit = _mm_set1_epi16(static_cast<int16>(pattern[0].unicode()));
+      const __m128i lastUnit = _mm_set1_epi16(static_cast<int16>(pattern[tail].unicode()));
+      for(; index + 8 <= last + 1; index += 8)
+      {
+         uint32 mask = matchMask(data + index, firstUnit) &
+                         matchMask(data + index + tail, lastUnit);
+         while(mask != 0)
+         {
+            uint32 bit = lowestBit(mask);
+            size_t pos = index + bit / 2;
+            if(matches(data + pos + 1, pattern + 1, tail - 1))return pos;
+            mask &= ~(3u << bit);
+         }
+      }
+      #endif
+
+      for(; index <= last; index++)
+      {
+         if(data[index] == pattern[0] && matches(data + index + 1, pattern + 1, tail))return index;
+      }
+      return npos;
+   }
+
+   //! Returns the last position <= \p start of \p pattern in \p data. \p patternLength must
+   //! be > 1 and \p start + \p patternLength must not exceed the length of \p data.
+   size_t findStringReverse(const Char* data, size_t start, const Char* pattern,
+                            size_t patternLength)
+   {
+      const size_t tail = patternLength - 1;
+      size_t index = start + 1; // Number of remaining positions.
+
+      #if defined(JM_SSE2)
+      const __m128i firstUnit = _mm_set1_epi16(static_cast<int16>(pattern[0].unicode()));
+      const __m128i lastUnit = _mm_set1_epi16(static_cast<int16>(pattern[tail].unicode()));
+      while(index >= 8)
+      {
+         index -= 8;
+         uint32 mask = matchMask(data + index, firstUnit) &
+                         matchMask(data + index + tail, lastUnit);
+         while(mask != 0)
+         {
+            uint32 bit = highestBit(mask);
+            size_t pos = index + bit / 2;
+            if(matches(data + pos + 1, pattern + 1, tail - 1))return pos;
+            mask &= ~(3u << (bit - 1));
+         }
+      }
+      #endif
+
+      while(index > 0)
+      {
+         index--;
+         if(data[index] == pattern[0] && matches(data + index + 1, pattern + 1, tail))return index;
+      }
+      return npos;
+   }
+}
+
 String::String(): Object(), Comparable<String>(),
-   mArrLength(16),
+   mValue(mInline),
+   mArrLength(kInlineLength),
    mStrLength(0),
    mHash(0)
 {
-   mValue = new Char[mArrLength];
 }
 
 String::String(jm::Char character): Object(), Comparable<String>(),
-   mArrLength(16),
-   mStrLength(0),
+   mValue(mInline),
+   mArrLength(kInlineLength),
+   mStrLength(1),
    mHash(0)
 {
-   mValue = new Char[mArrLength];
-   append(character);
+   mValue[0] = character;
 }
 
 String::String(const uint16* buffer, size_t size): Object(), Comparable<String>(),
    mHash(0)
 {
-   CharArray array = CharArray(size);
-   memcpy(array.buffer, buffer, sizeof(Char) * size);
-   copy(array);
+   allocate(size);
+   memcpy(static_cast<void*>(mValue), buffer, sizeof(Char) * size);
+   mStrLength = size;
 }
 
 String::String(const String& another) noexcept: Object(), Comparable<String>(),
-   mArrLength(another.mArrLength),
    mStrLength(another.mStrLength),
-   mHash(another.mHash)
+   mHash(another.mHash.load(std::memory_order_relaxed))
 {
-   mValue = new Char[mArrLength];
-   memcpy(mValue, another.mValue, sizeof(Char) * mStrLength);
+   if(another.isInline())
+   {
+      mValue = mInline;
+      mArrLength = kInlineLength;
+      memcpy(mValue, another.mValue, sizeof(Char) * mStrLength);
+   }
+   else
+   {
+      // Share the array of the other string.
+      another.sharedArray()->references.fetch_add(1, std::memory_order_relaxed);
+      mValue = another.mValue;
+      mArrLength = another.mArrLength;
+   }
+}
+
+String::String(String&& another) noexcept: Object(), Comparable<String>(),
+   mValue(mInline),
+   mArrLength(kInlineLength)
+{
+   take(another);
 }
 
 String::String(const char* buffer, size_t size): Object(), Comparable<String>(),
    mHash(0)
 {
-   char* cstring = new char[size + 1];
-   memcpy(cstring, buffer, size);
-   cstring[size] = 0;
-
    // Intentionally not used Charset::GetDefault, since this leads to problems with global strings.
    // (Initialization sequence not predictable)
    UTF8Decoder dec = UTF8Decoder();
-   CharArray array = dec.decode(cstring);
-   copy(array);
-
-   delete[] cstring;
+   decode(buffer, size, &dec);
 }
 
 String::String(const char* buffer, size_t size, Charset* charset): Object(), Comparable<String>(),
    mHash(0)
 {
-   char* cstring = new char[size + 2];
-   memcpy(cstring, buffer, size);
-   cstring[size] = 0;
-   cstring[size + 1] = 0; //For UTF16 required
-   CharArray array = charset->decode(cstring);
-   copy(array);
-   delete[] cstring;
+   decode(buffer, size, charset->decoder());
 }
 
 String::String(const char* cstring): Object(), Comparable<String>(),
@@ -103,14 +449,12 @@ String::String(const char* cstring): Object(), Comparable<String>(),
       // Intentionally not used Charset::GetDefault, since this leads to problems with global
       // strings. (Initialization sequence not predictable)
       UTF8Decoder dec = UTF8Decoder();
-      CharArray array = dec.decode(cstring);
-      copy(array);
+      decode(cstring, strlen(cstring), &dec);
    }
    else
    {
       mStrLength = 0;
-      mArrLength = 16;
-      mValue = new Char[mArrLength];
+      allocate(0);
    }
 }
 
@@ -122,14 +466,12 @@ String::String(const ByteArray& buffer) : Object(), Comparable<String>(),
       // Intentionally not used Charset::GetDefault, since this leads to problems with global
       // strings. (Initialization sequence not predictable)
       UTF8Decoder dec = UTF8Decoder();
-      CharArray array = dec.decode(buffer.constData());
-      copy(array);
+      decode(buffer.constData(), strlen(buffer.constData()), &dec);
    }
    else
    {
       mStrLength = 0;
-      mArrLength = 16;
-      mValue = new Char[mArrLength];
+      allocate(0);
    }
 }
 
@@ -149,36 +491,146 @@ String::String(const ByteArray& buffer, Charset* charset) : Object(), Comparable
 
 String::~String()
 {
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
    mStrLength = 0;
+   deallocate();
    mArrLength = 0;
-   delete[] mValue;
    mValue = nullptr;
 }
 
+bool String::isInline() const
+{
+   return mValue == mInline;
+}
+
+void String::allocate(size_t length)
+{
+   if(length <= kInlineLength)
+   {
+      mValue = mInline;
+      mArrLength = kInlineLength;
+      return;
+   }
+
+   mArrLength = length;
+   size_t mod = mArrLength % 16;
+   if(mod != 0)mArrLength += 16 - mod;
+
+   uint8* memory = new uint8[sizeof(SharedArray) + sizeof(Char) * mArrLength];
+   SharedArray* array = new(memory) SharedArray();
+   array->references.store(1, std::memory_order_relaxed);
+   mValue = reinterpret_cast<Char*>(memory + sizeof(SharedArray));
+}
+
+void String::deallocate()
+{
+   if(!isInline())release(sharedArray());
+   mValue = mInline;
+   mArrLength = kInlineLength;
+}
+
+String::SharedArray* String::sharedArray() const
+{
+   return reinterpret_cast<SharedArray*>(reinterpret_cast<uint8*>(mValue) - sizeof(SharedArray));
+}
+
+void String::release(SharedArray* array)
+{
+   if(array->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+   {
+      array->~SharedArray();
+      delete[] reinterpret_cast<uint8*>(array);
+   }
+}
+
+void String::take(String& another) noexcept
+{
+   mStrLength = another.mStrLength;
+   mHash.store(another.mHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+   if(another.isInline())
+   {
+      memcpy(mValue, another.mValue, sizeof(Char) * mStrLength);
+   }
+   else
+   {
+      mValue = another.mValue;
+      mArrLength = another.mArrLength;
+      another.mValue = another.mInline;
+      another.mArrLength = kInlineLength;
+   }
+
+   another.mStrLength = 0;
+   another.mHash.store(0, std::memory_order_relaxed);
+}
+
+void String::detach()
+{
+   if(isInline())return;
+   if(sharedArray()->references.load(std::memory_order_acquire) == 1)return;
+
+   // The own reference keeps the old array alive until the copy is made. Another string may
+   // detach at the same time, so the reference is dropped only afterwards.
+   SharedArray* old = sharedArray();
+   const Char* content = mValue;
+   allocate(mArrLength);
+   memcpy(mValue, content, sizeof(Char) * mStrLength);
+   release(old);
+}
+
 void String::copy(const CharArray& array)
 {
    mStrLength = array.length;
-   mArrLength = mStrLength;
-   uint32 mod = mArrLength % 16;
-   if(mod != 0)mArrLength += 16 - mod;
-   mValue = new Char[mArrLength];
+   allocate(mStrLength);
    memcpy(mValue, array.buffer, 2 * mStrLength);
 }
 
+void String::decode(const char* buffer, size_t size, CharsetDecoder* decoder)
+{
+   mStrLength = 0;
+   allocate(decoder->maxLength(size));
+
+   try
+   {
+      mStrLength = decoder->decode(buffer, size, mValue);
+   }
+   catch(...)
+   {
+      deallocate();
+      throw;
+   }
+
+   // Multibyte encodings may need much less space than reserved. Give back the surplus.
+   if(!isInline() && (mStrLength <= kInlineLength || 2 * mStrLength < mArrLength))
+   {
+      String tmp;
+      tmp.allocate(mStrLength);
+      memcpy(tmp.mValue, mValue, sizeof(Char) * mStrLength);
+      tmp.mStrLength = mStrLength;
+      deallocate();
+      take(tmp);
+   }
+}
+
 void String::checkCapacity(size_t more)
 {
-   if(mStrLength + more < mArrLength)return;
+   if(mStrLength + more <= mArrLength)
+   {
+      detach();
+      return;
+   }
 
    //Vergrößere
-   size_t newLength = mStrLength + more;
-   size_t mod = newLength % 16;
-   if(mod != 0)newLength += 16 - mod;
-   mArrLength = newLength;
-   Char* tmp = new Char [mArrLength];
-   memcpy(tmp, mValue, sizeof(Char) * mStrLength);
-   delete[] mValue;
-   mValue = tmp;
+   String tmp;
+   tmp.allocate(mStrLength + more);
+   memcpy(tmp.mValue, mValue, sizeof(Char) * mStrLength);
+
+   // Take over the array of tmp.
+   deallocate();
+   mValue = tmp.mValue;
+   mArrLength = tmp.mArrLength;
+   tmp.mValue = tmp.mInline;
+   tmp.mArrLength = kInlineLength;
 }
 
 #if defined(JM_MACOS) || defined(JM_IOS)
@@ -283,58 +735,86 @@ bool String::atIsIgnoreCase(size_t position, const String& another) const
 {
    if(position + another.mStrLength > mStrLength)return false;
 
-   for(size_t a = 0; a < another.mStrLength; a++)
-   {
-      Char c1 = mValue[a + position].toLowerCase();
-      Char c2 = another.mValue[a].toLowerCase();
-      if(c1 != c2)return false;
-   }
-
-   return true;
+   return Char::equalsIgnoreCase(mValue + position, another.mValue, another.mStrLength);
 }
 
-int64 String::hashCode()
+int64 String::hashCode() const
 {
-   if(mHash != 0)return mHash;
-   uint32 hash = 0;
-   for(size_t a = 0; a < mStrLength; a++)hash = (hash << 5) - hash + mValue[a].unicode();
-   mHash = (int32) hash;
-   return hash;
+   uint64 hash = mHash.load(std::memory_order_relaxed);
+   if(hash != 0)return static_cast<int64>(hash);
+
+   hash = static_cast<uint64>(hashCode(mValue, mStrLength));
+
+   // Threads racing here calculate the same value, so a relaxed store is sufficient.
+   mHash.store(hash, std::memory_order_relaxed);
+   return static_cast<int64>(hash);
 }
 
 int64 String::constHashCode() const
 {
-   if(mHash != 0)return mHash;
-   uint32 hash = 0;
-   for(size_t a = 0; a < mStrLength; a++)hash = (hash << 5) - hash + mValue[a].unicode();
-   return hash;
+   return hashCode();
 }
 
-String String::toLowerCase() const
+int64 String::hashCode(const Char* buffer, size_t length)
 {
-   String ret = *this;
+   uint64 hash = hashBytes(reinterpret_cast<const uint8*>(buffer), sizeof(Char) * length);
+   if(hash == 0)hash = 1; // 0 marks a hash, which is not calculated yet.
+   return static_cast<int64>(hash);
+}
 
-   for(size_t a = 0; a < mStrLength; a++)
-   {
-      ret.mValue[a] = ret.mValue[a].toLowerCase();
-   }
+String String::toLowerCase() const&
+{
+   return String(*this).toLowerCase();
+}
 
-   return ret;
+String String::toLowerCase() &&
+{
+   detach();
+
+   Char::toLowerCase(mValue, mStrLength);
+   mHash.store(0, std::memory_order_relaxed);
+
+   return std::move(*this);
 }
 
-String String::toUpperCase() const
+String String::toUpperCase() const&
 {
-   String ret = *this;
+   return String(*this).toUpperCase();
+}
 
-   for(size_t a = 0; a < mStrLength; a++)
+String String::toUpperCase() &&
+{
+   detach();
+
+   Char::toUpperCase(mValue, mStrLength);
+   mHash.store(0, std::memory_order_relaxed);
+
+   return std::move(*this);
+}
+
+String String::trim() &&
+{
+   size_t beginIndex = 0;
+   size_t endIndex = mStrLength;
+
+   //Von links
+   while(beginIndex < mStrLength && mValue[beginIndex].isWhitespace())beginIndex++;
+
+   //Von rechts
+   while(endIndex > beginIndex && mValue[endIndex - 1].isWhitespace())endIndex--;
+
+   if(beginIndex > 0 || endIndex < mStrLength)
    {
-      ret.mValue[a] = ret.mValue[a].toUpperCase();
+      detach();
+      memmove(mValue, &mValue[beginIndex], sizeof(Char) * (endIndex - beginIndex));
+      mStrLength = endIndex - beginIndex;
+      mHash.store(0, std::memory_order_relaxed);
    }
 
-   return ret;
+   return std::move(*this);
 }
 
-String String::trim() const
+String String::trim() const&
 {
    size_t beginIndex = 0;
    size_t endIndex = mStrLength;
@@ -364,29 +844,31 @@ size_t String::indexOf(const String& str) const
 
 size_t String::indexOf(Char character, size_t fromIndex) const
 {
-   for(size_t a = fromIndex; a < mStrLength; a++)
-   {
-      if(mValue[a] == character)return a;
-   }
-   return npos;
+   if(fromIndex >= mStrLength)return npos;
+
+   size_t index = findChar(mValue + fromIndex, mStrLength - fromIndex, character);
+   return (index == npos) ? npos : fromIndex + index;
 }
 
 size_t String::indexOf(const String& str, size_t fromIndex) const
 {
-   for(size_t a = fromIndex; a < mStrLength; a++)
-   {
-      bool found = true;
-      for(size_t b = 0 ; b < str.mStrLength; b++)
-      {
-         if(mValue[a + b] != str.mValue[b])
-         {
-            found = false;
-            break;
-         }
-      }
-      if(found)return a;
-   }
-   return npos;
+   if(fromIndex >= mStrLength)return npos;
+   if(str.mStrLength == 0)return fromIndex;
+
+   size_t index;
+   const size_t length = mStrLength - fromIndex;
+   if(str.mStrLength == 1)index = findChar(mValue + fromIndex, length, str.mValue[0]);
+   else index = findString(mValue + fromIndex, length, str.mValue, str.mStrLength);
+   return (index == npos) ? npos : fromIndex + index;
+}
+
+size_t String::indexOfAny(const String& characters, size_t fromIndex) const
+{
+   if(fromIndex >= mStrLength)return npos;
+
+   size_t index = findAny(mValue + fromIndex, mStrLength - fromIndex, characters.mValue,
+                          characters.mStrLength);
+   return (index == npos) ? npos : fromIndex + index;
 }
 
 size_t String::lastIndexOf(Char character) const
@@ -404,77 +886,80 @@ size_t String::lastIndexOf(const String& str) const
 size_t String::lastIndexOf(Char character, size_t fromIndex) const
 {
    if(fromIndex >= mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1").arg(fromIndex));
+      throw Exception(TrLiteral("Index out of Bounds: %1").arg(fromIndex));
    if(mStrLength==0)return npos;
 
    if(fromIndex > mStrLength - 1)fromIndex = mStrLength - 1;
 
-   for(int64 a = (int64)fromIndex; a >= 0; a--)
-   {
-      if(mValue[(size_t)a] == character)return (size_t)a;
-   }
-   return npos;
+   return findCharReverse(mValue, fromIndex + 1, character);
 }
 
 size_t String::lastIndexOf(const String& str, size_t fromIndex) const
 {
-   if(str.mStrLength>fromIndex)return npos;
+   if(str.mStrLength > mStrLength)return npos;
    size_t begin = mStrLength - str.mStrLength;
    fromIndex = (fromIndex > begin) ? begin : fromIndex;
 
-   for(int64 a = (int64)fromIndex; a >= 0; a--)
-   {
-      bool found = true;
-      for(size_t b = 0 ; b < str.mStrLength; b++)
-      {
-         if(mValue[(size_t)a + b] != str.mValue[b])
-         {
-            found = false;
-            break;
-         }
-      }
-      if(found)return (size_t)a;
-   }
-   return npos;
+   if(str.mStrLength == 0)return fromIndex;
+   if(str.mStrLength == 1)return findCharReverse(mValue, fromIndex + 1, str.mValue[0]);
+   return findStringReverse(mValue, fromIndex, str.mValue, str.mStrLength);
 }
 
 
-String String::replace(Char oldChar, Char newChar) const
+String String::replace(Char oldChar, Char newChar) const&
 {
-   String ret = String(*this);
+   return String(*this).replace(oldChar, newChar);
+}
+
+String String::replace(Char oldChar, Char newChar) &&
+{
+   detach();
 
    for(size_t a = 0; a < mStrLength; a++)
    {
-      if(ret.mValue[a] == oldChar)ret.mValue[a] = newChar;
+      if(mValue[a] == oldChar)mValue[a] = newChar;
    }
+   mHash.store(0, std::memory_order_relaxed);
 
-   return ret;
+   return std::move(*this);
 }
 
 String String::replace(const String& oldStr, const String& newStr)const
 {
-   size_t pos1 = 0;
-   size_t pos2 = indexOf(oldStr);
-   if(pos2 == npos)return *this;
+   if(oldStr.mStrLength == 0)return *this;
 
-   String output;
+   size_t pos = indexOf(oldStr);
+   if(pos == npos)return *this;
 
-   do
+   // Count the occurrences first, so that the result is allocated only once.
+   size_t count = 0;
+   while(pos != npos)
    {
-      // Append everything in front
-      output.append(substring(pos1, pos2));
+      count++;
+      pos = indexOf(oldStr, pos + oldStr.mStrLength);
+   }
 
-      // Append new string
-      output.append(newStr);
+   String output;
+   output.mStrLength = mStrLength - count * oldStr.mStrLength + count * newStr.mStrLength;
+   output.allocate(output.mStrLength);
 
-      pos1 = pos2 + oldStr.size();
-      pos2 = indexOf(oldStr, pos1);
+   Char* target = output.mValue;
+   size_t pos1 = 0;
+   size_t pos2 = indexOf(oldStr);
+   while(pos2 != npos)
+   {
+      // Copy everything in front and the new string
+      memcpy(static_cast<void*>(target), mValue + pos1, sizeof(Char) * (pos2 - pos1));
+      target += pos2 - pos1;
+      memcpy(static_cast<void*>(target), newStr.mValue, sizeof(Char) * newStr.mStrLength);
+      target += newStr.mStrLength;
 
+      pos1 = pos2 + oldStr.mStrLength;
+      pos2 = indexOf(oldStr, pos1);
    }
-   while(pos2 != npos);
 
-   // Append last part.
-   output.append(substring(pos1));
+   // Copy last part.
+   memcpy(static_cast<void*>(target), mValue + pos1, sizeof(Char) * (mStrLength - pos1));
 
    return output;
 }
@@ -483,6 +968,7 @@ String String::replace(const String& oldStr, const String& newStr)const
 String String::reverse() const
 {
    String ret = String(*this);
+   ret.detach();
    size_t cnt = mStrLength / 2;
    size_t last = mStrLength - 1;
    for(size_t a = 0; a < cnt; a++)
@@ -511,7 +997,7 @@ StringList String::split(Char character) const
 Char String::charAt(size_t index) const
 {
    if(index >= mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
 
    return mValue[index];
 }
@@ -519,10 +1005,11 @@ Char String::charAt(size_t index) const
 void String::setCharAt(size_t index, Char character)
 {
    if(index >= mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
 
+   detach();
    mValue[index] = character;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::append(const String& another)
@@ -531,7 +1018,7 @@ void String::append(const String& another)
    checkCapacity(another.mStrLength);
    memcpy(&mValue[mStrLength], &another.mValue[0], sizeof(Char) * another.mStrLength);
    mStrLength += another.mStrLength;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::append(Char utf8char)
@@ -539,24 +1026,24 @@ void String::append(Char utf8char)
    checkCapacity(1);
    mValue[mStrLength] = utf8char;
    mStrLength++;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::insert(size_t index, Char character)
 {
    if(index > mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
    checkCapacity(1);
    for(size_t a = mStrLength; a > index; a--)mValue[a] = mValue[a - 1];
    mValue[index] = character;
    mStrLength++;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::insert(size_t index, const String& str)
 {
    if(index > mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
 
    size_t len = str.size();
    checkCapacity(len);
@@ -566,63 +1053,53 @@ void String::insert(size_t index, const String& str)
    for(size_t a = 0; a < len; a++)mValue[index + a] = str.charAt(a);
 
    mStrLength += len;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::deleteCharAt(size_t index)
 {
    if(index >= mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
 
+   detach();
    for(size_t a = index ; a < mStrLength - 1; a++)
    {
       mValue[a] = mValue[a + 1];
    }
    mStrLength--;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 void String::deleteCharRangeAt(size_t index, size_t length)
 {
    if(index > mStrLength)
-      throw Exception(Tr("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
+      throw Exception(TrLiteral("Index out of Bounds: %1 of %2").arg(index).arg(mStrLength));
 
+   detach();
    for(size_t a = index ; a < mStrLength - length; a++)
    {
       mValue[a] = mValue[a + length];
    }
    mStrLength -= length;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 size_t String::count(Char character)const
 {
-   size_t count = 0;
-
-   for(size_t index = 0; index < mStrLength; index++)
-   {
-      if(mValue[index] == character)count++;
-   }
-
-   return count;
+   return countChar(mValue, mStrLength, character);
 }
 
 
 void String::clear()
 {
    zero();
-   if(mArrLength > 16)
-   {
-      delete[] mValue;
-      mArrLength = 16;
-      mValue = new Char[mArrLength];
-   }
+   deallocate();
 }
 
 void String::zero()
 {
    mStrLength = 0;
-   mHash = 0;
+   mHash.store(0, std::memory_order_relaxed);
 }
 
 
@@ -637,31 +1114,23 @@ bool String::equals(const Object* other) const
 bool String::equals(const String& another) const
 {
    if(mStrLength != another.mStrLength)return false;
+   if(mValue == another.mValue)return true;
 
-   size_t cnt = 0;
-   while(cnt < mStrLength)
-   {
-      if(mValue[cnt] != another.mValue[cnt])return false;
-      cnt++;
-   }
+   return std::memcmp(mValue, another.mValue, mStrLength * sizeof(Char)) == 0;
+}
 
-   return true;
+bool String::equals(const Char* buffer, size_t length) const
+{
+   if(mStrLength != length)return false;
+
+   return std::memcmp(mValue, buffer, length * sizeof(Char)) == 0;
 }
 
 bool String::equalsIgnoreCase(const String& another) const
 {
    if(mStrLength != another.mStrLength)return false;
 
-   size_t cnt = 0;
-   while(cnt < mStrLength)
-   {
-      Char c1 = mValue[cnt].toLowerCase();
-      Char c2 = another.mValue[cnt].toLowerCase();
-      if(c1 != c2)return false;
-      cnt++;
-   }
-
-   return true;
+   return Char::equalsIgnoreCase(mValue, another.mValue, mStrLength);
 }
 
 int32 String::compareTo(const String& another) const
@@ -1218,7 +1687,8 @@ namespace jm
    {
       char cstr[256];
       in.getline(cstr, 256);
-      str = String(cstr, (uint32)in.gcount());
+      // gcount() includes the extracted line break, which getline() replaces by the 0 byte.
+      str = String(cstr, strlen(cstr));
       return in;
    }
 
@@ -1271,14 +1741,34 @@ namespace jm
    }
 
    String& String::operator=(const String& another)
+   {
+      if(this != &another && mValue != another.mValue)
+      {
+         deallocate();
+         if(another.isInline())
+         {
+            memcpy(mValue, another.mValue, sizeof(Char) * another.mStrLength);
+         }
+         else
+         {
+            // Share the array of the other string.
+            another.sharedArray()->references.fetch_add(1, std::memory_order_relaxed);
+            mValue = another.mValue;
+            mArrLength = another.mArrLength;
+         }
+      }
+      mStrLength = another.mStrLength;
+      mHash.store(another.mHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+      return *this;
+   }
+
+   String& String::operator=(String&& another) noexcept
    {
       if(this != &another)
       {
-         delete[] mValue;
-         mStrLength = another.mStrLength;
-         mArrLength = another.mArrLength;
-         mValue = new Char[mArrLength];
-         memcpy(mValue, another.mValue, sizeof(Char) * mStrLength);
+         deallocate();
+         take(another);
       }
 
       return *this;
@@ -1297,6 +1787,13 @@ namespace jm
       return ret;
    }
 
+   String operator+(String&& left, const String& right)
+   {
+      String ret = std::move(left);
+      ret.append(right);
+      return ret;
+   }
+
    String operator+(const char*& left, const String& right)
    {
       String ret = left;
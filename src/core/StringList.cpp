@@ -36,114 +36,86 @@ using namespace jm;
 
 StringList::StringList(): Object()
 {
-   mData = new String[8];
-   mLength = 8;
-   mSize = 0;
 }
 
-StringList::StringList(size_t size)
+StringList::StringList(size_t size): Object(),
+   mData(size)
 {
-   mData = new String[size];
-   mLength = size;
-   mSize = size;
 }
 
 
 StringList::StringList(const jm::String& string): Object()
 {
-   mData = new String[8];
-   mLength = 8;
-   mSize = 0;
    append(string);
 };
 
-StringList::StringList(const StringList& other): Object()
+StringList::StringList(const StringList& other): Object(),
+   mData(other.mData)
+{
+}
+
+StringList::StringList(StringList&& other) noexcept: Object(),
+   mData(std::move(other.mData))
 {
-   mSize = other.mSize;
-   mLength = other.mLength;
-   mData = new String[mLength];
-   for(size_t a = 0; a < mSize; a++)
-   {
-      mData[a] = other.mData[a];
-   }
 }
 
 StringList::~StringList()
 {
-   mLength = 0;
-   mSize = 0;
-   if(mData != nullptr)delete[] mData;
 }
 
 void StringList::reserve(size_t size)
 {
-   checkSize(size);
+   mData.reserve(mData.size() + size);
 }
 
 void StringList::append(const jm::String& string)
 {
-   checkSize(1);
-   mData[mSize++] = string;
+   mData.append(string);
 }
 
 void StringList::remove(const jm::String& string)
 {
-   for(size_t index = 0; index < mSize; index++)
+   size_t size = 0;
+   for(size_t index = 0; index < mData.size(); index++)
    {
-      if(mData[index] == string)
+      if(mData[index] != string)
       {
-         for(size_t index2 = index + 1; index2 < mSize; index2++)
-         {
-            mData[index2 - 1] = mData[index2];
-         }
-         mSize--;
-         index--;
+         if(size != index)mData[size] = std::move(mData[index]);
+         size++;
       }
    }
+   mData.resize(size);
 }
 
 size_t StringList::size() const
 {
-   return mSize;
+   return mData.size();
 }
 
 void StringList::sort()
 {
-   if(mSize < 1)return;
+   Sort::sort(mData.begin(), mData.end(), Sort::Ascending<String>());
+}
 
-   size_t n = mSize;
-   do
-   {
-      size_t newn = 1;
-      for(size_t i = 0; i < n - 1; ++i)
-      {
-         size_t j = i + 1;
-         const String* a1 = &mData[i];
-         const String* a2 = &mData[j];
-         if(a1->compareTo(*a2) > 0)
-         {
-            // Swap
-            String tmp = mData[i];
-            mData[i] = mData[j];
-            mData[j] = tmp;
-
-            newn = i + 1;
-         }
-      }
-      n = newn;
-   }
-   while(n > 1);
+void StringList::stableSort()
+{
+   Sort::stableSort(mData.begin(), mData.end(), Sort::Ascending<String>());
+}
+
+void StringList::parallelSort()
+{
+   Sort::parallelSort(mData.begin(), mData.end(), Sort::Ascending<String>());
 }
 
 jm::String StringList::join(Char divider) const
 {
-   size_t stringSize = mSize - 1;
-   for(size_t index = 0; index < mSize; index++)stringSize += mData[index].size();
+   size_t stringSize = mData.size() - 1;
+   for(size_t index = 0; index < mData.size(); index++)stringSize += mData[index].size();
 
    jm::String result;
    result.checkCapacity(stringSize);
 
-   for(size_t index = 0; index < mSize; index++)
+   for(size_t index = 0; index < mData.size(); index++)
    {
       if(index > 0)result << divider;
       result << mData[index];
@@ -154,26 +126,26 @@ jm::String StringList::join(Char divider) const
 
 const String& StringList::get(size_t index) const
 {
-   if(index >= mSize)
+   if(index >= mData.size())
       throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
    return mData[index];
 }
 
 void StringList::set(size_t index, const String& item)
 {
-   if(index >= mSize)
+   if(index >= mData.size())
       throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
    mData[index] = item;
 }
 
 void StringList::clear()
 {
-   mSize = 0;
+   mData.clear();
 }
 
 bool StringList::contains(const String& str) const
 {
-   for(size_t index = 0; index < mSize; index++)
+   for(size_t index = 0; index < mData.size(); index++)
    {
       if(mData[index] == str)return true;
    }
@@ -181,38 +153,22 @@ bool StringList::contains(const String& str) const
 }
 
 
-void StringList::checkSize(size_t size)
-{
-   if(mSize + size < mLength)return;
-   while(mLength < mSize + size)mLength += 8;
-   String* tmp = new String[mLength];
-   for(size_t index = 0; index < mSize; index++)tmp[index] = mData[index];
-   delete[] mData;
-   mData = tmp;
-}
-
 String& jm::StringList::operator[](const size_t index) const
 {
-   if(index >= mSize)
+   if(index >= mData.size())
       throw Exception(jm::String("Array index %1 out of bounds.").arg(index));
-   return mData[index];
+   return const_cast<String&>(mData[index]);
 }
 
 StringList& jm::StringList::operator=(const StringList& another)
 {
-   if(this != &another)
-   {
-      delete[] mData;
-
-      mLength = another.mLength;
-      mSize = another.mSize;
-      mData = new String[mLength];
-      for(size_t a = 0; a < mSize; a++)
-      {
-         mData[a] = another.mData[a];
-      }
-   }
+   mData = another.mData;
+   return *this;
+}
 
+StringList& jm::StringList::operator=(StringList&& another) noexcept
+{
+   mData = std::move(another.mData);
    return *this;
 }
 
@@ -224,15 +180,10 @@ StringList& jm::operator<< (StringList& out, const String& str)
 
 String* StringList::begin()
 {
-   return &mData[0];
+   return mData.begin();
 }
 
 String* StringList::end()
 {
-   // Note: end() returns a pointer to the "element" after the last element.
-   // This is the standard behavior for STL containers.
-   // It allows for range-based for loops to work correctly.
-   // This element is not always initialized or valid, but it is used to indicate the end of the
-   // container.
-   return &mData[mSize];
+   return mData.end();
 }
@@ -45,28 +45,13 @@ StringTokenizer::StringTokenizer(const String& str,
 
 bool StringTokenizer::isDelimiter(size_t index) const
 {
-   size_t cnt = 0;
-   size_t l = mDelimiters.size();
-   Char c = mStr.charAt(index);
-
-   while(cnt < l)
-   {
-      if(mDelimiters.charAt(cnt++) == c)return true;
-   }
-   return false;
+   return mDelimiters.indexOf(mStr.charAt(index)) != npos;
 }
 
 size_t StringTokenizer::findTokenEnd(size_t startPos) const
 {
-   size_t pos = startPos;
-   size_t l = mStr.size();
-
-   while(pos < l)
-   {
-      if(isDelimiter(pos))break;
-      pos++;
-   }
-   return pos;
+   size_t pos = mStr.indexOfAny(mDelimiters, startPos);
+   return (pos == npos) ? std::max(startPos, mStr.size()) : pos;
 }
 
 size_t StringTokenizer::findDelimiterEnd(size_t startPos) const
@@ -96,7 +81,7 @@ String StringTokenizer::next()
    mPosition = (mNewStart != npos) ? mNewStart : findDelimiterEnd(mPosition);
    mNewStart = npos;
 
-   if(mPosition >= mStr.size())throw Exception(Tr("No such element."));
+   if(mPosition >= mStr.size())throw Exception(TrLiteral("No such element."));
 
    if(mRetDelim && isDelimiter(mPosition))
    {
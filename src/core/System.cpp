@@ -31,6 +31,10 @@
 
 #include "PrecompiledCore.hpp"
 
+#if defined(_MSC_VER) && defined(JM_X64)
+#include <intrin.h>
+#endif
+
 jm::Mutex gSystemMutex;
 jm::String gSystemError;
 
@@ -105,6 +109,9 @@ void jm::System::logEnableLabel(jm::LogLevel logLevel)
 
 void jm::System::log(const String& message, LogLevel logLevel)
 {
+   // Debug messages are filtered out below, so they are not composed and translated at all.
+   if(logLevel <= LogLevel::kDebug)return;
+
    gSystemMutex.lock();
 
    jm::String msg;
@@ -114,21 +121,21 @@ void jm::System::log(const String& message, LogLevel logLevel)
    {
       case LogLevel::kError:
          msg << kTxtBold << kTxtRed;
-         if(logLevel >= mSystemLogLabel)msg << Tr("ERROR: ");
+         if(logLevel >= mSystemLogLabel)msg << TrLiteral("ERROR: ");
          gSystemError = message;
          break;
 
       case 	LogLevel::kWarning:
          msg << kTxtBold << kTxtYellow;
-         if(logLevel >= mSystemLogLabel)msg << Tr("WARNING: ");
+         if(logLevel >= mSystemLogLabel)msg << TrLiteral("WARNING: ");
          break;
 
       case LogLevel::kInformation:
-         if(logLevel >= mSystemLogLabel)msg << Tr("INFO: ");
+         if(logLevel >= mSystemLogLabel)msg << TrLiteral("INFO: ");
          break;
 
-      case LogLevel::kDebug:
-         if(logLevel >= mSystemLogLabel)msg << Tr("DEBUG: ");
+      default:
+         // Debug messages have returned above.
          break;
    }
    msg << message;
@@ -147,7 +154,7 @@ void jm::System::log(const String& message, LogLevel logLevel)
 
 
    // Output to console
-   if(logLevel > LogLevel::kDebug)std::cout << msg << std::endl;
+   std::cout << msg << std::endl;
 
    // Output to log file
 #ifdef __APPLE__ //macOS and iOS
@@ -423,7 +430,58 @@ jm::String gBundleId;
 
 jm::AutoreleasePool* jm::System::autoreleasePool()
 {
-   return gMainThreadPool;
+   AutoreleasePool* pool = AutoreleasePool::current();
+   return pool != nullptr ? pool : gMainThreadPool;
+}
+
+#if defined(JM_X64)
+
+//! Queries the features with cpuid. AVX2 also needs the operating system to save the YMM
+//! registers.
+static uint32 detectCpuFeatures()
+{
+   bool sse42 = false;
+   bool pclmul = false;
+   bool avx2 = false;
+
+#if defined(_MSC_VER)
+   int info[4];
+   __cpuid(info, 0);
+   const int maximum = info[0];
+   __cpuid(info, 1);
+   sse42 = (info[2] & (1 << 20)) != 0;
+   pclmul = (info[2] & (1 << 1)) != 0 && (info[2] & (1 << 19)) != 0;
+   const bool osxsave = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+   if(maximum >= 7 && osxsave && (_xgetbv(0) & 0x06) == 0x06)
+   {
+      __cpuidex(info, 7, 0);
+      avx2 = (info[1] & (1 << 5)) != 0;
+   }
+#else
+   __builtin_cpu_init();
+   sse42 = __builtin_cpu_supports("sse4.2");
+   pclmul = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+   avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+   uint32 features = 0;
+   if(sse42)features |= 1u << static_cast<uint32>(jm::CpuFeature::kSSE42);
+   if(pclmul)features |= 1u << static_cast<uint32>(jm::CpuFeature::kPCLMUL);
+   if(avx2)features |= 1u << static_cast<uint32>(jm::CpuFeature::kAVX2);
+   return features;
+}
+
+#endif
+
+bool jm::System::hasCpuFeature(CpuFeature feature)
+{
+#if defined(JM_X64)
+   static const uint32 features = detectCpuFeatures();
+   return (features & (1u << static_cast<uint32>(feature))) != 0;
+#else
+   (void)feature;
+   return false;
+#endif
 }
 
 const jm::String& jm::System::bundleId()
@@ -439,7 +497,7 @@ void jm::System::init(const jm::String& bundleId)
    gBundleId = bundleId;
 
    // Start autorelease pool
-   if(gMainThreadPool == nullptr)gMainThreadPool = new AutoreleasePool();
+   if(gMainThreadPool == nullptr)gMainThreadPool = new AutoreleasePool(true);
 
    // Load default translation
    I18nBundle::initDefault();
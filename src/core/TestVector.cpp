@@ -39,21 +39,19 @@ TestVector::TestVector(int argc, const char* argv[])
    {
       mArg = argv[1];
    }
-   mTests = new std::vector<Test*>();
 }
 
 TestVector::~TestVector()
 {
-   for(jm::Test* test: *mTests)
+   for(jm::Test* test: mTests)
    {
       delete test;
    }
-   delete mTests;
 }
 
 void TestVector::addTest(Test* test)
 {
-   mTests->push_back(test);
+   mTests.append(test);
 }
 
 size_t TestVector::execute()
@@ -75,23 +73,23 @@ size_t TestVector::execute()
       {}
    }
 
-   for(size_t a = 0; a < mTests->size(); a++)
+   for(size_t a = 0; a < mTests.size(); a++)
    {
-      if(single == npos || single == a)testrun(mTests->at(a));
+      if(single == npos || single == a)testrun(mTests[a]);
    }
 
    clock_t et = clock();
 
-   std::cout << std::endl << Tr("Cycle finished! In total:") << std::endl;
-   std::cout << Tr("Tests:    %1").arg(jm::gTotalTestCount) << std::endl;
+   std::cout << std::endl << TrLiteral("Cycle finished! In total:") << std::endl;
+   std::cout << TrLiteral("Tests:    %1").arg(jm::gTotalTestCount) << std::endl;
 
    std::cout <<
              ((jm::gTotalErrorCount > 0) ? kTxtRed : kTxtGreen)
-             << Tr("Errors:   %1").arg(jm::gTotalErrorCount)
+             << TrLiteral("Errors:   %1").arg(jm::gTotalErrorCount)
              << kTxtReset << std::endl;
 
    std::cout <<
-             Tr("Duration: %1 sec").arg(((double)(et - bt) / CLOCKS_PER_SEC), 1, 3)
+             TrLiteral("Duration: %1 sec").arg(((double)(et - bt) / CLOCKS_PER_SEC), 1, 3)
              << std::endl;
 
    return gTotalErrorCount;
@@ -101,7 +99,7 @@ void TestVector::testrun(Test* test) const
 {
    if(test == nullptr)return;
 
-   System::log(Tr("Execute %1...").arg(test->name()), LogLevel::kInformation);
+   System::log(TrLiteral("Execute %1...").arg(test->name()), LogLevel::kInformation);
 
    try
    {
@@ -113,7 +111,7 @@ void TestVector::testrun(Test* test) const
       test->testUnexpectedException(e.errorMessage());
    }
 
-   System::log(Tr("Test finished! %1 Tests, %2 Errors.")
+   System::log(TrLiteral("Test finished! %1 Tests, %2 Errors.")
                .arg(gTestCount)
                .arg(gErrorCount),
                LogLevel::kInformation);
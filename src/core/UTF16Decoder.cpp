@@ -41,50 +41,64 @@ UTF16Decoder::UTF16Decoder(bool isBE): CharsetDecoder()
 CharArray UTF16Decoder::decode(const char* cstring)
 {
    //Bestimme Länge
-   uint32 strLength = 0;
-   uint32 cntV = 0;
-   uint32 cntC = be ? 1 : 0;
-   uint32 start = 0;
+   size_t strLength = 0;
+   size_t cntC = be ? 1 : 0;
+   size_t start = 0;
 
    //Prüfe auf Steuerzeichen am Anfang des cstring. Wenn vorhanden ignoriere
-   if(cstring[0] == static_cast<char>(0xFE) &&
-         cstring[1] == static_cast<char>(0xFF))
+   if((cstring[0] == static_cast<char>(0xFE) && cstring[1] == static_cast<char>(0xFF)) ||
+         (cstring[0] == static_cast<char>(0xFF) && cstring[1] == static_cast<char>(0xFE)))
    {
       cntC = 2;
       start = 2;
    }
-   else if(cstring[0] == static_cast<char>(0xFF) &&
-           cstring[1] == static_cast<char>(0xFE))
-   {
-      cntC = 2;
-      start = 2;
-   }
-   else if(cstring[0] == static_cast<char>(0xEF) &&
-           cstring[1] == static_cast<char>(0xBB) &&
-           cstring[2] == static_cast<char>(0xBF))
-   {
-      throw Exception("UTF-8 Encoding detected.");
-   }
-
 
    while(cstring[cntC] != 0)
    {
       cntC += 2;
       strLength++;
    }
-   cntC = start;
 
    CharArray ret = CharArray(strLength);
-   while(cntV < strLength)
+   decode(cstring, start + 2 * strLength, ret.buffer);
+   return ret;
+}
+
+size_t UTF16Decoder::decode(const char* cString, size_t length, Char* target)
+{
+   size_t cntC = 0;
+
+   //Prüfe auf Steuerzeichen am Anfang des cstring. Wenn vorhanden ignoriere
+   if(length >= 2 &&
+         ((cString[0] == static_cast<char>(0xFE) && cString[1] == static_cast<char>(0xFF)) ||
+          (cString[0] == static_cast<char>(0xFF) && cString[1] == static_cast<char>(0xFE))))
+   {
+      cntC = 2;
+   }
+   else if(length >= 3 &&
+           cString[0] == static_cast<char>(0xEF) &&
+           cString[1] == static_cast<char>(0xBB) &&
+           cString[2] == static_cast<char>(0xBF))
+   {
+      throw Exception("UTF-8 Encoding detected.");
+   }
+
+   size_t cntV = 0;
+   while(cntC + 1 < length)
    {
-      uint16 c1 = (uint8)cstring[cntC++];
-      uint16 c2 = (uint8)cstring[cntC++];
+      uint16 c1 = static_cast<uint8>(cString[cntC++]);
+      uint16 c2 = static_cast<uint8>(cString[cntC++]);
 
-      if(be)ret.buffer[cntV] = Char((c1 << 8) | c2);
-      else ret.buffer[cntV] = Char(c1 | (c2 << 8));
+      if(be)target[cntV] = Char(static_cast<uint16>((c1 << 8) | c2));
+      else target[cntV] = Char(static_cast<uint16>(c1 | (c2 << 8)));
       cntV++;
    }
-   return ret;
+   return cntV;
+}
+
+size_t UTF16Decoder::maxLength(size_t length) const
+{
+   return length / 2;
 }
 
 ByteArray UTF16Decoder::encode(const CharArray& string)
@@ -31,8 +31,148 @@
 
 #include "PrecompiledCore.hpp"
 
+#if defined(JM_AVX2)
+#include <immintrin.h>
+#endif
+#if defined(JM_SSE2)
+#include <emmintrin.h>
+#endif
+
 using namespace jm;
 
+namespace
+{
+   /*!
+    \brief Returns true, if \p byte is a UTF-8 continuation byte (10xxxxxx).
+    */
+   inline bool isContinuation(uint8 byte)
+   {
+      return (byte & 0xC0) == 0x80;
+   }
+
+   #if defined(JM_AVX2)
+   /*!
+    \brief Widens the leading blocks of 32 ASCII bytes from \p source to \p target.
+    \return The number of converted bytes.
+    */
+   JM_TARGET("avx2") size_t decodeAsciiAvx2(const uint8* source, size_t length, Char* target)
+   {
+      size_t index = 0;
+      while(index + 32 <= length)
+      {
+         __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + index));
+         if(_mm256_movemask_epi8(bytes) != 0)break;
+         __m256i low = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(bytes));
+         __m256i high = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(bytes, 1));
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + index), low);
+         _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + index + 16), high);
+         index += 32;
+      }
+      return index;
+   }
+   #endif
+
+   /*!
+    \brief Copies the leading run of ASCII bytes from \p source to \p target, widening each byte
+    to one UTF-16 unit.
+    \return The number of converted bytes.
+    */
+   size_t decodeAscii(const uint8* source, size_t length, Char* target)
+   {
+      size_t index = 0;
+
+      #if defined(JM_AVX2)
+      static const bool avx2 = System::hasCpuFeature(CpuFeature::kAVX2);
+      if(avx2)index = decodeAsciiAvx2(source, length, target);
+      #endif
+
+      #if defined(JM_SSE2)
+      const __m128i zero = _mm_setzero_si128();
+      while(index + 16 <= length)
+      {
+         __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+         if(_mm_movemask_epi8(bytes) != 0)break;
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(target + index),
+                          _mm_unpacklo_epi8(bytes, zero));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(target + index + 8),
+                          _mm_unpackhi_epi8(bytes, zero));
+         index += 16;
+      }
+      #else
+      while(index + 8 <= length)
+      {
+         uint64 word;
+         memcpy(&word, source + index, 8);
+         if((word & 0x8080808080808080ULL) != 0)break;
+         for(size_t a = 0; a < 8; a++)target[index + a] = Char(source[index + a]);
+         index += 8;
+      }
+      #endif
+
+      while(index < length && source[index] < 0x80)
+      {
+         target[index] = Char(source[index]);
+         index++;
+      }
+      return index;
+   }
+
+   /*!
+    \brief Returns the number of leading UTF-16 units in \p source, which are below 0x80.
+    */
+   size_t countAscii(const Char* source, size_t length)
+   {
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      const __m128i mask = _mm_set1_epi16(static_cast<int16>(0xFF80));
+      const __m128i zero = _mm_setzero_si128();
+      while(index + 8 <= length)
+      {
+         __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+         __m128i high = _mm_cmpeq_epi16(_mm_and_si128(units, mask), zero);
+         if(_mm_movemask_epi8(high) != 0xFFFF)break;
+         index += 8;
+      }
+      #endif
+
+      while(index < length && source[index].unicode() < 0x80)index++;
+      return index;
+   }
+
+   /*!
+    \brief Narrows the leading \p count UTF-16 units of \p source, which must all be ASCII, to
+    single bytes.
+    */
+   void encodeAscii(const Char* source, size_t count, uint8* target)
+   {
+      size_t index = 0;
+
+      #if defined(JM_SSE2)
+      while(index + 16 <= count)
+      {
+         __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index));
+         __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + index + 8));
+         _mm_storeu_si128(reinterpret_cast<__m128i*>(target + index), _mm_packus_epi16(low, high));
+         index += 16;
+      }
+      #endif
+
+      for(; index < count; index++)target[index] = static_cast<uint8>(source[index].unicode());
+   }
+
+   /*!
+    \brief Returns true, if a valid surrogate pair starts at \p index.
+    */
+   inline bool isSurrogatePair(const Char* source, size_t length, size_t index)
+   {
+      if(index + 1 >= length)return false;
+      uint16 high = source[index].unicode();
+      uint16 low = source[index + 1].unicode();
+      return high >= 0xD800 && high < 0xDC00 && low >= 0xDC00 && low < 0xE000;
+   }
+}
+
 UTF8Decoder::UTF8Decoder(): CharsetDecoder()
 {
 
@@ -40,159 +180,181 @@ UTF8Decoder::UTF8Decoder(): CharsetDecoder()
 
 CharArray UTF8Decoder::decode(const char* cstring)
 {
-   //Bestimme Länge
-   uint32 strLength = 0;
-   uint32 cntV = 0;
-   uint32 cntC = 0;
-   uint32 start = 0;
+   return decode(cstring, strlen(cstring));
+}
 
+CharArray UTF8Decoder::decode(const char* cstring, size_t length)
+{
+   // Every UTF-8 sequence yields at most one UTF-16 unit per byte, so length is an upper bound.
+   CharArray ret = CharArray(length);
+   ret.length = transcode(reinterpret_cast<const uint8*>(cstring), length, ret.buffer);
+   return ret;
+}
+
+size_t UTF8Decoder::decode(const char* cString, size_t length, Char* target)
+{
+   return transcode(reinterpret_cast<const uint8*>(cString), length, target);
+}
+
+size_t UTF8Decoder::transcode(const uint8* source, size_t length, Char* target)
+{
+   size_t cntC = 0;
+   size_t cntV = 0;
 
    //Prüfe auf Steuerzeichen am Anfang des cstring. Wenn vorhanden ignoriere
-   if(cstring[0] == static_cast<char>(0xFE) &&
-         cstring[1] == static_cast<char>(0xFF))
+   if(length >= 2 && source[0] == 0xFE && source[1] == 0xFF)
    {
       throw Exception("UTF-16 (BE) encoding detected.");
    }
-   else if(cstring[0] == static_cast<char>(0xFF) &&
-           cstring[1] == static_cast<char>(0xFE))
+   else if(length >= 2 && source[0] == 0xFF && source[1] == 0xFE)
    {
       throw Exception("UTF-16 (LE) encoding detected.");
    }
-   else if(cstring[0] == static_cast<char>(0xEF) &&
-           cstring[1] == static_cast<char>(0xBB) &&
-           cstring[2] == static_cast<char>(0xBF))
+   else if(length >= 3 && source[0] == 0xEF && source[1] == 0xBB && source[2] == 0xBF)
    {
       cntC = 3;
-      start = 3;
    }
 
-   while(cstring[cntC] != 0)
+   while(cntC < length)
    {
-      uint8 c = static_cast<uint8>(cstring[cntC]);
+      uint8 c = source[cntC];
 
-      if((c & 0x80) == 0)     //1 Zeichen
+      if(c < 0x80)   //1 Zeichen, ganze ASCII-Folge auf einmal
       {
-         strLength++;
-         cntC++;
-      }
-      else if((c & 0xE0) == 0xC0)     //2 Zeichen
-      {
-         strLength++;
-         cntC += 2;
+         size_t count = decodeAscii(source + cntC, length - cntC, target + cntV);
+         cntC += count;
+         cntV += count;
+         continue;
       }
-      else if((c & 0xF0) == 0xE0)     //3 Zeichen
-      {
-         strLength++;
-         cntC += 3;
-      }
-      else if((c & 0xF8) == 0xF0)     //4 Zeichen
-      {
-         strLength++;
-         cntC += 4;
-      }
-      else
-      {
-         // In fact an encoding error, but we then take the byte as a single character
-         strLength++;
-         cntC++;
-      }
-   }
-   cntC = start;
 
-   CharArray ret = CharArray(strLength);
-   uint16 d, e, f;
-   while(cntV < strLength)
-   {
-      uint16 c = (uint8)cstring[cntC];
+      const size_t remaining = length - cntC;
 
-      if((c & 0x80) == 0)     //1 Zeichen
-      {
-         ret.buffer[cntV] = Char(c);
-         cntV++;
-         cntC++;
-      }
-      else if((c & 0xE0) == 0xC0)     //2 Zeichen
+      // 2 Zeichen. C0 and C1 would be overlong encodings.
+      if(c >= 0xC2 && c < 0xE0 && remaining >= 2 && isContinuation(source[cntC + 1]))
       {
-         c = static_cast<uint16>((c & 0x001F) << 6);
-         d = cstring[cntC + 1] & 0x3F;
-         ret.buffer[cntV] = Char(c | d);
-         cntV++;
+         target[cntV++] = Char(static_cast<uint16>(((c & 0x1F) << 6) | (source[cntC + 1] & 0x3F)));
          cntC += 2;
       }
-      else if((c & 0xF0) == 0xE0)     //3 Zeichen
+      // 3 Zeichen. Surrogates are accepted, so that text written by older versions (CESU-8)
+      // can still be read.
+      else if((c & 0xF0) == 0xE0 && remaining >= 3 &&
+              isContinuation(source[cntC + 1]) &&
+              isContinuation(source[cntC + 2]) &&
+              (c != 0xE0 || source[cntC + 1] >= 0xA0))
       {
-         c = static_cast<uint16>((c & 0x000F) << 12);
-         d = (cstring[cntC + 1] & 0x3F) << 6;
-         e = cstring[cntC + 2] & 0x3F;
-         ret.buffer[cntV] = Char(c | d | e);
-         cntV++;
+         target[cntV++] = Char(static_cast<uint16>(((c & 0x0F) << 12) |
+                                                   ((source[cntC + 1] & 0x3F) << 6) |
+                                                   (source[cntC + 2] & 0x3F)));
          cntC += 3;
       }
-      else if((c & 0xF8) == 0xF0)     //4 Zeichen
+      // 4 Zeichen. Code points beyond the BMP become a surrogate pair.
+      else if(c >= 0xF0 && c < 0xF5 && remaining >= 4 &&
+              isContinuation(source[cntC + 1]) &&
+              isContinuation(source[cntC + 2]) &&
+              isContinuation(source[cntC + 3]))
       {
-         c = (c & 0x0007) << 18;
-         d = (cstring[cntC + 1] & 0x3F) << 12;
-         e = (cstring[cntC + 2] & 0x3F) << 6;
-         f = cstring[cntC + 3] & 0x3F;
-         ret.buffer[cntV] = Char(c | d | e | f);
-         cntV++;
-         cntC += 4;
+         uint32 code = (static_cast<uint32>(c & 0x07) << 18) |
+                       (static_cast<uint32>(source[cntC + 1] & 0x3F) << 12) |
+                       (static_cast<uint32>(source[cntC + 2] & 0x3F) << 6) |
+                       static_cast<uint32>(source[cntC + 3] & 0x3F);
+         if(code >= 0x10000 && code <= 0x10FFFF)
+         {
+            code -= 0x10000;
+            target[cntV++] = Char(static_cast<uint16>(0xD800 | (code >> 10)));
+            target[cntV++] = Char(static_cast<uint16>(0xDC00 | (code & 0x3FF)));
+            cntC += 4;
+         }
+         else
+         {
+            //Friss Encoding-Fehler
+            target[cntV++] = Char(static_cast<uint16>(c));
+            cntC++;
+         }
+      }
+      else if(c == 0xFF && remaining >= 2 && source[cntC + 1] == 0xFE)
+      {
+         cntC += 2; //Steuerzeichen. erstmal ignorieren http://de.wikipedia.org/wiki/Unicodeblock_Spezielles
       }
-      else if(c == 0xFF
-              && ((uint8)cstring[cntC + 1]) == 0xFE)cntC += 2; //Steuerzeichen. erstmal ignorieren http://de.wikipedia.org/wiki/Unicodeblock_Spezielles
       else
       {
-         //Friss Encoding-Fehler
-         ret.buffer[cntV] = Char(c);
-         cntV++;
+         // In fact an encoding error, but we then take the byte as a single character
+         target[cntV++] = Char(static_cast<uint16>(c));
          cntC++;
       }
    }
-   return ret;
+   return cntV;
 }
 
 ByteArray UTF8Decoder::encode(const CharArray& string)
 {
-   uint32 cntC = 0;
-   for(uint32 a = 0; a < string.length; a++)
+   const Char* source = string.buffer;
+   const size_t length = string.length;
+
+   size_t cntC = 0;
+   size_t a = 0;
+   while(a < length)
    {
-      uint16 character = string.buffer[a].unicode();
-      if(character < 0x80)   //1 Zeichen
+      size_t count = countAscii(source + a, length - a);
+      cntC += count;
+      a += count;
+      if(a >= length)break;
+
+      uint16 character = source[a].unicode();
+      if(character < 0x800)   //2 Zeichen
       {
-         cntC += 1;
+         cntC += 2;
+         a++;
       }
-      else if(character < 0x800)   //2 Zeichen
+      else if(isSurrogatePair(source, length, a))   //4 Zeichen
       {
-         cntC += 2;
+         cntC += 4;
+         a += 2;
       }
       else//3 Zeichen
       {
          cntC += 3;
+         a++;
       }
    }
 
    ByteArray cstring = ByteArray(cntC, 0);
+   uint8* target = reinterpret_cast<uint8*>(cstring.data());
    cntC = 0;
-   for(size_t a = 0; a < string.length; a++)
+   a = 0;
+   while(a < length)
    {
-      uint16 character = string.buffer[a].unicode();
-      if(character < 0x80)   //1 Zeichen
+      size_t count = countAscii(source + a, length - a);
+      encodeAscii(source + a, count, target + cntC);
+      cntC += count;
+      a += count;
+      if(a >= length)break;
+
+      uint16 character = source[a].unicode();
+      if(character < 0x800)   //2 Zeichen
       {
-         cstring[cntC] = (uint8)character;
-         cntC += 1;
+         target[cntC] = static_cast<uint8>(((character >> 6) & 0x1F) | 0xC0);
+         target[cntC + 1] = static_cast<uint8>((character & 0x3F) | 0x80);
+         cntC += 2;
+         a++;
       }
-      else if(character < 0x800)   //2 Zeichen
+      else if(isSurrogatePair(source, length, a))   //4 Zeichen
       {
-         cstring[cntC] = (int8)((character >> 6) & 0x1F) | 0xC0;
-         cstring[cntC + 1] = (int8)(character & 0x3F) | 0x80;
-         cntC += 2;
+         uint32 code = 0x10000 + ((static_cast<uint32>(character & 0x3FF) << 10) |
+                                  (source[a + 1].unicode() & 0x3FFu));
+         target[cntC] = static_cast<uint8>((code >> 18) | 0xF0);
+         target[cntC + 1] = static_cast<uint8>(((code >> 12) & 0x3F) | 0x80);
+         target[cntC + 2] = static_cast<uint8>(((code >> 6) & 0x3F) | 0x80);
+         target[cntC + 3] = static_cast<uint8>((code & 0x3F) | 0x80);
+         cntC += 4;
+         a += 2;
       }
       else//3 Zeichen
       {
-         cstring[cntC] = (int8)((character >> 12) & 0x0F) | 0xE0;
-         cstring[cntC + 1] = (int8)((character >> 6) & 0x3F) | 0x80;
-         cstring[cntC + 2] = (int8)(character & 0x3F) | 0x80;
+         target[cntC] = static_cast<uint8>(((character >> 12) & 0x0F) | 0xE0);
+         target[cntC + 1] = static_cast<uint8>(((character >> 6) & 0x3F) | 0x80);
+         target[cntC + 2] = static_cast<uint8>((character & 0x3F) | 0x80);
          cntC += 3;
+         a++;
       }
    }
    return cstring;
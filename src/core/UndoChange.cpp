@@ -473,6 +473,55 @@ void UndoRegenerationMarker::swap()
    UndoChange::swap();
 }
 
+//
+// Link
+//
+
+UndoChangeLink::UndoChangeLink(LinkedListBase* list, LinkedListHook* item, LinkedListHook* before,
+                               bool linked): UndoChange(list)
+{
+   mList = list;
+   mItem = item;
+   mBefore = before;
+   mLinked = linked;
+   mPayload = list->payload(item);
+   if(mPayload != nullptr)mPayload->retain();
+}
+
+UndoChangeLink::~UndoChangeLink()
+{
+   // Nobody else refers to an unlinked element.
+   if(!mLinked)mList->dispose(mItem);
+   if(mPayload != nullptr)mPayload->release();
+}
+
+void UndoChangeLink::swap()
+{
+   if(mLinked)mList->erase(mItem);
+   else mList->insert(mItem, mBefore);
+   mLinked = !mLinked;
+
+   UndoChange::swap();
+}
+
+//
+// Swap data
+//
+
+UndoChangeSwapData::UndoChangeSwapData(LinkedList* list, LListElement* item1,
+                                       LListElement* item2): UndoChange(list)
+{
+   mList = list;
+   mItem1 = item1;
+   mItem2 = item2;
+}
+
+void UndoChangeSwapData::swap()
+{
+   mList->swapElementData(mItem1, mItem2);
+   UndoChange::swap();
+}
+
 UndoObjectRelease::UndoObjectRelease(Object* object, bool release): UndoChange(object)
 {
    // Nothing to do here. The super method will retain() the object.
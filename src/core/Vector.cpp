@@ -57,6 +57,14 @@ jm::Vector::Vector(const Vector& another)
    else data = nullptr;
 }
 
+jm::Vector::Vector(Vector&& another) noexcept
+{
+   m = another.m;
+   data = another.data;
+   another.m = 0;
+   another.data = nullptr;
+}
+
 jm::Vector::~Vector()
 {
    if(data != nullptr)delete[] data;
@@ -127,7 +135,21 @@ jm::Vector& jm::Vector::operator=(const jm::Vector& another)
    return *this;
 }
 
-const jm::Vector jm::operator+(const jm::Vector& v1, const jm::Vector& v2)
+jm::Vector& jm::Vector::operator=(jm::Vector&& another) noexcept
+{
+   if(this != &another)
+   {
+      if(data != nullptr)delete[] data;
+      m = another.m;
+      data = another.data;
+      another.m = 0;
+      another.data = nullptr;
+   }
+
+   return *this;
+}
+
+jm::Vector jm::operator+(const jm::Vector& v1, const jm::Vector& v2)
 {
    if(v1.m != v2.m) throw Exception("Dimensions don't match");
    jm::Vector v = jm::Vector(v1.m);
@@ -137,7 +159,7 @@ const jm::Vector jm::operator+(const jm::Vector& v1, const jm::Vector& v2)
    return v;
 }
 
-const jm::Vector jm::operator-(const jm::Vector& v1, const jm::Vector& v2)
+jm::Vector jm::operator-(const jm::Vector& v1, const jm::Vector& v2)
 {
    if(v1.m != v2.m) throw Exception("Dimensions don't match");
 
@@ -148,7 +170,7 @@ const jm::Vector jm::operator-(const jm::Vector& v1, const jm::Vector& v2)
    return v;
 }
 
-const jm::Vector jm::operator*(const double& d, const jm::Vector& v)
+jm::Vector jm::operator*(const double& d, const jm::Vector& v)
 {
    jm::Vector r = jm::Vector(v.m);
 
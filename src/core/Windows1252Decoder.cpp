@@ -71,13 +71,17 @@ CharArray Windows1252Decoder::decode(const char* cstring)
    while(cstring[length] != 0)length++;
 
    CharArray array = CharArray(length);
+   decode(cstring, length, array.buffer);
+   return array;
+}
 
-   for(uint32 a = 0; a < length; a++)
+size_t Windows1252Decoder::decode(const char* cString, size_t length, Char* target)
+{
+   for(size_t a = 0; a < length; a++)
    {
-      array.buffer[a] = codepage[static_cast<uint8>(cstring[a])];
+      target[a] = codepage[static_cast<uint8>(cString[a])];
    }
-
-   return array;
+   return length;
 }
 
 ByteArray Windows1252Decoder::encode(const CharArray& string)
@@ -31,6 +31,8 @@
 
 #include "PrecompiledCore.hpp"
 
+#include <memory>
+
 using namespace jm;
 
 //
@@ -92,7 +94,7 @@ void ZipFile::open()
    }
    while(seek > 0);
 
-   if(!found)throw jm::Exception(Tr("ZIP-File is invalid."));
+   if(!found)throw jm::Exception(TrLiteral("ZIP-File is invalid."));
 
    uint16 recordCount = jm::deserializeLEUInt16((uint8*)eocd.constData(), 10);
    uint32 dictSize = jm::deserializeLEUInt32((uint8*)eocd.constData(), 12);
@@ -108,6 +110,7 @@ void ZipFile::open()
    while(count < recordCount)
    {
       //signature = jm::DeserializeLEInt32(dict, index);
+      uint32 crc = jm::deserializeLEUInt32((uint8*)dict.constData(), index + 16);
       uint32 compressedSize = jm::deserializeLEUInt32((uint8*)dict.constData(), index + 20);
       uint32 uncompressedSize = jm::deserializeLEUInt32((uint8*)dict.constData(), index + 24);
       uint32 fileNameLength = jm::deserializeLEUInt16((uint8*)dict.constData(), index + 28);
@@ -123,6 +126,7 @@ void ZipFile::open()
       ZipEntry* entry = new ZipEntry(name);
       entry->mExtra = extra;
       entry->mComment = comment;
+      entry->mCRC = crc;
       entry->mUncompressedSize = uncompressedSize;
       entry->mCompressedSize = compressedSize;
       entry->mHeaderOffset = offset;
@@ -172,8 +176,6 @@ size_t ZipFile::entryCount() const
 
 jm::Stream* ZipFile::stream(const ZipEntry* entry)
 {
-   ByteArray input = ByteArray(entry->mCompressedSize, 0);
-
    //Local Header
    ByteArray localHeader = ByteArray(30, 0);
    mFile->seek(entry->mHeaderOffset);
@@ -182,7 +184,7 @@ jm::Stream* ZipFile::stream(const ZipEntry* entry)
 
    if(signature != 0x04034b50)
    {
-      throw jm::Exception(Tr("ZIP file Error. Signature of Entry wrong."));
+      throw jm::Exception(TrLiteral("ZIP file Error. Signature of Entry wrong."));
    }
 
    ZipCompression cm = static_cast<ZipCompression>(jm::deserializeLEUInt16(localHeader, 8));
@@ -191,24 +193,60 @@ jm::Stream* ZipFile::stream(const ZipEntry* entry)
 
 
    mFile->seek(entry->mHeaderOffset + 30 + fl + el);
-   mFile->Stream::readFully(input);
 
-   uint8* buffer = nullptr;
+   std::unique_ptr<uint8[]> buffer;
    if(cm == ZipCompression::kNone ) //Daten uncompressed
    {
-      buffer = new uint8[entry->mUncompressedSize];
-      memcpy(buffer, input.constData(), entry->mCompressedSize);
+      if(entry->mCompressedSize != entry->mUncompressedSize)
+      {
+         throw jm::Exception(TrLiteral("ZIP file Error. Size of stored entry is wrong."));
+      }
+      ByteArray input = ByteArray(entry->mCompressedSize, 0);
+      mFile->Stream::readFully(input);
+      buffer.reset(new uint8[entry->mUncompressedSize]);
+      memcpy(buffer.get(), input.constData(), entry->mCompressedSize);
    }
    if(cm == ZipCompression::kDeflate) //Deflate
    {
+      // The compressed data is read in chunks and inflated directly into the buffer.
+      buffer.reset(new uint8[entry->mUncompressedSize]);
+      ByteArray input = ByteArray(std::min(static_cast<size_t>(entry->mCompressedSize),
+                                           static_cast<size_t>(65536)), 0);
+      size_t remaining = entry->mCompressedSize;
+      size_t length = 0;
+
       Inflater inf = Inflater(true);
-      size_t control;
-      inf.SetInput(reinterpret_cast<uint8*>(input.data()), entry->mCompressedSize);
-      // buffer is initialized and set by Inflater
-      inf.Inflate(buffer, control);
+      while(!inf.Finished() && length < entry->mUncompressedSize)
+      {
+         if(inf.NeedsInput())
+         {
+            const size_t count = mFile->readFully(input, std::min(remaining, input.size()));
+            if(count == 0)
+            {
+               throw jm::Exception(
+                  TrLiteral("ZIP file Error. Compressed data of entry is truncated."));
+            }
+            inf.SetInput(reinterpret_cast<uint8*>(input.data()), count);
+            remaining -= count;
+         }
+         length += inf.Inflate(buffer.get(), length, entry->mUncompressedSize - length);
+      }
+
+      if(length < entry->mUncompressedSize)
+      {
+         throw jm::Exception(TrLiteral("ZIP file Error. Uncompressed data of entry is too short."));
+      }
+   }
+
+   // The CRC of the central directory verifies the data.
+   if(buffer != nullptr && CRC::crc32(0, buffer.get(), entry->mUncompressedSize) != entry->mCRC)
+   {
+      throw jm::Exception(TrLiteral("ZIP file Error. CRC of entry is wrong."));
    }
 
-   return new MemoryStream(buffer, entry->mUncompressedSize, true);
+   MemoryStream* stream = new MemoryStream(buffer.get(), entry->mUncompressedSize, true);
+   buffer.release();
+   return stream;
 }
 
 //
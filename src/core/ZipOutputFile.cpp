@@ -33,25 +33,6 @@
 
 using namespace jm;
 
-uint32 CRC32(const char* s, uint32 n)
-{
-   uint32 crc = 0xFFFFFFFF;
-
-   for(uint32 i = 0; i < n; i++)
-   {
-      char ch = s[i];
-      for(uint32 j = 0; j < 8; j++)
-      {
-         uint32 b = (static_cast<uint32>(ch) ^ crc) & 1;
-         crc >>= 1;
-         if(b) crc = crc ^ 0xEDB88320;
-         ch >>= 1;
-      }
-   }
-
-   return ~crc;
-}
-
 ZipOutputFile::ZipOutputFile(File* file): jm::Object(),
    mEntries(this)
 {
@@ -139,7 +120,8 @@ void ZipOutputFile::closeEntry()
    mTemp = nullptr;
 
    //CRC berechnen
-   entry->mCRC = CRC32(buffer.constData(), entry->mUncompressedSize);
+   entry->mCRC = CRC::crc32(0, reinterpret_cast<const uint8*>(buffer.constData()),
+                            entry->mUncompressedSize);
 
    //Schreibe unkomprimiert
    entry->mCompressedSize = entry->mUncompressedSize;
@@ -163,45 +145,72 @@ void ZipOutputFile::writeAndClose(jm::File* file)
    ZipEntry* entry = static_cast<ZipEntry*>(mEntries.last());
 
    entry->mUncompressedSize = static_cast<uint32>(file->size());
-   file->open(FileMode::kRead);
-   ByteArray buffer = ByteArray(entry->mUncompressedSize, 0);
-   file->Stream::readFully(buffer);
-   file->close();
-
-
 
    mTemp->close();
    mTemp->remove();
    delete mTemp;
    mTemp = nullptr;
 
-   //CRC berechnen
-   entry->mCRC = CRC32(buffer.constData(), entry->mUncompressedSize);
+   // The file is processed in chunks, so the memory does not depend on its size.
+   const size_t chunkSize = 65536;
+   ByteArray input = ByteArray(chunkSize, 0);
+   size_t remaining = entry->mUncompressedSize;
+   entry->mCRC = 0;
+   entry->mCompressedSize = 0;
+   file->open(FileMode::kRead);
 
    uint32 pos=0;
 
    //Schreibe unkomprimiert
    if(entry->mCompressionMethod==ZipCompression::kNone)
    {
-      entry->mCompressedSize = entry->mUncompressedSize;
-
-      mFile->write(reinterpret_cast<const uint8*>(buffer.constData()), entry->mCompressedSize);
+      while(remaining > 0)
+      {
+         const size_t count = file->readFully(input, std::min(remaining, chunkSize));
+         if(count == 0)break;
+         const uint8* data = reinterpret_cast<const uint8*>(input.constData());
+         entry->mCRC = CRC::crc32(entry->mCRC, data, count);
+         mFile->write(data, count);
+         entry->mCompressedSize += static_cast<uint32>(count);
+         remaining -= count;
+      }
    }
    else if(entry->mCompressionMethod==ZipCompression::kDeflate)
    {
-      uint8* output = nullptr;
-      size_t outputLength=0;
+      ByteArray output = ByteArray(chunkSize, 0);
+      uint8* outputData = reinterpret_cast<uint8*>(output.data());
 
+      // Large entries are compressed on all processor cores.
       jm::Deflater deflater=jm::Deflater(true);
-      deflater.reset();
-      deflater.setInput((uint8*)buffer.constData(),entry->mUncompressedSize);
-      deflater.deflate(output, outputLength);
-      entry->mCompressedSize = (uint32)outputLength;
+      if(remaining > Deflater::kBlockSize)deflater.setThreads(0);
+      while(!deflater.finished())
+      {
+         if(deflater.needsInput())
+         {
+            const size_t count = remaining > 0 ?
+                                 file->readFully(input, std::min(remaining, chunkSize)) : 0;
+            if(count == 0)deflater.finish();
+            else
+            {
+               const uint8* data = reinterpret_cast<const uint8*>(input.constData());
+               entry->mCRC = CRC::crc32(entry->mCRC, data, count);
+               deflater.setInput(reinterpret_cast<uint8*>(input.data()), count);
+               remaining -= count;
+            }
+         }
+
+         const size_t count = deflater.deflate(outputData, 0, chunkSize);
+         mFile->write(outputData, count);
+      }
+      entry->mCompressedSize = static_cast<uint32>(deflater.totalOutSize());
+   }
+   file->close();
 
-      mFile->write(output, entry->mCompressedSize);
+   // The sizes in the header are already fixed, so a file, which ended early, gives a broken entry.
+   if(remaining > 0)
+      throw jm::Exception(
+         TrLiteral("ZIP file Error. Data of entry is shorter than the file size."));
 
-      delete[]output;
-   }
    pos = static_cast<uint32>(mFile->position());
 
    //Aktualisiere Header
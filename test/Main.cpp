@@ -9,6 +9,10 @@
 #include "core/Core.h"
 
 #include "core/GeometryTest.h"
+#include "core/HashMapTest.h"
+#include "core/ConcurrentHashMapTest.h"
+#include "core/AtomTest.h"
+#include "core/I18nBundleTest.h"
 #include "core/HashtableTest.h"
 #include "core/LinkedListTest.h"
 #include "core/MathTest.h"
@@ -24,6 +28,18 @@
 #include "core/StringListTest.h"
 #include "core/SerializerTest.h"
 #include "core/NurbsTest.h"
+#include "core/ObjectTest.h"
+#include "core/MoveTest.h"
+#include "core/ObjectBenchmark.h"
+#include "core/StringBenchmark.h"
+#include "core/HashtableBenchmark.h"
+#include "core/SortBenchmark.h"
+#include "core/LinkedListBenchmark.h"
+#include "core/DeflateBenchmark.h"
+#include "core/CRCBenchmark.h"
+#include "core/CRCTest.h"
+#include "core/SortTest.h"
+#include "core/ArrayListTest.h"
 
 using namespace jm;
 
@@ -32,18 +48,33 @@ int main(int argc, const char* argv[])
    System::init("de.jameo.testsuite");
    System::log("Test Suite for VertexFusion ", jm::LogLevel::kInformation);
 
+   // Benchmarks take long and are only registered with the argument "--benchmark".
+   bool benchmark = false;
+   for(int index = 1; index < argc; index++)
+   {
+      if(String(argv[index]) == "--benchmark")benchmark = true;
+   }
+
    TestVector* vec = new TestVector(argc, argv);
 
+   vec->addTest(new ObjectTest());
    vec->addTest(new StringTest());
    vec->addTest(new StringListTest());
    vec->addTest(new StringTokenizerTest());
+   vec->addTest(new SortTest());
+   vec->addTest(new ArrayListTest());
    vec->addTest(new HashtableTest());
+   vec->addTest(new HashMapTest());
+   vec->addTest(new ConcurrentHashMapTest());
+   vec->addTest(new AtomTest());
+   vec->addTest(new I18nBundleTest());
    vec->addTest(new LinkedListTest());
    vec->addTest(new MathTest());
    vec->addTest(new VertexTest());
    vec->addTest(new MatrixTest());
    vec->addTest(new GeometryTest());
    vec->addTest(new DeflateTest());
+   vec->addTest(new CRCTest());
    vec->addTest(new UndoManagerTest());
    vec->addTest(new DateTest());
    vec->addTest(new DeflateTest());
@@ -51,6 +82,18 @@ int main(int argc, const char* argv[])
    vec->addTest(new FileTest());
    vec->addTest(new SerializerTest());
    vec->addTest(new NurbsTest());
+   vec->addTest(new MoveTest());
+
+   if(benchmark)
+   {
+      vec->addTest(new ObjectBenchmark());
+      vec->addTest(new StringBenchmark());
+      vec->addTest(new HashtableBenchmark());
+      vec->addTest(new SortBenchmark());
+      vec->addTest(new LinkedListBenchmark());
+      vec->addTest(new DeflateBenchmark());
+      vec->addTest(new CRCBenchmark());
+   }
 
    int32 result = static_cast<int32>(vec->execute());
 
@@ -0,0 +1,262 @@
+//
+//  ArrayListTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <memory>
+
+#include "core/Core.h"
+#include "ArrayListTest.h"
+
+using namespace jm;
+
+//! Number of living Tracked objects.
+static int64 gTrackedCount = 0;
+
+//! Element type, which is not trivially copyable and counts its instances.
+class Tracked
+{
+   public:
+
+      Tracked(): mValue(0)
+      {
+         gTrackedCount++;
+      }
+
+      explicit Tracked(int64 value): mValue(value)
+      {
+         gTrackedCount++;
+      }
+
+      Tracked(const Tracked& other): mValue(other.mValue)
+      {
+         gTrackedCount++;
+      }
+
+      Tracked(Tracked&& other) noexcept: mValue(other.mValue)
+      {
+         other.mValue = -1;
+         gTrackedCount++;
+      }
+
+      ~Tracked()
+      {
+         gTrackedCount--;
+      }
+
+      Tracked& operator=(const Tracked& other) = default;
+
+      Tracked& operator=(Tracked&& other) noexcept
+      {
+         mValue = other.mValue;
+         other.mValue = -1;
+         return *this;
+      }
+
+      int64 value() const
+      {
+         return mValue;
+      }
+
+   private:
+
+      int64 mValue;
+};
+
+ArrayListTest::ArrayListTest(): Test()
+{
+   setName("Test ArrayList");
+}
+
+void ArrayListTest::doTest()
+{
+   testAppend();
+   testInline();
+   testInsertRemove();
+   testCopyMove();
+   testLifetime();
+   testStringList();
+}
+
+void ArrayListTest::testAppend()
+{
+   ArrayList<int64> list;
+   testTrue(list.isEmpty(), "ArrayList is not empty");
+   testEquals(list.capacity(), 0u, "ArrayList allocates without elements");
+
+   size_t reallocations = 0;
+   size_t capacity = list.capacity();
+   bool ok = true;
+   for(int64 index = 0; index < 100000; index++)
+   {
+      list.append(index);
+      if(list.capacity() != capacity)
+      {
+         capacity = list.capacity();
+         reallocations++;
+      }
+   }
+   for(size_t index = 0; index < list.size(); index++)
+   {
+      if(list[index] != static_cast<int64>(index))ok = false;
+   }
+   testTrue(ok, "ArrayList::append() fails");
+   testEquals(list.size(), 100000u, "ArrayList::size() fails");
+   testTrue(reallocations <= 16, "ArrayList does not grow geometrically");
+
+   // Appending an element of the list itself, while the list grows.
+   ArrayList<String> strings;
+   strings.append("first");
+   while(strings.size() < strings.capacity())strings.append("x");
+   strings.append(strings[0]);
+   testEquals(strings.last(), "first", "ArrayList::append() of own element fails");
+
+   // reserve() keeps the size and avoids reallocations.
+   ArrayList<int64> reserved;
+   reserved.reserve(1000);
+   const int64* data = reserved.data();
+   for(int64 index = 0; index < 1000; index++)reserved.append(index);
+   testTrue(reserved.data() == data, "ArrayList::reserve() fails");
+
+   // Move-only elements
+   ArrayList<std::unique_ptr<int64>> pointers;
+   for(int64 index = 0; index < 100; index++)pointers.emplace(new int64(index));
+   testEquals(*pointers[99], 99, "ArrayList::emplace() fails");
+
+   // resize() and shrinkToFit()
+   list.resize(10);
+   testEquals(list.size(), 10u, "ArrayList::resize() fails");
+   list.shrinkToFit();
+   testEquals(list.capacity(), 10u, "ArrayList::shrinkToFit() fails");
+   list.resize(12);
+   testEquals(list[11], 0, "ArrayList::resize() fails");
+}
+
+void ArrayListTest::testInline()
+{
+   ArrayList<int64, 8> list;
+   const uint8* begin = reinterpret_cast<const uint8*>(&list);
+   const uint8* end = begin + sizeof(list);
+   const uint8* data = reinterpret_cast<const uint8*>(list.data());
+   testTrue(data >= begin && data < end, "ArrayList has no inline buffer");
+   testEquals(list.capacity(), 8u, "ArrayList has no inline capacity");
+
+   for(int64 index = 0; index < 8; index++)list.append(index);
+   testTrue(reinterpret_cast<const uint8*>(list.data()) == data, "ArrayList allocates too early");
+
+   list.append(8);
+   testTrue(reinterpret_cast<const uint8*>(list.data()) != data, "ArrayList does not grow");
+   testEquals(list[8], 8, "ArrayList fails after growing");
+   testEquals(list[0], 0, "ArrayList fails after growing");
+
+   // Shrinking back into the inline buffer
+   list.resize(4);
+   list.shrinkToFit();
+   testTrue(reinterpret_cast<const uint8*>(list.data()) == data, "ArrayList::shrinkToFit() fails");
+   testEquals(list[3], 3, "ArrayList::shrinkToFit() fails");
+
+   // Moving an inline list moves the elements.
+   ArrayList<String, 4> strings;
+   strings.append("alpha");
+   strings.append("bravo");
+   ArrayList<String, 4> moved(std::move(strings));
+   testEquals(moved.size(), 2u, "ArrayList move of inline elements fails");
+   testEquals(moved[1], "bravo", "ArrayList move of inline elements fails");
+   testTrue(strings.isEmpty(), "ArrayList move of inline elements fails");
+}
+
+void ArrayListTest::testInsertRemove()
+{
+   ArrayList<String> list = {"a", "c", "e"};
+   list.insert(1, "b");
+   list.insert(3, "d");
+   list.insert(5, "f");
+   list.insert(0, list[2]);
+   testEquals(list.size(), 7u, "ArrayList::insert() fails");
+
+   String joined;
+   for(const String& item : list)joined << item;
+   testEquals(joined, "cabcdef", "ArrayList::insert() fails");
+
+   list.remove(0);
+   list.remove(5);
+   list.removeLast();
+   joined = "";
+   for(const String& item : list)joined << item;
+   testEquals(joined, "abcd", "ArrayList::remove() fails");
+   testEquals(list.first(), "a", "ArrayList::first() fails");
+}
+
+void ArrayListTest::testCopyMove()
+{
+   ArrayList<String> list;
+   for(int64 index = 0; index < 50; index++)list.append(String::valueOf(index));
+
+   ArrayList<String> copy(list);
+   testEquals(copy.size(), 50u, "ArrayList copy fails");
+   testEquals(copy[49], "49", "ArrayList copy fails");
+
+   ArrayList<String> moved(std::move(copy));
+   testEquals(moved.size(), 50u, "ArrayList move fails");
+   testTrue(copy.isEmpty(), "ArrayList move fails");
+
+   copy = moved;
+   testEquals(copy[10], "10", "ArrayList copy assignment fails");
+   copy = copy;
+   testEquals(copy.size(), 50u, "ArrayList self assignment fails");
+
+   ArrayList<String> assigned = {"x"};
+   assigned = std::move(moved);
+   testEquals(assigned[0], "0", "ArrayList move assignment fails");
+   testTrue(moved.isEmpty(), "ArrayList move assignment fails");
+}
+
+void ArrayListTest::testLifetime()
+{
+   gTrackedCount = 0;
+   {
+      ArrayList<Tracked, 2> list;
+      for(int64 index = 0; index < 100; index++)list.emplace(index);
+      testEquals(gTrackedCount, 100, "ArrayList leaks or destroys elements");
+
+      bool ok = true;
+      for(size_t index = 0; index < list.size(); index++)
+      {
+         if(list[index].value() != static_cast<int64>(index))ok = false;
+      }
+      testTrue(ok, "ArrayList relocation fails");
+
+      list.remove(10);
+      list.insert(0, Tracked(-5));
+      testEquals(gTrackedCount, 100, "ArrayList leaks or destroys elements");
+
+      ArrayList<Tracked, 2> copy = list;
+      testEquals(gTrackedCount, 200, "ArrayList leaks or destroys elements");
+
+      copy.resize(1);
+      testEquals(gTrackedCount, 101, "ArrayList::resize() leaks elements");
+      testEquals(copy[0].value(), -5, "ArrayList::insert() fails");
+
+      list.clear();
+      testEquals(gTrackedCount, 1, "ArrayList::clear() leaks elements");
+   }
+   testEquals(gTrackedCount, 0, "ArrayList leaks elements");
+}
+
+void ArrayListTest::testStringList()
+{
+   // StringList is based on ArrayList.
+   StringList list;
+   for(int64 index = 0; index < 20; index++)list.append(String::valueOf(index % 4));
+   list.remove("1");
+   testEquals(list.size(), 15u, "StringList::remove() fails");
+   testFalse(list.contains("1"), "StringList::remove() fails");
+
+   StringList copy = list;
+   list.clear();
+   testEquals(list.size(), 0u, "StringList::clear() fails");
+   testEquals(copy.join(','), "0,2,3,0,2,3,0,2,3,0,2,3,0,2,3", "StringList copy fails");
+}
@@ -0,0 +1,29 @@
+//
+//  ArrayListTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_ArrayListTest_h
+#define jm_ArrayListTest_h
+
+#include "core/Test.h"
+
+class ArrayListTest : public jm::Test
+{
+   public:
+      ArrayListTest();
+      void doTest();
+
+   private:
+      void testAppend();
+      void testInline();
+      void testInsertRemove();
+      void testCopyMove();
+      void testLifetime();
+      void testStringList();
+};
+
+#endif
@@ -0,0 +1,196 @@
+//
+//  AtomTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <thread>
+#include <vector>
+
+#include "core/Core.h"
+#include "core/Property.h"
+#include "AtomTest.h"
+
+using namespace jm;
+
+AtomTest::AtomTest(): Test()
+{
+   setName("Test Atom");
+}
+
+void AtomTest::doTest()
+{
+   testAtoms();
+   testThreads();
+   testUsers();
+   testTranslationKeys();
+}
+
+void AtomTest::testAtoms()
+{
+   const Atom empty;
+   testTrue(empty.isEmpty(), "Atom not empty");
+   testTrue(empty == Atom(""), "Atom of empty string differs");
+   testTrue(empty == Atom(String()), "Atom of empty string differs");
+
+   const Atom layer = Atom("LAYER");
+   const size_t count = Atom::count();
+   testTrue(layer == Atom(String("LAYER")), "Atom not unique");
+   testTrue(layer == Atom(std::string_view("LAYERS", 5)), "Atom not unique");
+   testTrue(&layer.string() == &Atom("LAYER").string(), "Atom not interned");
+   testEquals(Atom::count(), count, "Existing atom was created again");
+   testTrue(layer != Atom("layer"), "Atoms are equal");
+   testEquals(Atom::count(), count + 1, "Atom not created");
+
+   testEquals(layer.string(), "LAYER", "Atom content wrong");
+   testEquals(layer.size(), 5, "Atom size wrong");
+   testEquals(layer.hashCode(), String("LAYER").hashCode(), "Atom hash wrong");
+
+   const Atom umlaut = Atom("Gr\xC3\xBC\xC3\x9F" "e");
+   testEquals(umlaut.size(), 5, "Atom UTF-8 decoding fails");
+   testTrue(umlaut == Atom(String("Gr\xC3\xBC\xC3\x9F" "e")), "Atom UTF-8 decoding fails");
+
+   // Atoms as keys
+   HashMap<Atom, int32> map;
+   map.put(layer, 1);
+   map.put(umlaut, 2);
+   testEquals(*map.get(Atom("LAYER")), 1, "Atom as key fails");
+   testNull(map.get(Atom("LINE")), "Atom as key fails");
+}
+
+void AtomTest::testThreads()
+{
+   // Several threads create the same atoms at the same time.
+   std::vector<std::vector<Atom>> results(4);
+   std::vector<std::thread> threads;
+   for(size_t t = 0; t < results.size(); t++)
+   {
+      threads.emplace_back([&results, t]()
+      {
+         for(int64 a = 0; a < 2000; a++)
+         {
+            results[t].push_back(Atom(String("threaded-atom-%1").arg(a)));
+         }
+      });
+   }
+   for(std::thread& thread : threads)thread.join();
+
+   bool ok = true;
+   for(size_t index = 0; index < 2000; index++)
+   {
+      for(size_t t = 1; t < results.size(); t++)
+      {
+         if(results[t][index] != results[0][index])ok = false;
+      }
+   }
+   testTrue(ok, "Atoms created by several threads differ");
+   testEquals(results[0][1234].string(), "threaded-atom-1234", "Atom content wrong");
+}
+
+void AtomTest::testUsers()
+{
+   const Atom color = Atom("color");
+   const Atom width = Atom("width");
+
+   SAXAttributes attributes;
+   attributes.addAttribute(kEmptyString, "width", "width", "100");
+   attributes.addAttribute(kEmptyString, "color", "color", "red");
+   testEquals(attributes.indexOf(color), 1, "SAXAttributes indexOf(Atom) fails");
+   testEquals(attributes.value(width), "100", "SAXAttributes value(Atom) fails");
+   testTrue(attributes.hasValue(color), "SAXAttributes hasValue(Atom) fails");
+   testFalse(attributes.hasValue(Atom("height")), "SAXAttributes hasValue(Atom) fails");
+   testEquals(attributes.value("color"), "red", "SAXAttributes value(String) fails");
+
+   SAXAttributes copy(attributes);
+   testEquals(copy.value(color), "red", "SAXAttributes copy fails");
+
+   // Attribute names from documents do not become atoms.
+   const size_t atoms = Atom::count();
+   attributes.addAttribute(kEmptyString, "unknown-attribute", "unknown-attribute", "1");
+   testEquals(Atom::count(), atoms, "SAXAttributes interns attribute names");
+   testEquals(attributes.localName(2), "unknown-attribute", "SAXAttributes localName fails");
+
+   Property property("width");
+   testTrue(property.is(width), "Property is(Atom) fails");
+   testFalse(property.is(color), "Property is(Atom) fails");
+   testTrue(property.is("width"), "Property is(String) fails");
+   testEquals(property.id(), "width", "Property id fails");
+
+   I18nBundle bundle("de");
+   bundle.setValue("Width", String("Breite"));
+   testEquals(bundle.translate(Atom("Width")), "Breite", "I18nBundle translate(Atom) fails");
+   testEquals(bundle.translate(Atom("Height")), "Height", "I18nBundle translate(Atom) fails");
+}
+
+void AtomTest::testTranslationKeys()
+{
+   // The hash calculated by the compiler must be the one of String for all code paths of the hash
+   // function (up to 3, 16, 48 and more than 48 bytes).
+   constexpr TranslationKey<2> one("A");
+   static_assert(one.isPrecomputed() && one.size() == 1);
+   testEquals(one.hashCode(), String("A").hashCode(), "TranslationKey hash fails");
+
+   constexpr TranslationKey<1> empty("");
+   testEquals(empty.hashCode(), String().hashCode(), "TranslationKey hash fails");
+
+   constexpr auto label = literalKey("WARNING: ");
+   testEquals(label.hashCode(), String("WARNING: ").hashCode(), "TranslationKey hash fails");
+
+   constexpr auto medium = literalKey("Cannot open the selected file");
+   testEquals(medium.hashCode(), String("Cannot open the selected file").hashCode(),
+              "TranslationKey hash fails");
+
+   const char* text = "The file was saved with a newer version and may contain unknown data.";
+   constexpr auto longer =
+      literalKey("The file was saved with a newer version and may contain unknown data.");
+   testEquals(longer.size(), String(text).size(), "TranslationKey decoding fails");
+   testEquals(longer.hashCode(), String(text).hashCode(), "TranslationKey hash fails");
+
+   // Umlauts, CESU-8 surrogates and code points beyond the BMP
+   constexpr auto umlaut = literalKey("Gr\xC3\xB6\xC3\x9F" "e");
+   testEquals(umlaut.size(), 5, "TranslationKey decoding fails");
+   testEquals(umlaut.hashCode(), String("Gr\xC3\xB6\xC3\x9F" "e").hashCode(),
+              "TranslationKey hash fails");
+
+   constexpr auto emoji = literalKey("Smile \xF0\x9F\x98\x80 \xE2\x82\xAC");
+   testEquals(emoji.size(), 10, "TranslationKey decoding fails");
+   testEquals(emoji.hashCode(), String("Smile \xF0\x9F\x98\x80 \xE2\x82\xAC").hashCode(),
+              "TranslationKey hash fails");
+
+   // Invalid UTF-8 is left to the decoder at run time.
+   constexpr auto invalid = literalKey("Stra\xDF" "e");
+   testFalse(invalid.isPrecomputed(), "TranslationKey accepts invalid UTF-8");
+   constexpr auto bom = literalKey("\xEF\xBB\xBFKey");
+   testFalse(bom.isPrecomputed(), "TranslationKey accepts byte order mark");
+
+   // Translation with precomputed keys
+   I18nBundle bundle("de");
+   bundle.setValue("Width", String("Breite"));
+   bundle.setValue("Gr\xC3\xB6\xC3\x9F" "e", String("Size"));
+   testEquals(bundle.translate(literalKey("Width")), "Breite", "translate(key) fails");
+   testEquals(bundle.translate(literalKey("Gr\xC3\xB6\xC3\x9F" "e")), "Size",
+              "translate(key) fails");
+   testEquals(bundle.translate(literalKey("Stra\xDF" "e")), String("Stra\xDF" "e"),
+              "translate(key) fails");
+
+   // The untranslated key is interned once.
+   testEquals(bundle.translate(literalKey("Height")), "Height", "translate(key) fails");
+   const size_t count = Atom::count();
+   testEquals(bundle.translate(literalKey("Height")), "Height", "translate(key) fails");
+   testEquals(Atom::count(), count, "Untranslated key is interned again");
+
+   // The macros also accept strings, which are not literals.
+   const String key = "Width";
+   testEquals(jtr(key), "Width", "jtr(String) fails");
+   testEquals(jtr(text), String(text), "jtr(const char*) fails");
+   testEquals(jtr("Height"), "Height", "jtr(literal) fails");
+   testEquals(TrLiteral("Height"), "Height", "TrLiteral fails");
+
+   // Character arrays, which are no literals, are hashed at run time.
+   const char array[] = {'W', 'i', 'd', 't', 'h'};
+   char buffer[16] = "Height";
+   testEquals(Tr(array), "Width", "Tr(array) fails");
+   testEquals(jtr(buffer), "Height", "jtr(array) fails");
+}
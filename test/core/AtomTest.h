@@ -0,0 +1,27 @@
+//
+//  AtomTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_AtomTest_h
+#define jm_AtomTest_h
+
+#include "core/Test.h"
+
+class AtomTest : public jm::Test
+{
+   public:
+      AtomTest();
+      void doTest();
+
+   private:
+      void testAtoms();
+      void testThreads();
+      void testUsers();
+      void testTranslationKeys();
+};
+
+#endif
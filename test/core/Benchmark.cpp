@@ -0,0 +1,35 @@
+//
+//  Benchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include "core/Core.h"
+#include "Benchmark.h"
+
+using namespace jm;
+
+double Benchmark::elapsed(Clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void Benchmark::report(const String& name, size_t operations, double ms)
+{
+   double ops = ms > 0 ? static_cast<double>(operations) / ms : 0;
+   System::log(String("%1: %2 ms (%3 ops/ms)")
+               .arg(name)
+               .arg(ms, 0, 3)
+               .arg(static_cast<uint64>(ops)), LogLevel::kInformation);
+}
+
+void Benchmark::reportThroughput(const String& name, size_t bytes, double ms)
+{
+   double mbs = ms > 0 ? static_cast<double>(bytes) / ms / 1000.0 : 0;
+   System::log(String("%1: %2 ms (%3 MB/s)")
+               .arg(name)
+               .arg(ms, 0, 3)
+               .arg(mbs, 0, 1), LogLevel::kInformation);
+}
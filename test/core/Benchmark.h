@@ -0,0 +1,38 @@
+//
+//  Benchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_Benchmark_h
+#define jm_Benchmark_h
+
+#include <chrono>
+
+#include "core/Test.h"
+
+/*!
+ \brief Base class of the micro benchmarks. It measures the time of a benchmark run and writes
+ the result to the log.
+ */
+class Benchmark : public jm::Test
+{
+   public:
+
+      using Clock = std::chrono::steady_clock;
+
+      //! Returns the milliseconds, which have passed since \p start.
+      static double elapsed(Clock::time_point start);
+
+   protected:
+
+      //! Logs the duration of a benchmark run with \p operations operations.
+      void report(const jm::String& name, size_t operations, double ms);
+
+      //! Logs the throughput of a benchmark run, which has processed \p bytes bytes.
+      void reportThroughput(const jm::String& name, size_t bytes, double ms);
+};
+
+#endif
@@ -0,0 +1,86 @@
+//
+//  CRCBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <vector>
+
+#include "zlib/zlib.h"
+#include "core/Core.h"
+#include "CRCBenchmark.h"
+
+using namespace jm;
+
+//! Returns the throughput in MB/s of \p function applied \p rounds times to \p data.
+template <class Function>
+static double throughput(const std::vector<uint8>& data, size_t rounds, uint32& checksum,
+                         Function function)
+{
+   const Benchmark::Clock::time_point start = Benchmark::Clock::now();
+   for(size_t round = 0; round < rounds; round++)checksum += function(data.data(), data.size());
+   const double time = Benchmark::elapsed(start) / 1000.0;
+   return static_cast<double>(data.size() * rounds) / (1024.0 * 1024.0) / time;
+}
+
+CRCBenchmark::CRCBenchmark(): Benchmark()
+{
+   setName("Benchmark CRC");
+}
+
+void CRCBenchmark::doTest()
+{
+   std::vector<uint8> data(16 * 1024 * 1024);
+   uint32 seed = 9;
+   for(uint8& byte : data)
+   {
+      seed = seed * 1103515245 + 12345;
+      byte = static_cast<uint8>(seed >> 16);
+   }
+   const size_t rounds = 8;
+
+   uint32 crc32 = 0;
+   uint32 zlibCrc32 = 0;
+   uint32 crc32c = 0;
+   uint32 adler = 0;
+   uint32 zlibAdler = 0;
+
+   const double crc32Speed = throughput(data, rounds, crc32, [](const uint8* buffer, size_t size)
+   {
+      return CRC::crc32(0, buffer, size);
+   });
+   const double zlibCrc32Speed = throughput(data, rounds, zlibCrc32,
+                                            [](const uint8* buffer, size_t size)
+   {
+      return static_cast<uint32>(::crc32(0, buffer, static_cast<uInt>(size)));
+   });
+   const double crc32cSpeed = throughput(data, rounds, crc32c, [](const uint8* buffer, size_t size)
+   {
+      return CRC::crc32c(0, buffer, size);
+   });
+   const double adlerSpeed = throughput(data, rounds, adler, [](const uint8* buffer, size_t size)
+   {
+      return CRC::adler32(1, buffer, size);
+   });
+   const double zlibAdlerSpeed = throughput(data, rounds, zlibAdler,
+                                            [](const uint8* buffer, size_t size)
+   {
+      return static_cast<uint32>(::adler32(1, buffer, static_cast<uInt>(size)));
+   });
+
+   testEquals(crc32, zlibCrc32, "CRC::crc32() differs from zlib");
+   testEquals(adler, zlibAdler, "CRC::adler32() differs from zlib");
+   testTrue(crc32c != crc32, "CRC::crc32c() fails");
+
+   System::log(String("CRC of %1 MB: crc32 %2 MB/s, zlib crc32 %3 MB/s, crc32c %4 MB/s, "
+                      "adler32 %5 MB/s, zlib adler32 %6 MB/s")
+               .arg(static_cast<uint64>(data.size() / (1024 * 1024)))
+               .arg(crc32Speed, 0, 0)
+               .arg(zlibCrc32Speed, 0, 0)
+               .arg(crc32cSpeed, 0, 0)
+               .arg(adlerSpeed, 0, 0)
+               .arg(zlibAdlerSpeed, 0, 0),
+               LogLevel::kInformation);
+}
@@ -0,0 +1,25 @@
+//
+//  CRCBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_CRCBenchmark_h
+#define jm_CRCBenchmark_h
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::CRC against crc32() and adler32() of zlib. The results are
+ written to the log. The few tests only make sure, that the benchmarks did real work.
+ */
+class CRCBenchmark : public Benchmark
+{
+   public:
+      CRCBenchmark();
+      void doTest();
+};
+
+#endif
@@ -0,0 +1,123 @@
+//
+//  CRCTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <vector>
+
+#include "zlib/zlib.h"
+#include "core/Core.h"
+#include "CRCTest.h"
+
+using namespace jm;
+
+//! Bitwise reference implementation of the reflected CRC with \p polynomial.
+static uint32 bitwiseCrc(uint32 polynomial, const uint8* buffer, size_t length)
+{
+   uint32 crc = 0xFFFFFFFF;
+   for(size_t index = 0; index < length; index++)
+   {
+      crc ^= buffer[index];
+      for(uint32 bit = 0; bit < 8; bit++)crc = (crc >> 1) ^ ((crc & 1) != 0 ? polynomial : 0);
+   }
+   return ~crc;
+}
+
+//! Pseudo random test data.
+static std::vector<uint8> createData(size_t length)
+{
+   std::vector<uint8> data(length);
+   uint32 seed = 5;
+   for(size_t index = 0; index < length; index++)
+   {
+      seed = seed * 1103515245 + 12345;
+      data[index] = static_cast<uint8>(seed >> 16);
+   }
+   return data;
+}
+
+CRCTest::CRCTest(): Test()
+{
+   setName("Test CRC");
+}
+
+void CRCTest::doTest()
+{
+   // Check values of the CRC catalogue for "123456789"
+   const uint8* check = reinterpret_cast<const uint8*>("123456789");
+   testEquals(CRC::crc32(0, check, 9), 0xCBF43926u, "CRC::crc32() fails.");
+   testEquals(CRC::crc32c(0, check, 9), 0xE3069283u, "CRC::crc32c() fails.");
+   testEquals(CRC::adler32(1, check, 9), 0x091E01DEu, "CRC::adler32() fails.");
+
+   // Empty data does not change the checksum.
+   testEquals(CRC::crc32(0, nullptr, 0), 0u, "CRC::crc32() fails for empty data.");
+   testEquals(CRC::crc32c(0x12345678, nullptr, 0), 0x12345678u,
+              "CRC::crc32c() fails for empty data.");
+   testEquals(CRC::adler32(1, nullptr, 0), 1u, "CRC::adler32() fails for empty data.");
+
+   testLengths();
+   testChunks();
+}
+
+void CRCTest::testLengths()
+{
+   // All lengths around the 8 byte steps and the 64 byte folds at all alignments.
+   const std::vector<uint8> data = createData(300);
+   bool crc32 = true;
+   bool crc32c = true;
+   bool adler = true;
+
+   for(size_t offset = 0; offset < 16; offset++)
+   {
+      for(size_t length = 0; offset + length <= data.size(); length++)
+      {
+         const uint8* buffer = data.data() + offset;
+         const uInt size = static_cast<uInt>(length);
+         crc32 = crc32 && CRC::crc32(0, buffer, length) == ::crc32(0, buffer, size);
+         crc32c = crc32c && CRC::crc32c(0, buffer, length) == bitwiseCrc(0x82F63B78, buffer,
+                                                                          length);
+         adler = adler && CRC::adler32(1, buffer, length) == ::adler32(1, buffer, size);
+      }
+   }
+
+   testTrue(crc32, "CRC::crc32() differs from zlib.");
+   testTrue(crc32c, "CRC::crc32c() differs from the bitwise CRC.");
+   testTrue(adler, "CRC::adler32() differs from zlib.");
+
+   // Adler-32 of large data, where the sums need the modulo in between.
+   std::vector<uint8> ones(1000000, 0xFF);
+   testEquals(CRC::adler32(1, ones.data(), ones.size()),
+              static_cast<uint32>(::adler32(1, ones.data(), static_cast<uInt>(ones.size()))),
+              "CRC::adler32() overflows.");
+}
+
+void CRCTest::testChunks()
+{
+   const std::vector<uint8> data = createData(100000);
+   const uint32 crc32 = CRC::crc32(0, data.data(), data.size());
+   const uint32 crc32c = CRC::crc32c(0, data.data(), data.size());
+   const uint32 adler = CRC::adler32(1, data.data(), data.size());
+   testEquals(crc32, bitwiseCrc(0xEDB88320, data.data(), data.size()), "CRC::crc32() fails.");
+
+   for(size_t chunk : {1u, 7u, 63u, 64u, 1000u, 65536u})
+   {
+      uint32 crc32Chunks = 0;
+      uint32 crc32cChunks = 0;
+      uint32 adlerChunks = 1;
+      for(size_t offset = 0; offset < data.size(); offset += chunk)
+      {
+         const size_t length = std::min(chunk, data.size() - offset);
+         crc32Chunks = CRC::crc32(crc32Chunks, data.data() + offset, length);
+         crc32cChunks = CRC::crc32c(crc32cChunks, data.data() + offset, length);
+         adlerChunks = CRC::adler32(adlerChunks, data.data() + offset, length);
+      }
+
+      const String name = String(" fails for chunks of %1 bytes.").arg(static_cast<uint64>(chunk));
+      testEquals(crc32Chunks, crc32, "CRC::crc32()" + name);
+      testEquals(crc32cChunks, crc32c, "CRC::crc32c()" + name);
+      testEquals(adlerChunks, adler, "CRC::adler32()" + name);
+   }
+}
@@ -0,0 +1,32 @@
+//
+//  CRCTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_CRCTest_h
+#define jm_CRCTest_h
+
+#include "core/Test.h"
+
+/*!
+ \brief Tests the checksums of jm::CRC against known check values and against zlib.
+ */
+class CRCTest : public jm::Test
+{
+   public:
+      CRCTest();
+      void doTest();
+
+   private:
+
+      //! Compares the checksums of all lengths and alignments with the bitwise algorithm and zlib.
+      void testLengths();
+
+      //! Calculates the checksums in chunks.
+      void testChunks();
+};
+
+#endif
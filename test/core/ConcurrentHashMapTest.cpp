@@ -0,0 +1,154 @@
+//
+//  ConcurrentHashMapTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "core/Core.h"
+#include "ConcurrentHashMapTest.h"
+
+using namespace jm;
+
+ConcurrentHashMapTest::ConcurrentHashMapTest(): Test()
+{
+   setName("Test ConcurrentHashMap");
+}
+
+void ConcurrentHashMapTest::doTest()
+{
+   testSingleThread();
+   testThreads();
+   testPreferences();
+}
+
+void ConcurrentHashMapTest::testSingleThread()
+{
+   ConcurrentHashMap<String, int64> map;
+   testTrue(map.isEmpty(), "ConcurrentHashMap not empty");
+
+   map.reserve(1000);
+   for(int64 a = 0; a < 1000; a++)
+   {
+      testTrue(map.put(String::valueOf(a), a), "ConcurrentHashMap put fails");
+   }
+   testFalse(map.put("7", 70), "ConcurrentHashMap replace fails");
+   testEquals(map.size(), 1000, "ConcurrentHashMap size wrong");
+
+   int64 value = -1;
+   testTrue(map.get("7", value), "ConcurrentHashMap get fails");
+   testEquals(value, 70, "ConcurrentHashMap get fails");
+   testFalse(map.get("1000", value), "ConcurrentHashMap get fails");
+   testEquals(value, 70, "ConcurrentHashMap get changed value");
+   testEquals(map.value("999", 0), 999, "ConcurrentHashMap value fails");
+   testEquals(map.value("-1", -2), -2, "ConcurrentHashMap value fails");
+   testTrue(map.containsKey("500"), "ConcurrentHashMap containsKey fails");
+
+   testTrue(map.remove("500"), "ConcurrentHashMap remove fails");
+   testFalse(map.remove("500"), "ConcurrentHashMap remove fails");
+   testFalse(map.containsKey("500"), "ConcurrentHashMap remove fails");
+
+   int64 sum = 0;
+   size_t count = 0;
+   map.forEach([&sum, &count](const String&, int64 v)
+   {
+      sum += v;
+      count++;
+   });
+   testEquals(count, 999, "ConcurrentHashMap forEach count wrong");
+   testEquals(sum, 999 * 1000 / 2 - 500 - 7 + 70, "ConcurrentHashMap forEach sum wrong");
+
+   map.clear();
+   testTrue(map.isEmpty(), "ConcurrentHashMap clear fails");
+}
+
+void ConcurrentHashMapTest::testThreads()
+{
+   // Readers look up a fixed set of keys, while writers insert and remove their own keys.
+   ConcurrentHashMap<String, String> map;
+   const int64 fixed = 1000;
+   for(int64 a = 0; a < fixed; a++)
+   {
+      map.put(String("fixed%1").arg(a), String("Value of the fixed entry %1").arg(a));
+   }
+
+   std::atomic<size_t> errors(0);
+   std::vector<std::thread> threads;
+   for(int64 t = 0; t < 4; t++)
+   {
+      threads.emplace_back([&map, &errors, t]()
+      {
+         for(int64 a = 0; a < 2000; a++)
+         {
+            const String key = String("thread%1-%2").arg(t).arg(a);
+            map.put(key, key);
+            if(map.value(key, kEmptyString) != key)errors++;
+            if(a % 2 == 0 && !map.remove(key))errors++;
+         }
+      });
+      threads.emplace_back([&map, &errors]()
+      {
+         String value;
+         for(int64 round = 0; round < 20; round++)
+         {
+            for(int64 a = 0; a < fixed; a++)
+            {
+               if(!map.get(String("fixed%1").arg(a), value))errors++;
+               else if(value.size() < 25)errors++;
+            }
+         }
+      });
+   }
+   for(std::thread& thread : threads)thread.join();
+
+   testEquals(errors.load(), 0, "ConcurrentHashMap lookups fail with several threads");
+   testEquals(map.size(), static_cast<size_t>(fixed + 4 * 1000), "ConcurrentHashMap size wrong");
+}
+
+void ConcurrentHashMapTest::testPreferences()
+{
+   Preferences prefs;
+   prefs.setValue("width", static_cast<int64>(100));
+   prefs.setValue("name", String("Multi\nline"));
+
+   std::atomic<size_t> errors(0);
+   std::vector<std::thread> threads;
+   for(int64 t = 0; t < 4; t++)
+   {
+      threads.emplace_back([&prefs, &errors, t]()
+      {
+         for(int64 a = 0; a < 5000; a++)
+         {
+            if(t == 0)prefs.setValue("counter", a);
+            if(prefs.valueInt("width", 0) != 100)errors++;
+            if(prefs.value("name") != "Multi\\nline")errors++;
+            if(prefs.valueInt("counter", 0) < 0)errors++;
+         }
+      });
+   }
+   for(std::thread& thread : threads)thread.join();
+
+   testEquals(errors.load(), 0, "Preferences fail with several threads");
+   testEquals(prefs.valueInt("counter", 0), 4999, "Preferences value wrong");
+
+   // Access to the entries
+   testEquals(prefs.size(), 3, "Preferences size wrong");
+   testEquals(prefs.keys().join(','), "counter,name,width", "Preferences keys wrong");
+   size_t count = 0;
+   prefs.forEach([&count](const String&, const String&)
+   {
+      count++;
+   });
+   testEquals(count, 3, "Preferences forEach fails");
+   testTrue(prefs.containsKey("name"), "Preferences containsKey fails");
+   testTrue(prefs.remove("name"), "Preferences remove fails");
+   testFalse(prefs.remove("name"), "Preferences remove fails");
+   testFalse(prefs.hasValue("name"), "Preferences remove fails");
+   prefs.clear();
+   testTrue(prefs.isEmpty(), "Preferences clear fails");
+}
@@ -0,0 +1,26 @@
+//
+//  ConcurrentHashMapTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_ConcurrentHashMapTest_h
+#define jm_ConcurrentHashMapTest_h
+
+#include "core/Test.h"
+
+class ConcurrentHashMapTest : public jm::Test
+{
+   public:
+      ConcurrentHashMapTest();
+      void doTest();
+
+   private:
+      void testSingleThread();
+      void testThreads();
+      void testPreferences();
+};
+
+#endif
@@ -0,0 +1,140 @@
+//
+//  DeflateBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+
+#include "zlib/zlib.h"
+#include "core/Core.h"
+#include "DeflateBenchmark.h"
+#include "DeflateTest.h"
+
+using namespace jm;
+
+DeflateBenchmark::DeflateBenchmark(): Benchmark()
+{
+   setName("Benchmark Deflate");
+}
+
+void DeflateBenchmark::doTest()
+{
+   // The corpus of the DeflateTest repeated to about 4 MB.
+   const ByteArray text = DeflateTest::corpus().toCString();
+   ByteArray data = ByteArray(4 * 1024 * 1024, 0);
+   for(size_t a = 0; a < data.size(); a++)data[a] = text[a % text.size()];
+
+   benchmarkInflate(data, Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY, 10);
+   benchmarkInflate(data, Z_BEST_SPEED, Z_DEFAULT_STRATEGY, 10);
+   benchmarkInflate(data, Z_BEST_COMPRESSION, Z_FIXED, 10);
+
+   benchmarkDeflate(data, Deflater::kBestCompression, 2);
+   benchmarkDeflate(data, Deflater::kBestSpeed, 2);
+}
+
+void DeflateBenchmark::benchmarkInflate(const ByteArray& data, int level, int strategy,
+                                        size_t rounds)
+{
+   uLongf compressedLength = compressBound(static_cast<uLong>(data.size()));
+   uint8* compressed = new uint8[compressedLength];
+   z_stream stream = {};
+   deflateInit2(&stream, level, Z_DEFLATED, MAX_WBITS, 8, strategy);
+   stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+   stream.avail_in = static_cast<uInt>(data.size());
+   stream.next_out = compressed;
+   stream.avail_out = static_cast<uInt>(compressedLength);
+   deflate(&stream, Z_FINISH);
+   deflateEnd(&stream);
+   compressedLength = stream.total_out;
+
+   // zlib
+   uint8* restored = new uint8[data.size()];
+   Clock::time_point start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      uLongf restoredLength = static_cast<uLongf>(data.size());
+      uncompress(restored, &restoredLength, compressed, compressedLength);
+      testEquals(static_cast<int64>(restoredLength), static_cast<int64>(data.size()),
+                 "zlib uncompress() fails");
+   }
+   const double zlibTime = elapsed(start);
+   delete[] restored;
+
+   // Inflater
+   bool equal = true;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      size_t restoredLength = 0;
+      Inflater inflater;
+      inflater.SetInput(compressed, compressedLength);
+      inflater.Inflate(restored, restoredLength);
+      equal = equal && restoredLength == data.size();
+      delete[] restored;
+   }
+   const double inflaterTime = elapsed(start);
+   testTrue(equal, "Inflater::Inflate() fails");
+
+   // Inflater streaming into a fixed buffer
+   uint8* chunk = new uint8[65536];
+   size_t streamed = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      Inflater inflater;
+      inflater.SetInput(compressed, compressedLength);
+      while(!inflater.Finished())streamed += inflater.Inflate(chunk, 0, 65536);
+   }
+   const double streamTime = elapsed(start);
+   testEquals(streamed, data.size() * rounds, "Inflater::Inflate() fails");
+   delete[] chunk;
+
+   const double megabytes = static_cast<double>(data.size() * rounds) / (1024.0 * 1024.0);
+   System::log(String("Inflate %1 MB (level %2, strategy %3, ratio %4): Inflater %5 MB/s, "
+                      "Inflater 64 KB buffer %6 MB/s, zlib %7 MB/s")
+               .arg(static_cast<uint64>(data.size() / (1024 * 1024)))
+               .arg(level)
+               .arg(strategy)
+               .arg(static_cast<double>(data.size()) / static_cast<double>(compressedLength), 0, 1)
+               .arg(megabytes * 1000.0 / inflaterTime, 0, 0)
+               .arg(megabytes * 1000.0 / streamTime, 0, 0)
+               .arg(megabytes * 1000.0 / zlibTime, 0, 0),
+               LogLevel::kInformation);
+
+   delete[] compressed;
+}
+
+void DeflateBenchmark::benchmarkDeflate(const ByteArray& data, int32 level, size_t rounds)
+{
+   uint8* chunk = new uint8[65536];
+   String result;
+
+   for(size_t threads = 1; threads <= 8; threads *= 2)
+   {
+      size_t compressed = 0;
+      const Clock::time_point start = Clock::now();
+      for(size_t round = 0; round < rounds; round++)
+      {
+         Deflater deflater = Deflater(level, DeflateStrategy::kDefault, true);
+         deflater.setThreads(threads);
+         deflater.setInput(reinterpret_cast<uint8*>(const_cast<char*>(data.constData())),
+                           data.size());
+         deflater.finish();
+         while(!deflater.finished())compressed += deflater.deflate(chunk, 0, 65536);
+         testEquals(deflater.totalInSize(), data.size(), "Deflater::deflate() fails");
+      }
+      const double time = elapsed(start);
+      const double megabytes = static_cast<double>(data.size() * rounds) / (1024.0 * 1024.0);
+      result << String(", %1 threads %2 MB/s (%3 bytes)")
+             .arg(static_cast<uint64>(threads))
+             .arg(megabytes * 1000.0 / time, 0, 0)
+             .arg(static_cast<uint64>(compressed / rounds));
+   }
+   delete[] chunk;
+
+   System::log(String("Deflate %1 MB (level %2)").arg(static_cast<uint64>(data.size() /
+                                                           (1024 * 1024))).arg(level) + result,
+               LogLevel::kInformation);
+}
@@ -0,0 +1,40 @@
+//
+//  DeflateBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_DeflateBenchmark_h
+#define jm_DeflateBenchmark_h
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::Inflater against inflate() of zlib and for the parallel mode of
+ jm::Deflater. The results are written to the log. The few tests only make sure, that the benchmarks did real work.
+ */
+class DeflateBenchmark : public Benchmark
+{
+   public:
+      DeflateBenchmark();
+      void doTest();
+
+   private:
+
+      /*!
+       \brief Compresses the corpus with zlib and decompresses it repeatedly.
+       \param level The zlib compression level.
+       \param strategy The zlib compression strategy.
+       */
+      void benchmarkInflate(const jm::ByteArray& data, int level, int strategy, size_t rounds);
+
+      /*!
+       \brief Compresses the data with the Deflater with 1, 2, 4 and 8 threads.
+       \param level The compression level.
+       */
+      void benchmarkDeflate(const jm::ByteArray& data, int32 level, size_t rounds);
+};
+
+#endif
@@ -84,7 +84,87 @@ void DeflateTest::doTest()
    delete[] restored;
 
    // Teste langen Code
-   test =
+   test = corpus();
+
+   uncompressed = test.toCString();
+   uncompressedLength = uncompressed.size();
+
+   std::cout << "Uncompressed Length: " << uncompressedLength << std::endl;
+
+   //Komprimieren
+   compressed = nullptr;
+   compressedLength = 0;
+   deflater.reset();
+   deflater.setInput((uint8*)uncompressed.data(), uncompressedLength);
+   deflater.deflate(compressed, compressedLength);
+
+   std::cout << "Compressed Length: " << compressedLength << std::endl;
+
+   //Dekomprimieren
+   restored = nullptr;
+   restoredLength = 0;
+   inflater.Reset();
+   inflater.SetInput(compressed, compressedLength);
+   inflater.Inflate(restored, restoredLength);
+
+   std::cout << "Restored Length: " << restoredLength << std::endl;
+
+   //Vergleiche uncompressed und restored...
+   testEquals((int64)uncompressedLength, (int64)restoredLength, "Länge der Daten unterschiedlich.");
+
+   l = std::min(uncompressedLength, restoredLength);
+
+   for(size_t a = 0; a < l; a++)
+   {
+      testEquals(uncompressed[a], restored[a], "Datenfehler in Kompression / Dekompression.");
+   }
+
+   delete[] compressed;
+   delete[] restored;
+
+   //
+   // Teste langen codeblock mit 0
+   //
+
+   uncompressed = jm::ByteArray(1000000, 0);
+   uncompressedLength = 1000000;
+
+   //Komprimieren
+   compressed = nullptr;
+   compressedLength = 0;
+   deflater.reset();
+   deflater.setInput((uint8*)uncompressed.data(), uncompressedLength);
+   deflater.deflate(compressed, compressedLength);
+
+   //Dekomprimieren
+   restored = nullptr;
+   restoredLength = 0;
+   inflater.Reset();
+   inflater.SetInput(compressed, compressedLength);
+   inflater.Inflate(restored, restoredLength);
+
+   //Vergleiche uncompressed und restored...
+   testTrue(uncompressedLength==restoredLength, "Länge der Daten unterschiedlich.");
+
+   l = std::min(uncompressedLength, restoredLength);
+
+   for(size_t a = 0; a < l; a++)
+   {
+      testEquals(uncompressed[a], restored[a], "Datenfehler in Kompression / Dekompression.");
+   }
+
+   delete[] compressed;
+   delete[] restored;
+
+   testZlibStreams();
+   testCorruptStreams();
+   testDeflaterStreams();
+   testParallelDeflater();
+}
+
+jm::String DeflateTest::corpus()
+{
+   return
       "0 g BT /Helvetica-Bold 16 Tf 56.6929 785.1969 Td (Jameo PDF\\055Distiller Testdokument) Tj ET\r\n"
       "BT /Helvetica 10 Tf 56.6929 756.8505 Td (Dieses Testdokument wurde ohne zus\\344tzliche Hilfsmittel aus dem PDF\\055Kit der Jameo Graphics Engine) Tj ET\r\n"
       "BT /Helvetica 10 Tf 56.6929 742.6772 Td (erzeugt\\056 Dieses Dokument enth\\344lt eine Vielzahl von Darstellungen\\054 die den gesamten Funktionsumfang) Tj ET\r\n"
@@ -635,74 +715,379 @@ void DeflateTest::doTest()
       "BT /Helvetica 10 Tf 56.6929 53.8583 Td (Schrift: Helvetica) Tj ET"
       "BT /Helvetica 10 Tf 311.811 53.8583 Td (Schrift: Symbol) Tj ET"
       "0 g BT /Helvetica 10 Tf 297.6378 34.0158 Td (1\\0577) Tj ET";
+}
 
-   uncompressed = test.toCString();
-   uncompressedLength = uncompressed.size();
+void DeflateTest::testZlibStreams()
+{
+   // Mixes the corpus with noise, so that the stream also contains distances beyond 32K and
+   // large literal runs.
+   jm::ByteArray text = corpus().toCString();
+   jm::ByteArray data = jm::ByteArray(500000, 0);
+   uint32 seed = 1;
+   for(size_t a = 0; a < data.size(); a++)
+   {
+      seed = seed * 1103515245 + 12345;
+      if((a / 40000) % 3 == 2)data[a] = static_cast<uint8>(seed >> 16);
+      else data[a] = text[(a * 7) % text.size()];
+   }
 
-   std::cout << "Uncompressed Length: " << uncompressedLength << std::endl;
+   // Level 0 creates stored blocks, Z_FIXED only fixed Huffman blocks.
+   testZlibStream(data, Z_NO_COMPRESSION, Z_DEFAULT_STRATEGY, false);
+   testZlibStream(data, Z_BEST_SPEED, Z_DEFAULT_STRATEGY, false);
+   testZlibStream(data, Z_DEFAULT_COMPRESSION, Z_DEFAULT_STRATEGY, false);
+   testZlibStream(data, Z_BEST_COMPRESSION, Z_FIXED, false);
+   testZlibStream(data, Z_BEST_COMPRESSION, Z_HUFFMAN_ONLY, false);
+   testZlibStream(data, Z_BEST_COMPRESSION, Z_RLE, true);
 
-   //Komprimieren
-   compressed = nullptr;
-   compressedLength = 0;
-   deflater.reset();
-   deflater.setInput((uint8*)uncompressed.data(), uncompressedLength);
-   deflater.deflate(compressed, compressedLength);
+   // Highly compressible data fills the window from a few input bytes, so the decoder stops at the
+   // window limit with symbols left in the bit buffer.
+   testZlibStream(jm::ByteArray(100000, 0), Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY, false);
+   testZlibStream(jm::ByteArray(1, 'x'), Z_BEST_COMPRESSION, Z_DEFAULT_STRATEGY, false);
+}
 
-   std::cout << "Compressed Length: " << compressedLength << std::endl;
+void DeflateTest::testZlibStream(const jm::ByteArray& data, int level, int strategy, bool raw)
+{
+   z_stream stream = {};
+   deflateInit2(&stream, level, Z_DEFLATED, raw ? -MAX_WBITS : MAX_WBITS, 8, strategy);
 
-   //Dekomprimieren
-   restored = nullptr;
-   restoredLength = 0;
-   inflater.Reset();
+   uLong bound = deflateBound(&stream, static_cast<uLong>(data.size()));
+   uint8* compressed = new uint8[bound];
+   stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.constData()));
+   stream.avail_in = static_cast<uInt>(data.size());
+   stream.next_out = compressed;
+   stream.avail_out = static_cast<uInt>(bound);
+   deflate(&stream, Z_FINISH);
+   deflateEnd(&stream);
+   const size_t compressedLength = stream.total_out;
+
+   uint8* restored = nullptr;
+   size_t restoredLength = 0;
+   jm::Inflater inflater = jm::Inflater(raw);
    inflater.SetInput(compressed, compressedLength);
    inflater.Inflate(restored, restoredLength);
 
-   std::cout << "Restored Length: " << restoredLength << std::endl;
+   jm::String name = jm::String("zlib level %1 strategy %2").arg(level).arg(strategy);
+   testTrue(inflater.Finished(), name + ": Inflater not finished.");
+   testEquals(static_cast<int64>(restoredLength), static_cast<int64>(data.size()),
+              name + ": Länge der Daten unterschiedlich.");
+   testTrue(restoredLength == data.size() && memcmp(restored, data.constData(), data.size()) == 0,
+            name + ": Datenfehler in Kompression / Dekompression.");
 
-   //Vergleiche uncompressed und restored...
-   testEquals((int64)uncompressedLength, (int64)restoredLength, "Länge der Daten unterschiedlich.");
+   // Only the Adler-32 checksum of the zlib stream must remain.
+   const size_t trailer = raw ? 0 : 4;
+   testEquals(static_cast<int64>(inflater.GetRemaining()), static_cast<int64>(trailer),
+              name + ": Inflater::GetRemaining() fails.");
+   testEquals(static_cast<int64>(inflater.GetTotalIn()), static_cast<int64>(compressedLength - trailer),
+              name + ": Inflater::GetTotalIn() fails.");
+   testEquals(static_cast<int64>(inflater.GetTotalOut()), static_cast<int64>(data.size()),
+              name + ": Inflater::GetTotalOut() fails.");
 
-   l = std::min(uncompressedLength, restoredLength);
+   // Streaming with small chunks of input and output, so that the decoder stops at any position.
+   testStreaming(compressed, compressedLength, data, raw, 1, 1000);
+   testStreaming(compressed, compressedLength, data, raw, 7, 1);
+   testStreaming(compressed, compressedLength, data, raw, 4096, 65536);
+   testStreaming(compressed, compressedLength, data, raw, compressedLength, 4096);
+   testStreaming(compressed, compressedLength, data, raw, compressedLength, 100000);
 
-   for(size_t a = 0; a < l; a++)
+   delete[] compressed;
+   delete[] restored;
+}
+
+void DeflateTest::testStreaming(uint8* compressed,
+                                size_t compressedLength,
+                                const jm::ByteArray& data,
+                                bool raw,
+                                size_t inputChunk,
+                                size_t outputChunk)
+{
+   jm::String name = jm::String("Streaming %1/%2").arg(static_cast<uint64>(inputChunk))
+                     .arg(static_cast<uint64>(outputChunk));
+   jm::Inflater inflater = jm::Inflater(raw);
+   uint8* output = new uint8[outputChunk];
+   size_t input = 0;
+   size_t restored = 0;
+   bool equal = true;
+
+   while(!inflater.Finished())
    {
-      testEquals(uncompressed[a], restored[a], "Datenfehler in Kompression / Dekompression.");
+      if(inflater.NeedsInput())
+      {
+         if(input == compressedLength)break;
+         const size_t size = std::min(inputChunk, compressedLength - input);
+         inflater.SetInput(compressed + input, size);
+         input += size;
+      }
+
+      const size_t count = inflater.Inflate(output, 0, outputChunk);
+      equal = equal && restored + count <= data.size() &&
+              memcmp(output, data.constData() + restored, count) == 0;
+      restored += count;
    }
 
+   testTrue(inflater.Finished(), name + ": Inflater not finished.");
+   testTrue(equal, name + ": Datenfehler in Kompression / Dekompression.");
+   testEquals(static_cast<int64>(restored), static_cast<int64>(data.size()),
+              name + ": Länge der Daten unterschiedlich.");
+   testEquals(static_cast<int64>(inflater.GetTotalOut()), static_cast<int64>(data.size()),
+              name + ": Inflater::GetTotalOut() fails.");
+
+   delete[] output;
+}
+
+void DeflateTest::testCorruptStreams()
+{
+   // Truncated stream
+   jm::ByteArray text = corpus().toCString();
+   uLongf length = compressBound(static_cast<uLong>(text.size()));
+   uint8* compressed = new uint8[length];
+   compress2(compressed, &length, reinterpret_cast<const Bytef*>(text.constData()),
+             static_cast<uLong>(text.size()), Z_BEST_COMPRESSION);
+   testCorruptStream(compressed, length / 2, false, "truncated stream");
+
+   // Reserved block type 11
+   uint8 reserved[] = {0x07, 0x00};
+   testCorruptStream(reserved, sizeof(reserved), true, "reserved block type");
+
+   // Stored block, where NLEN is not the complement of LEN
+   uint8 stored[] = {0x01, 0x05, 0x00, 0x00, 0x00, 'a', 'b', 'c', 'd', 'e'};
+   testCorruptStream(stored, sizeof(stored), true, "stored block length");
+
+   // Fixed block with a distance before the beginning of the output
+   uint8 distance[] = {0x03, 0x02, 0x00};
+   testCorruptStream(distance, sizeof(distance), true, "invalid distance");
+
    delete[] compressed;
-   delete[] restored;
+}
 
-   //
-   // Teste langen codeblock mit 0
-   //
+void DeflateTest::testCorruptStream(uint8* buffer, size_t length, bool raw, const jm::String& name)
+{
+   uint8* restored = nullptr;
+   size_t restoredLength = 0;
+   jm::Inflater inflater = jm::Inflater(raw);
+   inflater.SetInput(buffer, length);
+   bool thrown = false;
+   try
+   {
+      inflater.Inflate(restored, restoredLength);
+   }
+   catch(jm::Exception&)
+   {
+      thrown = true;
+   }
+   testTrue(thrown, "Inflater accepts " + name + ".");
+}
 
-   uncompressed = jm::ByteArray(1000000, 0);
-   uncompressedLength = 1000000;
+void DeflateTest::testDeflaterStreams()
+{
+   // Incompressible data, which is larger after compression
+   jm::ByteArray data = jm::ByteArray(100000, 0);
+   uint32 seed = 7;
+   for(size_t a = 0; a < data.size(); a++)
+   {
+      seed = seed * 1103515245 + 12345;
+      data[a] = static_cast<uint8>(seed >> 16);
+   }
 
-   //Komprimieren
-   compressed = nullptr;
-   compressedLength = 0;
-   deflater.reset();
-   deflater.setInput((uint8*)uncompressed.data(), uncompressedLength);
+   uint8* compressed = nullptr;
+   size_t compressedLength = 0;
+   jm::Deflater deflater = jm::Deflater();
+   deflater.setInput(reinterpret_cast<uint8*>(data.data()), data.size());
    deflater.deflate(compressed, compressedLength);
+   testTrue(compressedLength > data.size(), "Deflater::deflate() fails for incompressible data.");
+   testTrue(compressedLength <= deflater.maxOutputSize(data.size()),
+            "Deflater::maxOutputSize() fails.");
 
-   //Dekomprimieren
-   restored = nullptr;
-   restoredLength = 0;
-   inflater.Reset();
+   uint8* restored = nullptr;
+   size_t restoredLength = 0;
+   jm::Inflater inflater = jm::Inflater();
    inflater.SetInput(compressed, compressedLength);
    inflater.Inflate(restored, restoredLength);
+   testTrue(restoredLength == data.size() && memcmp(restored, data.constData(), data.size()) == 0,
+            "Datenfehler in Kompression / Dekompression.");
+   delete[] compressed;
+   delete[] restored;
 
-   //Vergleiche uncompressed und restored...
-   testTrue(uncompressedLength==restoredLength, "Länge der Daten unterschiedlich.");
+   // Streaming with all levels and strategies
+   jm::ByteArray text = corpus().toCString();
+   for(size_t a = 0; a < data.size(); a++)
+   {
+      if((a / 30000) % 2 == 0)data[a] = text[a % text.size()];
+   }
 
-   l = std::min(uncompressedLength, restoredLength);
+   testDeflaterStream(data, jm::Deflater::kNoCompression, jm::DeflateStrategy::kDefault, 1, 1000, 7);
+   testDeflaterStream(data, jm::Deflater::kBestSpeed, jm::DeflateStrategy::kDefault, 1, 4096, 100);
+   testDeflaterStream(data, jm::Deflater::kDefaultCompression, jm::DeflateStrategy::kFiltered, 1,
+                      65536, 65536);
+   testDeflaterStream(data, jm::Deflater::kBestCompression, jm::DeflateStrategy::kHuffmanOnly, 1,
+                      data.size(), 1);
+   testDeflaterStream(data, jm::Deflater::kBestCompression, jm::DeflateStrategy::kRle, 1, 333, 4096);
+   testDeflaterStream(data, jm::Deflater::kBestCompression, jm::DeflateStrategy::kFixed, 1, 77, 500);
+}
 
-   for(size_t a = 0; a < l; a++)
+jm::ByteArray DeflateTest::testDeflaterStream(jm::ByteArray& data,
+                                              int32 level,
+                                              jm::DeflateStrategy strategy,
+                                              size_t threads,
+                                              size_t inputChunk,
+                                              size_t outputChunk)
+{
+   jm::String name = jm::String("Deflater level %1 strategy %2 threads %3").arg(level)
+                     .arg(static_cast<int32>(strategy)).arg(static_cast<uint64>(threads));
+
+   // Compress into a buffer, which is filled in small steps.
+   jm::Deflater deflater = jm::Deflater(level, strategy, false);
+   deflater.setThreads(threads);
+   const size_t capacity = deflater.maxOutputSize(data.size());
+   uint8* compressed = new uint8[capacity];
+   size_t compressedLength = 0;
+   size_t input = 0;
+
+   while(!deflater.finished())
    {
-      testEquals(uncompressed[a], restored[a], "Datenfehler in Kompression / Dekompression.");
+      if(deflater.needsInput())
+      {
+         const size_t size = std::min(inputChunk, data.size() - input);
+         if(size == 0)deflater.finish();
+         else deflater.setInput(reinterpret_cast<uint8*>(data.data()) + input, size);
+         input += size;
+      }
+
+      const size_t size = std::min(outputChunk, capacity - compressedLength);
+      compressedLength += deflater.deflate(compressed, compressedLength, size);
+      if(compressedLength == capacity)break;
+   }
+
+   testTrue(deflater.finished(), name + ": Deflater not finished.");
+   testEquals(static_cast<int64>(deflater.totalInSize()), static_cast<int64>(data.size()),
+              name + ": Deflater::totalInSize() fails.");
+   testEquals(static_cast<int64>(deflater.totalOutSize()), static_cast<int64>(compressedLength),
+              name + ": Deflater::totalOutSize() fails.");
+
+   uint8* restored = nullptr;
+   size_t restoredLength = 0;
+   jm::Inflater inflater = jm::Inflater();
+   inflater.SetInput(compressed, compressedLength);
+   inflater.Inflate(restored, restoredLength);
+   testTrue(restoredLength == data.size() && memcmp(restored, data.constData(), data.size()) == 0,
+            name + ": Datenfehler in Kompression / Dekompression.");
+
+   // zlib verifies the Adler-32 checksum, which the Inflater ignores.
+   uLongf zlibLength = static_cast<uLongf>(data.size());
+   const int result = uncompress(restored, &zlibLength, compressed,
+                                 static_cast<uLong>(compressedLength));
+   testTrue(result == Z_OK && zlibLength == data.size(), name + ": zlib uncompress() fails.");
+
+   jm::ByteArray stream = jm::ByteArray(compressed, compressedLength);
+   delete[] compressed;
+   delete[] restored;
+   return stream;
+}
+
+void DeflateTest::testParallelDeflater()
+{
+   // Text with incompressible parts, which spans several blocks and batches of blocks.
+   const size_t kBlockSize = jm::Deflater::kBlockSize;
+   jm::ByteArray text = corpus().toCString();
+   jm::ByteArray data = jm::ByteArray(9 * kBlockSize + 12345, 0);
+   uint32 seed = 11;
+   for(size_t a = 0; a < data.size(); a++)
+   {
+      seed = seed * 1103515245 + 12345;
+      data[a] = (a / 50000) % 3 == 2 ? static_cast<uint8>(seed >> 16) : text[a % text.size()];
    }
 
+   // The output does not depend on the number of threads.
+   jm::ByteArray two = testDeflaterStream(data, jm::Deflater::kDefaultCompression,
+                                          jm::DeflateStrategy::kDefault, 2, 65536, 4096);
+   jm::ByteArray five = testDeflaterStream(data, jm::Deflater::kDefaultCompression,
+                                           jm::DeflateStrategy::kDefault, 5, 1000, 65536);
+   jm::ByteArray eight = testDeflaterStream(data, jm::Deflater::kDefaultCompression,
+                                            jm::DeflateStrategy::kDefault, 8, 1000, 65536);
+   testTrue(two == five && two == eight, "Parallel Deflater depends on the number of threads.");
+
+   // The dictionary keeps the compression ratio close to the single-threaded mode.
+   jm::ByteArray serial = testDeflaterStream(data, jm::Deflater::kDefaultCompression,
+                                             jm::DeflateStrategy::kDefault, 1, 65536, 65536);
+   testTrue(two.size() < serial.size() + serial.size() / 50,
+            "Parallel Deflater compresses worse than expected.");
+
+   testDeflaterStream(data, jm::Deflater::kNoCompression, jm::DeflateStrategy::kDefault, 3,
+                      70000, 777);
+   testDeflaterStream(data, jm::Deflater::kBestSpeed, jm::DeflateStrategy::kRle, 4, 4096, 100);
+   testDeflaterStream(data, jm::Deflater::kBestCompression, jm::DeflateStrategy::kFixed, 0,
+                      data.size(), 65536);
+
+   // Input of exactly one batch of two blocks
+   jm::ByteArray batch = jm::ByteArray(2 * kBlockSize, 0);
+   memcpy(batch.data(), data.constData(), batch.size());
+   two = testDeflaterStream(batch, jm::Deflater::kBestCompression, jm::DeflateStrategy::kDefault,
+                            2, kBlockSize, 65536);
+   five = testDeflaterStream(batch, jm::Deflater::kBestCompression, jm::DeflateStrategy::kDefault,
+                             5, batch.size(), 65536);
+   testTrue(two == five, "Parallel Deflater depends on the number of threads.");
+
+   // Empty input
+   jm::ByteArray empty = jm::ByteArray(static_cast<size_t>(0), 0);
+   jm::ByteArray stream = testDeflaterStream(empty, jm::Deflater::kBestCompression,
+                                             jm::DeflateStrategy::kDefault, 4, 1, 1);
+   testEquals(static_cast<int64>(stream.size()), 8, "Parallel Deflater fails for empty input.");
+
+   // Raw stream compressed at once
+   uint8* compressed = nullptr;
+   size_t compressedLength = 0;
+   jm::Deflater deflater = jm::Deflater(true);
+   deflater.setThreads(4);
+   deflater.setInput(reinterpret_cast<uint8*>(data.data()), data.size());
+   deflater.deflate(compressed, compressedLength);
+   testTrue(compressedLength <= deflater.maxOutputSize(data.size()),
+            "Deflater::maxOutputSize() fails in parallel mode.");
+
+   uint8* restored = nullptr;
+   size_t restoredLength = 0;
+   jm::Inflater inflater = jm::Inflater(true);
+   inflater.SetInput(compressed, compressedLength);
+   inflater.Inflate(restored, restoredLength);
+   testTrue(restoredLength == data.size() && memcmp(restored, data.constData(), data.size()) == 0,
+            "Parallel Deflater: Datenfehler in Kompression / Dekompression.");
+
+   // The workers are kept for the next stream, also if a stream is reset while blocks are
+   // compressed.
+   uint8 chunk[1000];
+   deflater.reset();
+   deflater.setInput(reinterpret_cast<uint8*>(data.data()), 5 * kBlockSize);
+   deflater.deflate(chunk, 0, sizeof(chunk));
+   deflater.reset();
+   uint8* again = nullptr;
+   size_t againLength = 0;
+   deflater.setInput(reinterpret_cast<uint8*>(data.data()), data.size());
+   deflater.deflate(again, againLength);
+   testTrue(againLength == compressedLength && memcmp(again, compressed, compressedLength) == 0,
+            "Parallel Deflater fails after reset().");
+
+   // The number of threads can be changed after reset().
+   uint8* first = nullptr;
+   size_t firstLength = 0;
+   jm::Deflater changed = jm::Deflater(true);
+   changed.setThreads(2);
+   changed.setInput(reinterpret_cast<uint8*>(data.data()), data.size());
+   changed.deflate(first, firstLength);
+   testEquals(static_cast<int64>(changed.workerCount()), 2, "Deflater::setThreads() fails (1)");
+
+   uint8* second = nullptr;
+   size_t secondLength = 0;
+   changed.reset();
+   changed.setThreads(4);
+   changed.setInput(reinterpret_cast<uint8*>(data.data()), data.size());
+   changed.deflate(second, secondLength);
+   testEquals(static_cast<int64>(changed.workerCount()), 4, "Deflater::setThreads() fails (2)");
+   testTrue(firstLength == compressedLength && secondLength == compressedLength &&
+            memcmp(first, compressed, compressedLength) == 0 &&
+            memcmp(second, compressed, compressedLength) == 0,
+            "Deflater::setThreads() fails (3)");
+
    delete[] compressed;
    delete[] restored;
+   delete[] again;
+   delete[] first;
+   delete[] second;
 }
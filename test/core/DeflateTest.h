@@ -10,6 +10,7 @@
 #define __jameo__DeflateTest__
 
 #include "core/Test.h"
+#include "core/Deflater.h"
 
 class DeflateTest : public jm::Test
 {
@@ -18,5 +19,42 @@ class DeflateTest : public jm::Test
       DeflateTest();
       void doTest();
 
+      //! Returns the text of a PDF page, which is also used by the DeflateBenchmark.
+      static jm::String corpus();
+
+   private:
+
+      //! Decompresses streams created by zlib with different levels and strategies.
+      void testZlibStreams();
+
+      void testZlibStream(const jm::ByteArray& data, int level, int strategy, bool raw);
+
+      //! Passes the compressed data in chunks and drains the output into small buffers.
+      void testStreaming(uint8* compressed,
+                         size_t compressedLength,
+                         const jm::ByteArray& data,
+                         bool raw,
+                         size_t inputChunk,
+                         size_t outputChunk);
+
+      //! Makes sure, that corrupt streams are rejected.
+      void testCorruptStreams();
+
+      void testCorruptStream(uint8* buffer, size_t length, bool raw, const jm::String& name);
+
+      //! Compresses data in chunks with different levels and strategies.
+      void testDeflaterStreams();
+
+      //! Compresses data in chunks and returns the compressed zlib stream.
+      jm::ByteArray testDeflaterStream(jm::ByteArray& data,
+                                       int32 level,
+                                       jm::DeflateStrategy strategy,
+                                       size_t threads,
+                                       size_t inputChunk,
+                                       size_t outputChunk);
+
+      //! Compresses data with several threads.
+      void testParallelDeflater();
+
 };
 #endif
@@ -0,0 +1,239 @@
+//
+//  HashMapTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <string>
+
+#include "core/Core.h"
+#include "HashMapTest.h"
+
+using namespace jm;
+
+namespace
+{
+   // Counts its copies, to verify that emplace constructs in place.
+   struct Counted
+   {
+      static inline size_t copies = 0;
+      int32 value;
+
+      explicit Counted(int32 v): value(v) {}
+      Counted(const Counted& other): value(other.value)
+      {
+         copies++;
+      }
+      Counted(Counted&& other) noexcept: value(other.value) {}
+      Counted& operator=(const Counted& other)
+      {
+         value = other.value;
+         copies++;
+         return *this;
+      }
+      Counted& operator=(Counted&& other) noexcept
+      {
+         value = other.value;
+         return *this;
+      }
+   };
+
+   // Hash function, which only knows String keys.
+   struct LengthHash
+   {
+      size_t operator()(const String& key) const noexcept
+      {
+         return key.size();
+      }
+   };
+
+   // Hash function, which also accepts UTF-8 text.
+   struct TransparentLengthHash
+   {
+      using is_transparent = void;
+
+      size_t operator()(const String& key) const noexcept
+      {
+         return key.size();
+      }
+
+      size_t operator()(std::string_view key) const
+      {
+         return String(key.data(), key.size()).size();
+      }
+   };
+}
+
+HashMapTest::HashMapTest(): Test()
+{
+   setName("Test HashMap");
+}
+
+void HashMapTest::doTest()
+{
+   testStringKeys();
+   testIntegerKeys();
+   testEmplace();
+   testCopy();
+   testHashFunctions();
+}
+
+void HashMapTest::testStringKeys()
+{
+   HashMap<String, int32> map;
+   testTrue(map.isEmpty(), "HashMap not empty");
+   testNull(map.get("width"), "HashMap get on empty map fails");
+
+   testTrue(map.put("width", 100), "HashMap put fails");
+   testTrue(map.put(String("height"), 200), "HashMap put fails");
+   testTrue(map.put("Gr\xC3\xB6\xC3\x9F" "e", 300), "HashMap put fails");
+   testFalse(map.put("width", 150), "HashMap replace fails");
+   testEquals(map.size(), 3, "HashMap size wrong");
+
+   // Lookup by String, const char* and std::string_view
+   testEquals(*map.get(String("width")), 150, "HashMap get fails");
+   testEquals(*map.get("height"), 200, "HashMap get (const char*) fails");
+   testEquals(*map.get(std::string_view("Gr\xC3\xB6\xC3\x9F" "e")), 300,
+              "HashMap get (string_view) fails");
+   testTrue(map.containsKey("height"), "HashMap containsKey fails");
+   testFalse(map.containsKey("depth"), "HashMap containsKey fails");
+   testNull(map.get("heigh"), "HashMap get fails");
+
+   // Keys longer than the stack buffer
+   const std::string longKey(300, 'x');
+   map.put(String(longKey.c_str()), 400);
+   testEquals(*map.get(longKey), 400, "HashMap get (long key) fails");
+
+   // Removal keeps the other entries
+   testTrue(map.remove("width"), "HashMap remove fails");
+   testFalse(map.remove("width"), "HashMap remove fails");
+   testNull(map.get("width"), "HashMap get after remove fails");
+   testEquals(*map.get("height"), 200, "HashMap get after remove fails");
+   testEquals(*map.get(longKey), 400, "HashMap get after remove fails");
+   testEquals(map.size(), 3, "HashMap size wrong");
+
+   map["depth"] = 500;
+   map["depth"] += 1;
+   testEquals(*map.get("depth"), 501, "HashMap operator[] fails");
+
+   map.clear();
+   testTrue(map.isEmpty(), "HashMap clear fails");
+   testNull(map.get("height"), "HashMap clear fails");
+}
+
+void HashMapTest::testIntegerKeys()
+{
+   HashMap<int64, int64> map;
+   const int64 count = 20000;
+   for(int64 a = 0; a < count; a++)map.put(a * 16, a);
+   testEquals(static_cast<int64>(map.size()), count, "HashMap size wrong");
+
+   bool ok = true;
+   for(int64 a = 0; a < count; a++)
+   {
+      const int64* value = map.get(a * 16);
+      if(value == nullptr || *value != a)ok = false;
+      if(map.get(a * 16 + 1) != nullptr)ok = false;
+   }
+   testTrue(ok, "HashMap lookup fails");
+
+   for(int64 a = 0; a < count; a += 3)
+   {
+      if(!map.remove(a * 16))ok = false;
+   }
+   testTrue(ok, "HashMap remove fails");
+   for(int64 a = 0; a < count; a++)
+   {
+      const int64* value = map.get(a * 16);
+      if(a % 3 == 0 && value != nullptr)ok = false;
+      if(a % 3 != 0 && (value == nullptr || *value != a))ok = false;
+   }
+   testTrue(ok, "HashMap lookup after remove fails");
+
+   // The iteration visits every entry once.
+   int64 sum = 0;
+   size_t entries = 0;
+   for(const auto& entry : map)
+   {
+      if(entry.key() != entry.value() * 16)ok = false;
+      sum += entry.value();
+      entries++;
+   }
+   testTrue(ok, "HashMap iteration fails");
+   testEquals(entries, map.size(), "HashMap iteration count wrong");
+   int64 expected = 0;
+   for(int64 a = 0; a < count; a++)if(a % 3 != 0)expected += a;
+   testEquals(sum, expected, "HashMap iteration sum wrong");
+
+   // Insertion order is kept without removal.
+   HashMap<int32, int32> ordered;
+   ordered.reserve(100);
+   for(int32 a = 99; a >= 0; a--)ordered.put(a, a);
+   int32 next = 99;
+   for(const auto& entry : ordered)
+   {
+      if(entry.key() != next--)ok = false;
+   }
+   testTrue(ok, "HashMap order fails");
+}
+
+void HashMapTest::testEmplace()
+{
+   HashMap<String, Counted> map;
+   Counted::copies = 0;
+   map.emplace("a", 1);
+   map.emplace(String("b"), 2);
+   map.emplace("a", 3);
+   for(int32 a = 0; a < 1000; a++)map.emplace(String::valueOf(static_cast<int64>(a)), a);
+   testEquals(map.get("a")->value, 1, "HashMap emplace replaced value");
+   testEquals(map.get("b")->value, 2, "HashMap emplace fails");
+   testEquals(map.get("999")->value, 999, "HashMap emplace fails");
+   testEquals(Counted::copies, 0, "HashMap emplace copies values");
+}
+
+void HashMapTest::testCopy()
+{
+   HashMap<String, String> map;
+   for(int64 a = 0; a < 100; a++)map.put(String::valueOf(a), String("value%1").arg(a));
+
+   HashMap<String, String> copy = map;
+   map.remove("5");
+   testEquals(copy.size(), 100, "HashMap copy fails");
+   testEquals(*copy.get("5"), "value5", "HashMap copy fails");
+
+   HashMap<String, String> moved = std::move(copy);
+   testEquals(*moved.get("99"), "value99", "HashMap move fails");
+
+   copy = moved;
+   moved = HashMap<String, String>();
+   testTrue(moved.isEmpty(), "HashMap move assignment fails");
+   testEquals(*copy.get("42"), "value42", "HashMap copy assignment fails");
+}
+
+void HashMapTest::testHashFunctions()
+{
+   static_assert(HashMap<String, int32>::kTextLookup);
+   static_assert(!HashMap<String, int32, LengthHash>::kTextLookup);
+   static_assert(HashMap<String, int32, TransparentLengthHash>::kTextLookup);
+   static_assert(!HashMap<int32, int32>::kTextLookup);
+
+   // Text is converted to a String, so that the hash function of the map is used.
+   HashMap<String, int32, LengthHash> map;
+   map.put("width", 100);
+   map.put("Gr\xC3\xB6\xC3\x9F" "e", 300);
+   testEquals(*map.get("width"), 100, "HashMap with own hash function fails");
+   testEquals(*map.get(String("Gr\xC3\xB6\xC3\x9F" "e")), 300,
+              "HashMap with own hash function fails");
+   testNull(map.get("depth"), "HashMap with own hash function fails");
+
+   HashMap<String, int32, TransparentLengthHash> transparent;
+   transparent.put("width", 100);
+   transparent.put("Gr\xC3\xB6\xC3\x9F" "e", 300);
+   testEquals(*transparent.get(std::string_view("width")), 100,
+              "HashMap with transparent hash function fails");
+   testEquals(*transparent.get("Gr\xC3\xB6\xC3\x9F" "e"), 300,
+              "HashMap with transparent hash function fails");
+   testFalse(transparent.containsKey("depth"), "HashMap with transparent hash function fails");
+}
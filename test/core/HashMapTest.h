@@ -0,0 +1,28 @@
+//
+//  HashMapTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_HashMapTest_h
+#define jm_HashMapTest_h
+
+#include "core/Test.h"
+
+class HashMapTest : public jm::Test
+{
+   public:
+      HashMapTest();
+      void doTest();
+
+   private:
+      void testStringKeys();
+      void testIntegerKeys();
+      void testEmplace();
+      void testCopy();
+      void testHashFunctions();
+};
+
+#endif
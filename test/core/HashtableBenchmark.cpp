@@ -0,0 +1,413 @@
+//
+//  HashtableBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "core/Core.h"
+#include "core/Property.h"
+#include "HashtableBenchmark.h"
+
+using namespace jm;
+
+HashtableBenchmark::HashtableBenchmark(): Benchmark()
+{
+   setName("Benchmark Hashtable");
+}
+
+void HashtableBenchmark::doTest()
+{
+   benchmarkHashtable(1000);
+   benchmarkHashtable(100000);
+   benchmarkHashMap(1000);
+   benchmarkHashMap(100000);
+   benchmarkPreferences();
+   benchmarkI18nBundle();
+   benchmarkI18nBundle(1);
+   benchmarkI18nBundle(2);
+   benchmarkI18nBundle(4);
+   benchmarkI18nBundle(8);
+   benchmarkAtoms();
+}
+
+std::vector<String> HashtableBenchmark::createKeys(size_t count, const String& prefix)
+{
+   std::vector<String> keys;
+   keys.reserve(count);
+   for(size_t index = 0; index < count; index++)
+   {
+      keys.push_back(prefix + String::valueOf(static_cast<uint64>(index)));
+   }
+   return keys;
+}
+
+void HashtableBenchmark::benchmarkHashtable(size_t count)
+{
+   const std::vector<String> keys = createKeys(count, "layer/Wall-Exterior-");
+   const std::vector<String> missing = createKeys(count, "layer/Wall-Interior-");
+   const size_t rounds = std::max(static_cast<size_t>(1), 1000000 / count);
+   const String label = String("%1 keys").arg(static_cast<uint64>(count));
+   size_t total = 0;
+
+   Clock::time_point start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      Hashtable table;
+      for(size_t index = 0; index < count; index++)
+      {
+         table.put(keys[index], reinterpret_cast<void*>(index + 1));
+      }
+      total += table.size();
+   }
+   report(String("Hashtable put %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, rounds * count, "Hashtable put benchmark fails");
+
+   Hashtable table;
+   for(size_t index = 0; index < count; index++)
+   {
+      table.put(keys[index], reinterpret_cast<void*>(index + 1));
+   }
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         total += reinterpret_cast<size_t>(table.get(keys[index]));
+      }
+   }
+   report(String("Hashtable get (hit) %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, rounds * count * (count + 1) / 2, "Hashtable get benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         if(table.get(missing[index]) == nullptr)total++;
+      }
+   }
+   report(String("Hashtable get (miss) %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, rounds * count, "Hashtable miss benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < count; index++)
+   {
+      if(table.remove(keys[index]) != nullptr)total++;
+   }
+   report(String("Hashtable remove %1").arg(label), count, elapsed(start));
+   testEquals(total, count, "Hashtable remove benchmark fails");
+}
+
+void HashtableBenchmark::benchmarkHashMap(size_t count)
+{
+   const std::vector<String> keys = createKeys(count, "layer/Wall-Exterior-");
+   std::vector<std::string> utf8;
+   for(size_t index = 0; index < count; index++)
+   {
+      utf8.push_back("layer/Wall-Exterior-" + std::to_string(index));
+   }
+   const size_t rounds = std::max(static_cast<size_t>(1), 1000000 / count);
+   const String label = String("%1 keys").arg(static_cast<uint64>(count));
+   const size_t expected = rounds * count * (count + 1) / 2;
+
+   // Insertion
+   size_t total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      HashMap<String, size_t> map;
+      for(size_t index = 0; index < count; index++)map.put(keys[index], index + 1);
+      total += map.size();
+   }
+   report(String("HashMap put %1").arg(label), rounds * count, elapsed(start));
+
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      std::unordered_map<String, size_t> map;
+      for(size_t index = 0; index < count; index++)map.emplace(keys[index], index + 1);
+      total += map.size();
+   }
+   report(String("std::unordered_map put %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, 2 * rounds * count, "HashMap put benchmark fails");
+
+   // Lookup
+   HashMap<String, size_t> map;
+   std::unordered_map<String, size_t> stdMap;
+   Hashtable table;
+   for(size_t index = 0; index < count; index++)
+   {
+      map.put(keys[index], index + 1);
+      stdMap.emplace(keys[index], index + 1);
+      table.put(keys[index], reinterpret_cast<void*>(index + 1));
+   }
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         const size_t* value = map.get(keys[index]);
+         if(value != nullptr)total += *value;
+      }
+   }
+   report(String("HashMap get %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, expected, "HashMap get benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         const auto it = stdMap.find(keys[index]);
+         if(it != stdMap.end())total += it->second;
+      }
+   }
+   report(String("std::unordered_map find %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, expected, "std::unordered_map benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         total += reinterpret_cast<size_t>(table.get(keys[index]));
+      }
+   }
+   report(String("Hashtable get %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, expected, "Hashtable benchmark fails");
+
+   // Lookup with UTF-8 text, where the others need a temporary String.
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         const size_t* value = map.get(utf8[index].c_str());
+         if(value != nullptr)total += *value;
+      }
+   }
+   report(String("HashMap get (const char*) %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, expected, "HashMap get benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         const auto it = stdMap.find(String(utf8[index].c_str()));
+         if(it != stdMap.end())total += it->second;
+      }
+   }
+   report(String("std::unordered_map find (const char*) %1").arg(label), rounds * count,
+          elapsed(start));
+   testEquals(total, expected, "std::unordered_map benchmark fails");
+
+   // Iteration
+   total = 0;
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(const auto& entry : map)total += entry.value();
+   }
+   report(String("HashMap iterate %1").arg(label), rounds * count, elapsed(start));
+
+   start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(const auto& entry : stdMap)total += entry.second;
+   }
+   report(String("std::unordered_map iterate %1").arg(label), rounds * count, elapsed(start));
+   testEquals(total, 2 * expected, "HashMap iteration benchmark fails");
+}
+
+void HashtableBenchmark::benchmarkPreferences()
+{
+   const size_t count = 2000;
+   const size_t rounds = 500;
+   const std::vector<String> keys = createKeys(count, "view.toolbar.item.");
+
+   Preferences prefs;
+   for(size_t index = 0; index < count; index++)
+   {
+      prefs.setValue(keys[index], static_cast<int64>(index));
+   }
+
+   int64 total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         total += prefs.valueInt(keys[index], 0);
+      }
+   }
+   report("Preferences valueInt 2000 keys", rounds * count, elapsed(start));
+   testEquals(total, static_cast<int64>(rounds * count * (count - 1) / 2),
+              "Preferences benchmark fails");
+}
+
+void HashtableBenchmark::benchmarkI18nBundle()
+{
+   const size_t count = 5000;
+   const size_t rounds = 200;
+   const std::vector<String> keys = createKeys(count, "Cannot open the selected file: ");
+
+   I18nBundle bundle("de");
+   for(size_t index = 0; index < count; index += 2)
+   {
+      bundle.setValue(keys[index], keys[index].toUpperCase());
+   }
+
+   // Half of the keys have no translation, like in a partly translated application.
+   size_t total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(size_t index = 0; index < count; index++)
+      {
+         total += bundle.translate(keys[index]).size();
+      }
+   }
+   report("I18nBundle translate 5000 keys", rounds * count, elapsed(start));
+
+   size_t expected = 0;
+   for(const String& key : keys)expected += key.size();
+   testEquals(total, rounds * expected, "I18nBundle benchmark fails");
+}
+
+void HashtableBenchmark::benchmarkI18nBundle(size_t threads)
+{
+   const size_t count = 5000;
+   const size_t rounds = 100;
+   const std::vector<String> keys = createKeys(count, "Cannot open the selected file: ");
+
+   I18nBundle bundle("de");
+   for(size_t index = 0; index < count; index++)
+   {
+      bundle.setValue(keys[index], keys[index].toUpperCase());
+   }
+
+   // Every thread translates all keys, starting at a different key.
+   std::vector<size_t> totals(threads, 0);
+   std::vector<std::thread> workers;
+   Clock::time_point start = Clock::now();
+   for(size_t thread = 0; thread < threads; thread++)
+   {
+      workers.emplace_back([&bundle, &keys, &totals, thread]()
+      {
+         size_t total = 0;
+         for(size_t round = 0; round < rounds; round++)
+         {
+            for(size_t index = 0; index < count; index++)
+            {
+               total += bundle.translate(keys[(index + thread * 997) % count]).size();
+            }
+         }
+         totals[thread] = total;
+      });
+   }
+   for(std::thread& worker : workers)worker.join();
+   report(String("I18nBundle translate %1 threads").arg(static_cast<uint64>(threads)),
+          threads * rounds * count, elapsed(start));
+
+   size_t expected = 0;
+   for(const String& key : keys)expected += key.size();
+   for(size_t total : totals)testEquals(total, rounds * expected, "I18nBundle benchmark fails");
+}
+
+void HashtableBenchmark::benchmarkAtoms()
+{
+   const size_t iterations = 1000000;
+   const char* literal = "Cannot open the selected file";
+
+   I18nBundle bundle("de");
+   const String translation = String("Die Datei kann nicht ge\xC3\xB6" "ffnet werden");
+   bundle.setValue(literal, translation);
+
+   // Like Tr("..."): the key is created from the literal for every call.
+   size_t total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += bundle.translate(literal).size();
+   }
+   report("translate(const char*)", iterations, elapsed(start));
+
+   const Atom key = Atom(literal);
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += bundle.translate(key).size();
+   }
+   report("translate(Atom)", iterations, elapsed(start));
+
+   // Like TrLiteral("..."): the key is decoded and hashed by the compiler.
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += bundle.translate(literalKey("Cannot open the selected file")).size();
+   }
+   report("translate(TranslationKey)", iterations, elapsed(start));
+   testEquals(total, 3 * iterations * translation.size(), "Atom benchmark fails");
+
+   // Keys without translation, like most log labels
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += bundle.translate("Cannot save the selected file").size();
+   }
+   report("translate(const char*) untranslated", iterations, elapsed(start));
+
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += bundle.translate(literalKey("Cannot save the selected file")).size();
+   }
+   report("translate(TranslationKey) untranslated", iterations, elapsed(start));
+   testEquals(total, 2 * iterations * 29, "Atom benchmark fails");
+
+   // Searching a property among others
+   std::vector<Property*> properties;
+   for(const char* id : {"layer", "linetype", "lineweight", "color", "transparency", "width"})
+   {
+      properties.push_back(new Property(id));
+   }
+
+   total = 0;
+   const String width = "width";
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      for(const Property* property : properties)if(property->is(width))total++;
+   }
+   report("Property::is(String)", iterations, elapsed(start));
+
+   const Atom widthAtom = Atom(width);
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      for(const Property* property : properties)if(property->is(widthAtom))total++;
+   }
+   report("Property::is(Atom)", iterations, elapsed(start));
+   testEquals(total, 2 * iterations, "Atom benchmark fails");
+
+   for(Property* property : properties)delete property;
+}
@@ -0,0 +1,41 @@
+//
+//  HashtableBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef __jameo__HashtableBenchmark__
+#define __jameo__HashtableBenchmark__
+
+#include <vector>
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::Hashtable, jm::HashMap and the classes built on them. The results are written to
+ the log, so that changes of the throughput become visible. The few tests only make sure, that the
+ benchmarks did real work.
+ */
+class HashtableBenchmark : public Benchmark
+{
+   public:
+      HashtableBenchmark();
+      void doTest();
+
+   private:
+
+      void benchmarkHashtable(size_t count);
+      void benchmarkHashMap(size_t count);
+      void benchmarkPreferences();
+      void benchmarkI18nBundle();
+      void benchmarkI18nBundle(size_t threads);
+      void benchmarkAtoms();
+
+      //! Creates \p count distinct keys, which look like translation or preference keys.
+      static std::vector<jm::String> createKeys(size_t count, const jm::String& prefix);
+
+};
+
+#endif
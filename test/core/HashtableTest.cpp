@@ -78,4 +78,98 @@ void HashtableTest::doTest()
    testEquals((uint64)ht->get("value5"), 0, "Hashtable fails");
    delete ht;
 
+   // Growth, removal and reinsertion
+   ht = new Hashtable();
+   testTrue(ht->isEmpty(), "Hashtable not empty");
+   for(uint64 a = 1; a <= 10000; a++)
+   {
+      ht->put(String("key%1").arg(a), (void*) a);
+   }
+   testEquals(ht->size(), 10000, "Hashtable size wrong");
+   testFalse(ht->isEmpty(), "Hashtable is empty");
+   testTrue(ht->containsValue((void*) 5000), "Hashtable containsValue fails");
+   testFalse(ht->containsValue((void*) 10001), "Hashtable containsValue fails");
+
+   bool ok = true;
+   for(uint64 a = 1; a <= 10000; a++)
+   {
+      if((uint64)ht->get(String("key%1").arg(a)) != a)ok = false;
+   }
+   testTrue(ok, "Hashtable lookup after growth fails");
+   testEquals((uint64)ht->get("key0"), 0, "Hashtable fails");
+
+   for(uint64 a = 1; a <= 10000; a += 2)
+   {
+      if((uint64)ht->remove(String("key%1").arg(a)) != a)ok = false;
+   }
+   testTrue(ok, "Hashtable remove fails");
+   testEquals(ht->size(), 5000, "Hashtable size wrong");
+   for(uint64 a = 1; a <= 10000; a++)
+   {
+      uint64 expected = (a % 2 == 0) ? a : 0;
+      if((uint64)ht->get(String("key%1").arg(a)) != expected)ok = false;
+   }
+   testTrue(ok, "Hashtable lookup after remove fails");
+
+   for(uint64 a = 1; a <= 10000; a += 2)
+   {
+      if(ht->put(String("key%1").arg(a), (void*)(a + 1)) != nullptr)ok = false;
+   }
+   testTrue(ok, "Hashtable reinsert fails");
+   testEquals((uint64)ht->put("key2", (void*) 3), 2, "Hashtable replace fails");
+   testEquals(ht->size(), 10000, "Hashtable size wrong");
+
+   // Iterators visit every entry once
+   Iterator* it = ht->values();
+   uint64 sum = 0;
+   size_t count = 0;
+   while(it->hasNext())
+   {
+      sum += (uint64)it->next();
+      count++;
+   }
+   delete it;
+   testEquals(count, 10000, "Hashtable iterator count wrong");
+   testEquals(sum, 10000 * 10002 / 2 + 1, "Hashtable iterator values wrong");
+
+   it = ht->keys();
+   count = 0;
+   while(it->hasNext())
+   {
+      const String* key = static_cast<String*>(it->next());
+      if(!key->startsWith("key"))ok = false;
+      count++;
+   }
+   delete it;
+   testTrue(ok, "Hashtable key iterator fails");
+   testEquals(count, 10000, "Hashtable iterator count wrong");
+
+   ht->clear();
+   testTrue(ht->isEmpty(), "Hashtable not empty after clear");
+   testEquals((uint64)ht->get("key2"), 0, "Hashtable clear fails");
+   ht->put("key2", (void*) 2);
+   testEquals((uint64)ht->get("key2"), 2, "Hashtable put after clear fails");
+   delete ht;
+
+   // Repeated put and remove of the same keys must not fill the table.
+   ht = new Hashtable();
+   for(uint64 a = 1; a <= 100000; a++)
+   {
+      ht->put(String("tmp%1").arg(a % 8), (void*) a);
+      ht->remove(String("tmp%1").arg((a + 4) % 8));
+   }
+   testEquals(ht->size(), 4, "Hashtable size wrong");
+   delete ht;
+
+   // Reserve
+   ht = new Hashtable();
+   ht->reserve(1000);
+   for(uint64 a = 1; a <= 1000; a++)
+   {
+      ht->put(String("reserved%1").arg(a), (void*) a);
+   }
+   testEquals((uint64)ht->get("reserved999"), 999, "Hashtable reserve fails");
+   testEquals(ht->size(), 1000, "Hashtable size wrong");
+   delete ht;
+
 }
@@ -0,0 +1,341 @@
+//
+//  I18nBundleTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "core/Core.h"
+#include "I18nBundleTest.h"
+
+using namespace jm;
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed(Clock::time_point start)
+{
+   return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+//! The hash function of GNU gettext.
+static uint32 hashString(const std::string& key)
+{
+   uint32 hash = 0;
+   for(char c : key)
+   {
+      hash = (hash << 4) + static_cast<uint8>(c);
+      const uint32 high = hash & 0xF0000000u;
+      if(high != 0)hash ^= (high >> 24) ^ high;
+   }
+   return hash;
+}
+
+static void appendUInt32(std::string& buffer, uint32 value)
+{
+   for(uint32 shift = 0; shift < 32; shift += 8)
+   {
+      buffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+   }
+}
+
+I18nBundleTest::I18nBundleTest(): Test()
+{
+   setName("Test I18nBundle");
+}
+
+void I18nBundleTest::doTest()
+{
+   testMappedFile();
+   testMappedCatalog();
+   testPrecedence();
+   testConcurrentMapping();
+   testFallbacks();
+   benchmarkStartup();
+}
+
+File I18nBundleTest::writeMo(const String& name, const Entries& entries, bool hashTable)
+{
+   const uint32 count = static_cast<uint32>(entries.size());
+
+   // Like msgfmt: the next prime above 4/3 of the number of strings
+   uint32 hashSize = 0;
+   if(hashTable)
+   {
+      hashSize = std::max(count * 4 / 3, static_cast<uint32>(3));
+      bool prime = false;
+      while(!prime)
+      {
+         prime = true;
+         for(uint32 divisor = 2; divisor * divisor <= hashSize && prime; divisor++)
+         {
+            if(hashSize % divisor == 0)prime = false;
+         }
+         if(!prime)hashSize++;
+      }
+   }
+
+   std::vector<uint32> table(hashSize, 0);
+   for(uint32 index = 0; index < count && hashTable; index++)
+   {
+      const uint32 hash = hashString(entries[index].first);
+      const uint32 step = 1 + hash % (hashSize - 2);
+      uint32 slot = hash % hashSize;
+      while(table[slot] != 0)
+      {
+         slot = slot >= hashSize - step ? slot - (hashSize - step) : slot + step;
+      }
+      table[slot] = index + 1;
+   }
+
+   const uint32 origOffset = 28;
+   const uint32 transOffset = origOffset + 8 * count;
+   const uint32 hashOffset = transOffset + 8 * count;
+   uint32 stringOffset = hashOffset + 4 * hashSize;
+
+   std::string header;
+   appendUInt32(header, 0x950412de);
+   appendUInt32(header, 0);
+   appendUInt32(header, count);
+   appendUInt32(header, origOffset);
+   appendUInt32(header, transOffset);
+   appendUInt32(header, hashSize);
+   appendUInt32(header, hashOffset);
+
+   std::string origTable;
+   std::string transTable;
+   std::string strings;
+   for(const auto& entry : entries)
+   {
+      appendUInt32(origTable, static_cast<uint32>(entry.first.size()));
+      appendUInt32(origTable, stringOffset);
+      strings.append(entry.first);
+      strings.push_back(0);
+      stringOffset += static_cast<uint32>(entry.first.size() + 1);
+   }
+   for(const auto& entry : entries)
+   {
+      appendUInt32(transTable, static_cast<uint32>(entry.second.size()));
+      appendUInt32(transTable, stringOffset);
+      strings.append(entry.second);
+      strings.push_back(0);
+      stringOffset += static_cast<uint32>(entry.second.size() + 1);
+   }
+
+   std::string content = header + origTable + transTable;
+   for(uint32 slot : table)appendUInt32(content, slot);
+   content += strings;
+
+   File file = File(jm::currentDir(), name);
+   file.open(FileMode::kWrite);
+   file.write(reinterpret_cast<const uint8*>(content.data()), content.size());
+   file.close();
+   return file;
+}
+
+void I18nBundleTest::testMappedFile()
+{
+   File file = File(jm::currentDir(), "mapped-file-test.txt");
+   file.open(FileMode::kWrite);
+   file.write(reinterpret_cast<const uint8*>("mapped content"), 14);
+   file.close();
+
+   MappedFile mapped;
+   testFalse(mapped.isMapped(), "MappedFile::isMapped() fails");
+   testTrue(mapped.map(file) == Status::eOK, "MappedFile::map() fails");
+   testTrue(mapped.isMapped(), "MappedFile::isMapped() fails");
+   testEquals(mapped.size(), 14, "MappedFile::size() fails");
+   testTrue(memcmp(mapped.data(), "mapped content", 14) == 0, "MappedFile::data() fails");
+   mapped.unmap();
+   testNull(mapped.data(), "MappedFile::unmap() fails");
+
+   testTrue(mapped.map(File(jm::currentDir(), "missing-file.txt")) == Status::eNotFound,
+            "MappedFile::map() of missing file fails");
+   file.remove();
+}
+
+void I18nBundleTest::testMappedCatalog()
+{
+   Entries entries =
+   {
+      {"", "Content-Type: text/plain; charset=UTF-8\n"},
+      {"Untranslated", ""},
+      {"Cannot open file", "Kann Datei nicht \xC3\xB6" "ffnen"},
+      {"Gr\xC3\xB6\xC3\x9F" "e", "Size"},
+      {"%1 file", std::string("%1 Datei\0%1 Dateien", 19)},
+      {"Two lines", "Erste Zeile\nZweite Zeile\r\nDritte Zeile"}
+   };
+   for(int32 index = 0; index < 500; index++)
+   {
+      entries.push_back({"Key " + std::to_string(index),
+                         "Schl\xC3\xBCssel " + std::to_string(index)});
+   }
+
+   File file = writeMo("mapped-test.mo", entries);
+   I18nBundle mapped("de");
+   testTrue(mapped.mapMo(file) == Status::eOK, "I18nBundle::mapMo() fails");
+
+   I18nBundle read("de");
+   read.appendMo(&file);
+
+   // Every key gives the same translation as with appendMo(), also with line breaks.
+   bool ok = true;
+   for(const auto& entry : entries)
+   {
+      const String key = String(entry.first.data(), entry.first.size());
+      if(mapped.translate(key) != read.translate(key))ok = false;
+   }
+   testTrue(ok, "I18nBundle::mapMo() translation differs from appendMo()");
+
+   testEquals(mapped.translate("Cannot open file"), "Kann Datei nicht \xC3\xB6" "ffnen",
+              "I18nBundle::mapMo() translation fails");
+   testEquals(mapped.translate(literalKey("Gr\xC3\xB6\xC3\x9F" "e")), "Size",
+              "I18nBundle::mapMo() translation of TranslationKey fails");
+   testEquals(mapped.translate(Atom("Key 499")), "Schl\xC3\xBCssel 499",
+              "I18nBundle::mapMo() translation of Atom fails");
+   testEquals(mapped.translate("%1 file"), "%1 Datei",
+              "I18nBundle::mapMo() singular of plural entry fails");
+   testEquals(mapped.translate(""), "Content-Type: text/plain; charset=UTF-8\\n",
+              "I18nBundle::mapMo() header fails");
+   testEquals(mapped.translate("Two lines"), "Erste Zeile\\nZweite Zeile\\nDritte Zeile",
+              "I18nBundle::mapMo() line breaks fail");
+   testEquals(read.translate("Two lines"), mapped.translate("Two lines"),
+              "I18nBundle::mapMo() line breaks differ from appendMo()");
+   testEquals(mapped.translate("Untranslated"), "Untranslated",
+              "I18nBundle::mapMo() empty translation fails");
+
+   // Misses, also twice to read the remembered miss
+   for(int32 round = 0; round < 2; round++)
+   {
+      testEquals(mapped.translate("Key 500"), "Key 500", "I18nBundle::mapMo() miss fails");
+      testEquals(mapped.translate(literalKey("Cannot open")), "Cannot open",
+                 "I18nBundle::mapMo() miss fails");
+      testEquals(mapped.translate("Cannot open file!"), "Cannot open file!",
+                 "I18nBundle::mapMo() miss fails");
+   }
+
+   file.remove();
+}
+
+void I18nBundleTest::testPrecedence()
+{
+   File first = writeMo("first-test.mo", {{"Open", "\xC3\x96" "ffnen"}, {"Close", "Schliessen"}});
+   File second = writeMo("second-test.mo", {{"Close", "Schlie\xC3\x9F" "en"}});
+
+   I18nBundle bundle("de");
+   testTrue(bundle.mapMo(first) == Status::eOK, "I18nBundle::mapMo() fails");
+   testEquals(bundle.translate("Close"), "Schliessen", "I18nBundle::mapMo() fails");
+   testEquals(bundle.translate("Save"), "Save", "I18nBundle::mapMo() fails");
+
+   // A later catalog takes precedence, also over remembered translations.
+   testTrue(bundle.mapMo(second) == Status::eOK, "I18nBundle::mapMo() fails");
+   testEquals(bundle.translate("Close"), "Schlie\xC3\x9F" "en", "Later catalog is not preferred");
+   testEquals(bundle.translate("Open"), "\xC3\x96" "ffnen", "Earlier catalog is not searched");
+
+   // Values set directly take precedence.
+   bundle.setValue("Open", String("Aufmachen"));
+   testEquals(bundle.translate("Open"), "Aufmachen", "Value is not preferred");
+   testEquals(bundle.translate(literalKey("Open")), "Aufmachen", "Value is not preferred");
+
+   // Empty values are no translation.
+   bundle.setValue("Close", String());
+   testEquals(bundle.translate("Close"), "Schlie\xC3\x9F" "en", "Empty value is used");
+   testEquals(bundle.translate(literalKey("Close")), "Schlie\xC3\x9F" "en",
+              "Empty value is used");
+
+   first.remove();
+   second.remove();
+}
+
+void I18nBundleTest::testConcurrentMapping()
+{
+   File first = writeMo("first-test.mo", {{"Close", "Schliessen"}});
+   File second = writeMo("second-test.mo", {{"Close", "Schlie\xC3\x9F" "en"}});
+
+   // A lookup in the old catalogs, which runs while a catalog is added, must not remember its
+   // result after the catalog was added.
+   for(int32 round = 0; round < 20; round++)
+   {
+      I18nBundle bundle("de");
+      bundle.mapMo(first);
+      std::atomic<bool> running(true);
+      std::thread reader([&bundle, &running]()
+      {
+         while(running.load())bundle.translate(String("Close"));
+      });
+      std::this_thread::yield();
+      bundle.mapMo(second);
+      running.store(false);
+      reader.join();
+      testEquals(bundle.translate("Close"), "Schlie\xC3\x9F" "en",
+                 "I18nBundle::mapMo() keeps translation of old catalog");
+   }
+
+   first.remove();
+   second.remove();
+}
+
+void I18nBundleTest::testFallbacks()
+{
+   // Without hash table the file is read.
+   File file = writeMo("unhashed-test.mo", {{"Open", "\xC3\x96" "ffnen"}}, false);
+   I18nBundle bundle("de");
+   testTrue(bundle.mapMo(file) == Status::eOK, "I18nBundle::mapMo() without hash table fails");
+   testEquals(bundle.translate("Open"), "\xC3\x96" "ffnen",
+              "I18nBundle::mapMo() without hash table fails");
+   file.remove();
+
+   // Plural entries are found by the singular, like in gettext.
+   file = writeMo("plural-test.mo", {{std::string("%1 day\0%1 days", 14),
+                                      std::string("%1 Tag\0%1 Tage", 14)}}, false);
+   I18nBundle plural("de");
+   plural.appendMo(&file);
+   testEquals(plural.translate("%1 day"), "%1 Tag", "I18nBundle::appendMo() plural entry fails");
+   file.remove();
+
+   // Broken and missing files
+   file = File(jm::currentDir(), "broken-test.mo");
+   file.open(FileMode::kWrite);
+   file.write(reinterpret_cast<const uint8*>("This is no catalog at all."), 26);
+   file.close();
+   testTrue(bundle.mapMo(file) == Status::eInvalidInput, "I18nBundle::mapMo() accepts no catalog");
+   file.remove();
+
+   testTrue(bundle.mapMo(File(jm::currentDir(), "missing-test.mo")) == Status::eNotFound,
+            "I18nBundle::mapMo() of missing file fails");
+   testEquals(bundle.translate("Open"), "\xC3\x96" "ffnen", "Failed mapMo() changes bundle");
+}
+
+void I18nBundleTest::benchmarkStartup()
+{
+   Entries entries;
+   for(int32 index = 0; index < 20000; index++)
+   {
+      entries.push_back({"Cannot open the file number " + std::to_string(index),
+                         "Die Datei Nummer " + std::to_string(index) +
+                         " kann nicht ge\xC3\xB6" "ffnet werden"});
+   }
+   File file = writeMo("benchmark-test.mo", entries);
+
+   Clock::time_point start = Clock::now();
+   I18nBundle read("de");
+   read.appendMo(&file);
+   const double readTime = elapsed(start);
+
+   start = Clock::now();
+   I18nBundle mapped("de");
+   mapped.mapMo(file);
+   const double mapTime = elapsed(start);
+
+   System::log(String("I18nBundle 20000 entries: appendMo %1 ms, mapMo %2 ms")
+               .arg(readTime, 0, 3)
+               .arg(mapTime, 0, 3), LogLevel::kInformation);
+
+   testEquals(mapped.translate("Cannot open the file number 12345"),
+              read.translate("Cannot open the file number 12345"), "I18nBundle::mapMo() fails");
+   file.remove();
+}
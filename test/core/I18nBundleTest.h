@@ -0,0 +1,41 @@
+//
+//  I18nBundleTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_I18nBundleTest_h
+#define jm_I18nBundleTest_h
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/Test.h"
+
+class I18nBundleTest : public jm::Test
+{
+   public:
+      I18nBundleTest();
+      void doTest();
+
+   private:
+
+      //! Original and translated string
+      typedef std::vector<std::pair<std::string, std::string>> Entries;
+
+      void testMappedFile();
+      void testMappedCatalog();
+      void testPrecedence();
+      void testConcurrentMapping();
+      void testFallbacks();
+      void benchmarkStartup();
+
+      //! Writes a *.mo file with \p entries. Like msgfmt, a hash table is added if \p hashTable
+      //! is true.
+      jm::File writeMo(const jm::String& name, const Entries& entries, bool hashTable = true);
+};
+
+#endif
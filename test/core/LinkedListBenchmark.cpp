@@ -0,0 +1,83 @@
+//
+//  LinkedListBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <random>
+#include <vector>
+
+#include "core/Core.h"
+#include "LinkedListBenchmark.h"
+
+using namespace jm;
+
+LinkedListBenchmark::LinkedListBenchmark(): Benchmark()
+{
+   setName("Benchmark LinkedList");
+}
+
+void LinkedListBenchmark::doTest()
+{
+   // Without index, each removal searches the list, so only a few removals are measured.
+   benchmarkRemove(1000000, 1000, false, false);
+   benchmarkRemove(1000000, 100000, true, false);
+   benchmarkRemove(1000000, 100000, true, true);
+}
+
+void LinkedListBenchmark::benchmarkRemove(size_t count, size_t removals, bool indexed, bool undo)
+{
+   std::vector<Object> objects(count);
+   std::vector<size_t> victims(count);
+   for(size_t index = 0; index < count; index++)victims[index] = index;
+   std::mt19937 random(5);
+   std::shuffle(victims.begin(), victims.end(), random);
+
+   UndoManager* um = new UndoManager();
+   um->setActive(undo);
+
+   LinkedList* list = new LinkedList(this);
+   list->setIndexed(indexed);
+
+   Clock::time_point start = Clock::now();
+   for(Object& object : objects)list->add(&object, nullptr);
+   const double addTime = elapsed(start);
+
+   start = Clock::now();
+   for(size_t index = 0; index < removals; index++)
+   {
+      list->remove(&objects[victims[index]], undo ? um : nullptr);
+   }
+   um->close();
+   const double removeTime = elapsed(start);
+   testEquals(list->size(), count - removals, "LinkedList::remove() fails");
+
+   System::log(String("LinkedList%1 %2 elements: add %3 ms, remove %4 elements %5 ms "
+                      "(%6 us/element)")
+               .arg(indexed ? " (indexed)" : "")
+               .arg(static_cast<uint64>(count))
+               .arg(addTime, 0, 1)
+               .arg(static_cast<uint64>(removals))
+               .arg(removeTime, 0, 1)
+               .arg(removeTime * 1000.0 / static_cast<double>(removals), 0, 3),
+               LogLevel::kInformation);
+
+   if(undo)
+   {
+      start = Clock::now();
+      um->undo();
+      const double undoTime = elapsed(start);
+      testEquals(list->size(), count, "LinkedList undo fails");
+      testTrue(list->contains(&objects[victims[0]]), "LinkedList undo fails");
+      System::log(String("LinkedList%1 undo of %2 removals: %3 ms")
+                  .arg(indexed ? " (indexed)" : "")
+                  .arg(static_cast<uint64>(removals))
+                  .arg(undoTime, 0, 1), LogLevel::kInformation);
+   }
+
+   list->clear(nullptr);
+   delete um;
+   list->release();
+}
@@ -0,0 +1,34 @@
+//
+//  LinkedListBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_LinkedListBenchmark_h
+#define jm_LinkedListBenchmark_h
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::LinkedList. The results are written to the log. The few tests
+ only make sure, that the benchmarks did real work.
+ */
+class LinkedListBenchmark : public Benchmark
+{
+   public:
+      LinkedListBenchmark();
+      void doTest();
+
+   private:
+
+      /*!
+       \brief Removes \p removals random objects from a list with \p count objects.
+       \param indexed Enables the index of the list.
+       \param undo Records the removals at an UndoManager and undoes them afterwards.
+       */
+      void benchmarkRemove(size_t count, size_t removals, bool indexed, bool undo);
+};
+
+#endif
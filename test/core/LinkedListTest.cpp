@@ -12,6 +12,33 @@
 
 using namespace jm;
 
+//! Element of an IntrusiveList
+class Entity: public Object, public LinkedListHook
+{
+   public:
+      int64 id = 0;
+};
+
+//! Returns the indexes of the objects in \p list as string, e.g. "0213".
+static String order(LinkedList* list, const Object* objects)
+{
+   String result;
+   LinkedListIterator iter = list->iterator();
+   while(iter.hasNext())result << String::valueOf(static_cast<int64>(iter.next() - objects));
+   return result;
+}
+
+//! Returns the ids of the elements in \p list as string, e.g. "0213".
+static String order(const IntrusiveList<Entity>& list)
+{
+   String result;
+   for(Entity* item = list.first(); item != nullptr; item = list.next(item))
+   {
+      result << String::valueOf(item->id);
+   }
+   return result;
+}
+
 LinkedListTest::LinkedListTest(): Test()
 {
    setName("Test LinkedList");
@@ -24,6 +51,10 @@ void LinkedListTest::doTest()
    DoTest2(true);
    DoTest3(false);
    DoTest3(true);
+   DoTest4(false);
+   DoTest4(true);
+   DoTest5();
+   DoTest6();
 }
 
 void LinkedListTest::DoTest1()
@@ -392,3 +423,165 @@ void LinkedListTest::DoTest3(bool active)
    testEquals(l->referenceCount(), 1, "LinkList ref fails(22)");
    l->release();
 }
+
+void LinkedListTest::DoTest4(bool indexed)
+{
+   // Undo and redo of all operations, with and without index
+   UndoManager* um = new UndoManager();
+   um->setActive(true);
+
+   Object objects[6];
+   Object* data = new Object();
+
+   LinkedList* l = new LinkedList(this);
+   l->add(&objects[0], um);
+   l->setIndexed(indexed);
+   testEquals(l->isIndexed(), indexed, "LinkedList fails (29)");
+   for(size_t index = 1; index < 5; index++)l->add(&objects[index], um);
+   um->close();
+   testEquals(order(l, objects), "01234", "LinkedList fails (30)");
+   testTrue(l->contains(&objects[0]), "LinkedList fails (30a)");
+   testFalse(l->contains(&objects[5]), "LinkedList fails (30b)");
+
+   l->remove(&objects[0], um);
+   l->remove(&objects[4], um);
+   l->remove(&objects[2], um);
+   um->close();
+   testEquals(order(l, objects), "13", "LinkedList fails (31)");
+   testEquals(l->size(), 2u, "LinkedList fails (32)");
+   testTrue(l->remove(&objects[2], um) == Status::eNotFound, "LinkedList fails (33)");
+
+   l->addBefore(&objects[3], &objects[5], um);
+   l->swapData(&objects[1], &objects[3], um);
+   um->close();
+   testEquals(order(l, objects), "351", "LinkedList fails (34)");
+
+   testTrue(l->contains(&objects[5]), "LinkedList fails (34a)");
+
+   um->undo();
+   testEquals(order(l, objects), "13", "LinkedList fails (35)");
+   testFalse(l->contains(&objects[5]), "LinkedList fails (35a)");
+   um->undo();
+   testEquals(order(l, objects), "01234", "LinkedList fails (36)");
+   testTrue(l->contains(&objects[2]), "LinkedList fails (36a)");
+   testEquals(l->first(), &objects[0], "LinkedList fails (37)");
+   testEquals(l->last(), &objects[4], "LinkedList fails (38)");
+   um->redo();
+   um->redo();
+   testEquals(order(l, objects), "351", "LinkedList fails (39)");
+   testEquals(l->size(), 3u, "LinkedList fails (40)");
+
+   // The data, which was swapped and redone, is still found.
+   l->addBefore(&objects[1], &objects[0], um);
+   testEquals(order(l, objects), "3501", "LinkedList fails (40a)");
+   l->remove(&objects[0], um);
+   um->close();
+
+   // Removed data is retained as long as the change can be undone.
+   l->add(data, um);
+   um->close();
+   l->remove(data, um);
+   um->close();
+   testEquals(data->referenceCount(), 3, "LinkedList fails (41)");
+   um->clearStacks();
+   testEquals(data->referenceCount(), 1, "LinkedList fails (42)");
+   testEquals(order(l, objects), "351", "LinkedList fails (43)");
+
+   // A removed element stays removed, even if the iteration was at it.
+   l->rewind();
+   l->remove(&objects[3], nullptr);
+   testEquals(l->next(), &objects[5], "LinkedList fails (44)");
+
+   l->clear(um);
+   um->close();
+   um->undo();
+   testEquals(order(l, objects), "51", "LinkedList fails (45)");
+
+   delete um;
+   testEquals(l->referenceCount(), 1, "LinkedList fails (46)");
+   l->release();
+   data->release();
+}
+
+void LinkedListTest::DoTest5()
+{
+   // Intrusive list
+   UndoManager* um = new UndoManager();
+   um->setActive(true);
+
+   Entity entities[5];
+   for(size_t index = 0; index < 5; index++)entities[index].id = static_cast<int64>(index);
+
+   IntrusiveList<Entity>* l = new IntrusiveList<Entity>();
+   l->add(&entities[0], um);
+   l->add(&entities[2], um);
+   l->add(&entities[3], um);
+   l->addBefore(&entities[2], &entities[1], um);
+   um->close();
+   testEquals(order(*l), "0123", "IntrusiveList fails (1)");
+   testEquals(l->size(), 4u, "IntrusiveList fails (2)");
+   testEquals(entities[0].referenceCount(), 2, "IntrusiveList fails (3)");
+
+   testTrue(l->remove(&entities[2], um) == Status::eOK, "IntrusiveList fails (4)");
+   testTrue(l->remove(&entities[2], um) == Status::eNotFound, "IntrusiveList fails (5)");
+   testTrue(l->remove(&entities[4], um) == Status::eNotFound, "IntrusiveList fails (6)");
+   l->remove(&entities[0], um);
+   um->close();
+   testEquals(order(*l), "13", "IntrusiveList fails (7)");
+   testEquals(l->first(), &entities[1], "IntrusiveList fails (8)");
+   testEquals(l->previous(&entities[3]), &entities[1], "IntrusiveList fails (9)");
+
+   um->undo();
+   testEquals(order(*l), "0123", "IntrusiveList fails (10)");
+   um->undo();
+   testEquals(l->size(), 0u, "IntrusiveList fails (11)");
+   um->redo();
+   um->redo();
+   testEquals(order(*l), "13", "IntrusiveList fails (12)");
+   testEquals(l->last(), &entities[3], "IntrusiveList fails (13)");
+
+   l->clear(nullptr);
+   testEquals(l->size(), 0u, "IntrusiveList fails (14)");
+   l->add(&entities[4], nullptr);
+   testEquals(order(*l), "4", "IntrusiveList fails (15)");
+
+   delete um;
+   testEquals(entities[0].referenceCount(), 1, "IntrusiveList fails (16)");
+   testEquals(l->referenceCount(), 1, "IntrusiveList fails (17)");
+   l->release();
+}
+
+void LinkedListTest::DoTest6()
+{
+   // Elements of another intrusive list are not removed
+   Entity entities[4];
+   for(size_t index = 0; index < 4; index++)entities[index].id = static_cast<int64>(index);
+
+   IntrusiveList<Entity>* a = new IntrusiveList<Entity>();
+   IntrusiveList<Entity>* b = new IntrusiveList<Entity>();
+   a->add(&entities[0], nullptr);
+   a->add(&entities[1], nullptr);
+   b->add(&entities[2], nullptr);
+   b->add(&entities[3], nullptr);
+
+   // entities[1] and entities[3] have a predecessor and are the last element of their list.
+   testTrue(a->remove(&entities[3], nullptr) == Status::eNotFound, "IntrusiveList fails (18)");
+   testTrue(b->remove(&entities[1], nullptr) == Status::eNotFound, "IntrusiveList fails (19)");
+   testTrue(a->remove(&entities[2], nullptr) == Status::eNotFound, "IntrusiveList fails (20)");
+   testEquals(order(*a), "01", "IntrusiveList fails (21)");
+   testEquals(order(*b), "23", "IntrusiveList fails (22)");
+   testEquals(a->size(), 2u, "IntrusiveList fails (23)");
+   testEquals(b->size(), 2u, "IntrusiveList fails (24)");
+   testEquals(a->last(), &entities[1], "IntrusiveList fails (25)");
+   testEquals(b->last(), &entities[3], "IntrusiveList fails (26)");
+
+   // After the removal, the element can be added to the other list.
+   testTrue(b->remove(&entities[3], nullptr) == Status::eOK, "IntrusiveList fails (27)");
+   a->add(&entities[3], nullptr);
+   testTrue(b->remove(&entities[3], nullptr) == Status::eNotFound, "IntrusiveList fails (28)");
+   testEquals(order(*a), "013", "IntrusiveList fails (29)");
+   testEquals(order(*b), "2", "IntrusiveList fails (30)");
+
+   a->release();
+   b->release();
+}
@@ -20,6 +20,9 @@ class LinkedListTest : public jm::Test
       void DoTest1();
       void DoTest2(bool active);
       void DoTest3(bool active);
+      void DoTest4(bool indexed);
+      void DoTest5();
+      void DoTest6();
 };
 
 #endif /* defined(__tornado__LinkedListTest__) */
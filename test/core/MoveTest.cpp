@@ -0,0 +1,276 @@
+//
+//  MoveTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <cstdlib>
+#include <new>
+
+#include "core/Core.h"
+#include "MoveTest.h"
+
+using namespace jm;
+
+//
+// Counting of heap allocations. The global operator new of the test application only counts while
+// an AllocationCounter is alive on the calling thread. Otherwise it behaves like the default
+// implementation, so other tests and threads are not affected.
+//
+class AllocationCounter
+{
+   public:
+
+      AllocationCounter(): mCount(0), mPrevious(sCurrent)
+      {
+         sCurrent = this;
+      }
+
+      ~AllocationCounter()
+      {
+         sCurrent = mPrevious;
+      }
+
+      AllocationCounter(const AllocationCounter&) = delete;
+      AllocationCounter& operator=(const AllocationCounter&) = delete;
+
+      //! Returns the number of allocations since construction or the last reset.
+      size_t count() const
+      {
+         return mCount;
+      }
+
+      void reset()
+      {
+         mCount = 0;
+      }
+
+      static void record() noexcept
+      {
+         if(sCurrent != nullptr)sCurrent->mCount++;
+      }
+
+   private:
+
+      size_t mCount;
+      AllocationCounter* mPrevious;
+      static thread_local AllocationCounter* sCurrent;
+};
+
+thread_local AllocationCounter* AllocationCounter::sCurrent = nullptr;
+
+void* operator new(size_t size)
+{
+   AllocationCounter::record();
+   if(size == 0)size = 1;
+   for(;;)
+   {
+      void* ptr = std::malloc(size);
+      if(ptr != nullptr)return ptr;
+      std::new_handler handler = std::get_new_handler();
+      if(handler == nullptr)throw std::bad_alloc();
+      handler();
+   }
+}
+
+void operator delete(void* ptr) noexcept
+{
+   std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+   std::free(ptr);
+}
+
+MoveTest::MoveTest(): Test()
+{
+   setName("Test Move Semantics");
+}
+
+void MoveTest::doTest()
+{
+   testString();
+   testStringChain();
+   testContainers();
+   testMath();
+   testDecode();
+}
+
+void MoveTest::testString()
+{
+   AllocationCounter allocations;
+   size_t count;
+   String longStr = "This string is longer than the inline storage.";
+   String shortStr = "short";
+
+   // Move of heap content does not allocate
+   allocations.reset();
+   String moved = std::move(longStr);
+   count = allocations.count();
+   testEquals(count, 0, "String move constructor allocates");
+   testEquals(moved, "This string is longer than the inline storage.", "String move fails");
+   testTrue(longStr.isEmpty(), "Moved-from String not empty");
+
+   // Move of inline content
+   String movedShort = std::move(shortStr);
+   testEquals(movedShort, "short", "String move of short string fails");
+   testTrue(shortStr.isEmpty(), "Moved-from short String not empty");
+
+   // Move assignment
+   allocations.reset();
+   longStr = std::move(moved);
+   count = allocations.count();
+   testEquals(count, 0, "String move assignment allocates");
+   testEquals(longStr, "This string is longer than the inline storage.", "String move assignment fails");
+
+   // Moved-from strings are usable
+   moved.append("abc");
+   testEquals(moved, "abc", "Moved-from String not usable");
+   shortStr = movedShort;
+   testEquals(shortStr, "short", "Assignment to moved-from String fails");
+}
+
+void MoveTest::testStringChain()
+{
+   AllocationCounter allocations;
+   const String text = "   Some Text With Surrounding Whitespace And Upper Case   ";
+   const String expected = "some text with surrounding whitespace and upper case";
+
+   // Temporaries are modified in place.
+   allocations.reset();
+   String result = text.substring(1).trim().toLowerCase();
+   size_t chained = allocations.count();
+   testEquals(result, expected, "String call chain fails");
+
+   // The same operations on lvalues, which must create new strings.
+   allocations.reset();
+   String sub = text.substring(1);
+   String trimmed = sub.trim();
+   String lower = trimmed.toLowerCase();
+   size_t separate = allocations.count();
+   testEquals(lower, expected, "String operations on lvalues fail");
+
+   testEquals(chained, 1, "String call chain allocates more than once");
+   testTrue(chained < separate, "String call chain does not save allocations");
+
+   // Concatenation reuses the left temporary
+   String left = "This is a longer text, ";
+   allocations.reset();
+   String concat = left + text + expected + "!";
+   size_t concatAllocs = allocations.count();
+   testEquals(concat.size(), left.size() + text.size() + expected.size() + 1,
+              "String concatenation fails");
+   testTrue(concatAllocs <= 4, "String concatenation allocates for each temporary");
+
+   // Replace in temporaries
+   testEquals(String("a-b-c").replace('-', '+'), "a+b+c", "String.replace on temporary fails");
+   testEquals(text.replace('-', '+'), text, "String.replace on lvalue fails");
+}
+
+void MoveTest::testContainers()
+{
+   AllocationCounter allocations;
+   size_t count;
+   ByteArray bytes = ByteArray(1000, 'x');
+   allocations.reset();
+   ByteArray movedBytes = std::move(bytes);
+   count = allocations.count();
+   testEquals(count, 0, "ByteArray move allocates");
+   testEquals(movedBytes.size(), 1000, "ByteArray move fails");
+   testTrue(bytes.isNull(), "Moved-from ByteArray not null");
+   bytes = std::move(movedBytes);
+   testEquals(bytes.size(), 1000, "ByteArray move assignment fails");
+
+   StringList list;
+   list << "a" << "b" << "c";
+   allocations.reset();
+   StringList movedList = std::move(list);
+   count = allocations.count();
+   testEquals(count, 0, "StringList move allocates");
+   testEquals(movedList.size(), 3, "StringList move fails");
+   testEquals(list.size(), 0, "Moved-from StringList not empty");
+   list = std::move(movedList);
+   testEquals(list.join(','), "a,b,c", "StringList move assignment fails");
+
+   CharArray chars = CharArray(100);
+   allocations.reset();
+   CharArray movedChars = std::move(chars);
+   count = allocations.count();
+   testEquals(count, 0, "CharArray move allocates");
+   testEquals(movedChars.length, 100, "CharArray move fails");
+   testTrue(chars.buffer == nullptr, "Moved-from CharArray not empty");
+
+   Array<String> array = Array<String>(10);
+   array[3] = "three";
+   allocations.reset();
+   Array<String> movedArray = std::move(array);
+   count = allocations.count();
+   testEquals(count, 0, "Array move allocates");
+   testEquals(movedArray.size(), 10, "Array move fails");
+   testEquals(movedArray[3], "three", "Array move fails");
+   testEquals(array.size(), 0, "Moved-from Array not empty");
+}
+
+void MoveTest::testMath()
+{
+   AllocationCounter allocations;
+   size_t count;
+   Matrix a = Matrix(10, 10);
+   for(size_t i = 0; i < 10; i++)
+   {
+      for(size_t j = 0; j < 10; j++)a.set(i, j, 1.0);
+   }
+   allocations.reset();
+   Matrix moved = std::move(a);
+   count = allocations.count();
+   testEquals(count, 0, "Matrix move allocates");
+   testEquals(moved.rows(), 10, "Matrix move fails");
+   testEquals(a.rows(), 0, "Moved-from Matrix not empty");
+
+   // Result of the multiplication is moved, not copied.
+   allocations.reset();
+   a = moved * moved;
+   count = allocations.count();
+   testEquals(count, 1, "Matrix product allocates more than once");
+   testEquals(a.get(0, 0), 10.0, "Matrix product fails");
+
+   Vector v = Vector(3);
+   v.ones();
+   allocations.reset();
+   Vector w = v + v;
+   w = 2.0 * w;
+   count = allocations.count();
+   testEquals(count, 2, "Vector operators copy the results");
+   testEquals(w.data[2], 4.0, "Vector operators fail");
+}
+
+void MoveTest::testDecode()
+{
+   AllocationCounter allocations;
+   size_t count;
+   const char* text = "entries/drawings/Grundri\xC3\x9F" "_Erdgeschoss.dxf";
+   const size_t length = strlen(text);
+
+   // Decoding writes directly into the storage of the string.
+   allocations.reset();
+   String str1(text, length);
+   count = allocations.count();
+   testEquals(count, 1, "String decoding from UTF-8 needs more than one allocation");
+   testEquals(str1.size(), length - 1, "String decoding from UTF-8 fails");
+
+   allocations.reset();
+   String str2(text, length, Charset::forName("Windows-1252"));
+   count = allocations.count();
+   testEquals(count, 1, "String decoding from Windows-1252 needs more than one allocation");
+   testEquals(str2.size(), length, "String decoding from Windows-1252 fails");
+
+   // Short strings need no allocation at all.
+   allocations.reset();
+   String str3(text, 8);
+   count = allocations.count();
+   testEquals(count, 0, "String decoding of short text allocates");
+   testEquals(str3, "entries/", "String decoding of short text fails");
+}
@@ -0,0 +1,30 @@
+//
+//  MoveTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef __jameo__MoveTest__
+#define __jameo__MoveTest__
+
+#include "core/Test.h"
+
+class MoveTest : public jm::Test
+{
+   public:
+      MoveTest();
+      void doTest();
+
+   private:
+
+      void testString();
+      void testStringChain();
+      void testContainers();
+      void testMath();
+      void testDecode();
+
+};
+
+#endif
@@ -0,0 +1,61 @@
+//
+//  ObjectBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <thread>
+#include <vector>
+
+#include "core/Core.h"
+#include "ObjectBenchmark.h"
+
+using namespace jm;
+
+ObjectBenchmark::ObjectBenchmark(): Benchmark()
+{
+   setName("Benchmark Object");
+}
+
+void ObjectBenchmark::doTest()
+{
+   benchmarkRetainRelease();
+}
+
+void ObjectBenchmark::benchmarkRetainRelease()
+{
+   const size_t iterations = 200000;
+
+   Object* o = new Object();
+   o->setHighBit(true);
+
+   for(size_t threadCount = 1; threadCount <= 32; threadCount *= 2)
+   {
+      std::vector<std::thread> threads;
+      threads.reserve(threadCount);
+
+      const Clock::time_point start = Clock::now();
+      for(size_t t = 0; t < threadCount; t++)
+      {
+         threads.emplace_back([o, iterations]()
+         {
+            for(size_t i = 0; i < iterations; i++)
+            {
+               o->retain();
+               o->release();
+            }
+         });
+      }
+      for(std::thread& thread : threads)thread.join();
+      const double ms = elapsed(start);
+
+      testEquals(o->referenceCount(), 1, "Reference count after concurrent access wrong");
+
+      report(String("Retain/release with %1 threads").arg(static_cast<uint64>(threadCount)),
+             threadCount * iterations, ms);
+   }
+
+   o->release();
+}
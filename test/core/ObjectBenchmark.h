@@ -0,0 +1,33 @@
+//
+//  ObjectBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_ObjectBenchmark_h
+#define jm_ObjectBenchmark_h
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for the reference counting of jm::Object. The results are written to the
+ log. The few tests only make sure, that the benchmarks did real work.
+ */
+class ObjectBenchmark : public Benchmark
+{
+   public:
+      ObjectBenchmark();
+      void doTest();
+
+   private:
+
+      /*!
+       \brief All threads retain and release the same object, so the reference counter is
+       contended by 1 to 32 threads.
+       */
+      void benchmarkRetainRelease();
+};
+
+#endif
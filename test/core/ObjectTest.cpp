@@ -0,0 +1,170 @@
+//
+//  ObjectTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <thread>
+#include <vector>
+
+#include "core/Core.h"
+#include "ObjectTest.h"
+
+using namespace jm;
+
+ObjectTest::ObjectTest(): Test()
+{
+   setName("Test Object");
+}
+
+void ObjectTest::doTest()
+{
+   testReferenceCount();
+   testHighBit();
+   testConcurrentRetainRelease();
+   testAutoreleasePool();
+}
+
+void ObjectTest::testReferenceCount()
+{
+   Object* o = new Object();
+   testEquals(o->referenceCount(), 1, "Reference count of new object wrong");
+
+   o->retain();
+   o->retain();
+   testEquals(o->referenceCount(), 3, "Reference count after retain wrong");
+
+   o->release();
+   testEquals(o->referenceCount(), 2, "Reference count after release wrong");
+
+   // Copies start with their own reference counter
+   Object copy(*o);
+   testEquals(copy.referenceCount(), 1, "Reference count of copy wrong");
+
+   o->release();
+   o->release();
+}
+
+void ObjectTest::testHighBit()
+{
+   Object* o = new Object();
+   testFalse(o->highBit(), "High bit of new object is set");
+
+   o->setHighBit(true);
+   testTrue(o->highBit(), "High bit not set");
+   testEquals(o->referenceCount(), 1, "High bit changes reference count");
+
+   o->retain();
+   testTrue(o->highBit(), "High bit lost after retain");
+   testEquals(o->referenceCount(), 2, "Reference count with high bit wrong");
+
+   o->release();
+   testTrue(o->highBit(), "High bit lost after release");
+   testEquals(o->referenceCount(), 1, "Reference count with high bit wrong");
+
+   o->setHighBit(false);
+   testFalse(o->highBit(), "High bit not cleared");
+   testEquals(o->referenceCount(), 1, "Clearing high bit changes reference count");
+
+   // Object must be deleted even if the high bit is set.
+   o->setHighBit(true);
+   o->release();
+}
+
+void ObjectTest::testConcurrentRetainRelease()
+{
+   // All threads retain and release the same object. The reference counter must be consistent
+   // afterwards. The timed sweep over the thread counts is in ObjectBenchmark.
+   const size_t threadCount = 4;
+   const size_t iterations = 10000;
+
+   Object* o = new Object();
+   o->setHighBit(true);
+
+   std::vector<std::thread> threads;
+   threads.reserve(threadCount);
+   for(size_t t = 0; t < threadCount; t++)
+   {
+      threads.emplace_back([o, iterations]()
+      {
+         for(size_t i = 0; i < iterations; i++)
+         {
+            o->retain();
+            o->release();
+         }
+      });
+   }
+   for(std::thread& thread : threads)thread.join();
+
+   testEquals(o->referenceCount(), 1, "Reference count after concurrent access wrong");
+   testTrue(o->highBit(), "High bit lost during concurrent access");
+
+   o->release();
+}
+
+void ObjectTest::testAutoreleasePool()
+{
+   AutoreleasePool* shared = System::autoreleasePool();
+
+   Object* o = new Object();
+   o->retain();
+   {
+      AutoreleasePool outer;
+      testTrue(AutoreleasePool::current() == &outer, "Pool is not current pool");
+      testTrue(System::autoreleasePool() == &outer, "Pool is not system pool");
+
+      o->autorelease();
+      {
+         AutoreleasePool inner;
+         testTrue(AutoreleasePool::current() == &inner, "Nested pool is not current pool");
+
+         // More objects than fit into one chunk
+         for(size_t index = 0; index < 1000; index++)
+         {
+            o->retain();
+            o->autorelease();
+         }
+         testEquals(o->referenceCount(), 1002, "Reference count before drain wrong");
+
+         inner.drain();
+         testEquals(o->referenceCount(), 2, "Reference count after drain wrong");
+
+         o->retain();
+         o->autorelease();
+      }
+      testTrue(AutoreleasePool::current() == &outer, "Pool stack not restored");
+      testEquals(o->referenceCount(), 2, "Nested pool not drained");
+   }
+   testTrue(System::autoreleasePool() == shared, "Shared pool not restored");
+   testEquals(o->referenceCount(), 1, "Pool not drained");
+
+   // Pools destroyed out of order are removed from the middle of the stack.
+   {
+      AutoreleasePool* lower = new AutoreleasePool();
+      AutoreleasePool upper;
+      delete lower;
+      testTrue(AutoreleasePool::current() == &upper, "Upper pool is not current pool");
+      o->retain();
+      o->autorelease();
+   }
+   testTrue(AutoreleasePool::current() == nullptr, "Pool stack not unlinked");
+   testEquals(o->referenceCount(), 1, "Upper pool not drained");
+
+   // Each worker thread has its own pool stack.
+   std::thread worker([this, o]()
+   {
+      testTrue(AutoreleasePool::current() == nullptr, "Worker has a pool");
+      AutoreleasePool pool;
+      for(size_t index = 0; index < 300; index++)
+      {
+         o->retain();
+         o->autorelease();
+      }
+   });
+   worker.join();
+   testEquals(o->referenceCount(), 1, "Worker pool not drained");
+
+   o->release();
+}
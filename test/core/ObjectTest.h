@@ -0,0 +1,29 @@
+//
+//  ObjectTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef __jameo__ObjectTest__
+#define __jameo__ObjectTest__
+
+#include "core/Test.h"
+
+class ObjectTest : public jm::Test
+{
+   public:
+      ObjectTest();
+      void doTest();
+
+   private:
+
+      void testReferenceCount();
+      void testHighBit();
+      void testConcurrentRetainRelease();
+      void testAutoreleasePool();
+
+};
+
+#endif
@@ -0,0 +1,206 @@
+//
+//  SortBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <random>
+#include <vector>
+
+#include "core/Core.h"
+#include "SortBenchmark.h"
+
+using namespace jm;
+
+//! The bubble sort, which the containers used before, as reference.
+template <class T>
+static void bubbleSort(T* data, size_t length)
+{
+   if(length < 1)return;
+
+   size_t n = length;
+   do
+   {
+      size_t newn = 1;
+      for(size_t i = 0; i < n - 1; ++i)
+      {
+         if(data[i + 1] < data[i])
+         {
+            std::swap(data[i], data[i + 1]);
+            newn = i + 1;
+         }
+      }
+      n = newn;
+   }
+   while(n > 1);
+}
+
+SortBenchmark::SortBenchmark(): Benchmark()
+{
+   setName("Benchmark Sort");
+}
+
+void SortBenchmark::doTest()
+{
+   for(size_t count = 10; count <= 10000000; count *= 10)benchmarkNumbers(count);
+   for(size_t count = 10; count <= 100000; count *= 10)benchmarkStrings(count);
+   benchmarkBytes(1000);
+   benchmarkBytes(1000000);
+}
+
+void SortBenchmark::reportElements(const String& name, size_t count, size_t rounds, double ms)
+{
+   const double perElement = ms * 1000000.0 / static_cast<double>(count * rounds);
+   System::log(String("%1 %2 elements: %3 ms (%4 ns/element)")
+               .arg(name)
+               .arg(static_cast<uint64>(count))
+               .arg(ms / static_cast<double>(rounds), 0, 3)
+               .arg(perElement, 0, 2), LogLevel::kInformation);
+}
+
+void SortBenchmark::benchmarkNumbers(size_t count)
+{
+   std::mt19937 random(1);
+   std::vector<int32> input(count);
+   for(int32& value : input)value = static_cast<int32>(random());
+
+   std::vector<int32> expected = input;
+   std::stable_sort(expected.begin(), expected.end());
+
+   // Small arrays are sorted several times, so that the time can be measured.
+   const size_t rounds = std::max(static_cast<size_t>(1), 1000000 / count);
+   const Sort::Ascending<int32> less;
+   std::vector<int32> values;
+   bool ok = true;
+
+   const auto run = [&](const char* name, auto sorter)
+   {
+      double ms = 0;
+      for(size_t round = 0; round < rounds; round++)
+      {
+         values = input;
+         const Clock::time_point start = Clock::now();
+         sorter(values);
+         ms += elapsed(start);
+      }
+      if(values != expected)ok = false;
+      reportElements(name, count, rounds, ms);
+   };
+
+   run("std::stable_sort", [](std::vector<int32>& v)
+   {
+      std::stable_sort(v.begin(), v.end());
+   });
+   run("Sort::sort", [&less](std::vector<int32>& v)
+   {
+      Sort::sort(v.begin(), v.end(), less);
+   });
+   run("Sort::stableSort", [&less](std::vector<int32>& v)
+   {
+      Sort::stableSort(v.begin(), v.end(), less);
+   });
+   run("Sort::parallelSort", [&less](std::vector<int32>& v)
+   {
+      Sort::parallelSort(v.begin(), v.end(), less);
+   });
+
+   // Already sorted input
+   input = expected;
+   run("Sort::sort (sorted)", [&less](std::vector<int32>& v)
+   {
+      Sort::sort(v.begin(), v.end(), less);
+   });
+
+   if(count <= 10000)
+   {
+      std::shuffle(input.begin(), input.end(), random);
+      run("Bubble sort", [](std::vector<int32>& v)
+      {
+         bubbleSort(v.data(), v.size());
+      });
+   }
+
+   testTrue(ok, "Sort benchmark fails");
+}
+
+void SortBenchmark::benchmarkStrings(size_t count)
+{
+   std::mt19937 random(2);
+   StringList input;
+   input.reserve(count);
+   for(size_t index = 0; index < count; index++)
+   {
+      input.append(String("layer/Wall-%1").arg(static_cast<uint64>(random() % 1000000)));
+   }
+
+   const size_t rounds = std::max(static_cast<size_t>(1), 100000 / count);
+   bool ok = true;
+
+   const auto run = [&](const char* name, auto sorter)
+   {
+      double ms = 0;
+      StringList list;
+      for(size_t round = 0; round < rounds; round++)
+      {
+         list = input;
+         const Clock::time_point start = Clock::now();
+         sorter(list);
+         ms += elapsed(start);
+      }
+      for(size_t index = 1; index < count; index++)
+      {
+         if(list[index].compareTo(list[index - 1]) < 0)ok = false;
+      }
+      reportElements(name, count, rounds, ms);
+   };
+
+   run("StringList::sort", [](StringList& list)
+   {
+      list.sort();
+   });
+   run("StringList::stableSort", [](StringList& list)
+   {
+      list.stableSort();
+   });
+   run("StringList::parallelSort", [](StringList& list)
+   {
+      list.parallelSort();
+   });
+
+   if(count <= 1000)
+   {
+      run("StringList bubble sort", [](StringList& list)
+      {
+         bubbleSort(list.begin(), list.size());
+      });
+   }
+
+   testTrue(ok, "String sort benchmark fails");
+}
+
+void SortBenchmark::benchmarkBytes(size_t count)
+{
+   std::mt19937 random(3);
+   ByteArray input(count, 0);
+   for(size_t index = 0; index < count; index++)
+   {
+      input.data()[index] = static_cast<int8>(random());
+   }
+
+   const size_t rounds = std::max(static_cast<size_t>(1), 1000000 / count);
+   double ms = 0;
+   ByteArray bytes;
+   for(size_t round = 0; round < rounds; round++)
+   {
+      bytes = input;
+      const Clock::time_point start = Clock::now();
+      bytes.sort();
+      ms += elapsed(start);
+   }
+   reportElements("ByteArray::sort", count, rounds, ms);
+
+   const uint8* data = reinterpret_cast<const uint8*>(bytes.constData());
+   testTrue(std::is_sorted(data, data + count), "ByteArray sort benchmark fails");
+}
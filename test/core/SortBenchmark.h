@@ -0,0 +1,34 @@
+//
+//  SortBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_SortBenchmark_h
+#define jm_SortBenchmark_h
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::Sort and the sort methods of the containers. The results are
+ written to the log. The few tests only make sure, that the benchmarks did real work.
+ */
+class SortBenchmark : public Benchmark
+{
+   public:
+      SortBenchmark();
+      void doTest();
+
+   private:
+
+      void benchmarkNumbers(size_t count);
+      void benchmarkStrings(size_t count);
+      void benchmarkBytes(size_t count);
+
+      //! Logs the mean duration of one of \p rounds rounds and the time per element.
+      void reportElements(const jm::String& name, size_t count, size_t rounds, double ms);
+};
+
+#endif
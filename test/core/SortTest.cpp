@@ -0,0 +1,239 @@
+//
+//  SortTest.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/Core.h"
+#include "SortTest.h"
+
+using namespace jm;
+
+//! Creates \p size numbers in one of the patterns, which are known to be hard for quicksorts.
+static std::vector<int32> createPattern(size_t pattern, size_t size, std::mt19937& random)
+{
+   std::vector<int32> values(size);
+   for(size_t index = 0; index < size; index++)
+   {
+      const int32 i = static_cast<int32>(index);
+      const int32 n = static_cast<int32>(size);
+      switch(pattern)
+      {
+         case 0: // Random
+            values[index] = static_cast<int32>(random() % 1000000);
+            break;
+
+         case 1: // Sorted
+            values[index] = i;
+            break;
+
+         case 2: // Reversed
+            values[index] = n - i;
+            break;
+
+         case 3: // All equal
+            values[index] = 7;
+            break;
+
+         case 4: // Few distinct values
+            values[index] = static_cast<int32>(random() % 4);
+            break;
+
+         case 5: // Organ pipe
+            values[index] = i < n / 2 ? i : n - i;
+            break;
+
+         case 6: // Sawtooth
+            values[index] = i % 32;
+            break;
+
+         default: // Sorted with some random elements at the end
+            values[index] = index + 8 < size ? i : static_cast<int32>(random() % 1000);
+            break;
+      }
+   }
+   return values;
+}
+
+SortTest::SortTest(): Test()
+{
+   setName("Test Sort");
+}
+
+void SortTest::doTest()
+{
+   testPatterns();
+   testStable();
+   testParallel();
+   testMoveOnly();
+   testContainers();
+}
+
+void SortTest::testPatterns()
+{
+   std::mt19937 random(42);
+   bool ok = true;
+
+   const size_t sizes[] = {0, 1, 2, 3, 10, 23, 24, 25, 100, 129, 1000, 100000};
+   for(size_t size : sizes)
+   {
+      for(size_t pattern = 0; pattern < 8; pattern++)
+      {
+         std::vector<int32> values = createPattern(pattern, size, random);
+         std::vector<int32> expected = values;
+         std::stable_sort(expected.begin(), expected.end());
+
+         Sort::sort(values.begin(), values.end(), Sort::Ascending<int32>());
+         if(values != expected)ok = false;
+      }
+   }
+   testTrue(ok, "Sort::sort() fails");
+
+   // Descending order by another comparison
+   std::vector<int32> values = createPattern(0, 1000, random);
+   Sort::sort(values.begin(), values.end(), [](int32 a, int32 b)
+   {
+      return a > b;
+   });
+   testTrue(std::is_sorted(values.rbegin(), values.rend()), "Sort::sort() with comparison fails");
+
+   // Counting sort
+   std::vector<uint8> bytes(10000);
+   for(uint8& byte : bytes)byte = static_cast<uint8>(random());
+   std::vector<uint8> expectedBytes = bytes;
+   std::stable_sort(expectedBytes.begin(), expectedBytes.end());
+   Sort::countingSort(bytes.data(), bytes.size());
+   testTrue(bytes == expectedBytes, "Sort::countingSort() fails");
+}
+
+void SortTest::testStable()
+{
+   std::mt19937 random(7);
+   bool ok = true;
+
+   const size_t sizes[] = {0, 1, 5, 24, 25, 1000, 50000};
+   for(size_t size : sizes)
+   {
+      // The first value is the key, the second the original position.
+      std::vector<std::pair<int32, size_t>> values(size);
+      for(size_t index = 0; index < size; index++)
+      {
+         values[index] = std::pair<int32, size_t>(static_cast<int32>(random() % 16), index);
+      }
+
+      Sort::stableSort(values.begin(), values.end(), [](const auto & a, const auto & b)
+      {
+         return a.first < b.first;
+      });
+
+      for(size_t index = 1; index < size; index++)
+      {
+         if(values[index - 1].first > values[index].first)ok = false;
+         if(values[index - 1].first == values[index].first &&
+               values[index - 1].second > values[index].second)ok = false;
+      }
+   }
+   testTrue(ok, "Sort::stableSort() fails");
+}
+
+void SortTest::testParallel()
+{
+   std::mt19937 random(3);
+   bool ok = true;
+
+   for(size_t pattern = 0; pattern < 8; pattern++)
+   {
+      std::vector<int32> values = createPattern(pattern, 300000, random);
+      std::vector<int32> expected = values;
+      std::stable_sort(expected.begin(), expected.end());
+
+      Sort::parallelSort(values.begin(), values.end(), Sort::Ascending<int32>(), 4);
+      if(values != expected)ok = false;
+   }
+   testTrue(ok, "Sort::parallelSort() fails");
+
+   // Small ranges are sorted in the calling thread.
+   std::vector<int32> values = {3, 1, 2};
+   Sort::parallelSort(values.begin(), values.end(), Sort::Ascending<int32>(), 8);
+   testTrue(std::is_sorted(values.begin(), values.end()), "Sort::parallelSort() fails");
+}
+
+void SortTest::testMoveOnly()
+{
+   // The algorithms only move elements. Otherwise this would not compile.
+   std::mt19937 random(11);
+   std::vector<std::unique_ptr<int32>> values;
+   for(size_t index = 0; index < 5000; index++)
+   {
+      values.push_back(std::make_unique<int32>(static_cast<int32>(random() % 100)));
+   }
+   const auto less = [](const std::unique_ptr<int32>& a, const std::unique_ptr<int32>& b)
+   {
+      return *a < *b;
+   };
+
+   Sort::sort(values.begin(), values.end(), less);
+   testTrue(std::is_sorted(values.begin(), values.end(), less), "Sort::sort() fails");
+
+   std::shuffle(values.begin(), values.end(), random);
+   Sort::stableSort(values.begin(), values.end(), less);
+   testTrue(std::is_sorted(values.begin(), values.end(), less), "Sort::stableSort() fails");
+}
+
+void SortTest::testContainers()
+{
+   Array<String> strings(4);
+   strings[0] = "delta";
+   strings[1] = "alpha";
+   strings[2] = "charlie";
+   strings[3] = "bravo";
+   strings.sort();
+   testEquals(strings[0], "alpha", "Array<String>::sort() fails");
+   testEquals(strings[3], "delta", "Array<String>::sort() fails");
+
+   // Pointers are sorted by their objects, nullptr at the end.
+   String s1 = "b";
+   String s2 = "a";
+   Array<String*> pointers(3);
+   pointers[0] = &s1;
+   pointers[1] = nullptr;
+   pointers[2] = &s2;
+   pointers.sort();
+   testTrue(pointers[0] == &s2 && pointers[1] == &s1, "Array<String*>::sort() fails");
+   testNull(pointers[2], "Array<String*>::sort() fails");
+
+   // Types without Comparable use operator <.
+   Array<int32> numbers(5);
+   for(size_t index = 0; index < 5; index++)numbers[index] = static_cast<int32>(10 - index * 2);
+   numbers.sort();
+   testEquals(numbers[0], 2, "Array<int32>::sort() fails");
+   testEquals(numbers[4], 10, "Array<int32>::sort() fails");
+   numbers.stableSort();
+   numbers.parallelSort();
+   testEquals(numbers[2], 6, "Array<int32>::sort() fails");
+
+   // NaN does not break the order.
+   FloatArray floats = {3.0f, NAN, 1.0f, 2.0f};
+   floats.Sort();
+   testEquals(floats[0], 1.0f, "FloatArray::Sort() fails");
+   testEquals(floats[2], 3.0f, "FloatArray::Sort() fails");
+   testTrue(std::isnan(floats[3]), "FloatArray::Sort() fails");
+
+   ByteArray bytes = ByteArray(reinterpret_cast<const int8*>("sorting"));
+   bytes.sort();
+   testTrue(memcmp(bytes.constData(), "ginorst", 7) == 0, "ByteArray::sort() fails");
+
+   StringList list;
+   list << "item3" << "Item2" << "item1" << "item2";
+   list.stableSort();
+   testEquals(list.join(Char(',')), "Item2,item1,item2,item3", "StringList::stableSort() fails");
+   list.parallelSort();
+   testEquals(list.join(Char(',')), "Item2,item1,item2,item3", "StringList::parallelSort() fails");
+}
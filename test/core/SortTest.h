@@ -0,0 +1,28 @@
+//
+//  SortTest.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef jm_SortTest_h
+#define jm_SortTest_h
+
+#include "core/Test.h"
+
+class SortTest : public jm::Test
+{
+   public:
+      SortTest();
+      void doTest();
+
+   private:
+      void testPatterns();
+      void testStable();
+      void testParallel();
+      void testMoveOnly();
+      void testContainers();
+};
+
+#endif
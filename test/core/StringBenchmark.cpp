@@ -0,0 +1,348 @@
+//
+//  StringBenchmark.cpp
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#include <algorithm>
+#include <set>
+
+#include "core/Core.h"
+#include "StringBenchmark.h"
+
+using namespace jm;
+
+StringBenchmark::StringBenchmark(): Benchmark()
+{
+   setName("Benchmark String");
+}
+
+void StringBenchmark::doTest()
+{
+   benchmarkLifecycle();
+   benchmarkLargeCopy();
+   benchmarkUtf8();
+   benchmarkSearch();
+   benchmarkCase();
+   benchmarkHash();
+}
+
+void StringBenchmark::benchmarkLifecycle()
+{
+   // Typical DXF/XML keys and values and a longer text.
+   const char* samples[] = {"8", "AcDbEntity", "LAYER", "Wall-Exterior-01", "0.25",
+                            "The quick brown fox jumps over the lazy dog. 0123456789"
+                           };
+   const size_t iterations = 200000;
+
+   for(const char* sample : samples)
+   {
+      String source = String(sample);
+      size_t total = 0;
+
+      // Construction and destruction
+      Clock::time_point start = Clock::now();
+      for(size_t index = 0; index < iterations; index++)
+      {
+         String str = String(sample);
+         total += str.size();
+      }
+      report(String("Construct \"%1\"").arg(source), iterations, elapsed(start));
+
+      // Copy and destruction
+      start = Clock::now();
+      for(size_t index = 0; index < iterations; index++)
+      {
+         String copy = source;
+         total += copy.size();
+      }
+      report(String("Copy \"%1\"").arg(source), iterations, elapsed(start));
+
+      testEquals(total, 2 * iterations * source.size(), "String benchmark did not run");
+   }
+}
+
+void StringBenchmark::benchmarkLargeCopy()
+{
+   // 100 KB of content
+   String source;
+   for(size_t index = 0; index < 51200; index++)
+   {
+      source.append(Char(static_cast<uint16>('a' + index % 26)));
+   }
+
+   const size_t iterations = 200000;
+   size_t total = 0;
+
+   Clock::time_point start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      String copy = source;
+      total += copy.size();
+   }
+   report("Copy 100 KB string", iterations, elapsed(start));
+
+   testEquals(total, iterations * source.size(), "String benchmark did not run");
+}
+
+void StringBenchmark::benchmarkUtf8()
+{
+   // About 4 MB of XML like content with some non ASCII characters.
+   const char* line = "  <layer name=\"Wand-Au\xC3\x9F" "en\" color=\"7\" linetype=\"Continuous\" "
+                      "description=\"Gr\xC3\xBC\xC3\x9F" "e aus M\xC3\xBCnchen\"/>\n";
+   std::string xml;
+   while(xml.size() < 4 * 1024 * 1024)xml += line;
+
+   const size_t iterations = 10;
+   size_t total = 0;
+
+   Clock::time_point start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      String str = String(xml.c_str(), xml.size());
+      total += str.size();
+   }
+   reportThroughput("Decode 4 MB UTF-8", iterations * xml.size(), elapsed(start));
+
+   String str = String(xml.c_str(), xml.size());
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      ByteArray bytes = str.toCString();
+      testEquals(bytes.size(), xml.size(), "UTF-8 encoding length wrong");
+   }
+   reportThroughput("Encode 4 MB UTF-8", iterations * xml.size(), elapsed(start));
+
+   testEquals(total, iterations * str.size(), "UTF-8 benchmark did not run");
+}
+
+void StringBenchmark::benchmarkSearch()
+{
+   benchmarkSearch(1024);
+   benchmarkSearch(64 * 1024);
+   benchmarkSearch(1024 * 1024);
+   benchmarkSearch(100 * 1024 * 1024);
+}
+
+void StringBenchmark::benchmarkSearch(size_t size)
+{
+   // Every operation processes about 64 MB in total, regardless of the size of the text.
+   const size_t iterations = std::max(static_cast<size_t>(1), 64 * 1024 * 1024 / size);
+   const String label = (size >= 1024 * 1024)
+                        ? String("%1 MB").arg(static_cast<uint64>(size / 1024 / 1024))
+                        : String("%1 KB").arg(static_cast<uint64>(size / 1024));
+   const size_t bytes = iterations * size * sizeof(Char);
+
+   const std::string sentence = "Lorem ipsum dolor sit amet, consectetur adipiscing elit; ";
+   std::string text;
+   text.reserve(size);
+   while(text.size() + sentence.size() <= size)text += sentence;
+   while(text.size() < size)text += ' ';
+   const String str = String(text.c_str(), text.size());
+   const size_t sentences = size / sentence.size();
+
+   size_t total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      if(str.indexOf(Char('#')) == npos)total++;
+   }
+   reportThroughput(String("indexOf(Char) %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations, "indexOf(Char) benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      if(str.indexOf("adipiscing elix") == npos)total++;
+   }
+   reportThroughput(String("indexOf(String) %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations, "indexOf(String) benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      if(str.lastIndexOf("ipsum dolor amet") == npos)total++;
+   }
+   reportThroughput(String("lastIndexOf(String) %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations, "lastIndexOf(String) benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += str.count(Char(';'));
+   }
+   reportThroughput(String("count(Char) %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations * sentences, "count(Char) benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += str.replace("dolor", "DOLORES").size();
+   }
+   reportThroughput(String("replace(String, String) %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations * (size + 2 * sentences), "replace() benchmark fails");
+
+   // Tokenizing creates a String per token, so the largest text is skipped.
+   if(size > 1024 * 1024)return;
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      StringTokenizer tokenizer(str, " ,;", false);
+      while(tokenizer.hasNext())
+      {
+         tokenizer.next();
+         total++;
+      }
+   }
+   reportThroughput(String("StringTokenizer %1").arg(label), bytes, elapsed(start));
+   testEquals(total, iterations * sentences * 8, "StringTokenizer benchmark fails");
+}
+
+void StringBenchmark::benchmarkCase()
+{
+   const String sentence = "Lorem Ipsum DOLOR sit amet, Größe aus München. Ελληνικά Кириллица. ";
+   String text;
+   while(text.size() < 1024 * 1024)text.append(sentence);
+   const String upper = text.toUpperCase();
+   const size_t iterations = 64;
+   const size_t bytes = iterations * text.size() * sizeof(Char);
+
+   size_t total = 0;
+   Clock::time_point start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      total += text.toLowerCase().size();
+   }
+   reportThroughput("toLowerCase 1 MB", bytes, elapsed(start));
+   testEquals(total, iterations * text.size(), "toLowerCase() benchmark fails");
+
+   total = 0;
+   start = Clock::now();
+   for(size_t index = 0; index < iterations; index++)
+   {
+      if(text.equalsIgnoreCase(upper))total++;
+   }
+   reportThroughput("equalsIgnoreCase 1 MB", bytes, elapsed(start));
+   testEquals(total, iterations, "equalsIgnoreCase() benchmark fails");
+}
+
+void StringBenchmark::benchmarkHash()
+{
+   // Layer names following the AIA CAD layer guidelines, e.g. "A-WALL-EXTR-N-12"
+   const char* disciplines[] = {"A", "C", "E", "F", "G", "I", "L", "M", "P", "Q", "S", "T"};
+   const char* majors[] = {"WALL", "DOOR", "GLAZ", "FLOR", "ROOF", "COLS", "BEAM", "GRID",
+                           "ANNO", "DIMS", "EQPM", "FURN", "CLNG", "STRS", "ELEV", "SITE"
+                          };
+   const char* minors[] = {"EXTR", "INTR", "FULL", "PATT", "IDEN", "OTLN", "HRAL", "SYMB"};
+   const char* states[] = {"N", "E", "D", "F", "M"};
+
+   std::vector<std::string> layers;
+   for(const char* discipline : disciplines)
+   {
+      for(const char* major : majors)
+      {
+         for(const char* minor : minors)
+         {
+            for(const char* state : states)
+            {
+               for(size_t index = 0; index < 4; index++)
+               {
+                  layers.push_back(std::string(discipline) + "-" + major + "-" + minor + "-" +
+                                   state + "-" + std::to_string(index));
+               }
+            }
+         }
+      }
+   }
+   benchmarkHash("layer names", layers);
+
+   // Translation keys are short sentences, which often differ in a single word only.
+   const char* verbs[] = {"open", "save", "read", "write", "delete", "rename", "copy", "move"};
+   const char* objects[] = {"file", "directory", "drawing", "layer", "block", "image",
+                            "archive", "preferences"
+                           };
+   const char* reasons[] = {"", ": %1", " (%1)", ". Access denied.", ". The disk is full.",
+                            ". Index out of bounds: %1", ". The file is locked by %1."
+                           };
+   std::vector<std::string> translations;
+   for(size_t prefix = 0; prefix < 8; prefix++)
+   {
+      for(const char* verb : verbs)
+      {
+         for(const char* object : objects)
+         {
+            for(const char* reason : reasons)
+            {
+               translations.push_back(std::string(prefix % 2 == 0 ? "Cannot " : "Unable to ") +
+                                      verb + " the " + object + reason +
+                                      std::string(prefix / 2, ' '));
+            }
+         }
+      }
+   }
+   benchmarkHash("translation keys", translations);
+}
+
+void StringBenchmark::benchmarkHash(const String& name, const std::vector<std::string>& keys)
+{
+   const size_t rounds = 100;
+
+   // Fresh strings, since the hash code is cached after the first call.
+   std::vector<String> strings;
+   strings.reserve(rounds * keys.size());
+   size_t bytes = 0;
+   for(size_t round = 0; round < rounds; round++)
+   {
+      for(const std::string& key : keys)
+      {
+         strings.push_back(String(key.c_str(), key.size()));
+         bytes += key.size() * sizeof(Char);
+      }
+   }
+
+   uint64 sum = 0;
+   Clock::time_point start = Clock::now();
+   for(const String& str : strings)sum += static_cast<uint64>(str.hashCode());
+   double ms = elapsed(start);
+   report(String("hashCode %1 (%2 keys)").arg(name).arg(static_cast<uint64>(keys.size())),
+          strings.size(), ms);
+   reportThroughput(String("hashCode %1").arg(name), bytes, ms);
+   testTrue(sum != 0, "hashCode() benchmark fails");
+
+   // Quality: Full collisions and the distribution over a table with a power of 2 size, like it
+   // is used by hash tables. The expected number of empty buckets of a random function is
+   // m * (1 - 1/m)^n.
+   std::set<uint64> hashes;
+   size_t buckets = 1;
+   while(buckets < keys.size())buckets *= 2;
+   std::vector<size_t> load(buckets, 0);
+   for(size_t index = 0; index < keys.size(); index++)
+   {
+      uint64 hash = static_cast<uint64>(strings[index].hashCode());
+      hashes.insert(hash);
+      load[hash & (buckets - 1)]++;
+   }
+   size_t empty = static_cast<size_t>(std::count(load.begin(), load.end(), 0));
+   size_t longest = *std::max_element(load.begin(), load.end());
+   double expected = static_cast<double>(buckets) *
+                     std::pow(1.0 - 1.0 / static_cast<double>(buckets),
+                              static_cast<double>(keys.size()));
+
+   System::log(String("hashCode %1: %2 collisions, %3 of %4 buckets empty (random: %5), "
+                      "longest chain %6")
+               .arg(name)
+               .arg(static_cast<uint64>(keys.size() - hashes.size()))
+               .arg(static_cast<uint64>(empty))
+               .arg(static_cast<uint64>(buckets))
+               .arg(expected, 0, 0)
+               .arg(static_cast<uint64>(longest)), LogLevel::kInformation);
+   testEquals(hashes.size(), keys.size(), "hashCode() has full collisions");
+}
@@ -0,0 +1,40 @@
+//
+//  StringBenchmark.h
+//  jameo
+//
+//  Created by Uwe Runtemund on 17.10.26.
+//  Copyright (c) 2026 Jameo Software. All rights reserved.
+//
+
+#ifndef __jameo__StringBenchmark__
+#define __jameo__StringBenchmark__
+
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+
+/*!
+ \brief Micro benchmarks for jm::String. The results are written to the log, so that changes of the
+ throughput become visible. The few tests only make sure, that the benchmarks did real work.
+ */
+class StringBenchmark : public Benchmark
+{
+   public:
+      StringBenchmark();
+      void doTest();
+
+   private:
+
+      void benchmarkLifecycle();
+      void benchmarkLargeCopy();
+      void benchmarkUtf8();
+      void benchmarkSearch();
+      void benchmarkSearch(size_t size);
+      void benchmarkCase();
+      void benchmarkHash();
+      void benchmarkHash(const jm::String& name, const std::vector<std::string>& keys);
+
+};
+
+#endif
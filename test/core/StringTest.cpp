@@ -9,8 +9,32 @@
 #include "core/Core.h"
 #include "StringTest.h"
 
+#include <thread>
+
 using namespace jm;
 
+//! A decoder, which implements only decode(const char*), so the default implementation of
+//! decode(const char*, size_t, Char*) is used.
+class LatinDecoder: public CharsetDecoder
+{
+   public:
+
+      using CharsetDecoder::decode;
+
+      CharArray decode(const char* cString) override
+      {
+         const size_t length = strlen(cString);
+         CharArray array = CharArray(length);
+         for(size_t a = 0; a < length; a++)array.buffer[a] = Char(cString[a]);
+         return array;
+      }
+
+      ByteArray encode(const CharArray& string) override
+      {
+         return ByteArray(string.length, 0);
+      }
+};
+
 StringTest::StringTest(): Test()
 {
    setName("Test String");
@@ -83,8 +107,18 @@ void StringTest::doTest()
    //Hash
    str1 = "This is a Java string";
    str2 = "What the heck?";
-   testEquals(str1.hashCode(), 586653468, "String.hashCode() fails");
-   testEquals(str2.hashCode(), 277800975, "String.hashCode() fails");
+   testEquals(str1.hashCode(), String("This is a Java string").hashCode(),
+              "String.hashCode() fails (1)");
+   testTrue(str1.hashCode() != str2.hashCode(), "String.hashCode() fails (2)");
+   testTrue(String("ab").hashCode() != String("ba").hashCode(), "String.hashCode() fails (3)");
+   testTrue(String("").hashCode() != 0, "String.hashCode() fails (4)");
+   str3 = str1;
+   str3.append('!');
+   testTrue(str1.hashCode() != str3.hashCode(), "String.hashCode() not reset");
+   testEquals(str3.hashCode(), String("This is a Java string!").hashCode(),
+              "String.hashCode() fails (5)");
+   const String str9 = "Hash of a const string, which is long enough for the blocks of 48 bytes.";
+   testEquals(str9.constHashCode(), str9.hashCode(), "String.constHashCode() fails");
 
    //lastIndexOf
    testTrue(str1.indexOf('i') == 2, "String.indexOf() fails");
@@ -259,6 +293,11 @@ void StringTest::doTest()
    isEmpty();
    compareFancy();
    constructors();
+   storage();
+   concurrentCopies();
+   utf8();
+   search();
+   characters();
 }
 
 void StringTest::constructors()
@@ -288,6 +327,56 @@ void StringTest::constructors()
    jm::ByteArray byteArray = str6.toCString();
    String str7(byteArray, jm::Charset::getDefault());
    testEquals(str7, String("abc"), "String() fails (7)");
+
+   // Only the given number of bytes is decoded, whatever follows.
+   String str8("abc\xE4xyz", 4, jm::Charset::forName("Windows-1252"));
+   testEquals(str8.size(), static_cast<size_t>(4), "String() fails (8)");
+   testEquals(str8.charAt(3).unicode(), 0x00E4, "String() fails (9)");
+
+   const char utf16[] = {'\xFF', '\xFE', 'a', 0, 'b', 0, 'c', 0, 'd', 0};
+   String str9(utf16, 8, jm::Charset::forName("UTF-16LE"));
+   testEquals(str9, String("abc"), "String() fails (10)");
+
+   String str10("ab\xE4", 3, jm::Charset::forName("RAW"));
+   testEquals(str10.size(), static_cast<size_t>(3), "String() fails (11)");
+
+   // Every decoder decodes exactly the given number of bytes, also embedded 0 characters.
+   const char* names[] = {"UTF-8", "Windows-1252", "MacRoman", "RAW"};
+   for(const char* name : names)
+   {
+      const String message = "String() fails for " + String(name);
+      String embedded("a\0b\0", 4, jm::Charset::forName(name));
+      testEquals(embedded.size(), static_cast<size_t>(4), message);
+      testEquals(embedded.charAt(1).unicode(), 0, message);
+      testEquals(embedded.charAt(2).unicode(), 'b', message);
+   }
+   const char utf16Null[] = {'a', 0, 0, 0, 'b', 0};
+   String embedded16(utf16Null, 6, jm::Charset::forName("UTF-16LE"));
+   testEquals(embedded16.size(), static_cast<size_t>(3), "String() fails for UTF-16LE");
+   testEquals(embedded16.charAt(2).unicode(), 'b', "String() fails for UTF-16LE");
+
+   LatinDecoder decoder;
+   Char target[8];
+   testEquals(static_cast<uint64>(decoder.decode("\0ab\0\0c", 6, target)), 6u,
+              "CharsetDecoder::decode() fails");
+   testTrue(target[0].unicode() == 0 && target[1].unicode() == 'a' && target[2].unicode() == 'b' &&
+            target[3].unicode() == 0 && target[4].unicode() == 0 && target[5].unicode() == 'c',
+            "CharsetDecoder::decode() fails");
+
+   // operator>> reads a line without the line break.
+   std::istringstream stream("hello\nworld");
+   String line;
+   stream >> line;
+   testTrue(line.equals("hello"), "operator>>() fails (1)");
+   stream >> line;
+   testTrue(line.equals("world"), "operator>>() fails (2)");
+
+   // Demangled stack trace names end at the name and not at the size of the demangle buffer.
+   const String demangled = Exception::demangle("_ZN2jm6String6appendERKS0_");
+   testEquals(demangled, String("jm::String::append(jm::String const&)"),
+              "Exception::demangle() fails (1)");
+   testEquals(demangled.indexOf(Char(0)), npos, "Exception::demangle() fails (2)");
+   testEquals(Exception::demangle("main"), String("main"), "Exception::demangle() fails (3)");
 }
 
 
@@ -357,3 +446,191 @@ void StringTest::compareFancy()
    String str22("abc");
    testEquals(str21.compareFancyTo(str22), -1, "String.compareFancyTo() fails (11)");
 }
+
+void StringTest::storage()
+{
+   // Grow from inline storage to heap and back
+   String str;
+   String expected = "0123456789abcdefghij";
+   for(size_t index = 0; index < expected.size(); index++)
+   {
+      str.append(expected.charAt(index));
+      testEquals(str, expected.substring(0, index + 1), "String.append fails");
+   }
+
+   // Assignment between short and long strings
+   String shortStr = "abc";
+   String longStr = expected;
+   longStr = shortStr;
+   testEquals(longStr, "abc", "String.operator= (long = short) fails");
+   shortStr = expected;
+   testEquals(shortStr, expected, "String.operator= (short = long) fails");
+   longStr.append(expected);
+   testEquals(longStr, "abc" + expected, "String.append after operator= fails");
+
+   // Copies are independent
+   String copy = shortStr;
+   copy.setCharAt(0, 'X');
+   testEquals(shortStr, expected, "String copy not independent");
+   testTrue(copy.charAt(0) == Char('X'), "String.setCharAt on copy fails");
+
+   // Modifications of shared content do not affect the other copies
+   String original = expected;
+   String copies[] = {original, original, original};
+   copies[0].append('!');
+   copies[1].deleteCharAt(0);
+   copies[2].insert(0, '#');
+   String lower = original.toUpperCase();
+   testEquals(original, expected, "Shared String modified");
+   testEquals(copies[0], expected + "!", "String.append on shared String fails");
+   testEquals(copies[1], expected.substring(1), "String.deleteCharAt on shared String fails");
+   testEquals(copies[2], "#" + expected, "String.insert on shared String fails");
+   testEquals(lower, "0123456789ABCDEFGHIJ", "String.toUpperCase on shared String fails");
+   original = copies[0];
+   copies[0].zero();
+   copies[0].append("xyz");
+   testEquals(original, expected + "!", "String.zero on shared String fails");
+   testEquals(copies[0], "xyz", "String.append after zero fails");
+
+   // Clear releases the heap and the string is usable afterwards
+   longStr.clear();
+   testTrue(longStr.isEmpty(), "String.clear fails");
+   longStr.append(expected);
+   testEquals(longStr, expected, "String.append after clear fails");
+}
+
+void StringTest::concurrentCopies()
+{
+   // Two threads modify their copies of one shared array at the same time. Each detach must copy
+   // the content before the shared array is released by the other thread.
+   const String expected = "0123456789abcdefghijklmnopqrstuvwxyz";
+   bool consistent = true;
+
+   for(size_t round = 0; round < 2000; round++)
+   {
+      String first = expected;
+      first.setCharAt(0, '0');
+      String second = first;
+
+      std::thread worker([&first]()
+      {
+         first.append('!');
+      });
+      second.append('?');
+      worker.join();
+
+      if(first != expected + "!" || second != expected + "?")consistent = false;
+   }
+
+   testTrue(consistent, "Concurrent modification of shared String copies fails");
+}
+
+void StringTest::utf8()
+{
+   // Long ASCII run followed by 2, 3 and 4 byte sequences, so that the block and the scalar
+   // code paths are used.
+   const char* text = "0123456789abcdefghijklmnopqrstuvwxyzABCDEF"
+                      "\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80!";
+   String str1(text, strlen(text));
+   testEquals(str1.size(), static_cast<size_t>(47), "UTF-8 decoding length fails");
+   testEquals(str1.charAt(41).unicode(), 0x0046, "UTF-8 decoding ASCII fails");
+   testEquals(str1.charAt(42).unicode(), 0x00E4, "UTF-8 decoding 2 bytes fails");
+   testEquals(str1.charAt(43).unicode(), 0x20AC, "UTF-8 decoding 3 bytes fails");
+   testEquals(str1.charAt(44).unicode(), 0xD83D, "UTF-8 decoding 4 bytes fails (high)");
+   testEquals(str1.charAt(45).unicode(), 0xDE00, "UTF-8 decoding 4 bytes fails (low)");
+   testEquals(str1.charAt(46).unicode(), 0x0021, "UTF-8 decoding after 4 bytes fails");
+
+   // Round trip
+   ByteArray bytes = str1.toCString();
+   testEquals(bytes.size(), strlen(text), "UTF-8 encoding length fails");
+   testTrue(memcmp(bytes.constData(), text, bytes.size()) == 0, "UTF-8 round trip fails");
+
+   // Byte order mark is skipped
+   String str2("\xEF\xBB\xBF" "abc", 6);
+   testEquals(str2, String("abc"), "UTF-8 BOM fails");
+
+   // Only the given number of bytes is decoded
+   String str3("abcdef", 3);
+   testEquals(str3, String("abc"), "UTF-8 explicit length fails");
+
+   // Invalid and truncated sequences are taken as single characters
+   String str4("a\x80" "b\xC3", 4);
+   testEquals(str4.size(), static_cast<size_t>(4), "UTF-8 invalid sequence fails (1)");
+   testEquals(str4.charAt(1).unicode(), 0x0080, "UTF-8 invalid sequence fails (2)");
+   testEquals(str4.charAt(3).unicode(), 0x00C3, "UTF-8 truncated sequence fails");
+
+   // Overlong encoding of '/'
+   String str5("\xC0\xAF", 2);
+   testEquals(str5.size(), static_cast<size_t>(2), "UTF-8 overlong sequence fails");
+}
+
+void StringTest::search()
+{
+   // Long enough for the block wise search, matches at block borders and in the rest.
+   String str1 = "0123456789abcdef0123456789abcdefXYZ";
+
+   testEquals(str1.indexOf(Char('X')), static_cast<size_t>(32), "String.indexOf() fails. (9)");
+   testEquals(str1.indexOf(Char('7'), 8), static_cast<size_t>(23), "String.indexOf() fails. (10)");
+   testEquals(str1.indexOf(Char('0'), 40), npos, "String.indexOf() fails. (11)");
+   testEquals(str1.indexOf("89ab"), static_cast<size_t>(8), "String.indexOf() fails. (12)");
+   testEquals(str1.indexOf("89ab", 9), static_cast<size_t>(24), "String.indexOf() fails. (13)");
+   testEquals(str1.indexOf("fXYZ"), static_cast<size_t>(31), "String.indexOf() fails. (14)");
+   testEquals(str1.indexOf("XYZ!"), npos, "String.indexOf() fails. (15)");
+   testEquals(str1.indexOf(str1), static_cast<size_t>(0), "String.indexOf() fails. (16)");
+
+   testEquals(str1.lastIndexOf(Char('0')), static_cast<size_t>(16),
+              "String.lastIndexOf() fails. (8)");
+   testEquals(str1.lastIndexOf(Char('0'), 15), static_cast<size_t>(0),
+              "String.lastIndexOf() fails. (9)");
+   testEquals(str1.lastIndexOf("0123"), static_cast<size_t>(16),
+              "String.lastIndexOf() fails. (10)");
+   testEquals(str1.lastIndexOf("0123", 15), static_cast<size_t>(0),
+              "String.lastIndexOf() fails. (11)");
+   testEquals(str1.lastIndexOf("XYZ"), static_cast<size_t>(32), "String.lastIndexOf() fails. (12)");
+   testEquals(str1.lastIndexOf(str1), static_cast<size_t>(0), "String.lastIndexOf() fails. (13)");
+
+   testEquals(str1.count(Char('a')), static_cast<size_t>(2), "String.count() fails");
+
+   testEquals(str1.indexOfAny("ZYX", 0), static_cast<size_t>(32), "String.indexOfAny() fails. (1)");
+   testEquals(str1.indexOfAny("fe", 15), static_cast<size_t>(15), "String.indexOfAny() fails. (2)");
+   testEquals(str1.indexOfAny("#+-", 0), npos, "String.indexOfAny() fails. (3)");
+
+   testEquals(str1.replace("0123", "-"), "-456789abcdef-456789abcdefXYZ",
+              "String.replace() fails. (1)");
+   testEquals(str1.replace("XYZ", ""), "0123456789abcdef0123456789abcdef",
+              "String.replace() fails. (2)");
+   testEquals(str1.replace("", "#"), str1, "String.replace() fails. (3)");
+   testEquals(String("aaaa").replace("aa", "b"), "bb", "String.replace() fails. (4)");
+}
+
+void StringTest::characters()
+{
+   // Classification
+   testTrue(Char(0x03A9).isUpperCase(), "Char.isUpperCase() fails (Greek)");
+   testTrue(Char(0x0436).isLowerCase(), "Char.isLowerCase() fails (Cyrillic)");
+   testTrue(Char(0x4E2D).isLetter(), "Char.isLetter() fails (CJK)");
+   testFalse(Char(0x4E2D).isUpperCase(), "Char.isUpperCase() fails (CJK)");
+   testFalse(Char(0x00D7).isLetter(), "Char.isLetter() fails (Multiplication sign)");
+   testFalse(Char('5').isLetter(), "Char.isLetter() fails (Digit)");
+   testTrue(Char('5').isDigitOrLetter(), "Char.isDigitOrLetter() fails");
+   testTrue(Char(0x2003).isWhitespace(), "Char.isWhitespace() fails (Em space)");
+   testTrue(Char('\t').isWhitespace(), "Char.isWhitespace() fails (Tab)");
+   testFalse(Char(0x00A0).isWhitespace(), "Char.isWhitespace() fails (No-break space)");
+   testFalse(Char('x').isWhitespace(), "Char.isWhitespace() fails (Letter)");
+
+   // Case mapping
+   testEquals(Char(0x03A9).toLowerCase().unicode(), 0x03C9, "Char.toLowerCase() fails (Greek)");
+   testEquals(Char(0x0436).toUpperCase().unicode(), 0x0416, "Char.toUpperCase() fails (Cyrillic)");
+   testEquals(Char(0x0130).toLowerCase().unicode(), 0x0069, "Char.toLowerCase() fails (Turkish)");
+   testEquals(Char(0x00FF).toUpperCase().unicode(), 0x0178, "Char.toUpperCase() fails (y)");
+   testEquals(Char(0x00DF).toUpperCase().unicode(), 0x00DF, "Char.toUpperCase() fails (sharp s)");
+   testEquals(Char(0xFF21).toLowerCase().unicode(), 0xFF41, "Char.toLowerCase() fails (Fullwidth)");
+   testEquals(Char('1').toLowerCase().unicode(), 0x0031, "Char.toLowerCase() fails (Digit)");
+
+   String str1 = "Ελληνικά Кириллица Ärger";
+   testEquals(str1.toUpperCase(), "ΕΛΛΗΝΙΚΆ КИРИЛЛИЦА ÄRGER", "String.toUpperCase() fails (2)");
+   testEquals(str1.toLowerCase(), "ελληνικά кириллица ärger", "String.toLowerCase() fails (2)");
+   testTrue(str1.equalsIgnoreCase("ΕΛΛΗΝΙΚΆ кИРИЛЛИЦА äRGER"), "String.equalsIgnoreCase() fails");
+   testTrue(str1.atIsIgnoreCase(9, "кИРИЛЛИЦА"), "String.atIsIgnoreCase() fails (1)");
+   testFalse(str1.atIsIgnoreCase(9, "кИРИЛЛИЦы"), "String.atIsIgnoreCase() fails (2)");
+}
@@ -21,6 +21,11 @@ class StringTest : public jm::Test
       void isEmpty();
       void compareFancy();
       void constructors();
+      void storage();
+      void concurrentCopies();
+      void utf8();
+      void search();
+      void characters();
 };
 
 #endif